@@ -0,0 +1,25 @@
+/**
+ * \file bench-calibration.cpp
+ * \brief fixed workload independent of the library, measuring the speed of the machine. perf_gate.py divides the
+ *        ratios of the other benchmarks by the ratio of this one, to compensate the frequency changes between runs.
+ */
+
+#include <Eigen/Dense>
+#include <benchmark/benchmark.h>
+
+static void BM_calibration(benchmark::State& state) {
+  Eigen::Matrix3d m = Eigen::Matrix3d::Identity();
+  const Eigen::Matrix3d r = Eigen::AngleAxisd(0.1, Eigen::Vector3d::UnitZ()).toRotationMatrix();
+  Eigen::VectorXd v = Eigen::VectorXd::LinSpaced(64, 0., 1.);
+  for (auto _ : state) {
+    for (int i = 0; i < 64; ++i) {
+      m = r * m;
+      // v converges to 0.5 instead of decaying to the denormals, which are much slower on most CPUs
+      v = v.cwiseProduct(v) * 0.5 + v * 0.25;
+      v.array() += 0.25;
+    }
+    benchmark::DoNotOptimize(m.data());
+    benchmark::DoNotOptimize(v.data());
+  }
+}
+BENCHMARK(BM_calibration);
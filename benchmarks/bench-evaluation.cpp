@@ -0,0 +1,161 @@
+/**
+ * \file bench-evaluation.cpp
+ * \brief evaluation and derivatives of each curve type, for several degrees and dimensions.
+ */
+
+#include "common.h"
+#include "ndcurves/constant_curve.h"
+#include "ndcurves/cubic_hermite_spline.h"
+#include "ndcurves/se3_curve.h"
+#include "ndcurves/sinusoidal.h"
+#include "ndcurves/so3_bezier.h"
+
+using namespace ndcurves;
+using namespace ndcurves::benchmarks;
+
+namespace {
+// evaluate the curve (order 0) or its derivative at all the sample times at each iteration
+template <typename Curve>
+void run_evaluation(benchmark::State& state, const Curve& curve, const std::size_t order) {
+  const std::vector<double> times = sample_times(curve.min(), curve.max());
+  for (auto _ : state) {
+    for (std::vector<double>::const_iterator cit = times.begin(); cit != times.end(); ++cit) {
+      if (order == 0) {
+        benchmark::DoNotOptimize(curve(*cit));
+      } else {
+        benchmark::DoNotOptimize(curve.derivate(*cit, order));
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * int64_t(times.size()));
+}
+
+// same as run_evaluation, without allocation in the loop
+template <typename Curve>
+void run_evaluation_into(benchmark::State& state, const Curve& curve, const std::size_t order) {
+  const std::vector<double> times = sample_times(curve.min(), curve.max());
+  pointX_t out(curve.dim());
+  for (auto _ : state) {
+    for (std::vector<double>::const_iterator cit = times.begin(); cit != times.end(); ++cit) {
+      if (order == 0) {
+        curve.evaluate_into(*cit, out);
+      } else {
+        curve.derivate_into(*cit, order, out);
+      }
+      benchmark::DoNotOptimize(out.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * int64_t(times.size()));
+}
+
+// deterministic rotation, different for each index
+quaternion_t rotation(const std::size_t index) {
+  return quaternion_t(Eigen::Vector4d(point(4, index)).normalized());
+}
+
+// Arguments: dimension, degree, order of the derivative
+void dim_degree_order(benchmark::internal::Benchmark* b) {
+  const int dims[] = {1, 3, 6};
+  const int degrees[] = {3, 5, 9, 15};
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      for (int order = 0; order < 3; ++order) {
+        b->Args({dims[i], degrees[j], order});
+      }
+    }
+  }
+  b->ArgNames({"dim", "degree", "order"});
+}
+}  // namespace
+
+static void BM_polynomial(benchmark::State& state) {
+  const polynomial_t pol = make_polynomial(std::size_t(state.range(0)), std::size_t(state.range(1)));
+  run_evaluation(state, pol, std::size_t(state.range(2)));
+}
+BENCHMARK(BM_polynomial)->Apply(dim_degree_order);
+
+static void BM_polynomial_into(benchmark::State& state) {
+  const polynomial_t pol = make_polynomial(std::size_t(state.range(0)), std::size_t(state.range(1)));
+  run_evaluation_into(state, pol, std::size_t(state.range(2)));
+}
+BENCHMARK(BM_polynomial_into)->Apply(dim_degree_order);
+
+static void BM_bezier(benchmark::State& state) {
+  const bezier_t bezier = make_bezier(std::size_t(state.range(0)), std::size_t(state.range(1)));
+  run_evaluation(state, bezier, std::size_t(state.range(2)));
+}
+BENCHMARK(BM_bezier)->Apply(dim_degree_order);
+
+static void BM_bezier_into(benchmark::State& state) {
+  const bezier_t bezier = make_bezier(std::size_t(state.range(0)), std::size_t(state.range(1)));
+  run_evaluation_into(state, bezier, std::size_t(state.range(2)));
+}
+BENCHMARK(BM_bezier_into)->Apply(dim_degree_order);
+
+static void BM_bezier_de_casteljau(benchmark::State& state) {
+  const bezier_t bezier = make_bezier(std::size_t(state.range(0)), std::size_t(state.range(1)));
+  const std::vector<double> times = sample_times(bezier.min(), bezier.max());
+  for (auto _ : state) {
+    for (std::vector<double>::const_iterator cit = times.begin(); cit != times.end(); ++cit) {
+      benchmark::DoNotOptimize(bezier.evalDeCasteljau(*cit));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * int64_t(times.size()));
+}
+BENCHMARK(BM_bezier_de_casteljau)->ArgsProduct({{1, 3, 6}, {3, 5, 9, 15}})->ArgNames({"dim", "degree"});
+
+// Arguments: dimension, number of waypoints, order of the derivative
+static void BM_cubic_hermite_spline(benchmark::State& state) {
+  const std::size_t dim = std::size_t(state.range(0));
+  const std::size_t num_points = std::size_t(state.range(1));
+  cubic_hermite_spline_t::t_pair_point_tangent_t control_points;
+  std::vector<double> times;
+  for (std::size_t i = 0; i < num_points; ++i) {
+    control_points.push_back(cubic_hermite_spline_t::pair_point_tangent_t(point(dim, i), point(dim, i + num_points)));
+    times.push_back(double(i));
+  }
+  const cubic_hermite_spline_t hermite(control_points.begin(), control_points.end(), times);
+  run_evaluation(state, hermite, std::size_t(state.range(2)));
+}
+BENCHMARK(BM_cubic_hermite_spline)
+    ->ArgsProduct({{1, 3, 6}, {2, 8, 32}, {0, 1, 2}})
+    ->ArgNames({"dim", "waypoints", "order"});
+
+static void BM_constant(benchmark::State& state) {
+  const constant_t constant(point(std::size_t(state.range(0)), 0), 0., 1.);
+  run_evaluation(state, constant, std::size_t(state.range(1)));
+}
+BENCHMARK(BM_constant)->ArgsProduct({{1, 3, 6}, {0, 1}})->ArgNames({"dim", "order"});
+
+static void BM_sinusoidal(benchmark::State& state) {
+  const std::size_t dim = std::size_t(state.range(0));
+  const sinusoidal_t sinusoidal(point(dim, 0), point(dim, 1), 0.8, 0.2, 0., 1.);
+  run_evaluation(state, sinusoidal, std::size_t(state.range(1)));
+}
+BENCHMARK(BM_sinusoidal)->ArgsProduct({{1, 3, 6}, {0, 1, 2}})->ArgNames({"dim", "order"});
+
+// Arguments: number of control rotations, order of the derivative
+static void BM_SO3_bezier(benchmark::State& state) {
+  std::vector<quaternion_t> rotations;
+  for (int i = 0; i < state.range(0); ++i) {
+    rotations.push_back(rotation(std::size_t(i)));
+  }
+  const SO3Bezier_t so3(rotations.begin(), rotations.end(), 0., 1.);
+  run_evaluation(state, so3, std::size_t(state.range(1)));
+}
+BENCHMARK(BM_SO3_bezier)->ArgsProduct({{2, 4, 8}, {0, 1, 2}})->ArgNames({"rotations", "order"});
+
+// Arguments: order of the derivative
+static void BM_SO3_linear(benchmark::State& state) {
+  const SO3Linear_t so3(rotation(0), rotation(1), 0., 1.);
+  run_evaluation(state, so3, std::size_t(state.range(0)));
+}
+BENCHMARK(BM_SO3_linear)->DenseRange(0, 2)->ArgName("order");
+
+// Arguments: degree of the translation, order of the derivative
+static void BM_SE3(benchmark::State& state) {
+  const curve_ptr_t translation(new bezier_t(make_bezier(3, std::size_t(state.range(0)))));
+  const SE3Curve_t se3(translation, rotation(0).toRotationMatrix(), rotation(1).toRotationMatrix());
+  run_evaluation(state, se3, std::size_t(state.range(1)));
+}
+BENCHMARK(BM_SE3)->ArgsProduct({{3, 9}, {0, 1, 2}})->ArgNames({"degree", "order"});
@@ -0,0 +1,98 @@
+/**
+ * \file bench-optimization.cpp
+ * \brief generation of the quadratic problem of a bezier curve as the degree and the number of splits grow.
+ */
+
+#include "common.h"
+#include "ndcurves/optimization/definitions.h"
+#include "ndcurves/optimization/quadratic_problem.h"
+
+using namespace ndcurves;
+using namespace ndcurves::optimization;
+using namespace ndcurves::benchmarks;
+
+namespace {
+typedef problem_definition<point3_t, double> problem_definition_t;
+
+// problem with fixed boundary positions and velocities, and a box constraint on each split segment
+problem_definition_t make_problem(const std::size_t degree, const std::size_t num_splits) {
+  problem_definition_t pDef(3);
+  pDef.flag = constraint_flag(INIT_POS | END_POS | INIT_VEL | END_VEL);
+  pDef.init_pos = point3_t(0., 0., 0.);
+  pDef.end_pos = point3_t(1., 2., 3.);
+  pDef.init_vel = point3_t(0.5, 0., 0.);
+  pDef.end_vel = point3_t(0., 0., -0.5);
+  pDef.degree = degree;
+  pDef.totalTime = 2.;
+  pDef.splitTimes_ = Eigen::VectorXd::Zero(Eigen::Index(num_splits));
+  for (std::size_t i = 0; i < num_splits; ++i) {
+    pDef.splitTimes_[Eigen::Index(i)] = pDef.totalTime * double(i + 1) / double(num_splits + 1);
+  }
+  // -10 <= x, y, z <= 10 on each segment:
+  Eigen::MatrixXd A(6, 3);
+  A << Eigen::Matrix3d::Identity(), -Eigen::Matrix3d::Identity();
+  const Eigen::VectorXd b = Eigen::VectorXd::Constant(6, 10.);
+  for (std::size_t i = 0; i <= num_splits; ++i) {
+    pDef.inequalityMatrices_.push_back(A);
+    pDef.inequalityVectors_.push_back(b);
+  }
+  return pDef;
+}
+}  // namespace
+
+// Arguments: degree of the bezier curve, number of splits
+static void BM_generate_problem(benchmark::State& state) {
+  const problem_definition_t pDef = make_problem(std::size_t(state.range(0)), std::size_t(state.range(1)));
+  for (auto _ : state) {
+    const quadratic_problem<point3_t, double> prob = generate_problem<point3_t, double, true>(pDef, VELOCITY);
+    benchmark::DoNotOptimize(prob.ineqMatrix.data());
+  }
+}
+BENCHMARK(BM_generate_problem)->ArgsProduct({{5, 7, 9, 13}, {0, 1, 3, 7}})->ArgNames({"degree", "splits"});
+
+static void BM_generate_problem_acceleration(benchmark::State& state) {
+  const problem_definition_t pDef = make_problem(std::size_t(state.range(0)), 0);
+  for (auto _ : state) {
+    const quadratic_problem<point3_t, double> prob = generate_problem<point3_t, double, true>(pDef, ACCELERATION);
+    benchmark::DoNotOptimize(prob.cost.A_packed().data());
+  }
+}
+BENCHMARK(BM_generate_problem_acceleration)->Arg(5)->Arg(9)->Arg(13)->Arg(20)->ArgName("degree");
+
+namespace {
+// candidate values of the variables of the problem, one per column
+Eigen::MatrixXd candidates(const problem_data<point3_t, double>& pData, const std::size_t num_candidates) {
+  Eigen::MatrixXd res(Eigen::Index(pData.numVariables * 3), Eigen::Index(num_candidates));
+  for (std::size_t k = 0; k < num_candidates; ++k) {
+    res.col(Eigen::Index(k)) = point(std::size_t(res.rows()), k);
+  }
+  return res;
+}
+}  // namespace
+
+// Arguments: degree of the bezier curve, number of candidate values of the variables
+static void BM_evaluate_linear(benchmark::State& state) {
+  const problem_data<point3_t, double> pData =
+      setup_control_points<point3_t, double, true>(make_problem(std::size_t(state.range(0)), 0));
+  const Eigen::MatrixXd X = candidates(pData, std::size_t(state.range(1)));
+  for (auto _ : state) {
+    for (Eigen::Index k = 0; k < X.cols(); ++k) {
+      const bezier_t bc = evaluateLinear<bezier_t, bezier_linear_variable_t>(*pData.bezier, X.col(k));
+      benchmark::DoNotOptimize(bc.control_points_.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * X.cols());
+}
+BENCHMARK(BM_evaluate_linear)->ArgsProduct({{5, 13}, {16, 256}})->ArgNames({"degree", "candidates"});
+
+static void BM_evaluate_linear_batch(benchmark::State& state) {
+  const problem_data<point3_t, double> pData =
+      setup_control_points<point3_t, double, true>(make_problem(std::size_t(state.range(0)), 0));
+  const Eigen::MatrixXd X = candidates(pData, std::size_t(state.range(1)));
+  for (auto _ : state) {
+    const Eigen::MatrixXd res = evaluateLinearBatch(*pData.bezier, X);
+    benchmark::DoNotOptimize(res.data());
+  }
+  state.SetItemsProcessed(state.iterations() * X.cols());
+}
+BENCHMARK(BM_evaluate_linear_batch)->ArgsProduct({{5, 13}, {16, 256}})->ArgNames({"degree", "candidates"});
@@ -0,0 +1,93 @@
+/**
+ * \file bench-piecewise.cpp
+ * \brief piecewise curve lookup against the number of segments, for each storage, and exact_cubic construction.
+ */
+
+#include "common.h"
+#include "ndcurves/exact_cubic.h"
+#include "ndcurves/piecewise_variant_curve.h"
+
+using namespace ndcurves;
+using namespace ndcurves::benchmarks;
+
+namespace {
+// evaluate the piecewise curve at times spread over all the segments
+template <typename Piecewise>
+void run_lookup(benchmark::State& state, const Piecewise& pc) {
+  const std::vector<double> times = sample_times(pc.min(), pc.max(), 256);
+  for (auto _ : state) {
+    for (std::vector<double>::const_iterator cit = times.begin(); cit != times.end(); ++cit) {
+      benchmark::DoNotOptimize(pc(*cit));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * int64_t(times.size()));
+}
+
+template <typename Piecewise>
+Piecewise make_piecewise(const std::size_t num_segments) {
+  const std::vector<bezier_t> segments = bezier_segments(num_segments);
+  Piecewise pc;
+  for (std::size_t i = 0; i < segments.size(); ++i) {
+    pc.add_curve(segments[i]);
+  }
+  return pc;
+}
+}  // namespace
+
+// Arguments: number of segments
+static void BM_piecewise_lookup_shared(benchmark::State& state) {
+  run_lookup(state, make_piecewise<piecewise_t>(std::size_t(state.range(0))));
+}
+BENCHMARK(BM_piecewise_lookup_shared)->RangeMultiplier(4)->Range(1, 1024)->ArgName("segments");
+
+static void BM_piecewise_lookup_value(benchmark::State& state) {
+  run_lookup(state, make_piecewise<piecewise_bezier_value_t>(std::size_t(state.range(0))));
+}
+BENCHMARK(BM_piecewise_lookup_value)->RangeMultiplier(4)->Range(1, 1024)->ArgName("segments");
+
+static void BM_piecewise_lookup_variant(benchmark::State& state) {
+  run_lookup(state, make_piecewise<piecewise_variant_t>(std::size_t(state.range(0))));
+}
+BENCHMARK(BM_piecewise_lookup_variant)->RangeMultiplier(4)->Range(1, 1024)->ArgName("segments");
+
+static void BM_piecewise_add_curve(benchmark::State& state) {
+  const std::vector<bezier_t> segments = bezier_segments(std::size_t(state.range(0)));
+  for (auto _ : state) {
+    piecewise_t pc;
+    for (std::size_t i = 0; i < segments.size(); ++i) {
+      pc.add_curve(segments[i]);
+    }
+    benchmark::DoNotOptimize(pc.max());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_piecewise_add_curve)->RangeMultiplier(4)->Range(1, 1024)->ArgName("segments");
+
+// Arguments: number of waypoints
+static void BM_exact_cubic_construction(benchmark::State& state) {
+  typedef std::pair<double, pointX_t> waypoint_t;
+  std::vector<waypoint_t> waypoints;
+  for (std::size_t i = 0; i < std::size_t(state.range(0)); ++i) {
+    waypoints.push_back(waypoint_t(double(i), point(3, i)));
+  }
+  for (auto _ : state) {
+    const exact_cubic_t exact_cubic(waypoints.begin(), waypoints.end());
+    benchmark::DoNotOptimize(exact_cubic.num_curves());
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_exact_cubic_construction)
+    ->RangeMultiplier(2)
+    ->Range(4, 128)
+    ->ArgName("waypoints")
+    ->Complexity();
+
+static void BM_exact_cubic_evaluation(benchmark::State& state) {
+  typedef std::pair<double, pointX_t> waypoint_t;
+  std::vector<waypoint_t> waypoints;
+  for (std::size_t i = 0; i < std::size_t(state.range(0)); ++i) {
+    waypoints.push_back(waypoint_t(double(i), point(3, i)));
+  }
+  run_lookup(state, exact_cubic_t(waypoints.begin(), waypoints.end()));
+}
+BENCHMARK(BM_exact_cubic_evaluation)->RangeMultiplier(4)->Range(4, 256)->ArgName("waypoints");
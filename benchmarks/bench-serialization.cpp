@@ -0,0 +1,103 @@
+/**
+ * \file bench-serialization.cpp
+ * \brief save / load throughput of a piecewise curve for each archive type, and loading of discrete points files.
+ */
+
+#include "common.h"
+#include "ndcurves/serialization/curves.hpp"
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using namespace ndcurves;
+using namespace ndcurves::benchmarks;
+
+namespace {
+enum archive_type { TEXT = 0, XML = 1, BINARY = 2 };
+
+const std::string file_name("bench_serialization");
+
+piecewise_t make_piecewise(const std::size_t num_segments) {
+  const std::vector<bezier_t> segments = bezier_segments(num_segments);
+  piecewise_t pc;
+  for (std::size_t i = 0; i < segments.size(); ++i) {
+    pc.add_curve(segments[i]);
+  }
+  return pc;
+}
+
+void save(const piecewise_t& pc, const archive_type type) {
+  switch (type) {
+    case TEXT:
+      pc.saveAsText<piecewise_t>(file_name);
+      break;
+    case XML:
+      pc.saveAsXML<piecewise_t>(file_name, "curve");
+      break;
+    case BINARY:
+      pc.saveAsBinary<piecewise_t>(file_name);
+      break;
+  }
+}
+
+void load(piecewise_t& pc, const archive_type type) {
+  switch (type) {
+    case TEXT:
+      pc.loadFromText<piecewise_t>(file_name);
+      break;
+    case XML:
+      pc.loadFromXML<piecewise_t>(file_name, "curve");
+      break;
+    case BINARY:
+      pc.loadFromBinary<piecewise_t>(file_name);
+      break;
+  }
+}
+
+int64_t file_size() {
+  std::ifstream file(file_name.c_str(), std::ios::binary | std::ios::ate);
+  return int64_t(file.tellg());
+}
+
+// Arguments: archive type, number of segments
+void archive_segments(benchmark::internal::Benchmark* b) {
+  b->ArgsProduct({{TEXT, XML, BINARY}, {1, 16, 256}})->ArgNames({"archive", "segments"});
+}
+}  // namespace
+
+static void BM_serialization_save(benchmark::State& state) {
+  const archive_type type = archive_type(state.range(0));
+  const piecewise_t pc = make_piecewise(std::size_t(state.range(1)));
+  for (auto _ : state) {
+    save(pc, type);
+  }
+  state.SetBytesProcessed(state.iterations() * file_size());
+  std::remove(file_name.c_str());
+}
+BENCHMARK(BM_serialization_save)->Apply(archive_segments);
+
+static void BM_serialization_load(benchmark::State& state) {
+  const archive_type type = archive_type(state.range(0));
+  save(make_piecewise(std::size_t(state.range(1))), type);
+  for (auto _ : state) {
+    piecewise_t pc;
+    load(pc, type);
+    benchmark::DoNotOptimize(pc.num_curves());
+  }
+  state.SetBytesProcessed(state.iterations() * file_size());
+  std::remove(file_name.c_str());
+}
+BENCHMARK(BM_serialization_load)->Apply(archive_segments);
+
+// Arguments: 0 for positions only, 1 with velocities, 2 with velocities and accelerations
+static void BM_load_piecewise_from_text_file(benchmark::State& state) {
+  const char* files[] = {"discrete_points_pos.txt", "discrete_points_vel.txt", "discrete_points_acc.txt"};
+  const std::string file(std::string(BENCHMARK_DATA_PATH) + files[state.range(0)]);
+  for (auto _ : state) {
+    const piecewise_t pc = piecewise_t::load_piecewise_from_text_file<polynomial_t>(file, 0.01, 3);
+    benchmark::DoNotOptimize(pc.num_curves());
+  }
+  std::ifstream ifs(file.c_str(), std::ios::binary | std::ios::ate);
+  state.SetBytesProcessed(state.iterations() * int64_t(ifs.tellg()));
+}
+BENCHMARK(BM_load_piecewise_from_text_file)->DenseRange(0, 2)->ArgName("derivatives");
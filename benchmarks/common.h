@@ -0,0 +1,80 @@
+/**
+ * \file common.h
+ * \brief helpers shared by the benchmarks: deterministic curves of a given degree and dimension.
+ */
+
+#ifndef _CURVES_BENCHMARKS_COMMON
+#define _CURVES_BENCHMARKS_COMMON
+
+#include "ndcurves/fwd.h"
+#include "ndcurves/bezier_curve.h"
+#include "ndcurves/piecewise_curve.h"
+#include "ndcurves/polynomial.h"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <vector>
+
+namespace ndcurves {
+namespace benchmarks {
+
+/// \brief Deterministic point of dimension dim, different for each index.
+inline pointX_t point(const std::size_t dim, const std::size_t index) {
+  pointX_t res(dim);
+  for (std::size_t i = 0; i < dim; ++i) {
+    res[i] = std::sin(double(index * dim + i) + 0.5);
+  }
+  return res;
+}
+
+/// \brief degree + 1 control points of dimension dim.
+inline t_pointX_t control_points(const std::size_t dim, const std::size_t degree, const std::size_t offset = 0) {
+  t_pointX_t res;
+  for (std::size_t i = 0; i <= degree; ++i) {
+    res.push_back(point(dim, offset + i));
+  }
+  return res;
+}
+
+/// \brief Polynomial of the given degree and dimension defined on [t_min, t_max].
+inline polynomial_t make_polynomial(const std::size_t dim, const std::size_t degree, const double t_min = 0.,
+                                    const double t_max = 1.) {
+  const t_pointX_t points = control_points(dim, degree);
+  polynomial_t::coeff_t coeffs(dim, degree + 1);
+  for (std::size_t i = 0; i <= degree; ++i) {
+    coeffs.col(i) = points[i];
+  }
+  return polynomial_t(coeffs, t_min, t_max);
+}
+
+/// \brief Bezier curve of the given degree and dimension defined on [t_min, t_max].
+inline bezier_t make_bezier(const std::size_t dim, const std::size_t degree, const double t_min = 0.,
+                            const double t_max = 1., const std::size_t offset = 0) {
+  const t_pointX_t points = control_points(dim, degree, offset);
+  return bezier_t(points.begin(), points.end(), t_min, t_max);
+}
+
+/// \brief Piecewise curve of num_segments cubic bezier curves of dimension 3, each defined on [i, i+1].
+inline std::vector<bezier_t> bezier_segments(const std::size_t num_segments) {
+  std::vector<bezier_t> res;
+  t_pointX_t points = control_points(3, 3);
+  for (std::size_t i = 0; i < num_segments; ++i) {
+    res.push_back(bezier_t(points.begin(), points.end(), double(i), double(i + 1)));
+    const pointX_t last = points.back();
+    points = control_points(3, 3, i + 1);
+    points.front() = last;
+  }
+  return res;
+}
+
+/// \brief Sequence of times covering [t_min, t_max], visited by the evaluation loops.
+inline std::vector<double> sample_times(const double t_min, const double t_max, const std::size_t num = 64) {
+  std::vector<double> res;
+  for (std::size_t i = 0; i < num; ++i) {
+    res.push_back(t_min + (t_max - t_min) * double(i) / double(num - 1));
+  }
+  return res;
+}
+
+}  // namespace benchmarks
+}  // namespace ndcurves
+#endif  //_CURVES_BENCHMARKS_COMMON
@@ -0,0 +1,240 @@
+#!/usr/bin/env python3
+"""Performance regression gate for ndcurves.
+
+Run a reduced set of curves_benchmarks and compare the CPU time of each benchmark with a baseline JSON file. The time
+of a benchmark is the minimum over the repetitions: the noise (interrupts, other processes) only slows down the runs.
+The gate fails if a benchmark is slower than its baseline by more than its tolerance.
+The ratios are divided by the ratio of BM_calibration, a workload independent of the library, to compensate the
+changes of the speed of the machine between the runs (frequency scaling, other virtual machines, ...).
+
+The timings of a baseline are only meaningful on the machine that recorded them: the committed
+benchmarks/baseline.json provides the filter and the tolerances, its timings must be recorded again on each machine
+running the gate, keeping the filter and the tolerances of the existing file:
+    perf_gate.py --benchmark build/benchmarks/curves_benchmarks --baseline benchmarks/baseline.json --record
+Then check against it:
+    perf_gate.py --benchmark build/benchmarks/curves_benchmarks --baseline benchmarks/baseline.json
+
+Only the python standard library and the benchmark executable are needed.
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+DEFAULT_TOLERANCE = 0.25
+DEFAULT_REPETITIONS = 10
+CALIBRATION = "BM_calibration"
+
+# Exit codes
+SUCCESS = 0
+REGRESSION = 1
+ERROR = 2
+
+
+def noise_hints():
+    """Return a list of the machine settings that make the measurements noisy."""
+    hints = []
+    governors = set()
+    cpu_dir = "/sys/devices/system/cpu"
+    if os.path.isdir(cpu_dir):
+        for cpu in os.listdir(cpu_dir):
+            path = os.path.join(cpu_dir, cpu, "cpufreq", "scaling_governor")
+            if os.path.isfile(path):
+                with open(path) as f:
+                    governors.add(f.read().strip())
+    if governors - {"performance"}:
+        hints.append(
+            "CPU frequency scaling is enabled (governor: %s), use 'sudo cpupower frequency-set -g performance'"
+            % ", ".join(sorted(governors))
+        )
+    no_turbo = "/sys/devices/system/cpu/intel_pstate/no_turbo"
+    if os.path.isfile(no_turbo):
+        with open(no_turbo) as f:
+            if f.read().strip() == "0":
+                hints.append("turbo boost is enabled, use 'echo 1 | sudo tee %s'" % no_turbo)
+    load = os.getloadavg()[0]
+    # the gate itself accounts for 1
+    if load > 1. + 0.5 * (os.cpu_count() or 1):
+        hints.append("the load average is %.1f, close the other applications" % load)
+    return hints
+
+
+def run_benchmarks(executable, bench_filter, repetitions, min_time, cpu):
+    """Run the benchmarks and return {name: (minimal cpu time over the repetitions, time unit)}."""
+    with tempfile.NamedTemporaryFile(suffix=".json", delete=False) as out:
+        out_path = out.name
+    command = [
+        executable,
+        "--benchmark_filter=(%s)|^%s$" % (bench_filter, CALIBRATION),
+        "--benchmark_repetitions=%d" % repetitions,
+        "--benchmark_enable_random_interleaving=true",
+        "--benchmark_min_time=%g" % min_time,
+        "--benchmark_out=" + out_path,
+        "--benchmark_out_format=json",
+    ]
+    if cpu is not None:
+        # inherited by the benchmark process
+        os.sched_setaffinity(0, {cpu})
+    try:
+        subprocess.run(command, check=True, stdout=subprocess.DEVNULL)
+        with open(out_path) as f:
+            report = json.load(f)
+    finally:
+        os.remove(out_path)
+
+    results = {}
+    for bench in report["benchmarks"]:
+        if bench.get("run_type") == "aggregate":
+            continue
+        name = bench.get("run_name", bench["name"])
+        if name not in results or bench["cpu_time"] < results[name][0]:
+            results[name] = (bench["cpu_time"], bench["time_unit"])
+    return report.get("context", {}), results
+
+
+def record(args, baseline):
+    context, results = run_benchmarks(args.benchmark, baseline["filter"], args.repetitions, args.min_time, args.cpu)
+    previous = baseline.get("benchmarks", {})
+    benchmarks = {}
+    for name, (cpu_time, unit) in sorted(results.items()):
+        entry = {"cpu_time": cpu_time, "time_unit": unit}
+        if "tolerance" in previous.get(name, {}):
+            entry["tolerance"] = previous[name]["tolerance"]
+        benchmarks[name] = entry
+    baseline["context"] = {
+        key: context[key] for key in ("num_cpus", "mhz_per_cpu", "cpu_scaling_enabled") if key in context
+    }
+    baseline["benchmarks"] = benchmarks
+    with open(args.baseline, "w") as f:
+        json.dump(baseline, f, indent=2, sort_keys=True)
+        f.write("\n")
+    print("Recorded %d benchmarks in %s" % (len(benchmarks), args.baseline))
+    return SUCCESS
+
+
+def compare(args, baseline):
+    context, results = run_benchmarks(args.benchmark, baseline["filter"], args.repetitions, args.min_time, args.cpu)
+    recorded = baseline.get("context", {})
+    changed = [key for key in ("num_cpus", "mhz_per_cpu") if key in recorded and recorded[key] != context.get(key)]
+    if changed:
+        print(
+            "Warning, the baseline was recorded on another machine (%s differ), record it again on this machine "
+            "with --record.\n" % ", ".join(changed)
+        )
+    default_tolerance = baseline.get("default_tolerance", DEFAULT_TOLERANCE)
+    speed = 1.
+    if args.normalize and CALIBRATION in baseline["benchmarks"] and CALIBRATION in results:
+        reference = baseline["benchmarks"][CALIBRATION]
+        speed = convert(results[CALIBRATION][0], results[CALIBRATION][1], reference["time_unit"]) / reference["cpu_time"]
+        print("Machine speed compared to the baseline: %.3f (the ratios are divided by this factor)\n" % speed)
+    rows = []
+    regressions = []
+    missing = []
+    for name, entry in sorted(baseline["benchmarks"].items()):
+        if name == CALIBRATION:
+            continue
+        if name not in results:
+            missing.append(name)
+            continue
+        cpu_time, unit = results[name]
+        if unit != entry["time_unit"]:
+            cpu_time = convert(cpu_time, unit, entry["time_unit"])
+        tolerance = entry.get("tolerance", default_tolerance)
+        ratio = cpu_time / entry["cpu_time"] / speed
+        if ratio > 1. + tolerance:
+            status = "SLOWER"
+            regressions.append(name)
+        elif ratio < 1. - tolerance:
+            status = "faster"
+        else:
+            status = "ok"
+        rows.append((name, entry["cpu_time"], cpu_time, entry["time_unit"], ratio, tolerance, status))
+
+    width = max([len(row[0]) for row in rows] + [len("benchmark")])
+    print("%-*s %14s %14s %8s %6s  %s" % (width, "benchmark", "baseline", "current", "ratio", "tol", "status"))
+    for name, reference, current, unit, ratio, tolerance, status in rows:
+        print(
+            "%-*s %11.0f %-2s %11.0f %-2s %8.3f %5.0f%%  %s"
+            % (width, name, reference, unit, current, unit, ratio, 100. * tolerance, status)
+        )
+    new = sorted(set(results) - set(baseline["benchmarks"]))
+    if new:
+        print("\nNot in the baseline (record it again to include them):\n  " + "\n  ".join(new))
+    if missing:
+        print("\nIn the baseline but not run:\n  " + "\n  ".join(missing))
+
+    if regressions:
+        print("\n%d benchmark(s) slower than the baseline by more than their tolerance:" % len(regressions))
+        for name in regressions:
+            print("  " + name)
+        hints = noise_hints()
+        if hints:
+            print("\nThe measurements may be noisy:\n  " + "\n  ".join(hints))
+        print(
+            "\nIf the slowdown is expected, or the baseline was recorded on another machine, record it again with "
+            "--record."
+        )
+        return REGRESSION
+    if missing and not args.filter:
+        return ERROR
+    print("\nNo regression over %d benchmarks." % len(rows))
+    return SUCCESS
+
+
+def convert(value, unit, target):
+    factors = {"ns": 1., "us": 1e3, "ms": 1e6, "s": 1e9}
+    return value * factors[unit] / factors[target]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--benchmark", required=True, help="path to the curves_benchmarks executable")
+    parser.add_argument("--baseline", required=True, help="path to the baseline JSON file")
+    parser.add_argument("--record", action="store_true", help="write the baseline instead of checking it")
+    parser.add_argument(
+        "--repetitions",
+        type=int,
+        default=DEFAULT_REPETITIONS,
+        help="number of repetitions of each benchmark, the minimum is used (default: %d)" % DEFAULT_REPETITIONS,
+    )
+    parser.add_argument("--min-time", type=float, default=0.1, help="minimal time of each repetition, in seconds")
+    parser.add_argument(
+        "--no-normalize",
+        dest="normalize",
+        action="store_false",
+        help="compare the raw times, without the correction by %s" % CALIBRATION,
+    )
+    parser.add_argument("--cpu", type=int, help="pin the benchmarks to this CPU")
+    parser.add_argument("--filter", help="regular expression selecting the benchmarks, replaces the baseline one")
+    args = parser.parse_args()
+
+    if not os.path.isfile(args.benchmark):
+        print("%s not found" % args.benchmark, file=sys.stderr)
+        return ERROR
+    if os.path.isfile(args.baseline):
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+    elif args.record:
+        baseline = {"default_tolerance": DEFAULT_TOLERANCE, "benchmarks": {}}
+    else:
+        print("%s not found, create it with --record" % args.baseline, file=sys.stderr)
+        return ERROR
+    if args.filter:
+        baseline["filter"] = args.filter
+    if "filter" not in baseline:
+        print("no benchmark filter in %s, give one with --filter" % args.baseline, file=sys.stderr)
+        return ERROR
+
+    hints = noise_hints()
+    if hints and args.record:
+        print("Warning, the measurements may be noisy:\n  " + "\n  ".join(hints))
+    if args.record:
+        return record(args, baseline)
+    return compare(args, baseline)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
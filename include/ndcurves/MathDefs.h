@@ -20,6 +20,8 @@
 
 #include <vector>
 #include <utility>
+#include <cmath>
+#include <limits>
 namespace ndcurves {
 ///  \brief An inverse kinematics architecture enforcing an arbitrary number of strict priority levels (Reference : Boulic et Al. 2003)
 template <typename _Matrix_Type_>
@@ -48,6 +50,51 @@ Matrix3 skew(const Point&  x) {
   return res;
 }
 
+/// \brief Exp: so3 -> SO3, as a unit quaternion.
+///
+/// Only one sin / cos pair is evaluated, a Taylor expansion is used for small angles.
+///
+/// \param[in] v the rotation vector (angle * axis).
+/// \return The unit quaternion associated to the rotation vector.
+///
+template <typename Scalar>
+Eigen::Quaternion<Scalar> exp3(const Eigen::Matrix<Scalar, 3, 1>& v) {
+  const Scalar theta2 = v.squaredNorm();
+  Scalar c, s;  // cos(theta / 2) and sin(theta / 2) / theta
+  if (theta2 > std::sqrt(std::numeric_limits<Scalar>::epsilon())) {
+    const Scalar theta = std::sqrt(theta2);
+    c = std::cos(theta / Scalar(2));
+    s = std::sin(theta / Scalar(2)) / theta;
+  } else {
+    c = Scalar(1) - theta2 / Scalar(8);
+    s = Scalar(0.5) - theta2 / Scalar(48);
+  }
+  return Eigen::Quaternion<Scalar>(c, s * v[0], s * v[1], s * v[2]);
+}
+
+/// \brief Log: SO3 -> so3, from a unit quaternion.
+///
+/// The returned rotation vector has a norm in [0, pi]: q and -q give the same result.
+///
+/// \param[in] q the unit quaternion.
+/// \return The rotation vector (angle * axis) associated to the quaternion.
+///
+template <typename Scalar>
+Eigen::Matrix<Scalar, 3, 1> log3(const Eigen::Quaternion<Scalar>& q) {
+  const Scalar w = q.w() < Scalar(0) ? -q.w() : q.w();
+  const Eigen::Matrix<Scalar, 3, 1> vec = q.w() < Scalar(0) ? Eigen::Matrix<Scalar, 3, 1>(-q.vec()) : q.vec();
+  const Scalar n2 = vec.squaredNorm();
+  Scalar scale;  // theta / sin(theta / 2)
+  if (n2 > std::sqrt(std::numeric_limits<Scalar>::epsilon())) {
+    const Scalar n = std::sqrt(n2);
+    scale = Scalar(2) * std::atan2(n, w) / n;
+  } else {
+    // Taylor expansion of 2 atan(n / w) / n
+    scale = (Scalar(2) / w) * (Scalar(1) - n2 / (Scalar(3) * w * w));
+  }
+  return scale * vec;
+}
+
 static const double MARGIN(0.001);
 
 }  // namespace ndcurves
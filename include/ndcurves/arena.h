@@ -0,0 +1,180 @@
+/**
+ * \file arena.h
+ * \brief monotonic memory arena and the matching standard allocator.
+ */
+
+#ifndef _CLASS_ARENA
+#define _CLASS_ARENA
+
+#include "instrumentation.h"
+
+#include <boost/noncopyable.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace ndcurves {
+/// \class monotonic_arena.
+/// \brief Memory resource returning memory from large blocks with a bump pointer. Deallocation is a no-op: the
+///        memory is only reclaimed by reset(), which keeps the blocks for the next allocations, or by the destructor.
+///        This is meant for bursts of short-lived objects, e.g. all the curves built during one planning cycle,
+///        with a call to reset() at the beginning of each cycle. All the objects using the arena must be destroyed
+///        before calling reset(). The arena is not thread safe.
+///
+class monotonic_arena : private boost::noncopyable {
+ public:
+  /// \brief Default size of the blocks, in bytes.
+  static const std::size_t default_block_size = 64 * 1024;
+
+  /// \brief Constructor.
+  /// \param block_size : size of the blocks allocated from the heap, in bytes. Larger requests get their own block.
+  ///
+  explicit monotonic_arena(const std::size_t block_size = default_block_size)
+      : block_size_(block_size), current_(0), offset_(0), used_(0) {}
+
+  ~monotonic_arena() {
+    for (std::size_t i = 0; i < blocks_.size(); ++i) {
+      ::operator delete(blocks_[i].data);
+    }
+  }
+
+  /// \brief Return size bytes aligned on alignment, which must be a power of two.
+  /// Allocates a new block from the heap only if the remaining blocks are too small.
+  ///
+  void* allocate(const std::size_t size, const std::size_t alignment) {
+    while (current_ < blocks_.size()) {
+      const std::size_t begin = align(blocks_[current_].data, offset_, alignment);
+      if (begin + size <= blocks_[current_].size) {
+        return commit(begin, size);
+      }
+      ++current_;
+      offset_ = 0;
+    }
+    const std::size_t block_size = size + alignment > block_size_ ? size + alignment : block_size_;
+    // grow blocks_ before allocating the block, so that push_back can not throw and leak it
+    if (blocks_.size() == blocks_.capacity()) {
+      blocks_.reserve(2 * blocks_.size() + 1);
+    }
+    block b;
+    b.data = static_cast<char*>(::operator new(block_size));
+    instrumentation::record_allocation(block_size);
+    b.size = block_size;
+    blocks_.push_back(b);
+    current_ = blocks_.size() - 1;
+    offset_ = 0;
+    return commit(align(b.data, 0, alignment), size);
+  }
+
+  /// \brief Does nothing, the memory is reclaimed by reset().
+  void deallocate(void* /*p*/, const std::size_t /*size*/) {}
+
+  /// \brief Make all the memory of the arena available again, without releasing the blocks to the heap.
+  void reset() {
+    current_ = 0;
+    offset_ = 0;
+    used_ = 0;
+  }
+
+  /// \brief Get the number of bytes returned by allocate since the last reset, including alignment padding.
+  std::size_t used() const { return used_; }
+
+  /// \brief Get the number of bytes allocated from the heap.
+  std::size_t capacity() const {
+    std::size_t res = 0;
+    for (std::size_t i = 0; i < blocks_.size(); ++i) {
+      res += blocks_[i].size;
+    }
+    return res;
+  }
+
+  /// \brief Get the number of blocks allocated from the heap.
+  std::size_t num_blocks() const { return blocks_.size(); }
+
+ private:
+  struct block {
+    char* data;
+    std::size_t size;
+  };
+
+  static std::size_t align(const char* data, const std::size_t offset, const std::size_t alignment) {
+    const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(data) + offset;
+    return offset + std::size_t((alignment - address % alignment) % alignment);
+  }
+
+  void* commit(const std::size_t begin, const std::size_t size) {
+    used_ += begin + size - offset_;
+    offset_ = begin + size;
+    return blocks_[current_].data + begin;
+  }
+
+  std::size_t block_size_;
+  std::vector<block> blocks_;
+  std::size_t current_;  // index of the block used for the next allocation
+  std::size_t offset_;   // first free byte in the current block
+  std::size_t used_;
+};
+
+/// \class arena_allocator.
+/// \brief Standard allocator taking its memory from a monotonic_arena, for boost::allocate_shared (e.g.
+///        piecewise_curve::add_curve), in which case both the curve and its reference counter live in the arena.
+///        It can also be given as the Allocator template argument of bezier_curve and piecewise_curve, so that their
+///        containers live in the arena, and of optimization::problem_data for its vectors. The other curves are
+///        not allocator aware: their coefficients and other containers are still allocated on the heap, as are the
+///        dynamic Eigen matrices held by the points, e.g. pointX_t or linear_variable. The memory is aligned for
+///        Eigen fixed size types.
+///
+template <typename T>
+struct arena_allocator {
+  typedef T value_type;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+  template <typename U>
+  struct rebind {
+    typedef arena_allocator<U> other;
+  };
+
+  /// \brief Minimal alignment of the returned memory, compatible with the vectorized Eigen types.
+  static const std::size_t alignment = alignof(T) > 16 ? alignof(T) : 16;
+
+  explicit arena_allocator(monotonic_arena& arena) : arena_(&arena) {}
+  template <typename U>
+  arena_allocator(const arena_allocator<U>& other) : arena_(other.arena_) {}
+
+  T* allocate(const std::size_t n, const void* /*hint*/ = 0) {
+    if (n > max_size()) throw std::bad_alloc();
+    return static_cast<T*>(arena_->allocate(n * sizeof(T), alignment));
+  }
+  void deallocate(T* p, const std::size_t n) { arena_->deallocate(p, n * sizeof(T)); }
+  std::size_t max_size() const { return std::numeric_limits<std::size_t>::max() / sizeof(T); }
+
+  template <typename U, typename... Args>
+  void construct(U* p, Args&&... args) {
+    ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+  }
+  template <typename U>
+  void destroy(U* p) {
+    p->~U();
+  }
+
+  monotonic_arena* arena_;
+};
+
+template <typename T, typename U>
+bool operator==(const arena_allocator<T>& a, const arena_allocator<U>& b) {
+  return a.arena_ == b.arena_;
+}
+
+template <typename T, typename U>
+bool operator!=(const arena_allocator<T>& a, const arena_allocator<U>& b) {
+  return a.arena_ != b.arena_;
+}
+
+}  // namespace ndcurves
+#endif  //_CLASS_ARENA
@@ -92,6 +92,61 @@ std::vector<Bern<Numeric> > makeBernstein(const unsigned int n) {
   }
   return res;
 }
+
+/// \brief Computes all Bernstein polynomes for a certain degree, in a vector using alloc.
+///
+template <typename Numeric, typename Allocator>
+std::vector<Bern<Numeric>, Allocator> makeBernstein(const unsigned int n, const Allocator& alloc) {
+  std::vector<Bern<Numeric>, Allocator> res(alloc);
+  res.reserve(n + 1);
+  for (unsigned int i = 0; i <= n; ++i) {
+    res.push_back(Bern<Numeric>(n, i));
+  }
+  return res;
+}
+
+/// \brief Evaluate the derivatives of order k of the n+1 Bernstein polynomials of degree n at u, in O(n k):
+/// \f$ \frac{d^k B_i^n}{du^k}(u) = \frac{n!}{(n-k)!} \sum_{j=0}^{k} (-1)^{k-j} \binom{k}{j} B_{i-j}^{n-k}(u) \f$
+/// with \f$ B_i^n(u) = \binom{n}{i} u^i (1-u)^{n-i} \f$, computed with products of u and (1-u) instead of pow.
+/// \param degree : degree n of the polynomials.
+/// \param order : order k of the derivative, all the derivatives are zero if k > n.
+/// \param u : value between 0 and 1, not checked.
+/// \param out : resized to n+1, receives the derivatives of \f$B_0^n(u), ..., B_n^n(u)\f$.
+///
+template <typename Numeric>
+void bernstein_basis(const std::size_t degree, const std::size_t order, const Numeric u,
+                     Eigen::Matrix<Numeric, Eigen::Dynamic, 1>& out) {
+  out.setZero(degree + 1);
+  if (order > degree) {
+    return;
+  }
+  // Bernstein polynomials of degree m = n - k: first binomial(m, i) u^i, then times (1-u)^(m-i)
+  const std::size_t m = degree - order;
+  Numeric u_i = 1, binomial = 1;
+  for (std::size_t i = 0; i <= m; ++i) {
+    out[i] = binomial * u_i;
+    u_i *= u;
+    binomial = binomial * Numeric(m - i) / Numeric(i + 1);
+  }
+  const Numeric v = 1 - u;
+  Numeric v_i = 1;
+  for (std::size_t i = m + 1; i-- > 0;) {
+    out[i] *= v_i;
+    v_i *= v;
+  }
+  // each derivative applies the transpose of the finite difference: w_i <- w_{i-1} - w_i
+  Numeric factor = 1;
+  for (std::size_t j = 0; j < order; ++j) {
+    for (std::size_t i = m + j + 1; i > 0; --i) {
+      out[i] = out[i - 1] - out[i];
+    }
+    out[0] = -out[0];
+    factor *= Numeric(degree - j);
+  }
+  if (order > 0) {
+    out *= factor;
+  }
+}
 }  // namespace ndcurves
 
 DEFINE_CLASS_TEMPLATE_VERSION(typename Numeric, ndcurves::Bern<Numeric>)
@@ -17,6 +17,7 @@
 
 #include "MathDefs.h"
 
+#include <memory>
 #include <vector>
 #include <stdexcept>
 
@@ -27,9 +28,12 @@ namespace ndcurves {
 /// \brief Represents a Bezier curve of arbitrary dimension and order.
 /// For degree lesser than 4, the evaluation is analitycal. Otherwise
 /// the bernstein polynoms are used to evaluate the spline at a given location.
+/// The control points and the Bernstein polynomials are allocated with Allocator, e.g. an arena_allocator, and so
+/// are the ones of the curves computed from this curve (derivative, split, elevation...).
 ///
 template <typename Time = double, typename Numeric = Time, bool Safe = false,
-          typename Point = Eigen::Matrix<Numeric, Eigen::Dynamic, 1> >
+          typename Point = Eigen::Matrix<Numeric, Eigen::Dynamic, 1>,
+          typename Allocator /* = Eigen::aligned_allocator<Point>, see fwd.h */>
 struct bezier_curve : public curve_abc<Time, Numeric, Safe, Point> {
   typedef Point point_t;
   typedef Eigen::Matrix<Numeric, Eigen::Dynamic, 1> vector_x_t;
@@ -37,13 +41,17 @@ struct bezier_curve : public curve_abc<Time, Numeric, Safe, Point> {
   typedef Time time_t;
   typedef Numeric num_t;
   typedef curve_constraints<point_t> curve_constraints_t;
-  typedef std::vector<point_t, Eigen::aligned_allocator<point_t> > t_point_t;
+  typedef Allocator allocator_t;
+  typedef std::vector<point_t, Allocator> t_point_t;
   typedef typename t_point_t::const_iterator cit_point_t;
-  typedef bezier_curve<Time, Numeric, Safe, Point> bezier_curve_t;
+  typedef std::vector<Bern<Numeric>, typename std::allocator_traits<Allocator>::template rebind_alloc<Bern<Numeric> > >
+      t_bernstein_t;
+  typedef bezier_curve<Time, Numeric, Safe, Point, Allocator> bezier_curve_t;
   typedef boost::shared_ptr<bezier_curve_t> bezier_curve_ptr_t;
   typedef piecewise_curve<Time, Numeric, Safe, point_t, point_t, bezier_curve_t> piecewise_curve_t;
   typedef curve_abc<Time, Numeric, Safe, point_t> curve_abc_t;  // parent class
   typedef typename curve_abc_t::curve_ptr_t curve_ptr_t;
+  typedef typename curve_abc_t::point_out_t point_out_t;
 
   /* Constructors - destructors */
  public:
@@ -51,6 +59,11 @@ struct bezier_curve : public curve_abc<Time, Numeric, Safe, Point> {
   ///
   bezier_curve() : dim_(0), T_min_(0), T_max_(0) {}
 
+  /// \brief Empty constructor allocating with alloc, see bezier_curve().
+  ///
+  explicit bezier_curve(const Allocator& alloc)
+      : dim_(0), T_min_(0), T_max_(0), bernstein_(alloc), control_points_(alloc) {}
+
   /// \brief Constructor.
   /// Given the first and last point of a control points set, create the bezier curve.
   /// \param PointsBegin   : an iterator pointing to the first element of a control point container.
@@ -58,17 +71,20 @@ struct bezier_curve : public curve_abc<Time, Numeric, Safe, Point> {
   /// \param T_min         : lower bound of time, curve will be defined for time in [T_min, T_max].
   /// \param T_max         : upper bound of time, curve will be defined for time in [T_min, T_max].
   /// \param mult_T        : ... (default value is 1.0).
+  /// \param alloc         : allocator of the control points and of the Bernstein polynomials.
   ///
   template <typename In>
   bezier_curve(In PointsBegin, In PointsEnd, const time_t T_min = 0., const time_t T_max = 1.,
-               const time_t mult_T = 1.)
+               const time_t mult_T = 1., const Allocator& alloc = Allocator())
       : dim_(PointsBegin->size()),
         T_min_(T_min),
         T_max_(T_max),
         mult_T_(mult_T),
         size_(std::distance(PointsBegin, PointsEnd)),
         degree_(size_ - 1),
-        bernstein_(ndcurves::makeBernstein<num_t>((unsigned int)degree_)) 
+        bernstein_(
+            ndcurves::makeBernstein<num_t>((unsigned int)degree_, typename t_bernstein_t::allocator_type(alloc))),
+        control_points_(alloc)
   {
     if (bernstein_.size() != size_) {
       throw std::invalid_argument("Invalid size of polynomial");
@@ -77,6 +93,7 @@ struct bezier_curve : public curve_abc<Time, Numeric, Safe, Point> {
     if (Safe && (size_ < 1 || T_max_ <= T_min_)) {
       throw std::invalid_argument("can't create bezier min bound is higher than max bound");
     }
+    control_points_.reserve(size_);
     for (; it != PointsEnd; ++it) {
       if(Safe && static_cast<size_t>(it->size()) != dim_)
         throw std::invalid_argument("All the control points must have the same dimension.");
@@ -93,22 +110,26 @@ struct bezier_curve : public curve_abc<Time, Numeric, Safe, Point> {
   /// \param T_min         : lower bound of time, curve will be defined for time in [T_min, T_max].
   /// \param T_max         : upper bound of time, curve will be defined for time in [T_min, T_max].
   /// \param mult_T        : ... (default value is 1.0).
+  /// \param alloc         : allocator of the control points and of the Bernstein polynomials.
   ///
   template <typename In>
   bezier_curve(In PointsBegin, In PointsEnd, const curve_constraints_t& constraints, const time_t T_min = 0.,
-               const time_t T_max = 1., const time_t mult_T = 1.)
+               const time_t T_max = 1., const time_t mult_T = 1., const Allocator& alloc = Allocator())
       : dim_(PointsBegin->size()),
         T_min_(T_min),
         T_max_(T_max),
         mult_T_(mult_T),
         size_(std::distance(PointsBegin, PointsEnd) + 4),
         degree_(size_ - 1),
-        bernstein_(ndcurves::makeBernstein<num_t>((unsigned int)degree_)) 
+        bernstein_(
+            ndcurves::makeBernstein<num_t>((unsigned int)degree_, typename t_bernstein_t::allocator_type(alloc))),
+        control_points_(alloc)
   {
     if (Safe && (size_ < 1 || T_max_ <= T_min_)) {
       throw std::invalid_argument("can't create bezier min bound is higher than max bound");
     }
     t_point_t updatedList = add_constraints<In>(PointsBegin, PointsEnd, constraints);
+    control_points_.reserve(size_);
     for (cit_point_t cit = updatedList.begin(); cit != updatedList.end(); ++cit) {
       if(Safe && static_cast<size_t>(cit->size()) != dim_)
         throw std::invalid_argument("All the control points must have the same dimension.");
@@ -136,6 +157,7 @@ struct bezier_curve : public curve_abc<Time, Numeric, Safe, Point> {
   ///  \param t : time when to evaluate the curve.
   ///  \return \f$x(t)\f$ point corresponding on curve at time t.
   virtual point_t operator()(const time_t t) const {
+    CURVES_INSTRUMENT_SCOPE(EVALUATE, this);
     check_conditions();
     if (Safe & !(T_min_ <= t && t <= T_max_)) {
       throw std::invalid_argument("can't evaluate bezier curve, time t is out of range");  // TODO
@@ -184,18 +206,21 @@ struct bezier_curve : public curve_abc<Time, Numeric, Safe, Point> {
   ///  \param order : order of derivative.
   ///  \return \f$\frac{d^Nx(t)}{dt^N}\f$ derivative order N of the curve.
   bezier_curve_t compute_derivate(const std::size_t order) const {
+    CURVES_INSTRUMENT_SCOPE(COMPUTE_DERIVATE, this);
     check_conditions();
     if (order == 0) {
       return *this;
     }
-    t_point_t derived_wp;
+    t_point_t derived_wp(get_allocator());
+    derived_wp.reserve(size_);
     for (typename t_point_t::const_iterator pit = control_points_.begin(); pit != control_points_.end() - 1; ++pit) {
       derived_wp.push_back((num_t)degree_ * (*(pit + 1) - (*pit)));
     }
     if (derived_wp.empty()) {
       derived_wp.push_back(point_t::Zero(dim_));
     }
-    bezier_curve_t deriv(derived_wp.begin(), derived_wp.end(), T_min_, T_max_, mult_T_ * (1. / (T_max_ - T_min_)));
+    bezier_curve_t deriv(derived_wp.begin(), derived_wp.end(), T_min_, T_max_, mult_T_ * (1. / (T_max_ - T_min_)),
+                         get_allocator());
     return deriv.compute_derivate(order - 1);
   }
 
@@ -217,7 +242,8 @@ struct bezier_curve : public curve_abc<Time, Numeric, Safe, Point> {
       return *this;
     }
     num_t new_degree_inv = 1. / ((num_t)(degree_ + 1));
-    t_point_t n_wp;
+    t_point_t n_wp(get_allocator());
+    n_wp.reserve(size_ + 1);
     point_t current_sum = point_t::Zero(dim_);
     // recomputing waypoints q_i from derivative waypoints p_i. q_0 is the given constant.
     // then q_i = (sum( j = 0 -> j = i-1) p_j) /n+1
@@ -226,7 +252,7 @@ struct bezier_curve : public curve_abc<Time, Numeric, Safe, Point> {
       current_sum += *pit;
       n_wp.push_back(current_sum * new_degree_inv);
     }
-    bezier_curve_t integ(n_wp.begin(), n_wp.end(), T_min_, T_max_, mult_T_ * (T_max_ - T_min_));
+    bezier_curve_t integ(n_wp.begin(), n_wp.end(), T_min_, T_max_, mult_T_ * (T_max_ - T_min_), get_allocator());
     return integ.compute_primitive(order - 1);
   }
 
@@ -235,7 +261,7 @@ struct bezier_curve : public curve_abc<Time, Numeric, Safe, Point> {
   ///  \param order : number of order the curve must be updated
   ///  \return An equivalent Bezier, with one more degree.
   bezier_curve_t elevate(const std::size_t order) const {
-    t_point_t new_waypoints = control_points_, temp_waypoints;
+    t_point_t new_waypoints(control_points_), temp_waypoints(get_allocator());
     for (std::size_t i = 1; i<= order; ++i)
     {
         num_t new_degree_inv = 1. / ((num_t)(degree_ + i));
@@ -249,7 +275,7 @@ struct bezier_curve : public curve_abc<Time, Numeric, Safe, Point> {
         new_waypoints = temp_waypoints;
         temp_waypoints.clear();
     }
-    return bezier_curve_t (new_waypoints.begin(), new_waypoints.end(), T_min_, T_max_, mult_T_);
+    return bezier_curve_t (new_waypoints.begin(), new_waypoints.end(), T_min_, T_max_, mult_T_, get_allocator());
   }
 
   ///  \brief Elevate the Bezier curve of order degrees higher than the current curve, but strictly equivalent.
@@ -261,13 +287,107 @@ struct bezier_curve : public curve_abc<Time, Numeric, Safe, Point> {
   }
 
   ///  \brief Evaluate the derivative order N of curve at time t.
-  ///  If derivative is to be evaluated several times, it is
-  ///  rather recommended to compute derived curve using compute_derivate.
+  ///  The control points of the derived curve are computed on the fly from the finite differences of the control
+  ///  points, so the derived curve is never built.
   ///  \param order : order of derivative.
   ///  \param t : time when to evaluate the curve.
   ///  \return \f$\frac{d^Nx(t)}{dt^N}\f$ point corresponding on derived curve of order N at time t.
   ///
-  virtual point_t derivate(const time_t t, const std::size_t order) const { return compute_derivate(order)(t); }
+  virtual point_t derivate(const time_t t, const std::size_t order) const {
+    CURVES_INSTRUMENT_SCOPE(DERIVATE, this);
+    if (order == 0) {
+      return (*this)(t);
+    }
+    check_conditions();
+    if (Safe & !(T_min_ <= t && t <= T_max_)) {
+      throw std::invalid_argument("can't evaluate bezier curve, time t is out of range");
+    }
+    if (order > degree_) {
+      return point_t::Zero(dim_);
+    }
+    // the derived curve has the degree n = degree - order and the control points
+    // degree! / n! / (T_max - T_min)^order * finite_difference(i, order)
+    num_t factor = mult_T_;
+    for (std::size_t i = 0; i < order; ++i) {
+      factor *= (num_t)(degree_ - i) / (T_max_ - T_min_);
+    }
+    const std::size_t n = degree_ - order;
+    if (n == 0) {
+      return finiteDifference(0, order) * factor;
+    }
+    const Numeric u = (t - T_min_) / (T_max_ - T_min_);
+    const Numeric u_op = 1.0 - u;
+    Numeric bc = 1, tn = 1;
+    point_t tmp = finiteDifference(0, order) * u_op;
+    for (std::size_t i = 1; i < n; i++) {
+      tn = tn * u;
+      bc = bc * ((num_t)(n - i + 1)) / (num_t)i;
+      tmp = (tmp + tn * bc * finiteDifference(i, order)) * u_op;
+    }
+    return (tmp + tn * u * finiteDifference(n, order)) * factor;
+  }
+
+  ///  \brief Evaluation of the bezier curve at time t with Horner's scheme, written in out without allocation.
+  ///  \param t : time when to evaluate the curve.
+  ///  \param out : \f$x(t)\f$ point corresponding on curve at time t.
+  virtual void evaluate_into(const time_t t, point_out_t out) const {
+    check_conditions();
+    if (Safe & !(T_min_ <= t && t <= T_max_)) {
+      throw std::invalid_argument("can't evaluate bezier curve, time t is out of range");
+    }
+    evaluate_unchecked(t, out);
+  }
+
+  ///  \brief Evaluate the derivative order N of curve at time t, written in out without allocation.
+  ///  \param t : time when to evaluate the curve.
+  ///  \param order : order of derivative.
+  ///  \param out : \f$\frac{d^Nx(t)}{dt^N}\f$ point corresponding on derived curve of order N at time t.
+  virtual void derivate_into(const time_t t, const std::size_t order, point_out_t out) const {
+    if (order == 0) {
+      evaluate_into(t, out);
+      return;
+    }
+    check_conditions();
+    if (Safe & !(T_min_ <= t && t <= T_max_)) {
+      throw std::invalid_argument("can't evaluate bezier curve, time t is out of range");
+    }
+    derivate_unchecked(t, order, out);
+  }
+
+  ///  \brief Real-time safe evaluation of the bezier curve at time t, see curve_abc::evaluate_rt.
+  ///  Not available for the points that allocate, such as linear_variable.
+  ///  \param t : time when to evaluate the curve, clamped in [Tmin, Tmax].
+  ///  \param out : \f$x(t)\f$ point corresponding on curve at time t.
+  ///  \return EVAL_OK or EVAL_CLAMPED if out was written, the reason of the failure otherwise.
+  virtual eval_status evaluate_rt(const time_t t, point_out_t out) const noexcept {
+    if (!point_out<point_t>::real_time_safe) return EVAL_NOT_REAL_TIME;
+    if (control_points_.size() == 0 || dim_ == 0) return EVAL_EMPTY;
+    if (!point_out<point_t>::valid_size(out, dim_)) return EVAL_INVALID_SIZE;
+    time_t tc(t);
+    const eval_status status = clamp_time(tc, T_min_, T_max_);
+    evaluate_unchecked(tc, out);
+    return status;
+  }
+
+  ///  \brief Real-time safe evaluation of the derivative of order N at time t, see curve_abc::derivate_rt.
+  ///  Not available for the points that allocate, such as linear_variable.
+  ///  \param t : time when to evaluate the curve, clamped in [Tmin, Tmax].
+  ///  \param order : order of derivative.
+  ///  \param out : \f$\frac{d^Nx(t)}{dt^N}\f$ point corresponding on derived curve of order N at time t.
+  ///  \return EVAL_OK or EVAL_CLAMPED if out was written, the reason of the failure otherwise.
+  virtual eval_status derivate_rt(const time_t t, const std::size_t order, point_out_t out) const noexcept {
+    if (!point_out<point_t>::real_time_safe) return EVAL_NOT_REAL_TIME;
+    if (control_points_.size() == 0 || dim_ == 0) return EVAL_EMPTY;
+    if (!point_out<point_t>::valid_size(out, dim_)) return EVAL_INVALID_SIZE;
+    time_t tc(t);
+    const eval_status status = clamp_time(tc, T_min_, T_max_);
+    if (order == 0) {
+      evaluate_unchecked(tc, out);
+    } else {
+      derivate_unchecked(tc, order, out);
+    }
+    return status;
+  }
 
   /// \brief Evaluate all Bernstein polynomes for a certain degree.
   /// A bezier curve with N control points is represented by : \f$x(t) = \sum_{i=0}^{N} B_i^N(t) P_i\f$
@@ -281,7 +401,7 @@ struct bezier_curve : public curve_abc<Time, Numeric, Safe, Point> {
     const Numeric u = (t - T_min_) / (T_max_ - T_min_);
     point_t res = point_t::Zero(dim_);
     typename t_point_t::const_iterator control_points_it = control_points_.begin();
-    for (typename std::vector<Bern<Numeric> >::const_iterator cit = bernstein_.begin(); cit != bernstein_.end();
+    for (typename t_bernstein_t::const_iterator cit = bernstein_.begin(); cit != bernstein_.end();
          ++cit, ++control_points_it) {
       res += cit->operator()(u) * (*control_points_it);
     }
@@ -317,8 +437,83 @@ struct bezier_curve : public curve_abc<Time, Numeric, Safe, Point> {
     return (tmp + tn * u * (*control_points_it)) * mult_T_;
   }
 
+  /// \brief Weights of the control points in the derivative of order N of the curve at time t:
+  /// \f$\frac{d^Nx(t)}{dt^N} = \sum_{i=0}^{n} w_i P_i\f$, see bernstein_basis for the recurrence used.
+  /// The weights do not depend on the control points, they can be used to write constraints on the control points or
+  /// on the variables of a bezier curve of linear_variable.
+  /// \param t : time when to evaluate the weights.
+  /// \param order : order of the derivative, 0 for the position.
+  /// \return the vector \f$w\f$ of size size(), zero if order > degree().
+  ///
+  vector_x_t basis_at(const time_t t, const std::size_t order = 0) const {
+    check_conditions();
+    if (Safe & !(T_min_ <= t && t <= T_max_)) {
+      throw std::invalid_argument("can't evaluate bezier basis, time t is out of range");
+    }
+    vector_x_t res;
+    bernstein_basis<Numeric>(degree_, order, (t - T_min_) / (T_max_ - T_min_), res);
+    return res * (mult_T_ / std::pow(T_max_ - T_min_, Numeric(order)));
+  }
+
+  /// \brief Collocation matrix of the derivative of order N on a time grid: row j is basis_at(times[j], order).
+  /// \param times : times when to evaluate the weights.
+  /// \param order : order of the derivative, 0 for the position.
+  /// \return a matrix with one row per time and size() columns.
+  ///
+  Eigen::Matrix<Numeric, Eigen::Dynamic, Eigen::Dynamic> basis_matrix(const vector_x_ref_t& times,
+                                                                      const std::size_t order = 0) const {
+    check_conditions();
+    Eigen::Matrix<Numeric, Eigen::Dynamic, Eigen::Dynamic> res(times.size(), size_);
+    const Numeric scale = mult_T_ / std::pow(T_max_ - T_min_, Numeric(order));
+    vector_x_t row;
+    for (Eigen::Index j = 0; j < times.size(); ++j) {
+      if (Safe & !(T_min_ <= times[j] && times[j] <= T_max_)) {
+        throw std::invalid_argument("can't evaluate bezier basis, time t is out of range");
+      }
+      bernstein_basis<Numeric>(degree_, order, (times[j] - T_min_) / (T_max_ - T_min_), row);
+      res.row(j) = row.transpose() * scale;
+    }
+    return res;
+  }
+
   const t_point_t& waypoints() const { return control_points_; }
 
+  /// \brief Get the allocator of the control points.
+  allocator_t get_allocator() const { return control_points_.get_allocator(); }
+
+  /// \brief Finite difference of order N of the control points starting at index i:
+  /// \f$ \Delta^N P_i = \sum_{j=0}^{N} (-1)^j \binom{N}{j} P_{i+N-j} \f$.
+  /// \param index : index of the first control point used.
+  /// \param order : order of the finite difference.
+  /// \return the finite difference, the control point of index i of the derived curve of order N up to a factor.
+  ///
+  point_t finiteDifference(const std::size_t index, const std::size_t order) const {
+    point_t res = control_points_[index + order];
+    num_t binomial = 1;
+    for (std::size_t j = 1; j <= order; ++j) {
+      binomial = binomial * (num_t)(order - j + 1) / (num_t)j;
+      res += ((j % 2) ? -binomial : binomial) * control_points_[index + order - j];
+    }
+    return res;
+  }
+
+  /// \brief Add to out the finite difference of order N of the control points starting at index i, times a factor:
+  /// \f$ out += factor \Delta^N P_i = factor \sum_{j=0}^{N} (-1)^j \binom{N}{j} P_{i+N-j} \f$.
+  /// \param index : index of the first control point used.
+  /// \param order : order of the finite difference.
+  /// \param factor : factor applied to the finite difference.
+  /// \param out : point the finite difference is added to.
+  ///
+  void addFiniteDifference(const std::size_t index, const std::size_t order, const num_t factor,
+                           point_out_t out) const noexcept(point_out<point_t>::real_time_safe) {
+    num_t binomial = 1;
+    out += factor * control_points_[index + order];
+    for (std::size_t j = 1; j <= order; ++j) {
+      binomial = binomial * (num_t)(order - j + 1) / (num_t)j;
+      out += ((j % 2) ? -binomial * factor : binomial * factor) * control_points_[index + order - j];
+    }
+  }
+
   const point_t waypointAtIndex(const std::size_t index) const {
     point_t waypoint;
     if (index < control_points_.size()) {
@@ -365,7 +560,8 @@ struct bezier_curve : public curve_abc<Time, Numeric, Safe, Point> {
       return pts;
     }
 
-    t_point_t new_pts;
+    t_point_t new_pts(pts.get_allocator());
+    new_pts.reserve(pts.size() - 1);
     for (cit_point_t cit = pts.begin(); cit != (pts.end() - 1); ++cit) {
       new_pts.push_back((1 - u) * (*cit) + u * (*(cit + 1)));
     }
@@ -381,7 +577,9 @@ struct bezier_curve : public curve_abc<Time, Numeric, Safe, Point> {
     if (fabs(t - T_max_) < MARGIN) {
       throw std::runtime_error("can't split curve, interval range is equal to original curve");
     }
-    t_point_t wps_first(size_), wps_second(size_);
+    t_point_t wps_first(get_allocator()), wps_second(get_allocator());
+    wps_first.resize(size_);
+    wps_second.resize(size_);
     const Numeric u = (t - T_min_) / (T_max_ - T_min_);
     t_point_t casteljau_pts = waypoints();
     wps_first[0] = casteljau_pts.front();
@@ -393,8 +591,8 @@ struct bezier_curve : public curve_abc<Time, Numeric, Safe, Point> {
       wps_second[degree_ - id] = casteljau_pts.back();
       ++id;
     }
-    bezier_curve_t c_first(wps_first.begin(), wps_first.end(), T_min_, t, mult_T_);
-    bezier_curve_t c_second(wps_second.begin(), wps_second.end(), t, T_max_, mult_T_);
+    bezier_curve_t c_first(wps_first.begin(), wps_first.end(), T_min_, t, mult_T_, get_allocator());
+    bezier_curve_t c_second(wps_second.begin(), wps_second.end(), t, T_max_, mult_T_, get_allocator());
     return std::make_pair(c_first, c_second);
   }
 
@@ -432,7 +630,7 @@ struct bezier_curve : public curve_abc<Time, Numeric, Safe, Point> {
     }
     if (fabs(t1 - T_min_) < MARGIN && fabs(t2 - T_max_) < MARGIN)  // t1=T_min and t2=T_max
     {
-      return bezier_curve_t(waypoints().begin(), waypoints().end(), T_min_, T_max_, mult_T_);
+      return bezier_curve_t(waypoints().begin(), waypoints().end(), T_min_, T_max_, mult_T_, get_allocator());
     }
     if (fabs(t1 - T_min_) < MARGIN)  // t1=T_min
     {
@@ -462,7 +660,7 @@ struct bezier_curve : public curve_abc<Time, Numeric, Safe, Point> {
     int m =(int)(degree());
     int n =(int)(g.degree());
     unsigned int mj, n_ij, mn_i;
-    t_point_t new_waypoints;
+    t_point_t new_waypoints(get_allocator());
     for(int i = 0; i<= m+n; ++i)
     {
         bezier_curve_t::point_t current_point = bezier_curve_t::point_t::Zero(dim());
@@ -475,7 +673,7 @@ struct bezier_curve : public curve_abc<Time, Numeric, Safe, Point> {
         }
         new_waypoints.push_back(current_point);
     }
-    return bezier_curve_t(new_waypoints.begin(),new_waypoints.end(),min(),max(),mult_T_ * g.mult_T_);
+    return bezier_curve_t(new_waypoints.begin(),new_waypoints.end(),min(),max(),mult_T_ * g.mult_T_, get_allocator());
   }
 
 
@@ -490,11 +688,11 @@ struct bezier_curve : public curve_abc<Time, Numeric, Safe, Point> {
     //http://web.mit.edu/hyperbook/Patrikalakis-Maekawa-Cho/node10.html
     if (dim()!= 3)
         throw std::invalid_argument("Can't perform cross product on Bezier curves with dimensions != 3 ");
-    t_point_t new_waypoints;
+    t_point_t new_waypoints(get_allocator());
     for(typename t_point_t::const_iterator cit = waypoints().begin(); cit != waypoints().end(); ++cit){
       new_waypoints.push_back(ndcurves::cross(*cit, point));
     }
-    return bezier_curve_t(new_waypoints.begin(),new_waypoints.end(),min(),max(),mult_T_);
+    return bezier_curve_t(new_waypoints.begin(),new_waypoints.end(),min(),max(),mult_T_, get_allocator());
   }
 
   bezier_curve_t& operator+=(const bezier_curve_t& other) {
@@ -543,14 +741,14 @@ struct bezier_curve : public curve_abc<Time, Numeric, Safe, Point> {
     return *this;
   }
 
-  bezier_curve_t& operator/=(const double d) {
+  bezier_curve_t& operator/=(const num_t d) {
     for (typename t_point_t::iterator it = control_points_.begin(); it!=control_points_.end(); ++it){
       (*it)/=d;
     }
     return *this;
   }
 
-  bezier_curve_t& operator*=(const double d) {
+  bezier_curve_t& operator*=(const num_t d) {
     for (typename t_point_t::iterator it = control_points_.begin(); it!=control_points_.end(); ++it){
       (*it)*=d;
     }
@@ -565,7 +763,8 @@ struct bezier_curve : public curve_abc<Time, Numeric, Safe, Point> {
   ///
   template <typename In>
   t_point_t add_constraints(In PointsBegin, In PointsEnd, const curve_constraints_t& constraints) {
-    t_point_t res;
+    t_point_t res(get_allocator());
+    res.reserve(size_);
     num_t T = T_max_ - T_min_;
     num_t T_square = T * T;
     point_t P0, P1, P2, P_n_2, P_n_1, PN;
@@ -587,6 +786,50 @@ struct bezier_curve : public curve_abc<Time, Numeric, Safe, Point> {
     return res;
   }
 
+  /// \brief Horner's scheme, without any check on t or on the control points.
+  void evaluate_unchecked(const time_t t, point_out_t out) const noexcept(point_out<point_t>::real_time_safe) {
+    out = control_points_[0];
+    if (size_ > 1) {
+      const Numeric u = (t - T_min_) / (T_max_ - T_min_);
+      const Numeric u_op = 1.0 - u;
+      Numeric bc = 1, tn = 1;
+      for (std::size_t i = 1; i <= degree_; i++) {
+        tn = tn * u;
+        bc = bc * ((num_t)(degree_ - i + 1)) / (num_t)i;
+        out *= u_op;
+        out += (tn * bc) * control_points_[i];
+      }
+    }
+    out *= mult_T_;
+  }
+
+  /// \brief Derivative of order N > 0 with Horner's scheme on the finite differences of the control points,
+  /// without any check on t or on the control points.
+  void derivate_unchecked(const time_t t, const std::size_t order, point_out_t out) const
+      noexcept(point_out<point_t>::real_time_safe) {
+    out = point_t::Zero(dim_);
+    if (order > degree_) {
+      return;
+    }
+    // the derived curve has the degree n = degree - order and the control points
+    // degree! / n! / (T_max - T_min)^order * finite_difference(i, order)
+    num_t factor = mult_T_;
+    for (std::size_t i = 0; i < order; ++i) {
+      factor *= (num_t)(degree_ - i) / (T_max_ - T_min_);
+    }
+    const std::size_t n = degree_ - order;
+    const Numeric u = (t - T_min_) / (T_max_ - T_min_);
+    const Numeric u_op = 1.0 - u;
+    Numeric bc = 1, tn = 1;
+    addFiniteDifference(0, order, factor, out);
+    for (std::size_t i = 1; i <= n; i++) {
+      tn = tn * u;
+      bc = bc * ((num_t)(n - i + 1)) / (num_t)i;
+      out *= u_op;
+      addFiniteDifference(i, order, tn * bc * factor, out);
+    }
+  }
+
   void check_conditions() const {
     if (control_points_.size() == 0) {
       throw std::runtime_error(
@@ -620,6 +863,14 @@ struct bezier_curve : public curve_abc<Time, Numeric, Safe, Point> {
   /// \brief Get the degree of the curve.
   /// \return \f$degree\f$, the degree of the curve.
   virtual std::size_t degree() const { return degree_; }
+  /// \brief Get the memory used by the curve, by category. See footprint.
+  virtual footprint memory_footprint() const {
+    footprint res;
+    res.add(footprint::OBJECTS, sizeof(*this));
+    add_points_footprint(res, footprint::CONTROL_POINTS, control_points_);
+    res.add(footprint::BERNSTEIN, bernstein_.capacity() * sizeof(Bern<Numeric>));
+    return res;
+  }
   /*Helpers*/
 
   /* Attributes */
@@ -632,14 +883,14 @@ struct bezier_curve : public curve_abc<Time, Numeric, Safe, Point> {
   /*const*/ time_t mult_T_;
   /*const*/ std::size_t size_;
   /*const*/ std::size_t degree_;
-  /*const*/ std::vector<Bern<Numeric> > bernstein_;
+  /*const*/ t_bernstein_t bernstein_;
   /*const*/ t_point_t control_points_;
   /* Attributes */
 
-  static bezier_curve_t zero(const std::size_t dim, const time_t T = 1.) {
-    std::vector<point_t> ts;
+  static bezier_curve_t zero(const std::size_t dim, const time_t T = 1., const Allocator& alloc = Allocator()) {
+    t_point_t ts(alloc);
     ts.push_back(point_t::Zero(dim));
-    return bezier_curve_t(ts.begin(), ts.end(), 0., T);
+    return bezier_curve_t(ts.begin(), ts.end(), 0., T, 1., alloc);
   }
 
   // Serialization of the class
@@ -662,75 +913,76 @@ struct bezier_curve : public curve_abc<Time, Numeric, Safe, Point> {
   }
 };  // End struct bezier_curve
 
-template <typename T, typename N, bool S, typename P >
-bezier_curve<T,N,S,P> operator+(const bezier_curve<T,N,S,P>& p1, const bezier_curve<T,N,S,P>& p2) {
-  bezier_curve<T,N,S,P> res(p1);
+template <typename T, typename N, bool S, typename P, typename A>
+bezier_curve<T,N,S,P,A> operator+(const bezier_curve<T,N,S,P,A>& p1, const bezier_curve<T,N,S,P,A>& p2) {
+  bezier_curve<T,N,S,P,A> res(p1);
   return res+=p2;
 }
 
-template <typename T, typename N, bool S, typename P >
-bezier_curve<T,N,S,P> operator-(const bezier_curve<T,N,S,P>& p1) {
-    std::vector<typename bezier_curve<T,N,S,P>::point_t> ts;
+template <typename T, typename N, bool S, typename P, typename A>
+bezier_curve<T,N,S,P,A> operator-(const bezier_curve<T,N,S,P,A>& p1) {
+    typename bezier_curve<T,N,S,P,A>::t_point_t ts(p1.get_allocator());
     for (std::size_t i = 0; i <= p1.degree(); ++i){
-      ts.push_back(bezier_curve<T,N,S,P>::point_t::Zero(p1.dim()));
+      ts.push_back(bezier_curve<T,N,S,P,A>::point_t::Zero(p1.dim()));
     }
-    bezier_curve<T,N,S,P> res (ts.begin(),ts.end(),p1.min(),p1.max());
+    bezier_curve<T,N,S,P,A> res (ts.begin(),ts.end(),p1.min(),p1.max(),1.,p1.get_allocator());
     res-=p1;
     return res;
 }
 
-template <typename T, typename N, bool S, typename P >
-bezier_curve<T,N,S,P> operator-(const bezier_curve<T,N,S,P>& p1, const bezier_curve<T,N,S,P>& p2) {
-    bezier_curve<T,N,S,P> res(p1);
+template <typename T, typename N, bool S, typename P, typename A>
+bezier_curve<T,N,S,P,A> operator-(const bezier_curve<T,N,S,P,A>& p1, const bezier_curve<T,N,S,P,A>& p2) {
+    bezier_curve<T,N,S,P,A> res(p1);
     return res-=p2;
 }
 
 
-template <typename T, typename N, bool S, typename P >
-bezier_curve<T,N,S,P> operator-(const bezier_curve<T,N,S,P>& p1, const typename bezier_curve<T,N,S,P>::point_t& point) {
-  bezier_curve<T,N,S,P> res(p1);
+template <typename T, typename N, bool S, typename P, typename A>
+bezier_curve<T,N,S,P,A> operator-(const bezier_curve<T,N,S,P,A>& p1, const typename bezier_curve<T,N,S,P,A>::point_t& point) {
+  bezier_curve<T,N,S,P,A> res(p1);
   return res-=point;
 }
 
-template <typename T, typename N, bool S, typename P >
-bezier_curve<T,N,S,P> operator-(const typename bezier_curve<T,N,S,P>::point_t& point, const bezier_curve<T,N,S,P>& p1) {
-  bezier_curve<T,N,S,P> res(-p1);
+template <typename T, typename N, bool S, typename P, typename A>
+bezier_curve<T,N,S,P,A> operator-(const typename bezier_curve<T,N,S,P,A>::point_t& point, const bezier_curve<T,N,S,P,A>& p1) {
+  bezier_curve<T,N,S,P,A> res(-p1);
   return res+=point;
 }
 
-template <typename T, typename N, bool S, typename P >
-bezier_curve<T,N,S,P> operator+(const bezier_curve<T,N,S,P>& p1, const typename bezier_curve<T,N,S,P>::point_t& point) {
-  bezier_curve<T,N,S,P> res(p1);
+template <typename T, typename N, bool S, typename P, typename A>
+bezier_curve<T,N,S,P,A> operator+(const bezier_curve<T,N,S,P,A>& p1, const typename bezier_curve<T,N,S,P,A>::point_t& point) {
+  bezier_curve<T,N,S,P,A> res(p1);
   return res+=point;
 }
 
-template <typename T, typename N, bool S, typename P >
-bezier_curve<T,N,S,P> operator+(const typename bezier_curve<T,N,S,P>::point_t& point, const bezier_curve<T,N,S,P>& p1) {
-  bezier_curve<T,N,S,P> res(p1);
+template <typename T, typename N, bool S, typename P, typename A>
+bezier_curve<T,N,S,P,A> operator+(const typename bezier_curve<T,N,S,P,A>::point_t& point, const bezier_curve<T,N,S,P,A>& p1) {
+  bezier_curve<T,N,S,P,A> res(p1);
   return res+=point;
 }
 
-template <typename T, typename N, bool S, typename P >
-bezier_curve<T,N,S,P> operator/(const bezier_curve<T,N,S,P>& p1, const double k) {
-    bezier_curve<T,N,S,P> res(p1);
+template <typename T, typename N, bool S, typename P, typename A>
+bezier_curve<T,N,S,P,A> operator/(const bezier_curve<T,N,S,P,A>& p1, const typename bezier_curve<T,N,S,P,A>::num_t k) {
+    bezier_curve<T,N,S,P,A> res(p1);
     return res/=k;
 }
 
-template <typename T, typename N, bool S, typename P >
-bezier_curve<T,N,S,P> operator*(const bezier_curve<T,N,S,P>& p1,const double k)  {
-    bezier_curve<T,N,S,P> res(p1);
+template <typename T, typename N, bool S, typename P, typename A>
+bezier_curve<T,N,S,P,A> operator*(const bezier_curve<T,N,S,P,A>& p1,const typename bezier_curve<T,N,S,P,A>::num_t k)  {
+    bezier_curve<T,N,S,P,A> res(p1);
     return res*=k;
 }
 
-template <typename T, typename N, bool S, typename P >
-bezier_curve<T,N,S,P> operator*(const double k, const bezier_curve<T,N,S,P>& p1)  {
-    bezier_curve<T,N,S,P> res(p1);
+template <typename T, typename N, bool S, typename P, typename A>
+bezier_curve<T,N,S,P,A> operator*(const typename bezier_curve<T,N,S,P,A>::num_t k, const bezier_curve<T,N,S,P,A>& p1)  {
+    bezier_curve<T,N,S,P,A> res(p1);
     return res*=k;
 }
 
 }  // namespace ndcurves
 
-DEFINE_CLASS_TEMPLATE_VERSION(SINGLE_ARG(typename Time, typename Numeric, bool Safe, typename Point),
-                              SINGLE_ARG(ndcurves::bezier_curve<Time, Numeric, Safe, Point>))
+DEFINE_CLASS_TEMPLATE_VERSION(SINGLE_ARG(typename Time, typename Numeric, bool Safe, typename Point,
+                                         typename Allocator),
+                              SINGLE_ARG(ndcurves::bezier_curve<Time, Numeric, Safe, Point, Allocator>))
 
 #endif  //_CLASS_BEZIERCURVE
@@ -25,6 +25,8 @@ struct constant_curve : public curve_abc<Time, Numeric, Safe, Point, Point_deriv
   typedef constant_curve<Time, Numeric, Safe, Point, Point_derivate> constant_curve_t;
   typedef constant_curve<Time, Numeric, Safe, Point_derivate> curve_derivate_t;
   typedef curve_abc<Time, Numeric, Safe, point_t, Point_derivate> curve_abc_t;  // parent class
+  typedef typename curve_abc_t::point_out_t point_out_t;
+  typedef typename curve_abc_t::point_derivate_out_t point_derivate_out_t;
 
   /* Constructors - destructors */
  public:
@@ -58,6 +60,7 @@ struct constant_curve : public curve_abc<Time, Numeric, Safe, Point, Point_deriv
   ///  \param t : time when to evaluate the spine
   ///  \return \f$x(t)\f$, point corresponding on curve at time t.
   virtual point_t operator()(const time_t t) const {
+    CURVES_INSTRUMENT_SCOPE(EVALUATE, this);
     if (Safe && (t < T_min_ || t > T_max_)) {
       throw std::invalid_argument(
           "error in constant curve : time t to evaluate should be in range [Tmin, Tmax] of the curve");
@@ -84,6 +87,7 @@ struct constant_curve : public curve_abc<Time, Numeric, Safe, Point, Point_deriv
   ///  \param order : order of derivative.
   ///  \return A pointer to \f$\frac{d^Nx(t)}{dt^N}\f$ derivative order N of the curve.
   virtual curve_derivate_t* compute_derivate_ptr(const std::size_t) const {
+    CURVES_INSTRUMENT_SCOPE(COMPUTE_DERIVATE, this);
     return new curve_derivate_t(compute_derivate());
   }
 
@@ -92,6 +96,7 @@ struct constant_curve : public curve_abc<Time, Numeric, Safe, Point, Point_deriv
   /// \param order : order of derivative.
   /// \return \f$\frac{d^Nx(t)}{dt^N}\f$, point corresponding on derivative curve of order N at time t.
   virtual point_derivate_t derivate(const time_t t, const std::size_t) const {
+    CURVES_INSTRUMENT_SCOPE(DERIVATE, this);
     if (Safe && (t < T_min_ || t > T_max_)) {
       throw std::invalid_argument(
           "error in constant curve : time t to derivate should be in range [Tmin, Tmax] of the curve");
@@ -105,6 +110,54 @@ struct constant_curve : public curve_abc<Time, Numeric, Safe, Point, Point_deriv
     return point_derivate_t::Zero(derivate_size);
   }
 
+  ///  \brief Evaluation of the curve at time t, written in out without allocation.
+  ///  \param t : time when to evaluate the curve.
+  ///  \param out : \f$x(t)\f$, the constant value of the curve.
+  virtual void evaluate_into(const time_t t, point_out_t out) const {
+    if (Safe && (t < T_min_ || t > T_max_)) {
+      throw std::invalid_argument(
+          "error in constant curve : time t to evaluate should be in range [Tmin, Tmax] of the curve");
+    }
+    out = value_;
+  }
+
+  /// \brief Evaluate the derivative of order N of curve at time t, written in out without allocation.
+  /// \param t : time when to evaluate the curve.
+  /// \param out : \f$\frac{d^Nx(t)}{dt^N}\f$, always zero.
+  virtual void derivate_into(const time_t t, const std::size_t, point_derivate_out_t out) const {
+    if (Safe && (t < T_min_ || t > T_max_)) {
+      throw std::invalid_argument(
+          "error in constant curve : time t to derivate should be in range [Tmin, Tmax] of the curve");
+    }
+    out.setZero();
+  }
+
+  ///  \brief Real-time safe evaluation of the curve at time t, see curve_abc::evaluate_rt.
+  ///  \param t : time when to evaluate the curve, clamped in [Tmin, Tmax].
+  ///  \param out : \f$x(t)\f$, the constant value of the curve.
+  ///  \return EVAL_OK or EVAL_CLAMPED if out was written, the reason of the failure otherwise.
+  virtual eval_status evaluate_rt(const time_t t, point_out_t out) const noexcept {
+    if (dim_ == 0) return EVAL_EMPTY;
+    if (!point_out<point_t>::valid_size(out, dim_)) return EVAL_INVALID_SIZE;
+    time_t tc(t);
+    const eval_status status = clamp_time(tc, T_min_, T_max_);
+    out = value_;
+    return status;
+  }
+
+  /// \brief Real-time safe evaluation of the derivative of order N at time t, see curve_abc::derivate_rt.
+  /// \param t : time when to evaluate the curve, clamped in [Tmin, Tmax].
+  /// \param out : \f$\frac{d^Nx(t)}{dt^N}\f$, always zero.
+  /// \return EVAL_OK or EVAL_CLAMPED if out was written, the reason of the failure otherwise.
+  virtual eval_status derivate_rt(const time_t t, const std::size_t, point_derivate_out_t out) const noexcept {
+    if (dim_ == 0) return EVAL_EMPTY;
+    if (!point_out<point_derivate_t>::valid_size(out, dim_)) return EVAL_INVALID_SIZE;
+    time_t tc(t);
+    const eval_status status = clamp_time(tc, T_min_, T_max_);
+    out.setZero();
+    return status;
+  }
+
   /**
    * @brief isApprox check if other and *this are approximately equals given a precision treshold
    * Only two curves of the same class can be approximately equals,
@@ -145,6 +198,13 @@ struct constant_curve : public curve_abc<Time, Numeric, Safe, Point, Point_deriv
   /// \brief Get the degree of the curve.
   /// \return \f$degree\f$, the degree of the curve.
   virtual std::size_t degree() const { return 0; }
+  /// \brief Get the memory used by the curve, by category. See footprint.
+  virtual footprint memory_footprint() const {
+    footprint res;
+    res.add(footprint::OBJECTS, sizeof(*this));
+    point_footprint<Point>::add(res, footprint::CONTROL_POINTS, value_);
+    return res;
+  }
   /*Helpers*/
 
   /*Attributes*/
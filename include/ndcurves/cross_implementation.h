@@ -18,14 +18,24 @@ Eigen::Vector3d cross(const Eigen::VectorXd& a, const Eigen::VectorXd& b){
     return c;
 }
 
+inline
+Eigen::Vector3f cross(const Eigen::VectorXf& a, const Eigen::VectorXf& b){
+    Eigen::Vector3f c;
+    c << a[1]*b[2] - a[2]*b[1], a[2]*b[0] - a[0]*b[2], a[0]*b[1] - a[1]*b[0] ;
+    return c;
+}
+
 inline
 Eigen::Vector3d cross(const Eigen::Vector3d& a, const Eigen::Vector3d& b){
     return a.cross(b);
 }
 
+// Not a.cross(b): the vectorized cross product of Eigen loads 4 floats from each vector of 3 (-Warray-bounds)
 inline
 Eigen::Vector3f cross(const Eigen::Vector3f& a, const Eigen::Vector3f& b){
-    return a.cross(b);
+    Eigen::Vector3f c;
+    c << a[1]*b[2] - a[2]*b[1], a[2]*b[0] - a[0]*b[2], a[0]*b[1] - a[1]*b[0] ;
+    return c;
 }
 
 template<typename N, bool S>
@@ -45,6 +45,7 @@ struct cubic_hermite_spline : public curve_abc<Time, Numeric, Safe, Point> {
   typedef bezier_curve<Time, Numeric, Safe, point_t> bezier_t;
   typedef typename bezier_t::t_point_t t_point_t;
   typedef piecewise_curve<Time, Numeric, Safe, point_t, point_t, bezier_t> piecewise_bezier_t;
+  typedef typename curve_abc_t::point_out_t point_out_t;
 
  public:
   /// \brief Empty constructor. Curve obtained this way can not perform other class functions.
@@ -96,15 +97,25 @@ struct cubic_hermite_spline : public curve_abc<Time, Numeric, Safe, Point> {
   ///  \return \f$p(t)\f$ point corresponding on spline at time t.
   ///
   virtual Point operator()(const time_t t) const {
+    CURVES_INSTRUMENT_SCOPE(EVALUATE, this);
+    point_t res = point_t::Zero(dim_);
+    evaluate_into(t, res);
+    return res;
+  }
+
+  ///  \brief Evaluation of the cubic hermite spline at time t, written in out without allocation.
+  ///  \param t : time when to evaluate the spline.
+  ///  \param out : \f$p(t)\f$ point corresponding on spline at time t.
+  ///
+  virtual void evaluate_into(const time_t t, point_out_t out) const {
     check_conditions();
     if (Safe & !(T_min_ <= t && t <= T_max_)) {
       throw std::invalid_argument("can't evaluate cubic hermite spline, out of range");
     }
     if (size_ == 1) {
-      return control_points_.front().first;
+      out = control_points_.front().first;
     } else {
-      const bezier_t bezier = buildCurrentBezier(t);
-      return bezier(t);
+      evalCurrentInterval(t, 0, out);
     }
   }
 
@@ -149,19 +160,59 @@ struct cubic_hermite_spline : public curve_abc<Time, Numeric, Safe, Point> {
   ///  \return \f$\frac{d^Np(t)}{dt^N}\f$ point corresponding on derivative spline of order N at time t.
   ///
   virtual Point derivate(const time_t t, const std::size_t order) const {
+    CURVES_INSTRUMENT_SCOPE(DERIVATE, this);
+    point_t res = point_t::Zero(dim_);
+    derivate_into(t, order, res);
+    return res;
+  }
+
+  ///  \brief Evaluate the derivative of order N of spline at time t, written in out without allocation.
+  ///  \param t : time when to evaluate the spline.
+  ///  \param order : order of derivative.
+  ///  \param out : \f$\frac{d^Np(t)}{dt^N}\f$ point corresponding on derivative spline of order N at time t.
+  ///
+  virtual void derivate_into(const time_t t, const std::size_t order, point_out_t out) const {
     check_conditions();
     if (Safe & !(T_min_ <= t && t <= T_max_)) {
       throw std::invalid_argument("can't derivate cubic hermite spline, out of range");
     }
     if (size_ == 1) {
-      return control_points_.front().second;
+      out = control_points_.front().second;
+    } else {
+      evalCurrentInterval(t, order, out);
+    }
+  }
+
+  ///  \brief Real-time safe evaluation of the spline at time t, see curve_abc::evaluate_rt.
+  ///  \param t : time when to evaluate the spline, clamped in [Tmin, Tmax].
+  ///  \param out : \f$p(t)\f$ point corresponding on spline at time t.
+  ///  \return EVAL_OK or EVAL_CLAMPED if out was written, the reason of the failure otherwise.
+  ///
+  virtual eval_status evaluate_rt(const time_t t, point_out_t out) const noexcept {
+    return derivate_rt(t, 0, out);
+  }
+
+  ///  \brief Real-time safe evaluation of the derivative of order N at time t, see curve_abc::derivate_rt.
+  ///  \param t : time when to evaluate the spline, clamped in [Tmin, Tmax].
+  ///  \param order : order of derivative.
+  ///  \param out : \f$\frac{d^Np(t)}{dt^N}\f$ point corresponding on derivative spline of order N at time t.
+  ///  \return EVAL_OK or EVAL_CLAMPED if out was written, the reason of the failure otherwise.
+  ///
+  virtual eval_status derivate_rt(const time_t t, const std::size_t order, point_out_t out) const noexcept {
+    if (control_points_.size() == 0 || dim_ == 0) return EVAL_EMPTY;
+    if (!point_out<point_t>::valid_size(out, dim_)) return EVAL_INVALID_SIZE;
+    time_t tc(t);
+    const eval_status status = clamp_time(tc, T_min_, T_max_);
+    if (size_ == 1) {
+      out = (order == 0) ? control_points_.front().first : control_points_.front().second;
     } else {
-      const bezier_t bezier = buildCurrentBezier(t);
-      return bezier.derivate(t, order);
+      evalCurrentInterval(tc, order, out);
     }
+    return status;
   }
 
   piecewise_bezier_t compute_derivate(const std::size_t order) const {
+    CURVES_INSTRUMENT_SCOPE(COMPUTE_DERIVATE, this);
     piecewise_bezier_t res;
     for(size_t i = 0 ; i < size_ - 1 ; ++i){
       const bezier_t curve = buildCurrentBezier(time_control_points_[i]);
@@ -216,11 +267,61 @@ struct cubic_hermite_spline : public curve_abc<Time, Numeric, Safe, Point> {
   std::size_t numIntervals() const { return size() - 1; }
 
  private:
+  /// \brief Evaluate the derivative of order N at time t of the cubic polynomial of the interval containing t.
+  /// Same result as buildCurrentBezier(t).derivate(t, order), computed with the Hermite basis functions
+  /// \f$h_{00}, h_{10}, h_{01}, h_{11}\f$ of the normalized time, without building the bezier curve.
+  /// \param t : time when to evaluate the spline.
+  /// \param order : order of derivative.
+  /// \param out : \f$\frac{d^Np(t)}{dt^N}\f$ point corresponding on derivative spline of order N at time t.
+  ///
+  void evalCurrentInterval(const time_t t, const std::size_t order, point_out_t out) const noexcept {
+    const size_t id_interval = findInterval(t);
+    const pair_point_tangent_t& pair0 = control_points_[id_interval];
+    const pair_point_tangent_t& pair1 = control_points_[id_interval + 1];
+    const num_t T = time_control_points_[id_interval + 1] - time_control_points_[id_interval];
+    const num_t u = (t - time_control_points_[id_interval]) / T;
+    const num_t u2 = u * u;
+    num_t h00, h10, h01, h11;  // derivatives of order N of the basis functions with respect to u
+    switch (order) {
+      case 0:
+        h00 = (num_t(1) + num_t(2) * u) * (num_t(1) - u) * (num_t(1) - u);
+        h10 = u * (num_t(1) - u) * (num_t(1) - u);
+        h01 = u2 * (num_t(3) - num_t(2) * u);
+        h11 = u2 * (u - num_t(1));
+        break;
+      case 1:
+        h00 = num_t(6) * u2 - num_t(6) * u;
+        h10 = num_t(3) * u2 - num_t(4) * u + num_t(1);
+        h01 = num_t(6) * u - num_t(6) * u2;
+        h11 = num_t(3) * u2 - num_t(2) * u;
+        break;
+      case 2:
+        h00 = num_t(12) * u - num_t(6);
+        h10 = num_t(6) * u - num_t(4);
+        h01 = num_t(6) - num_t(12) * u;
+        h11 = num_t(6) * u - num_t(2);
+        break;
+      case 3:
+        h00 = num_t(12);
+        h10 = num_t(6);
+        h01 = num_t(-12);
+        h11 = num_t(6);
+        break;
+      default:
+        out.setZero();
+        return;
+    }
+    const num_t scale = num_t(1) / std::pow(T, num_t(order));
+    out = (h00 * scale) * pair0.first + (h10 * T * scale) * pair0.second + (h01 * scale) * pair1.first +
+          (h11 * T * scale) * pair1.second;
+  }
+
   /// \brief Get index of the interval (subspline) corresponding to time t for the interpolation.
   /// \param t : time where to look for interval.
   /// \return Index of interval for time t.
   ///
-  std::size_t findInterval(const time_t t) const {
+  std::size_t findInterval(const time_t t) const noexcept {
+    CURVES_INSTRUMENT_SCOPE(FIND_INTERVAL, this);
     // time before first control point time.
     if (t <= time_control_points_[0]) {
       return 0;
@@ -233,9 +334,9 @@ struct cubic_hermite_spline : public curve_abc<Time, Numeric, Safe, Point> {
     std::size_t right_id = size_ - 1;
     while (left_id <= right_id) {
       const std::size_t middle_id = left_id + (right_id - left_id) / 2;
-      if (time_control_points_.at(middle_id) < t) {
+      if (time_control_points_[middle_id] < t) {
         left_id = middle_id + 1;
-      } else if (time_control_points_.at(middle_id) > t) {
+      } else if (time_control_points_[middle_id] > t) {
         right_id = middle_id - 1;
       } else {
         return middle_id;
@@ -321,6 +422,20 @@ struct cubic_hermite_spline : public curve_abc<Time, Numeric, Safe, Point> {
   /// \brief Get the degree of the curve.
   /// \return \f$degree\f$, the degree of the curve.
   virtual std::size_t degree() const { return degree_; }
+  /// \brief Get the memory used by the curve, by category. See footprint.
+  virtual footprint memory_footprint() const {
+    footprint res;
+    res.add(footprint::OBJECTS, sizeof(*this));
+    res.add(footprint::CONTROL_POINTS, control_points_.capacity() * sizeof(pair_point_tangent_t));
+    for (typename t_pair_point_tangent_t::const_iterator cit = control_points_.begin(); cit != control_points_.end();
+         ++cit) {
+      point_footprint<Point>::add(res, footprint::CONTROL_POINTS, cit->first);
+      point_footprint<Point>::add(res, footprint::CONTROL_POINTS, cit->second);
+    }
+    add_points_footprint(res, footprint::TIMES, time_control_points_);
+    add_points_footprint(res, footprint::TIMES, duration_splines_);
+    return res;
+  }
   /*Helpers*/
 
   /*Attributes*/
@@ -12,6 +12,8 @@
 #define _STRUCT_CURVE_ABC
 
 #include "MathDefs.h"
+#include "instrumentation.h"
+#include "memory_footprint.h"
 #include "serialization/archive.hpp"
 #include "serialization/eigen-matrix.hpp"
 #include "serialization/registeration.hpp"
@@ -26,9 +28,66 @@ bool isApprox(const T a, const T b, const T eps = 1e-6) {
   return fabs(a - b) < eps;
 }
 
+/// \enum eval_status
+/// \brief Result of the real-time evaluation methods curve_abc::evaluate_rt and curve_abc::derivate_rt.
+enum eval_status {
+  EVAL_OK = 0,            // out contains the value at t.
+  EVAL_CLAMPED,           // t was not in [min, max], out contains the value at the closest bound.
+  EVAL_INVALID_ORDER,     // the curve does not provide the derivative of this order, out must not be used.
+  EVAL_INVALID_SIZE,      // out does not have the dimension of the curve, out must not be used.
+  EVAL_EMPTY,             // the curve is not initialized, out must not be used.
+  EVAL_NOT_REAL_TIME      // the curve does not provide a real-time evaluation, out must not be used.
+};
+
+/// \brief Check if a real-time evaluation wrote its result, i.e. if status is EVAL_OK or EVAL_CLAMPED.
+inline bool eval_succeeded(const eval_status status) noexcept {
+  return status == EVAL_OK || status == EVAL_CLAMPED;
+}
+
+/// \brief Clamp t in [t_min, t_max], a NaN is replaced by t_min.
+/// \return EVAL_OK if t was in the range, EVAL_CLAMPED otherwise.
+template <typename Time>
+eval_status clamp_time(Time& t, const Time t_min, const Time t_max) noexcept {
+  if (t >= t_min && t <= t_max) return EVAL_OK;
+  t = (t > t_max) ? t_max : t_min;
+  return EVAL_CLAMPED;
+}
+
+/// \struct point_out.
+/// \brief Type of the output argument of curve_abc::evaluate_into and curve_abc::derivate_into.
+/// An Eigen::Ref for the Eigen matrices, so that the result can also be written in a block of a bigger matrix,
+/// and a plain reference for the other point types.
+/// real_time_safe is true if the arithmetic on the points never allocates, which is required by
+/// curve_abc::evaluate_rt.
+template <typename Point>
+struct point_out {
+  typedef Point& type;
+  static const bool real_time_safe = false;
+  static bool valid_size(const Point&, const std::size_t) noexcept { return true; }
+};
+
+template <typename Scalar, int Rows, int Cols, int Options, int MaxRows, int MaxCols>
+struct point_out<Eigen::Matrix<Scalar, Rows, Cols, Options, MaxRows, MaxCols> > {
+  typedef Eigen::Ref<Eigen::Matrix<Scalar, Rows, Cols, Options, MaxRows, MaxCols> > type;
+  static const bool real_time_safe = true;
+  /// \brief Check that a dynamic size output has the dimension dim, fixed size outputs always do.
+  static bool valid_size(const type& out, const std::size_t dim) noexcept {
+    return Rows != Eigen::Dynamic || std::size_t(out.rows()) == dim;
+  }
+};
+
 /// \struct curve_abc.
 /// \brief Represents a curve of dimension Dim.
 /// If value of parameter Safe is false, no verification is made on the evaluation of the curve.
+///
+/// Real-time profile: evaluate_rt and derivate_rt may be called from a real-time thread. They are noexcept, never
+/// allocate, never format a message, and report errors with an eval_status instead of an exception. All the curves
+/// of this package implement them, except two which return EVAL_NOT_REAL_TIME: the bezier curves of linear_variable
+/// and helpers::rotation_spline, the rotation curve of helpers::effector_spline_rotation. They call the interval
+/// lookup of the piecewise curves and splines (find_interval, findInterval), which is timed by the instrumentation:
+/// CURVES_WITH_INSTRUMENTATION must stay undefined in real-time builds. Every other method, including operator(),
+/// derivate(), evaluate_into and derivate_into, may throw and must not be used in a real-time loop. Constructing,
+/// modifying, copying or serializing a curve is never real-time safe.
 template <typename Time = double, typename Numeric = Time, bool Safe = false,
           typename Point = Eigen::Matrix<Numeric, Eigen::Dynamic, 1>, typename Point_derivate = Point>
 struct curve_abc : std::unary_function<Time, Point>, public serialization::Serializable {
@@ -39,6 +98,8 @@ struct curve_abc : std::unary_function<Time, Point>, public serialization::Seria
   typedef curve_abc<Time, Numeric, Safe, point_t, point_derivate_t> curve_t;  // parent class
   typedef curve_abc<Time, Numeric, Safe, point_derivate_t> curve_derivate_t;  // parent class
   typedef boost::shared_ptr<curve_t> curve_ptr_t;
+  typedef typename point_out<point_t>::type point_out_t;
+  typedef typename point_out<point_derivate_t>::type point_derivate_out_t;
 
   /* Constructors - destructors */
  public:
@@ -66,6 +127,51 @@ struct curve_abc : std::unary_function<Time, Point>, public serialization::Seria
   /// \return \f$\frac{d^Nx(t)}{dt^N}\f$, point corresponding on derivative curve of order N at time t.
   virtual point_derivate_t derivate(const time_t t, const std::size_t order) const = 0;
 
+  /// \brief Evaluation of the curve at time t, written in out.
+  /// Unlike operator(), the curves of this package do not allocate any memory in this method, as long as out
+  /// already has the dimension of the curve.
+  /// \param t   : time when to evaluate the curve.
+  /// \param out : \f$x(t)\f$, point corresponding on curve at time t.
+  virtual void evaluate_into(const time_t t, point_out_t out) const { out = (*this)(t); }
+
+  /// \brief Evaluate the derivative of order N of curve at time t, written in out.
+  /// Unlike derivate(), the curves of this package do not allocate any memory in this method, as long as out
+  /// already has the dimension of the derivative.
+  /// \param t     : time when to evaluate the curve.
+  /// \param order : order of derivative.
+  /// \param out   : \f$\frac{d^Nx(t)}{dt^N}\f$, point corresponding on derivative curve of order N at time t.
+  virtual void derivate_into(const time_t t, const std::size_t order, point_derivate_out_t out) const {
+    out = derivate(t, order);
+  }
+
+  /// \brief Real-time safe evaluation of the curve at time t, written in out.
+  /// Never throws and never allocates. A time outside [min, max] is clamped to the closest bound.
+  /// The default implementation is for curves that can not be evaluated in real time.
+  /// \param t   : time when to evaluate the curve.
+  /// \param out : \f$x(t)\f$, point corresponding on curve at time t, must have the dimension of the curve.
+  /// \return EVAL_OK or EVAL_CLAMPED if out was written, the reason of the failure otherwise.
+  virtual eval_status evaluate_rt(const time_t /*t*/, point_out_t /*out*/) const noexcept { return EVAL_NOT_REAL_TIME; }
+
+  /// \brief Real-time safe evaluation of the derivative of order N of the curve at time t, written in out.
+  /// Never throws and never allocates. A time outside [min, max] is clamped to the closest bound.
+  /// The default implementation is for curves that can not be evaluated in real time.
+  /// \param t     : time when to evaluate the curve.
+  /// \param order : order of derivative.
+  /// \param out   : \f$\frac{d^Nx(t)}{dt^N}\f$, must have the dimension of the derivative.
+  /// \return EVAL_OK or EVAL_CLAMPED if out was written, the reason of the failure otherwise.
+  virtual eval_status derivate_rt(const time_t /*t*/, const std::size_t /*order*/,
+                                  point_derivate_out_t /*out*/) const noexcept {
+    return EVAL_NOT_REAL_TIME;
+  }
+
+  /// \brief Get the memory used by the curve, including sizeof the curve, by category. See footprint.
+  /// The default implementation is for the curves defined outside of this package, it only counts sizeof(curve_abc).
+  virtual footprint memory_footprint() const {
+    footprint res;
+    res.add(footprint::OBJECTS, sizeof(curve_abc));
+    return res;
+  }
+
   /**
    * @brief isEquivalent check if other and *this are approximately equal by values, given a precision treshold.
    * This test is done by discretizing both curves and evaluating them and their derivatives.
@@ -89,7 +89,7 @@ Hermite hermite_from_curve(const typename Hermite::curve_abc_t& curve) {
   t_pair_point_tangent_t control_points;
   control_points.push_back(pair0);
   control_points.push_back(pair1);
-  std::vector<double> time_control_points;
+  typename Hermite::vector_time_t time_control_points;
   time_control_points.push_back(T_min);
   time_control_points.push_back(T_max);
   return Hermite(control_points.begin(), control_points.end(), time_control_points);
@@ -30,6 +30,9 @@
 #include <vector>
 
 namespace ndcurves {
+template <typename Time, typename Numeric, bool Safe, typename Point, typename T_Point, typename SplineBase>
+struct exact_cubic_solver;
+
 /// \class ExactCubic.
 /// \brief Represents a set of cubic splines defining a continuous function
 /// crossing each of the waypoint given in its initialization.
@@ -57,6 +60,8 @@ struct exact_cubic : public piecewise_curve<Time, Numeric, Safe, Point> {
   typedef piecewise_curve<Time, Numeric, Safe, point_t> piecewise_curve_t;
   typedef polynomial<Time, Numeric, Safe, point_t> polynomial_t;
   typedef typename piecewise_curve_t::t_curve_ptr_t t_curve_ptr_t;
+  typedef exact_cubic_solver<Time, Numeric, Safe, Point, T_Point, SplineBase> solver_t;
+  friend struct exact_cubic_solver<Time, Numeric, Safe, Point, T_Point, SplineBase>;
 
   /* Constructors - destructors */
  public:
@@ -117,6 +122,13 @@ struct exact_cubic : public piecewise_curve<Time, Numeric, Safe, Point> {
     return piecewise_curve_t::isApprox(other, prec);
   }
 
+  /// \brief Get the memory used by the curve, by category. See footprint.
+  virtual footprint memory_footprint() const {
+    footprint res = piecewise_curve_t::memory_footprint();
+    res.add(footprint::OBJECTS, sizeof(*this) - sizeof(piecewise_curve_t));
+    return res;
+  }
+
   std::size_t getNumberSplines() { return this->getNumberCurves(); }
 
   spline_t getSplineAt(std::size_t index) {
@@ -153,10 +165,7 @@ struct exact_cubic : public piecewise_curve<Time, Numeric, Safe, Point> {
   }
 
   /// \brief Compute polynom of exact cubic spline from waypoints.
-  /// Compute the coefficients of polynom as in paper : "Task-Space Trajectories via Cubic Spline Optimization".<br>
-  /// \f$x_i(t)=a_i+b_i(t-t_i)+c_i(t-t_i)^2\f$<br>
-  /// with \f$a=x\f$, \f$H_1b=H_2x\f$, \f$c=H_3x+H_4b\f$, \f$d=H_5x+H_6b\f$.<br>
-  /// The matrices \f$H\f$ are defined as in the paper in Appendix A.
+  /// The matrices which only depend on the times of the waypoints are computed by exact_cubic_solver.
   ///
   template <typename In>
   t_spline_t computeWayPoints(In wayPointsBegin, In wayPointsEnd) const {
@@ -165,67 +174,15 @@ struct exact_cubic : public piecewise_curve<Time, Numeric, Safe, Point> {
     if (Safe && size < 1) {
       throw std::length_error("size of waypoints must be superior to 0");  // TODO
     }
-    t_spline_t subSplines;
-    subSplines.reserve(size);
-    // refer to the paper to understand all this.
-    MatrixX h1 = MatrixX::Zero(size, size);
-    MatrixX h2 = MatrixX::Zero(size, size);
-    MatrixX h3 = MatrixX::Zero(size, size);
-    MatrixX h4 = MatrixX::Zero(size, size);
-    MatrixX h5 = MatrixX::Zero(size, size);
-    MatrixX h6 = MatrixX::Zero(size, size);
-    MatrixX a = MatrixX::Zero(size, dim);
-    MatrixX b = MatrixX::Zero(size, dim);
-    MatrixX c = MatrixX::Zero(size, dim);
-    MatrixX d = MatrixX::Zero(size, dim);
+    std::vector<Time> times;
+    times.reserve(size);
     MatrixX x = MatrixX::Zero(size, dim);
-    In it(wayPointsBegin), next(wayPointsBegin);
-    ++next;
-    // Fill the matrices H as specified in the paper.
-    for (std::size_t i(0); next != wayPointsEnd; ++next, ++it, ++i) {
-      num_t const dTi((*next).first - (*it).first);
-      num_t const dTi_sqr(dTi * dTi);
-      num_t const dTi_cube(dTi_sqr * dTi);
-      // filling matrices values
-      h3(i, i) = -3 / dTi_sqr;
-      h3(i, i + 1) = 3 / dTi_sqr;
-      h4(i, i) = -2 / dTi;
-      h4(i, i + 1) = -1 / dTi;
-      h5(i, i) = 2 / dTi_cube;
-      h5(i, i + 1) = -2 / dTi_cube;
-      h6(i, i) = 1 / dTi_sqr;
-      h6(i, i + 1) = 1 / dTi_sqr;
-      if (i + 2 < size) {
-        In it2(next);
-        ++it2;
-        num_t const dTi_1((*it2).first - (*next).first);
-        num_t const dTi_1sqr(dTi_1 * dTi_1);
-        // this can be optimized but let's focus on clarity as long as not needed
-        h1(i + 1, i) = 2 / dTi;
-        h1(i + 1, i + 1) = 4 / dTi + 4 / dTi_1;
-        h1(i + 1, i + 2) = 2 / dTi_1;
-        h2(i + 1, i) = -6 / dTi_sqr;
-        h2(i + 1, i + 1) = (6 / dTi_1sqr) - (6 / dTi_sqr);
-        h2(i + 1, i + 2) = 6 / dTi_1sqr;
-      }
+    In it(wayPointsBegin);
+    for (std::size_t i(0); it != wayPointsEnd; ++it, ++i) {
+      times.push_back((*it).first);
       x.row(i) = (*it).second.transpose();
     }
-    // adding last x
-    x.row(size - 1) = (*it).second.transpose();
-    // Compute coefficients of polynom.
-    a = x;
-    PseudoInverse(h1);
-    b = h1 * h2 * x;  // h1 * b = h2 * x => b = (h1)^-1 * h2 * x
-    c = h3 * x + h4 * b;
-    d = h5 * x + h6 * b;
-    // create splines along waypoints.
-    it = wayPointsBegin, next = wayPointsBegin;
-    ++next;
-    for (int i = 0; next != wayPointsEnd; ++i, ++it, ++next) {
-      subSplines.push_back(create_cubic(a.row(i), b.row(i), c.row(i), d.row(i),
-                                                                             (*it).first, (*next).first));
-    }
-    return subSplines;
+    return solver_t(times.begin(), times.end()).computeSplines(x);
   }
 
   template <typename In>
@@ -308,6 +265,205 @@ struct exact_cubic : public piecewise_curve<Time, Numeric, Safe, Point> {
     ar& BOOST_SERIALIZATION_BASE_OBJECT_NVP(piecewise_curve_t);
   }
 };
+
+/// \class exact_cubic_solver.
+/// \brief Computes exact cubic splines for a fixed set of waypoint times.
+/// The matrices of the paper "Task-Space Trajectories via Cubic Spline Optimization" only depend on the times of the
+/// waypoints: they are computed and factorized once at construction. Each spline is then obtained from the waypoint
+/// positions by a banded back-substitution, in \f$O(nd)\f$ for n waypoints of dimension d.
+///
+template <typename Time = double, typename Numeric = Time, bool Safe = false,
+          typename Point = Eigen::Matrix<Numeric, Eigen::Dynamic, 1>,
+          typename T_Point = std::vector<Point, Eigen::aligned_allocator<Point> >,
+          typename SplineBase = polynomial<Time, Numeric, Safe, Point, T_Point> >
+struct exact_cubic_solver {
+  typedef exact_cubic<Time, Numeric, Safe, Point, T_Point, SplineBase> exact_cubic_t;
+  typedef typename exact_cubic_t::t_spline_t t_spline_t;
+  typedef typename exact_cubic_t::MatrixX MatrixX;
+  typedef Time time_t;
+  typedef Numeric num_t;
+  typedef std::vector<Time> t_time_t;
+
+  /* Constructors - destructors */
+ public:
+  /// \brief Empty constructor.
+  exact_cubic_solver() {}
+
+  /// \brief Constructor.
+  /// \param timesBegin : an iterator pointing to the first element of a container of waypoint times.
+  /// \param timesEnd   : an iterator pointing to the last element of a container of waypoint times.
+  ///
+  template <typename In>
+  exact_cubic_solver(In timesBegin, In timesEnd) : times_(timesBegin, timesEnd) {
+    if (Safe && times_.size() < 1) {
+      throw std::length_error("size of waypoints must be superior to 0");
+    }
+    compute_factorization();
+  }
+  /* Constructors - destructors */
+
+  /// \brief Compute the exact cubic spline crossing the given positions at the times of the solver.
+  /// \param pointsBegin : an iterator pointing to the first element of a container of positions.
+  /// \param pointsEnd   : an iterator pointing to the last element of a container of positions.
+  /// \return the exact cubic spline.
+  ///
+  template <typename In>
+  exact_cubic_t compute(In pointsBegin, In pointsEnd) const {
+    const std::size_t size = std::distance(pointsBegin, pointsEnd);
+    if (size != times_.size()) {
+      throw std::invalid_argument(
+          "exact_cubic_solver: the number of positions should be equal to the number of times.");
+    }
+    MatrixX x = MatrixX::Zero(size, pointsBegin->size());
+    In it(pointsBegin);
+    for (std::size_t i(0); it != pointsEnd; ++it, ++i) {
+      x.row(i) = (*it).transpose();
+    }
+    return exact_cubic_t(computeSplines(x));
+  }
+
+  /// \brief Compute the polynoms of the exact cubic spline crossing the given positions.
+  /// \param x : matrix of the positions, row i is the position at times()[i].
+  /// \return the polynoms of the spline, one for each interval between two waypoints.
+  ///
+  t_spline_t computeSplines(const MatrixX& x) const {
+    if (Safe && std::size_t(x.rows()) != times_.size()) {
+      throw std::invalid_argument(
+          "exact_cubic_solver: the number of positions should be equal to the number of times.");
+    }
+    const std::size_t size = times_.size();
+    t_spline_t subSplines;
+    subSplines.reserve(size);
+    // The waypoints are the columns of xt, so that the substitutions work on contiguous memory.
+    const MatrixX xt = x.transpose();
+    const MatrixX b = solve_velocities(xt);
+    // Compute coefficients of polynom: c = H3 x + H4 b and d = H5 x + H6 b, only the columns i and i + 1 of the
+    // row i of H3 to H6 are not zero. Then create splines along waypoints.
+    for (std::size_t i = 0; i + 1 < size; ++i) {
+      num_t const dTi(times_[i + 1] - times_[i]);
+      num_t const dTi_sqr(dTi * dTi);
+      num_t const dTi_cube(dTi_sqr * dTi);
+      const Eigen::Index id = Eigen::Index(i);
+      subSplines.push_back(exact_cubic_t::create_cubic(
+          xt.col(id), b.col(id),
+          (3 / dTi_sqr) * (xt.col(id + 1) - xt.col(id)) - (2 * b.col(id) + b.col(id + 1)) / dTi,
+          (2 / dTi_cube) * (xt.col(id) - xt.col(id + 1)) + (b.col(id) + b.col(id + 1)) / dTi_sqr, times_[i],
+          times_[i + 1]));
+    }
+    return subSplines;
+  }
+
+  /*Helpers*/
+  /// \brief Get the times of the waypoints.
+  const t_time_t& times() const { return times_; }
+  /// \brief Get the number of waypoints.
+  std::size_t size() const { return times_.size(); }
+  /// \brief Get the memory used by the solver, by category. See footprint.
+  footprint memory_footprint() const {
+    footprint res;
+    res.add(footprint::OBJECTS, sizeof(*this));
+    add_points_footprint(res, footprint::TIMES, times_);
+    point_footprint<MatrixX>::add(res, footprint::OTHER, h1_);
+    point_footprint<MatrixX>::add(res, footprint::OTHER, h2_);
+    point_footprint<MatrixX>::add(res, footprint::OTHER, ldlt_);
+    return res;
+  }
+  /*Helpers*/
+
+ private:
+  /// \brief Compute the matrices of the paper, with
+  /// \f$x_i(t)=a_i+b_i(t-t_i)+c_i(t-t_i)^2\f$<br>
+  /// with \f$a=x\f$, \f$H_1b=H_2x\f$, \f$c=H_3x+H_4b\f$, \f$d=H_5x+H_6b\f$.<br>
+  /// The matrices \f$H\f$ are defined as in the paper in Appendix A.
+  /// The first and last rows of \f$H_1\f$ and \f$H_2\f$ are zero, their other rows \f$A\f$ and \f$R\f$ are
+  /// tridiagonal and are stored by band. As \f$H_1^+ H_2\f$, b is the least norm solution of \f$Ab=Rx\f$:
+  /// \f$b=A^T(AA^T)^{-1}Rx\f$. \f$AA^T\f$ is pentadiagonal and positive definite, its \f$LDL^T\f$ factorization is
+  /// stored by band too. \f$H_3\f$ to \f$H_6\f$ are bidiagonal and are applied in computeSplines.
+  void compute_factorization() {
+    const std::size_t size = times_.size();
+    const Eigen::Index m = size > 2 ? Eigen::Index(size - 2) : 0;
+    // row k of the bands is row k + 1 of H1 and H2, its columns are the columns k, k + 1 and k + 2.
+    h1_ = MatrixX::Zero(m, 3);
+    h2_ = MatrixX::Zero(m, 3);
+    for (Eigen::Index k = 0; k < m; ++k) {
+      num_t const dTi(times_[k + 1] - times_[k]);
+      num_t const dTi_sqr(dTi * dTi);
+      num_t const dTi_1(times_[k + 2] - times_[k + 1]);
+      num_t const dTi_1sqr(dTi_1 * dTi_1);
+      h1_(k, 0) = 2 / dTi;
+      h1_(k, 1) = 4 / dTi + 4 / dTi_1;
+      h1_(k, 2) = 2 / dTi_1;
+      h2_(k, 0) = -6 / dTi_sqr;
+      h2_(k, 1) = (6 / dTi_1sqr) - (6 / dTi_sqr);
+      h2_(k, 2) = 6 / dTi_1sqr;
+    }
+    // LDL^T of AA^T: column 0 is D, columns 1 and 2 the first and second subdiagonals of L.
+    ldlt_ = MatrixX::Zero(m, 3);
+    for (Eigen::Index k = 0; k < m; ++k) {
+      num_t l1 = 0, l2 = 0;
+      if (k > 1) {
+        l2 = h1_(k, 0) * h1_(k - 2, 2) / ldlt_(k - 2, 0);
+      }
+      if (k > 0) {
+        const num_t m1 = h1_(k, 0) * h1_(k - 1, 1) + h1_(k, 1) * h1_(k - 1, 2);
+        l1 = (k > 1 ? m1 - l2 * ldlt_(k - 1, 1) * ldlt_(k - 2, 0) : m1) / ldlt_(k - 1, 0);
+      }
+      ldlt_(k, 0) = h1_.row(k).squaredNorm();
+      if (k > 0) {
+        ldlt_(k, 0) -= l1 * l1 * ldlt_(k - 1, 0);
+      }
+      if (k > 1) {
+        ldlt_(k, 0) -= l2 * l2 * ldlt_(k - 2, 0);
+      }
+      ldlt_(k, 1) = l1;
+      ldlt_(k, 2) = l2;
+    }
+  }
+
+  /// \brief Compute the velocities b at the waypoints, see compute_factorization.
+  /// \param xt : the waypoints, one per column.
+  /// \return the velocities, one per column.
+  MatrixX solve_velocities(const MatrixX& xt) const {
+    const Eigen::Index m = h1_.rows();
+    MatrixX b = MatrixX::Zero(xt.rows(), xt.cols());
+    if (m == 0) {
+      return b;
+    }
+    // y = (AA^T)^-1 Rx, with L z = Rx, then D w = z and L^T y = w.
+    MatrixX y(xt.rows(), m);
+    for (Eigen::Index k = 0; k < m; ++k) {
+      y.col(k) = h2_(k, 0) * xt.col(k) + h2_(k, 1) * xt.col(k + 1) + h2_(k, 2) * xt.col(k + 2);
+      if (k > 0) {
+        y.col(k) -= ldlt_(k, 1) * y.col(k - 1);
+      }
+      if (k > 1) {
+        y.col(k) -= ldlt_(k, 2) * y.col(k - 2);
+      }
+    }
+    for (Eigen::Index k = m - 1; k >= 0; --k) {
+      y.col(k) /= ldlt_(k, 0);
+      if (k + 1 < m) {
+        y.col(k) -= ldlt_(k + 1, 1) * y.col(k + 1);
+      }
+      if (k + 2 < m) {
+        y.col(k) -= ldlt_(k + 2, 2) * y.col(k + 2);
+      }
+    }
+    // b = A^T y
+    for (Eigen::Index k = 0; k < m; ++k) {
+      b.col(k) += h1_(k, 0) * y.col(k);
+      b.col(k + 1) += h1_(k, 1) * y.col(k);
+      b.col(k + 2) += h1_(k, 2) * y.col(k);
+    }
+    return b;
+  }
+
+  /*Attributes*/
+  t_time_t times_;
+  MatrixX h1_, h2_;  // rows 1 to n - 2 of H1 and H2, by band
+  MatrixX ldlt_;     // LDL^T factorization of H1 H1^T restricted to these rows, by band
+  /*Attributes*/
+};
 }  // namespace ndcurves
 
 DEFINE_CLASS_TEMPLATE_VERSION(SINGLE_ARG(typename Time, typename Numeric, bool Safe, typename Point,
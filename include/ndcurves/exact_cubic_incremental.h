@@ -0,0 +1,269 @@
+/**
+ * \file exact_cubic_incremental.h
+ * \brief Exact cubic spline which can be extended with new waypoints.
+ *
+ * The spline crosses each waypoint and has continuous velocity and acceleration. The first segment is a quartic
+ * polynomial, which allows to constrain both the initial velocity and the initial acceleration. The end of the
+ * spline is free: its acceleration is zero at the last waypoint.
+ * The velocities at the waypoints are the solution of a tridiagonal system. The forward elimination of this system
+ * is kept between two calls to append, so that adding k waypoints only costs O(k) to extend it.
+ * The back substitution stops as soon as the velocities are not modified by more than a given tolerance:
+ * the influence of a new waypoint decreases geometrically along the spline, and only the last segments are updated.
+ */
+
+#ifndef _CLASS_EXACTCUBIC_INCREMENTAL
+#define _CLASS_EXACTCUBIC_INCREMENTAL
+
+#include "exact_cubic.h"
+
+#include <boost/make_shared.hpp>
+#include <stdexcept>
+#include <vector>
+
+namespace ndcurves {
+/// \class exact_cubic_incremental.
+/// \brief Build an exact_cubic which can be extended by appending waypoints at its end.
+/// The velocity and acceleration are continuous at each waypoint, with the initial velocity and acceleration given
+/// by the constraints and a zero acceleration at the last waypoint.
+/// Appending waypoints updates the last segments of the curve in place. With freeze = true, the existing segments
+/// are not modified: the new segments start with the position, velocity and acceleration of the current end of the
+/// curve.
+///
+template <typename Time = double, typename Numeric = Time, bool Safe = false,
+          typename Point = Eigen::Matrix<Numeric, Eigen::Dynamic, 1>,
+          typename T_Point = std::vector<Point, Eigen::aligned_allocator<Point> >,
+          typename SplineBase = polynomial<Time, Numeric, Safe, Point, T_Point> >
+struct exact_cubic_incremental {
+  typedef Point point_t;
+  typedef T_Point t_point_t;
+  typedef Time time_t;
+  typedef Numeric num_t;
+  typedef SplineBase spline_t;
+  typedef exact_cubic<Time, Numeric, Safe, Point, T_Point, SplineBase> exact_cubic_t;
+  typedef typename exact_cubic_t::spline_constraints spline_constraints;
+  typedef std::vector<Time> t_time_t;
+  typedef std::vector<Numeric> t_num_t;
+
+  /* Constructors - destructors */
+ public:
+  /// \brief Empty constructor. Call append with at least two waypoints to build a curve.
+  /// \param tolerance : the back substitution stops when the velocity at a waypoint changes by less than this value.
+  ///
+  exact_cubic_incremental(const num_t tolerance = Eigen::NumTraits<Numeric>::dummy_precision())
+      : junction_(0), tolerance_(tolerance), constraints_(), default_constraints_(true) {}
+
+  /// \brief Constructor.
+  /// \param wayPointsBegin : an iterator pointing to the first element of a waypoint container.
+  /// \param wayPointsEnd   : an iterator pointing to the last element of a waypoint container.
+  /// \param tolerance      : the back substitution stops when the velocity at a waypoint changes by less than this
+  /// value. With a tolerance of 0 the curve is exactly the one obtained with all the waypoints at once.
+  ///
+  template <typename In>
+  exact_cubic_incremental(In wayPointsBegin, In wayPointsEnd,
+                          const num_t tolerance = Eigen::NumTraits<Numeric>::dummy_precision())
+      : junction_(0), tolerance_(tolerance), constraints_(), default_constraints_(true) {
+    append(wayPointsBegin, wayPointsEnd);
+    check_size();
+  }
+
+  /// \brief Constructor.
+  /// \param wayPointsBegin : an iterator pointing to the first element of a waypoint container.
+  /// \param wayPointsEnd   : an iterator pointing to the last element of a waypoint container.
+  /// \param constraints    : initial velocity and acceleration of the spline, the end constraints are not used.
+  /// \param tolerance      : the back substitution stops when the velocity at a waypoint changes by less than this
+  /// value.
+  ///
+  template <typename In>
+  exact_cubic_incremental(In wayPointsBegin, In wayPointsEnd, const spline_constraints& constraints,
+                          const num_t tolerance = Eigen::NumTraits<Numeric>::dummy_precision())
+      : junction_(0), tolerance_(tolerance), constraints_(constraints), default_constraints_(false) {
+    append(wayPointsBegin, wayPointsEnd);
+    check_size();
+  }
+
+  /// \brief Destructor.
+  ~exact_cubic_incremental() {}
+  /* Constructors - destructors */
+
+  /// \brief Add waypoints at the end of the curve.
+  /// \param wayPointsBegin : an iterator pointing to the first element of a waypoint container.
+  /// \param wayPointsEnd   : an iterator pointing to the last element of a waypoint container.
+  /// \param freeze         : if true, the existing segments are not modified and the continuity of the velocity
+  /// and acceleration is only ensured at the junction with the new segments.
+  ///
+  template <typename In>
+  void append(In wayPointsBegin, In wayPointsEnd, const bool freeze = false) {
+    const std::size_t previous_size = times_.size();
+    for (In it(wayPointsBegin); it != wayPointsEnd; ++it) {
+      add_waypoint(it->first, it->second);
+    }
+    if (times_.size() >= 2 && times_.size() != previous_size) update(previous_size, freeze);
+  }
+
+  /// \brief Add one waypoint at the end of the curve.
+  /// \param t      : time of the waypoint, greater than the max of the curve.
+  /// \param point  : position of the waypoint.
+  /// \param freeze : if true, the existing segments are not modified.
+  ///
+  void append(const time_t t, const point_t& point, const bool freeze = false) {
+    const std::size_t previous_size = times_.size();
+    add_waypoint(t, point);
+    if (times_.size() >= 2) update(previous_size, freeze);
+  }
+
+  /*Helpers*/
+  /// \brief Get the curve, its segments are updated in place by append.
+  const exact_cubic_t& curve() const { return curve_; }
+  /// \brief Get the number of waypoints.
+  std::size_t size() const { return times_.size(); }
+  /// \brief Get the velocities at each waypoint.
+  const t_point_t& velocities() const { return velocities_; }
+  /*Helpers*/
+
+ private:
+  void check_size() const {
+    if (times_.size() < 2) {
+      throw std::invalid_argument("exact_cubic_incremental: at least two waypoints are required.");
+    }
+  }
+
+  void add_waypoint(const time_t t, const point_t& point) {
+    if (times_.empty()) {
+      if (default_constraints_) {
+        // set in place, curve_constraints has a user-declared copy constructor but no copy assignment
+        constraints_.init_vel.setZero(point.size());
+        constraints_.init_acc.setZero(point.size());
+        constraints_.init_jerk.setZero(point.size());
+        constraints_.end_vel.setZero(point.size());
+        constraints_.end_acc.setZero(point.size());
+        constraints_.end_jerk.setZero(point.size());
+        constraints_.dim_ = point.size();
+      } else if (constraints_.dim_ != std::size_t(point.size())) {
+        throw std::invalid_argument("exact_cubic_incremental: the constraints should have the dimension of points.");
+      }
+      velocities_.push_back(constraints_.init_vel);
+      junction_acc_ = constraints_.init_acc;
+    } else {
+      if (!(t > times_.back())) {
+        throw std::invalid_argument("exact_cubic_incremental: times must be strictly increasing.");
+      }
+      if (point.size() != points_.back().size()) {
+        throw std::invalid_argument("exact_cubic_incremental: all the points must have the same dimension.");
+      }
+      velocities_.push_back(point_t::Zero(point.size()));
+    }
+    times_.push_back(t);
+    points_.push_back(point);
+    c_prime_.push_back(0);
+    d_prime_.push_back(point_t::Zero(point.size()));
+  }
+
+  num_t dt(const std::size_t i) const { return num_t(times_[i + 1] - times_[i]); }
+
+  /// \brief Coefficients of the continuity equation of the acceleration at waypoint i:
+  /// lower * v_{i-1} + diag * v_i + upper * v_{i+1} = rhs. The velocities at the junction are known and are moved to
+  /// the right hand side. The last waypoint has a zero acceleration.
+  void equation(const std::size_t i, num_t& lower, num_t& diag, num_t& upper, point_t& rhs) const {
+    const std::size_t last = times_.size() - 1;
+    if (i == junction_ + 1) {
+      // end acceleration of the quartic junction segment: a_1 = -5 a_0 - 12 A / h^2 + 6 (v_1 - v_0) / h
+      const num_t h = dt(junction_);
+      const point_t A = points_[i] - points_[junction_] - velocities_[junction_] * h - junction_acc_ * (h * h / 2);
+      lower = 0;
+      diag = 3 / h;
+      rhs = junction_acc_ * num_t(2.5) + A * (6 / (h * h)) + velocities_[junction_] * (3 / h);
+    } else {
+      const num_t h = dt(i - 1);
+      lower = 1 / h;
+      diag = 2 / h;
+      rhs = (points_[i] - points_[i - 1]) * (3 / (h * h));
+    }
+    if (i < last) {
+      const num_t h = dt(i);
+      diag += 2 / h;
+      upper = 1 / h;
+      rhs += (points_[i + 1] - points_[i]) * (3 / (h * h));
+    } else {
+      upper = 0;
+    }
+  }
+
+  /// \brief Update the velocities and the segments after adding waypoints.
+  /// \param previous_size : number of waypoints before the call to append.
+  /// \param freeze        : if true, the last previous waypoint becomes the new junction.
+  void update(const std::size_t previous_size, const bool freeze) {
+    const std::size_t last = times_.size() - 1;
+    const std::size_t previous_segments = previous_size > 0 ? previous_size - 1 : 0;
+    if (freeze && previous_segments > 0) {
+      junction_ = previous_size - 1;
+      junction_acc_ = curve_.curve_at_index(previous_segments - 1)->derivate(times_[junction_], 2);
+    }
+    // forward elimination, the rows before the previous last waypoint are not modified.
+    num_t lower, diag, upper;
+    point_t rhs;
+    const std::size_t first_row = std::max(junction_ + 1, previous_size > 0 ? previous_size - 1 : 0);
+    for (std::size_t i = first_row; i <= last; ++i) {
+      equation(i, lower, diag, upper, rhs);
+      const num_t denom = diag - lower * c_prime_[i - 1];
+      c_prime_[i] = upper / denom;
+      d_prime_[i] = (rhs - d_prime_[i - 1] * lower) / denom;
+    }
+    // back substitution, stopped when the velocities of the previous waypoints are not modified anymore.
+    velocities_[last] = d_prime_[last];
+    std::size_t first_modified = last;
+    for (std::size_t i = last - 1; i > junction_; --i) {
+      const point_t v = d_prime_[i] - velocities_[i + 1] * c_prime_[i];
+      if (i + 1 < previous_size && (v - velocities_[i]).norm() <= tolerance_) break;
+      velocities_[i] = v;
+      first_modified = i;
+    }
+    // update the segments having a modified velocity at one of their waypoints, then add the new ones.
+    for (std::size_t j = std::max(first_modified, junction_ + 1) - 1; j < previous_segments; ++j) {
+      curve_.curves_[j] = boost::make_shared<spline_t>(segment(j));
+    }
+    for (std::size_t j = previous_segments; j < last; ++j) {
+      curve_.add_curve(segment(j));
+    }
+  }
+
+  /// \brief Polynomial between the waypoints j and j+1, a quartic for the junction segment and a cubic otherwise.
+  spline_t segment(const std::size_t j) const {
+    const num_t h = dt(j);
+    const point_t& p0 = points_[j];
+    const point_t& p1 = points_[j + 1];
+    const point_t& v0 = velocities_[j];
+    const point_t& v1 = velocities_[j + 1];
+    typename spline_t::coeff_t coeffs;
+    if (j == junction_) {
+      const point_t A = p1 - p0 - v0 * h - junction_acc_ * (h * h / 2);
+      const point_t B = v1 - v0 - junction_acc_ * h;
+      coeffs.resize(p0.size(), 5);
+      coeffs.col(2) = junction_acc_ / 2;
+      coeffs.col(3) = (A * 4 - B * h) / (h * h * h);
+      coeffs.col(4) = (B - A * (3 / h)) / (h * h * h);
+    } else {
+      coeffs.resize(p0.size(), 4);
+      coeffs.col(2) = ((p1 - p0) * (3 / h) - v0 * 2 - v1) / h;
+      coeffs.col(3) = ((p0 - p1) * (2 / h) + v0 + v1) / (h * h);
+    }
+    coeffs.col(0) = p0;
+    coeffs.col(1) = v0;
+    return spline_t(coeffs, times_[j], times_[j + 1]);
+  }
+
+  /*Attributes*/
+  t_time_t times_;
+  t_point_t points_;
+  t_point_t velocities_;
+  t_num_t c_prime_;     // modified upper diagonal of the forward elimination
+  t_point_t d_prime_;   // modified right hand side of the forward elimination
+  std::size_t junction_;  // the velocities up to this waypoint are fixed
+  point_t junction_acc_;  // acceleration at the junction waypoint
+  num_t tolerance_;
+  spline_constraints constraints_;
+  bool default_constraints_;  // start at rest, the dimension is given by the first waypoint
+  exact_cubic_t curve_;
+  /*Attributes*/
+};
+}  // namespace ndcurves
+#endif  // _CLASS_EXACTCUBIC_INCREMENTAL
@@ -18,7 +18,8 @@ namespace ndcurves {
 template <typename Time, typename Numeric, bool Safe, typename Point, typename Point_derivate>
 struct curve_abc;
 
-template <typename Time, typename Numeric, bool Safe, typename Point>
+template <typename Time, typename Numeric, bool Safe, typename Point,
+          typename Allocator = Eigen::aligned_allocator<Point> >
 struct bezier_curve;
 
 template <typename Time, typename Numeric, bool Safe, typename Point,typename Point_derivate>
@@ -30,12 +31,26 @@ struct cubic_hermite_spline;
 template <typename Time, typename Numeric, bool Safe, typename Point, typename T_Point, typename SplineBase>
 struct exact_cubic;
 
-template <typename Time, typename Numeric, bool Safe, typename Point, typename Point_derivate, typename CurveType>
+template <typename Time, typename Numeric, bool Safe, typename Point, typename T_Point, typename SplineBase>
+struct exact_cubic_incremental;
+
+struct piecewise_storage_shared;
+
+struct piecewise_storage_value;
+
+template <typename Time, typename Numeric, bool Safe, typename Point, typename Point_derivate, typename CurveType,
+          typename Storage = piecewise_storage_shared, typename Allocator = std::allocator<Time> >
 struct piecewise_curve;
 
+template <typename Time, typename Numeric, bool Safe, typename Point, typename T_Point>
+struct piecewise_variant_curve;
+
 template <typename Time, typename Numeric, bool Safe, typename Point, typename T_Point>
 struct polynomial;
 
+template <typename Time, typename Numeric, bool Safe, typename Point, typename T_Point>
+struct minimum_derivative_spline;
+
 template <typename Time, typename Numeric, bool Safe>
 struct SE3Curve;
 
@@ -45,6 +60,15 @@ struct sinusoidal;
 template <typename Time, typename Numeric, bool Safe>
 struct SO3Linear;
 
+template <typename Time, typename Numeric, bool Safe>
+struct SO3Bezier;
+
+template <typename Time, typename Numeric, bool Safe>
+struct SO3BezierDerivate;
+
+template <typename Time, typename Numeric, bool Safe>
+struct SE3Derivate;
+
 template <typename Numeric>
 struct Bern;
 
@@ -86,6 +110,7 @@ typedef boost::shared_ptr<curve_SE3_t> curve_SE3_ptr_t;
 // definition of all curves class with pointX as return type:
 typedef polynomial<double, double, true, pointX_t, t_pointX_t> polynomial_t;
 typedef exact_cubic<double, double, true, pointX_t, t_pointX_t, polynomial_t> exact_cubic_t;
+typedef exact_cubic_incremental<double, double, true, pointX_t, t_pointX_t, polynomial_t> exact_cubic_incremental_t;
 typedef bezier_curve<double, double, true, pointX_t> bezier_t;
 typedef linear_variable<double, true> linear_variable_t;
 typedef bezier_curve<double, double, true, linear_variable_t> bezier_linear_variable_t;
@@ -93,20 +118,84 @@ typedef constant_curve<double, double, true, pointX_t, pointX_t> constant_t;
 typedef cubic_hermite_spline<double, double, true, pointX_t> cubic_hermite_spline_t;
 typedef piecewise_curve<double, double, true, pointX_t, pointX_t, curve_abc_t> piecewise_t;
 typedef sinusoidal<double, double, true, pointX_t> sinusoidal_t;
+typedef minimum_derivative_spline<double, double, true, pointX_t, t_pointX_t> minimum_derivative_spline_t;
 
 // definition of all curves class with point3 as return type:
 typedef polynomial<double, double, true, point3_t, t_point3_t> polynomial3_t;
-typedef exact_cubic<double, double, true, point3_t, t_point3_t, polynomial_t> exact_cubic3_t;
+typedef exact_cubic<double, double, true, point3_t, t_point3_t, polynomial3_t> exact_cubic3_t;
 typedef bezier_curve<double, double, true, point3_t> bezier3_t;
 typedef constant_curve<double, double, true, point3_t, point3_t> constant3_t;
 typedef cubic_hermite_spline<double, double, true, point3_t> cubic_hermite_spline3_t;
 typedef piecewise_curve<double, double, true, point3_t, point3_t, curve_3_t> piecewise3_t;
 
+// piecewise curves storing their segments by value:
+typedef piecewise_curve<double, double, true, pointX_t, pointX_t, polynomial_t, piecewise_storage_value>
+    piecewise_polynomial_value_t;
+typedef piecewise_curve<double, double, true, pointX_t, pointX_t, bezier_t, piecewise_storage_value>
+    piecewise_bezier_value_t;
+typedef piecewise_curve<double, double, true, point3_t, point3_t, polynomial3_t, piecewise_storage_value>
+    piecewise_polynomial3_value_t;
+typedef piecewise_curve<double, double, true, point3_t, point3_t, bezier3_t, piecewise_storage_value>
+    piecewise_bezier3_value_t;
+
+// piecewise curves made of polynomial, bezier, constant and sinusoidal segments stored inline:
+typedef piecewise_variant_curve<double, double, true, pointX_t, t_pointX_t> piecewise_variant_t;
+typedef piecewise_variant_curve<double, double, true, point3_t, t_point3_t> piecewise_variant3_t;
+
 // special curves with return type fixed:
 typedef SO3Linear<double, double, true> SO3Linear_t;
+typedef SO3Bezier<double, double, true> SO3Bezier_t;
+typedef SO3BezierDerivate<double, double, true> SO3BezierDerivate_t;
 typedef SE3Curve<double, double, true> SE3Curve_t;
+typedef SE3Derivate<double, double, true> SE3Derivate_t;
 typedef piecewise_curve<double, double, true, transform_t, point6_t, curve_SE3_t> piecewise_SE3_t;
 
+// single precision versions of the eigen types:
+typedef Eigen::Vector3f point3f_t;
+typedef Eigen::Matrix<float, 6, 1> point6f_t;
+typedef Eigen::VectorXf pointXf_t;
+typedef Eigen::Matrix<float, 3, 3> matrix3f_t;
+typedef Eigen::Quaternion<float> quaternionf_t;
+typedef Eigen::Transform<float, 3, Eigen::Affine> transformf_t;
+typedef std::vector<point3f_t, Eigen::aligned_allocator<point3f_t> > t_point3f_t;
+typedef std::vector<pointXf_t, Eigen::aligned_allocator<pointXf_t> > t_pointXf_t;
+
+// single precision abstract curves types:
+typedef curve_abc<float, float, true, pointXf_t, pointXf_t> curve_abcf_t;
+typedef curve_abc<float, float, true, point3f_t, point3f_t> curve_3f_t;
+typedef curve_abc<float, float, true, matrix3f_t, point3f_t> curve_rotationf_t;
+typedef curve_abc<float, float, true, transformf_t, point6f_t> curve_SE3f_t;
+typedef boost::shared_ptr<curve_abcf_t> curvef_ptr_t;
+typedef boost::shared_ptr<curve_3f_t> curve3f_ptr_t;
+typedef boost::shared_ptr<curve_rotationf_t> curve_rotationf_ptr_t;
+typedef boost::shared_ptr<curve_SE3f_t> curve_SE3f_ptr_t;
+
+// single precision curves with pointXf as return type:
+typedef polynomial<float, float, true, pointXf_t, t_pointXf_t> polynomialf_t;
+typedef exact_cubic<float, float, true, pointXf_t, t_pointXf_t, polynomialf_t> exact_cubicf_t;
+typedef bezier_curve<float, float, true, pointXf_t> bezierf_t;
+typedef linear_variable<float, true> linear_variablef_t;
+typedef bezier_curve<float, float, true, linear_variablef_t> bezier_linear_variablef_t;
+typedef constant_curve<float, float, true, pointXf_t, pointXf_t> constantf_t;
+typedef cubic_hermite_spline<float, float, true, pointXf_t> cubic_hermite_splinef_t;
+typedef piecewise_curve<float, float, true, pointXf_t, pointXf_t, curve_abcf_t> piecewisef_t;
+typedef sinusoidal<float, float, true, pointXf_t> sinusoidalf_t;
+
+// single precision curves with point3f as return type:
+typedef polynomial<float, float, true, point3f_t, t_point3f_t> polynomial3f_t;
+typedef bezier_curve<float, float, true, point3f_t> bezier3f_t;
+typedef constant_curve<float, float, true, point3f_t, point3f_t> constant3f_t;
+typedef cubic_hermite_spline<float, float, true, point3f_t> cubic_hermite_spline3f_t;
+typedef piecewise_curve<float, float, true, point3f_t, point3f_t, curve_3f_t> piecewise3f_t;
+
+// single precision special curves:
+typedef SO3Linear<float, float, true> SO3Linearf_t;
+typedef SO3Bezier<float, float, true> SO3Bezierf_t;
+typedef SO3BezierDerivate<float, float, true> SO3BezierDerivatef_t;
+typedef SE3Curve<float, float, true> SE3Curvef_t;
+typedef SE3Derivate<float, float, true> SE3Derivatef_t;
+typedef piecewise_curve<float, float, true, transformf_t, point6f_t, curve_SE3f_t> piecewise_SE3f_t;
+
 }  // namespace ndcurves
 
 #endif  // CURVES_FWD_H
@@ -63,15 +63,81 @@ spline_t make_end_spline(const Point& normal, const Point& from, const Numeric o
   return spline_t(points.begin(), points.end(), init_time, init_time + time_offset);
 }
 
+/// \brief Compute end velocity : along landing normal and respecting time. Write it in an existing constraints
+/// object, whose initial and end jerk constraints are set to zero.
+void compute_required_offset_velocity_acceleration(const spline_t& end_spline, spline_constraints_t& constraints) {
+  const Eigen::Index dim = Eigen::Index(end_spline.dim());
+  constraints.init_vel.setZero(dim);
+  constraints.init_acc.setZero(dim);
+  constraints.init_jerk.setZero(dim);
+  constraints.end_jerk.setZero(dim);
+  constraints.end_acc = end_spline.derivate(end_spline.min(), 2);
+  constraints.end_vel = end_spline.derivate(end_spline.min(), 1);
+  constraints.dim_ = end_spline.dim();
+}
+
 /// \brief Compute end velocity : along landing normal and respecting time.
 spline_constraints_t compute_required_offset_velocity_acceleration(const spline_t& end_spline,
                                                                    const Time /*time_offset*/) {
   spline_constraints_t constraints(end_spline.dim());
-  constraints.end_acc = end_spline.derivate(end_spline.min(), 2);
-  constraints.end_vel = end_spline.derivate(end_spline.min(), 1);
+  compute_required_offset_velocity_acceleration(end_spline, constraints);
   return constraints;
 }
 
+/// \brief Parameters of the take-off and landing phases of an effector trajectory.
+struct effector_spline_parameters {
+  /// \param lift_normal      : normal to be followed by end effector at take-off.
+  /// \param land_normal      : normal to be followed by end effector at landing.
+  /// \param lift_offset      : length of the straight line along normal at take-off.
+  /// \param land_offset      : length of the straight line along normal at landing.
+  /// \param lift_offset_duration : time travelled along straight line at take-off.
+  /// \param land_offset_duration : time travelled along straight line at landing.
+  effector_spline_parameters(const Point& lift_normal = Eigen::Vector3d::UnitZ(),
+                             const Point& land_normal = Eigen::Vector3d::UnitZ(), const Numeric lift_offset = 0.02,
+                             const Numeric land_offset = 0.02, const Time lift_offset_duration = 0.02,
+                             const Time land_offset_duration = 0.02)
+      : lift_normal(lift_normal),
+        land_normal(land_normal),
+        lift_offset(lift_offset),
+        land_offset(land_offset),
+        lift_offset_duration(lift_offset_duration),
+        land_offset_duration(land_offset_duration) {}
+
+  Point lift_normal;
+  Point land_normal;
+  Numeric lift_offset;
+  Numeric land_offset;
+  Time lift_offset_duration;
+  Time land_offset_duration;
+};
+
+/// \brief Compute the waypoints and the end constraints of the exact cubic part of an effector spline,
+/// and the landing spline.
+/// \param waypoints : filled with the waypoints of the exact cubic. It is cleared first, so the same buffer can be
+/// used for several trajectories.
+/// \param constraints : filled with the end velocity and acceleration of the exact cubic.
+/// \return the landing spline, a straight line along the landing normal.
+template <typename In>
+spline_t effector_spline_waypoints(In wayPointsBegin, In wayPointsEnd, const effector_spline_parameters& params,
+                                   T_Waypoint& waypoints, spline_constraints_t& constraints) {
+  waypoints.clear();
+  const Waypoint &inPoint = *wayPointsBegin, endPoint = *(wayPointsEnd - 1);
+  waypoints.push_back(inPoint);
+  // adding initial offset
+  waypoints.push_back(compute_offset(inPoint, params.lift_normal, params.lift_offset, params.lift_offset_duration));
+  // inserting all waypoints but last
+  waypoints.insert(waypoints.end(), wayPointsBegin + 1, wayPointsEnd - 1);
+  // inserting waypoint to start landing
+  const Waypoint& landWaypoint =
+      compute_offset(endPoint, params.land_normal, params.land_offset, -params.land_offset_duration);
+  waypoints.push_back(landWaypoint);
+  // specifying end velocity constraint such that landing will be in straight line
+  spline_t end_spline = make_end_spline(params.land_normal, landWaypoint.second, params.land_offset,
+                                        landWaypoint.first, params.land_offset_duration);
+  compute_required_offset_velocity_acceleration(end_spline, constraints);
+  return end_spline;
+}
+
 /// \brief Helper method to create a spline typically used to
 /// guide the 3d trajectory of a robot end effector.
 /// Given a set of waypoints, and the normal vector of the start and
@@ -93,22 +159,51 @@ exact_cubic_t* effector_spline(In wayPointsBegin, In wayPointsEnd, const Point&
                                const Numeric land_offset = 0.02, const Time lift_offset_duration = 0.02,
                                const Time land_offset_duration = 0.02) {
   T_Waypoint waypoints;
-  const Waypoint &inPoint = *wayPointsBegin, endPoint = *(wayPointsEnd - 1);
-  waypoints.push_back(inPoint);
-  // adding initial offset
-  waypoints.push_back(compute_offset(inPoint, lift_normal, lift_offset, lift_offset_duration));
-  // inserting all waypoints but last
-  waypoints.insert(waypoints.end(), wayPointsBegin + 1, wayPointsEnd - 1);
-  // inserting waypoint to start landing
-  const Waypoint& landWaypoint = compute_offset(endPoint, land_normal, land_offset, -land_offset_duration);
-  waypoints.push_back(landWaypoint);
-  // specifying end velocity constraint such that landing will be in straight line
-  spline_t end_spline =
-      make_end_spline(land_normal, landWaypoint.second, land_offset, landWaypoint.first, land_offset_duration);
-  spline_constraints_t constraints = compute_required_offset_velocity_acceleration(end_spline, land_offset_duration);
-  exact_cubic_t splines(waypoints.begin(), waypoints.end(), constraints);
-  splines.add_curve(end_spline);
-  return new exact_cubic_t(splines);
+  spline_constraints_t constraints;
+  const spline_t end_spline = effector_spline_waypoints(
+      wayPointsBegin, wayPointsEnd,
+      effector_spline_parameters(lift_normal, land_normal, lift_offset, land_offset, lift_offset_duration,
+                                 land_offset_duration),
+      waypoints, constraints);
+  exact_cubic_t* splines = new exact_cubic_t(waypoints.begin(), waypoints.end(), constraints);
+  splines->add_curve(end_spline);
+  return splines;
+}
+
+/// \brief Create the effector splines of several trajectories, with the same take-off and landing parameters.
+/// The waypoints buffer is shared between all the trajectories and each spline is constructed in place at the end of
+/// out, whose capacity is reserved first. As the trajectories are independent, callers can split the input range
+/// between several threads, each thread appending to its own vector.
+/// \param setsBegin : an iterator pointing to the first element of a container of waypoint containers.
+/// \param setsEnd   : an iterator pointing to the last element of a container of waypoint containers.
+/// \param out       : vector of exact_cubic_t where the splines are appended.
+/// \param params    : take-off and landing parameters.
+///
+template <typename InSets>
+void effector_splines(InSets setsBegin, InSets setsEnd, std::vector<exact_cubic_t>& out,
+                      const effector_spline_parameters& params = effector_spline_parameters()) {
+  out.reserve(out.size() + std::distance(setsBegin, setsEnd));
+  T_Waypoint waypoints;
+  spline_constraints_t constraints;
+  for (InSets it = setsBegin; it != setsEnd; ++it) {
+    const spline_t end_spline = effector_spline_waypoints(it->begin(), it->end(), params, waypoints, constraints);
+    out.emplace_back(waypoints.begin(), waypoints.end(), constraints);
+    out.back().add_curve(end_spline);
+  }
+}
+
+/// \brief Create the effector splines of several trajectories, with the same take-off and landing parameters.
+/// \param setsBegin : an iterator pointing to the first element of a container of waypoint containers.
+/// \param setsEnd   : an iterator pointing to the last element of a container of waypoint containers.
+/// \param params    : take-off and landing parameters.
+/// \return the splines, in the same order as the waypoint containers.
+///
+template <typename InSets>
+std::vector<exact_cubic_t> effector_splines(InSets setsBegin, InSets setsEnd,
+                                            const effector_spline_parameters& params = effector_spline_parameters()) {
+  std::vector<exact_cubic_t> res;
+  effector_splines(setsBegin, setsEnd, res, params);
+  return res;
 }
 }  // namespace helpers
 }  // namespace ndcurves
@@ -29,6 +29,8 @@ typedef Eigen::Matrix<Numeric, 4, 1> quat_t;
 typedef Eigen::Ref<quat_t> quat_ref_t;
 typedef const Eigen::Ref<const quat_t> quat_ref_const_t;
 typedef Eigen::Matrix<Numeric, 7, 1> config_t;
+typedef Eigen::Matrix<Numeric, 6, 1> config_derivate_t;
+typedef Eigen::Matrix<Numeric, 3, 1> angular_derivate_t;
 typedef curve_abc<Time, Numeric, false, quat_t> curve_abc_quat_t;
 typedef std::pair<Numeric, quat_t> waypoint_quat_t;
 typedef std::vector<waypoint_quat_t> t_waypoint_quat_t;
@@ -47,7 +49,7 @@ class rotation_spline : public curve_abc_quat_t {
         dim_(4),
         min_(min),
         max_(max),
-        time_reparam_(computeWayPoints()) {}
+        angular_displacement_(ndcurves::log3(Eigen::Quaterniond(quat_from_.conjugate() * quat_to_))) {}
 
   ~rotation_spline() {}
 
@@ -58,7 +60,7 @@ class rotation_spline : public curve_abc_quat_t {
     dim_ = from.dim_;
     min_ = from.min_;
     max_ = from.max_;
-    time_reparam_ = exact_cubic_constraint_one_dim(from.time_reparam_);
+    angular_displacement_ = from.angular_displacement_;
     return *this;
   }
   /* Copy Constructors / operator=*/
@@ -69,7 +71,7 @@ class rotation_spline : public curve_abc_quat_t {
     // normalize u
     Numeric u = (t - min()) / (max() - min());
     // reparametrize u
-    return quat_from_.slerp(time_reparam_(u)[0], quat_to_).coeffs();
+    return quat_from_.slerp(time_reparam(u), quat_to_).coeffs();
   }
 
   /**
@@ -84,7 +86,7 @@ class rotation_spline : public curve_abc_quat_t {
                 const Numeric prec = Eigen::NumTraits<Numeric>::dummy_precision()) const {
     return ndcurves::isApprox<Numeric>(min_, other.min_) && ndcurves::isApprox<Numeric>(max_, other.max_) &&
            dim_ == other.dim_ && quat_from_.isApprox(other.quat_from_, prec) &&
-           quat_to_.isApprox(other.quat_to_, prec) && time_reparam_.isApprox(other.time_reparam_, prec);
+           quat_to_.isApprox(other.quat_to_, prec);
   }
 
   virtual bool isApprox(const curve_abc_quat_t* other,
@@ -100,23 +102,63 @@ class rotation_spline : public curve_abc_quat_t {
 
   virtual bool operator!=(const rotation_spline& other) const { return !(*this == other); }
 
-  virtual quat_t derivate(time_t /*t*/, std::size_t /*order*/) const {
-    throw std::runtime_error("TODO quaternion spline does not implement derivate");
+  ///  \brief Evaluation of the derivative of the quaternion coefficients (x, y, z, w) at time t.
+  ///  With q(s) = q_from * exp(s * w / 2) the slerp and s(t) the time reparametrization:
+  ///  \f$ \dot{q} = \dot{s} q(s) (0, w/2) \f$ and \f$ \ddot{q} = \ddot{s} q(s) (0, w/2) - \dot{s}^2 |w|^2 / 4 q(s) \f$.
+  ///  \param t : the time when to evaluate the derivative.
+  ///  \param order : order of derivative, 1 or 2.
+  ///  \return the derivative of the quaternion coefficients at time t.
+  virtual quat_t derivate(time_t t, std::size_t order) const {
+    Numeric ds, dds;
+    reparam_derivates(t, order, ds, dds);
+    const Eigen::Quaterniond q(operator()(t));
+    const Eigen::Quaterniond half_displacement(0., angular_displacement_[0] / 2., angular_displacement_[1] / 2.,
+                                               angular_displacement_[2] / 2.);
+    const quat_t dq_ds = (q * half_displacement).coeffs();
+    if (order == 1) {
+      return ds * dq_ds;
+    }
+    return dds * dq_ds - ds * ds * angular_displacement_.squaredNorm() / 4. * q.coeffs();
+  }
+
+  ///  \brief Evaluation of the angular velocity (order 1) or angular acceleration (order 2) at time t.
+  ///  The axis of rotation is constant, so both are colinear to log(q_from^-1 q_to) and are the same expressed in
+  ///  the local frame or in the frame of q_from. As for SO3Linear, they are expressed in the local frame.
+  ///  \param t : the time when to evaluate the derivative.
+  ///  \param order : order of derivative, 1 or 2.
+  ///  \return the angular velocity or acceleration at time t.
+  angular_derivate_t angular_derivate(const time_t t, const std::size_t order) const {
+    Numeric ds, dds;
+    reparam_derivates(t, order, ds, dds);
+    return (order == 1 ? ds : dds) * angular_displacement_;
   }
 
   ///  \brief Compute the derived curve at order N.
+  ///  The derivative of the slerp is not a polynomial and can not be represented by an existing curve type.
   ///  \param order : order of derivative.
   ///  \return A pointer to \f$\frac{d^Nx(t)}{dt^N}\f$ derivative order N of the curve.
   curve_abc_quat_t* compute_derivate_ptr(const std::size_t /*order*/) const {
     throw std::logic_error("Compute derivate for quaternion spline is not implemented yet.");
   }
 
-  /// \brief Initialize time reparametrization for spline.
-  exact_cubic_constraint_one_dim computeWayPoints() const {
-    t_waypoint_one_dim_t waypoints;
-    waypoints.push_back(std::make_pair(0, point_one_dim_t::Zero()));
-    waypoints.push_back(std::make_pair(1, point_one_dim_t::Ones()));
-    return exact_cubic_constraint_one_dim(waypoints.begin(), waypoints.end());
+  /// \brief Time reparametrization of the spline, \f$ s(u) = 3u^2 - 2u^3 \f$ for u in [0, 1].
+  /// This is the exact cubic spline through the waypoints (0, 0) and (1, 1): its velocity is null at both ends.
+  static Numeric time_reparam(const Numeric u) { return u * u * (3. - 2. * u); }
+
+  /// \brief Derivative of order N of the time reparametrization.
+  static Numeric time_reparam_derivate(const Numeric u, const std::size_t order) {
+    switch (order) {
+      case 0:
+        return time_reparam(u);
+      case 1:
+        return 6. * u * (1. - u);
+      case 2:
+        return 6. - 12. * u;
+      case 3:
+        return -12.;
+      default:
+        return 0.;
+    }
   }
 
   /// \brief Get dimension of curve.
@@ -131,6 +173,12 @@ class rotation_spline : public curve_abc_quat_t {
   /// \brief Get the degree of the curve.
   /// \return \f$degree\f$, the degree of the curve.
   virtual std::size_t degree() const { return 1; }
+  /// \brief Get the memory used by the curve, by category. See footprint.
+  virtual footprint memory_footprint() const {
+    footprint res;
+    res.add(footprint::OBJECTS, sizeof(*this));
+    return res;
+  }
 
   /*Attributes*/
   Eigen::Quaterniond quat_from_;                 // const
@@ -138,8 +186,28 @@ class rotation_spline : public curve_abc_quat_t {
   std::size_t dim_;                              // const
   double min_;                                   // const
   double max_;                                   // const
-  exact_cubic_constraint_one_dim time_reparam_;  // const
+  angular_derivate_t angular_displacement_;      // const, log(quat_from_^-1 quat_to_)
   /*Attributes*/
+
+ private:
+  /// \brief First and second derivatives of the time reparametrization s(t), both null outside [min, max].
+  void reparam_derivates(const time_t t, const std::size_t order, Numeric& ds, Numeric& dds) const {
+    if (order == 0) {
+      throw std::invalid_argument("Order must be > 0 ");
+    }
+    if (order > 2) {
+      throw std::invalid_argument("rotation_spline: derivatives are only implemented up to order 2.");
+    }
+    ds = 0.;
+    dds = 0.;
+    if (t < min() || t > max() || min() == max()) {
+      return;
+    }
+    const Numeric T = max() - min();
+    const Numeric u = (t - min()) / T;
+    ds = time_reparam_derivate(u, 1) / T;
+    dds = time_reparam_derivate(u, 2) / (T * T);
+  }
 };  // End class rotation_spline
 
 typedef exact_cubic<Time, Numeric, false, quat_t, std::vector<quat_t, Eigen::aligned_allocator<quat_t> >,
@@ -250,6 +318,30 @@ class effector_spline_rotation {
     return quat_spline_(t);
   }
 
+  ///  \brief Evaluation of the derivative of order N of the effector trajectory at time t.
+  ///  \param t : the time when to evaluate the spline.
+  ///  \param order : order of derivative, 1 or 2.
+  ///  \return A 6D vector where the 3 first values are the linear velocity (or acceleration) and the 3 last are the
+  ///  angular velocity (or acceleration), expressed in the local frame of the effector.
+  ///
+  config_derivate_t derivate(const Numeric t, const std::size_t order) const {
+    config_derivate_t res;
+    res.head<3>() = spline_->derivate(t, order);
+    res.tail<3>() = interpolate_quat_derivate(t, order);
+    return res;
+  }
+
+  angular_derivate_t interpolate_quat_derivate(const Numeric t, const std::size_t order) const {
+    if (t <= time_lift_offset_ || t >= time_land_offset_) {
+      if (order == 0) {
+        throw std::invalid_argument("Order must be > 0 ");
+      }
+      return angular_derivate_t::Zero();
+    }
+    // quat_spline_ only contains rotation_spline, built by simple_quat_spline or quat_spline:
+    return static_cast<const rotation_spline&>(*quat_spline_.curve_at_time(t)).angular_derivate(t, order);
+  }
+
  private:
   exact_cubic_quat_t simple_quat_spline() const {
     std::vector<rotation_spline> splines;
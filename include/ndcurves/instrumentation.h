@@ -0,0 +1,371 @@
+/**
+ * \file instrumentation.h
+ * \brief optional counters, timers and trace of the hot paths of the library.
+ *
+ * The instrumentation is enabled by defining CURVES_WITH_INSTRUMENTATION (CMake option of the same name), which must
+ * be the same for all the translation units of a program. Otherwise the CURVES_INSTRUMENT_* macros expand to nothing
+ * and the snapshots are empty.
+ *
+ * When enabled, each call to operator(), derivate, compute_derivate and the interval lookup of the curves, to the
+ * Serializable I/O and to generate_problem increments a counter of its category and of the static type of the
+ * object, and its duration is accumulated. The instrumented calls allocate the first time and lock a mutex while a
+ * trace is recorded, so they are not real-time safe anymore: the instrumentation is meant for profiling builds.
+ * It never throws: a call whose counter can not be created is not measured.
+ */
+
+#ifndef _CLASS_INSTRUMENTATION
+#define _CLASS_INSTRUMENTATION
+
+#include <boost/noncopyable.hpp>
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#ifdef CURVES_WITH_INSTRUMENTATION
+#include <boost/core/demangle.hpp>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <typeinfo>
+#include <utility>
+#endif
+
+namespace ndcurves {
+namespace instrumentation {
+
+/// \brief Instrumented operations.
+enum category {
+  EVALUATE = 0,          // operator()
+  DERIVATE = 1,          // derivate
+  COMPUTE_DERIVATE = 2,  // compute_derivate and compute_derivate_ptr
+  FIND_INTERVAL = 3,     // lookup of the segment containing a time
+  SAVE = 4,              // Serializable save methods
+  LOAD = 5,              // Serializable load methods
+  GENERATE_PROBLEM = 6,  // optimization::generate_problem
+  ALLOCATION = 7,        // see record_allocation
+  NUM_CATEGORIES = 8
+};
+
+inline const char* category_name(const category c) {
+  static const char* names[] = {"evaluate", "derivate", "compute_derivate", "find_interval",
+                                "save",     "load",     "generate_problem", "allocation"};
+  if (int(c) < 0 || int(c) >= NUM_CATEGORIES) {
+    throw std::invalid_argument("category_name: unknown category");
+  }
+  return names[c];
+}
+
+/// \brief Return true if the library was compiled with CURVES_WITH_INSTRUMENTATION.
+inline bool enabled() {
+#ifdef CURVES_WITH_INSTRUMENTATION
+  return true;
+#else
+  return false;
+#endif
+}
+
+/// \brief Value of a counter when the snapshot was taken.
+struct counter_snapshot {
+  category category_;
+  std::string type_;   // demangled name of the type, or name given to CURVES_INSTRUMENT_SCOPE
+  std::size_t count_;  // number of calls, or of allocations
+  double total_time_;  // in seconds
+  double max_time_;    // duration of the slowest call, in seconds
+  std::size_t bytes_;  // allocated bytes, for ALLOCATION
+};
+
+/// \brief Completed call recorded while the trace is active.
+struct trace_event {
+  std::size_t counter_;  // index of the counter in the registry
+  long long start_;      // in nanoseconds since the creation of the registry
+  long long duration_;   // in nanoseconds
+  std::size_t thread_;
+};
+
+#ifdef CURVES_WITH_INSTRUMENTATION
+/// \brief Statistics of one (category, type) pair, updated without lock.
+struct counter : private boost::noncopyable {
+  counter(const category c, const std::string& type, const std::size_t index)
+      : category_(c), type_(type), index_(index), count_(0), time_(0), max_time_(0), bytes_(0) {}
+
+  void add(const long long duration) {
+    count_.fetch_add(1, std::memory_order_relaxed);
+    time_.fetch_add(duration, std::memory_order_relaxed);
+    long long max_time = max_time_.load(std::memory_order_relaxed);
+    while (duration > max_time && !max_time_.compare_exchange_weak(max_time, duration, std::memory_order_relaxed)) {
+    }
+  }
+
+  const category category_;
+  const std::string type_;
+  const std::size_t index_;
+  std::atomic<std::size_t> count_;
+  std::atomic<long long> time_;      // in nanoseconds
+  std::atomic<long long> max_time_;  // in nanoseconds
+  std::atomic<std::size_t> bytes_;
+};
+#else
+struct counter;
+#endif
+
+/// \class registry.
+/// \brief Process wide set of the counters and of the trace events.
+///
+class registry : private boost::noncopyable {
+ public:
+  typedef std::chrono::steady_clock clock_t;
+
+  /// \brief Get the registry. It is never destroyed, so that the instrumented calls made during the destruction of
+  /// the static objects are still valid.
+  static registry& instance() {
+    static registry* r = new registry();
+    return *r;
+  }
+
+#ifdef CURVES_WITH_INSTRUMENTATION
+  /// \brief Get the counter of (c, type), created on the first call. The reference stays valid until the end of the
+  /// program, the call sites keep it in a static variable.
+  counter& get(const category c, const std::string& type) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const std::pair<int, std::string> key(c, type);
+    std::map<std::pair<int, std::string>, counter*>::const_iterator it = index_.find(key);
+    if (it != index_.end()) {
+      return *it->second;
+    }
+    counter* res = new counter(c, type, counters_.size());
+    counters_.push_back(res);
+    index_[key] = res;
+    return *res;
+  }
+
+  /// \brief Record a completed call in the trace, if it is active and not full.
+  void trace(const counter& cnt, const clock_t::time_point& start, const long long duration) {
+    if (!tracing_.load(std::memory_order_relaxed)) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!tracing_.load(std::memory_order_relaxed) || events_.size() >= max_events_) return;
+    trace_event e;
+    e.counter_ = cnt.index_;
+    e.start_ = std::chrono::duration_cast<std::chrono::nanoseconds>(start - epoch_).count();
+    e.duration_ = duration;
+    e.thread_ = std::hash<std::thread::id>()(std::this_thread::get_id()) % 1000000;
+    events_.push_back(e);
+  }
+#endif
+
+  /// \brief Get the value of all the counters.
+  std::vector<counter_snapshot> snapshot() const {
+    std::vector<counter_snapshot> res;
+#ifdef CURVES_WITH_INSTRUMENTATION
+    std::lock_guard<std::mutex> lock(mutex_);
+    res.reserve(counters_.size());
+    for (std::size_t i = 0; i < counters_.size(); ++i) {
+      const counter& cnt = *counters_[i];
+      counter_snapshot s;
+      s.category_ = cnt.category_;
+      s.type_ = cnt.type_;
+      s.count_ = cnt.count_.load();
+      s.total_time_ = double(cnt.time_.load()) * 1e-9;
+      s.max_time_ = double(cnt.max_time_.load()) * 1e-9;
+      s.bytes_ = cnt.bytes_.load();
+      res.push_back(s);
+    }
+#endif
+    return res;
+  }
+
+  /// \brief Set all the counters to zero and clear the trace. The counters are kept.
+  void reset() {
+#ifdef CURVES_WITH_INSTRUMENTATION
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (std::size_t i = 0; i < counters_.size(); ++i) {
+      counters_[i]->count_ = 0;
+      counters_[i]->time_ = 0;
+      counters_[i]->max_time_ = 0;
+      counters_[i]->bytes_ = 0;
+    }
+    events_.clear();
+#endif
+  }
+
+  /// \brief Start recording each instrumented call, up to max_events calls. The memory is reserved here.
+  void start_trace(const std::size_t max_events = 1000000) {
+#ifdef CURVES_WITH_INSTRUMENTATION
+    std::lock_guard<std::mutex> lock(mutex_);
+    events_.clear();
+    events_.reserve(max_events);
+    max_events_ = max_events;
+    tracing_ = true;
+#else
+    (void)max_events;
+#endif
+  }
+
+  /// \brief Stop recording the calls, the recorded ones are kept until the next start_trace or reset.
+  void stop_trace() {
+#ifdef CURVES_WITH_INSTRUMENTATION
+    tracing_ = false;
+#endif
+  }
+
+  /// \brief Get the number of calls recorded in the trace.
+  std::size_t num_trace_events() const {
+#ifdef CURVES_WITH_INSTRUMENTATION
+    std::lock_guard<std::mutex> lock(mutex_);
+    return events_.size();
+#else
+    return 0;
+#endif
+  }
+
+  /// \brief Write the trace in the Chrome trace event format, to be opened with chrome://tracing or Perfetto.
+  /// The counters are written in the metadata of the trace.
+  void write_chrome_trace(std::ostream& os) const {
+    const std::vector<counter_snapshot> counters = snapshot();
+    os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+#ifdef CURVES_WITH_INSTRUMENTATION
+    std::lock_guard<std::mutex> lock(mutex_);
+    const std::streamsize precision = os.precision(3);
+    const std::ios_base::fmtflags flags = os.setf(std::ios::fixed, std::ios::floatfield);
+    for (std::size_t i = 0; i < events_.size(); ++i) {
+      const trace_event& e = events_[i];
+      os << (i == 0 ? "\n" : ",\n") << "{\"name\":\"" << escape(counters[e.counter_].type_) << "\",\"cat\":\""
+         << category_name(counters[e.counter_].category_) << "\",\"ph\":\"X\",\"ts\":" << double(e.start_) * 1e-3
+         << ",\"dur\":" << double(e.duration_) * 1e-3 << ",\"pid\":0,\"tid\":" << e.thread_ << "}";
+    }
+    os.precision(precision);
+    os.flags(flags);
+#endif
+    os << "\n],\"otherData\":{\"counters\":[";
+    for (std::size_t i = 0; i < counters.size(); ++i) {
+      const counter_snapshot& s = counters[i];
+      os << (i == 0 ? "\n" : ",\n") << "{\"category\":\"" << category_name(s.category_) << "\",\"type\":\""
+         << escape(s.type_) << "\",\"count\":" << s.count_ << ",\"total_time\":" << s.total_time_
+         << ",\"max_time\":" << s.max_time_ << ",\"bytes\":" << s.bytes_ << "}";
+    }
+    os << "\n]}}\n";
+  }
+
+  /// \brief Write the trace in filename, see write_chrome_trace.
+  void save_chrome_trace(const std::string& filename) const {
+    std::ofstream ofs(filename.c_str());
+    if (!ofs) {
+      throw std::invalid_argument(filename + " can not be opened for writing.");
+    }
+    write_chrome_trace(ofs);
+  }
+
+ private:
+  registry()
+#ifdef CURVES_WITH_INSTRUMENTATION
+      : epoch_(clock_t::now()), tracing_(false), max_events_(0)
+#endif
+  {
+  }
+
+  static std::string escape(const std::string& s) {
+    std::string res;
+    res.reserve(s.size());
+    for (std::string::const_iterator it = s.begin(); it != s.end(); ++it) {
+      if (*it == '"' || *it == '\\') res.push_back('\\');
+      res.push_back(*it);
+    }
+    return res;
+  }
+
+#ifdef CURVES_WITH_INSTRUMENTATION
+  mutable std::mutex mutex_;
+  const clock_t::time_point epoch_;
+  std::vector<counter*> counters_;
+  std::map<std::pair<int, std::string>, counter*> index_;
+  std::atomic<bool> tracing_;
+  std::size_t max_events_;
+  std::vector<trace_event> events_;
+#endif
+};
+
+/// \brief Shortcuts to the registry.
+inline std::vector<counter_snapshot> snapshot() { return registry::instance().snapshot(); }
+inline void reset() { registry::instance().reset(); }
+inline void start_trace(const std::size_t max_events = 1000000) { registry::instance().start_trace(max_events); }
+inline void stop_trace() { registry::instance().stop_trace(); }
+inline void save_chrome_trace(const std::string& filename) { registry::instance().save_chrome_trace(filename); }
+
+/// \brief Count an allocation of bytes bytes, under the type name "heap". The library records the curves copied on
+/// the heap by piecewise_curve::add_curve and the blocks of the monotonic arenas. It must not be called from an
+/// operator new, since the first call allocates.
+inline void record_allocation(const std::size_t bytes) {
+#ifdef CURVES_WITH_INSTRUMENTATION
+  static counter& cnt = registry::instance().get(ALLOCATION, "heap");
+  cnt.count_.fetch_add(1, std::memory_order_relaxed);
+  cnt.bytes_.fetch_add(bytes, std::memory_order_relaxed);
+#else
+  (void)bytes;
+#endif
+}
+
+#ifdef CURVES_WITH_INSTRUMENTATION
+/// \brief Get the counter of category c for the static type of object, or NULL if it can not be created. It never
+/// throws, so that CURVES_INSTRUMENT_SCOPE can be used in the noexcept functions.
+template <typename T>
+counter* get_counter(const category c, const T* /*object*/) noexcept {
+  try {
+    return &registry::instance().get(c, boost::core::demangle(typeid(T).name()));
+  } catch (...) {
+    return NULL;
+  }
+}
+
+inline counter* get_counter(const category c, const char* name) noexcept {
+  try {
+    return &registry::instance().get(c, name);
+  } catch (...) {
+    return NULL;
+  }
+}
+
+/// \brief Measure the duration of its scope and add it to a counter. Nothing is measured if cnt is NULL.
+class scoped_timer : private boost::noncopyable {
+ public:
+  explicit scoped_timer(counter* cnt) noexcept : counter_(cnt), start_(registry::clock_t::now()) {}
+  ~scoped_timer() {
+    if (!counter_) return;
+    const long long duration =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(registry::clock_t::now() - start_).count();
+    counter_->add(duration);
+    try {
+      registry::instance().trace(*counter_, start_, duration);
+    } catch (...) {
+      // the event is not recorded if the mutex can not be locked
+    }
+  }
+
+ private:
+  counter* const counter_;
+  const registry::clock_t::time_point start_;
+};
+#endif
+
+}  // namespace instrumentation
+}  // namespace ndcurves
+
+#define CURVES_INSTRUMENT_CONCAT_IMPL(a, b) a##b
+#define CURVES_INSTRUMENT_CONCAT(a, b) CURVES_INSTRUMENT_CONCAT_IMPL(a, b)
+
+#ifdef CURVES_WITH_INSTRUMENTATION
+/// \brief Count and time the end of the current scope, in category c for the static type of object (usually this),
+/// or for the name given as a string literal.
+#define CURVES_INSTRUMENT_SCOPE(c, object)                                                                 \
+  static ::ndcurves::instrumentation::counter* const CURVES_INSTRUMENT_CONCAT(curves_counter_, __LINE__) = \
+      ::ndcurves::instrumentation::get_counter(::ndcurves::instrumentation::c, object);                    \
+  const ::ndcurves::instrumentation::scoped_timer CURVES_INSTRUMENT_CONCAT(curves_timer_, __LINE__)(       \
+      CURVES_INSTRUMENT_CONCAT(curves_counter_, __LINE__))
+#else
+#define CURVES_INSTRUMENT_SCOPE(c, object) ((void)0)
+#endif
+
+#endif  //_CLASS_INSTRUMENTATION
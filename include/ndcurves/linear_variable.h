@@ -22,8 +22,18 @@
 #include <stdexcept>
 
 namespace ndcurves {
+/// \class linear_expression.
+/// \brief Base of the linear variables and of the lazy expressions returned by their arithmetic operators.
+/// An expression such as (1 - u) * a + u * b is only evaluated when it is assigned to a linear_variable, in a single
+/// pass over B and c without intermediate linear variables. The expressions keep references to the linear variables
+/// they use, so they must be evaluated before these variables are destroyed.
+template <typename Derived>
+struct linear_expression {
+  const Derived& derived() const { return static_cast<const Derived&>(*this); }
+};
+
 template <typename Numeric = double, bool Safe = true>
-struct linear_variable : public serialization::Serializable {
+struct linear_variable : public serialization::Serializable, public linear_expression<linear_variable<Numeric, Safe> > {
   typedef Eigen::Matrix<Numeric, Eigen::Dynamic, 1> vector_x_t;
   typedef Eigen::Matrix<Numeric, Eigen::Dynamic, Eigen::Dynamic> matrix_x_t;
   typedef Eigen::Matrix<Numeric, 3,1> vector_3_t;
@@ -34,6 +44,24 @@ struct linear_variable : public serialization::Serializable {
   linear_variable(const vector_x_t& c) : B_(matrix_x_t::Zero(c.size(), c.size())), c_(c), zero(false) {}  // constant
   linear_variable(const matrix_x_t& B, const vector_x_t& c) : B_(B), c_(c), zero(false) {}                // mixed
   linear_variable(const linear_variable_t& other) : B_(other.B()), c_(other.c()), zero(other.isZero()) {} // copy constructor
+  linear_variable& operator=(const linear_variable_t& other) {
+    B_ = other.B_;
+    c_ = other.c_;
+    zero = other.zero;
+    return *this;
+  }
+
+  /// \brief Evaluate an expression of linear variables, see linear_expression.
+  template <typename Derived>
+  linear_variable(const linear_expression<Derived>& expr) : zero(true) {
+    assign(expr.derived());
+  }
+
+  template <typename Derived>
+  linear_variable& operator=(const linear_expression<Derived>& expr) {
+    assign(expr.derived());
+    return *this;
+  }
 
   ///  \brief Linear evaluation for vector x.
   ///  \param val : vector to evaluate the linear variable.
@@ -78,11 +106,59 @@ struct linear_variable : public serialization::Serializable {
     return *this;
   }
 
+  /// \brief Add an expression of linear variables, without evaluating it first.
+  template <typename Derived>
+  linear_variable& operator+=(const linear_expression<Derived>& expr) {
+    add_scaled(expr.derived(), 1);
+    return *this;
+  }
+
+  /// \brief Substract an expression of linear variables, without evaluating it first.
+  template <typename Derived>
+  linear_variable& operator-=(const linear_expression<Derived>& expr) {
+    add_scaled(expr.derived(), -1);
+    return *this;
+  }
+
+  /// \brief Add k * w1, without temporary linear variable.
+  /// \param w1 : linear variable or expression of linear variables to add.
+  /// \param k : factor of w1.
+  /// \return Linear variable after operation.
+  ///
+  template <typename Derived>
+  linear_variable& add_scaled(const Derived& w1, const Numeric k) {
+    if (linear_has_zero(w1)) {
+      // the zero variables have no B and c, add the terms one by one
+      linear_accumulate(*this, w1, k);
+    } else if (isZero()) {
+      B_ = k * w1.B();
+      c_ = k * w1.c();
+      zero = false;
+    } else {
+      B_ += k * w1.B();
+      c_ += k * w1.c();
+    }
+    return *this;
+  }
+
+  linear_variable& add_scaled(const linear_variable& w1, const Numeric k) {
+    if (w1.isZero()) return *this;
+    if (isZero()) {
+      B_ = k * w1.B_;
+      c_ = k * w1.c_;
+      zero = false;
+    } else {
+      B_ += k * w1.B_;
+      c_ += k * w1.c_;
+    }
+    return *this;
+  }
+
   /// \brief Divide by a constant : p_i / d = B_i*x/d + c_i/d.
   /// \param d : constant.
   /// \return Linear variable after operation.
   ///
-  linear_variable_t& operator/=(const double d) {
+  linear_variable_t& operator/=(const Numeric d) {
     B_ /= d;
     c_ /= d;
     return *this;
@@ -92,7 +168,7 @@ struct linear_variable : public serialization::Serializable {
   /// \param d : constant.
   /// \return Linear variable after operation.
   ///
-  linear_variable_t& operator*=(const double d) {
+  linear_variable_t& operator*=(const Numeric d) {
     B_ *= d;
     c_ *= d;
     return *this;
@@ -152,13 +228,21 @@ struct linear_variable : public serialization::Serializable {
   /// \return true if the two linear variables are approximately equal.
   bool isApprox(const linear_variable_t& other,
                 const double prec = Eigen::NumTraits<Numeric>::dummy_precision()) const {
-    return (*this - other).norm() < prec;
+    return linear_variable(*this - other).norm() < prec;
   }
 
   const matrix_x_t& B() const { return B_; }
   const vector_x_t& c() const { return c_; }
   bool isZero() const { return zero; }
 
+  /// \brief Get the memory used by the linear variable, by category. See footprint.
+  footprint memory_footprint() const {
+    footprint res;
+    res.add(footprint::OBJECTS, sizeof(*this));
+    point_footprint<linear_variable>::add(res, footprint::LINEAR_VARIABLES, *this);
+    return res;
+  }
+
   // Serialization of the class
   friend class boost::serialization::access;
 
@@ -173,44 +257,168 @@ struct linear_variable : public serialization::Serializable {
   }
 
  private:
+  template <typename Derived>
+  void assign(const Derived& expr) {
+    if (linear_has_zero(expr)) {
+      linear_variable res;
+      linear_accumulate(res, expr, Numeric(1));
+      B_.swap(res.B_);
+      c_.swap(res.c_);
+      zero = res.zero;
+    } else {
+      // the expressions are coefficient-wise, this can appear in expr
+      B_ = expr.B();
+      c_ = expr.c();
+      zero = false;
+    }
+  }
+
   matrix_x_t B_;
   vector_x_t c_;
   bool zero;
 };
 
+/// \brief Expressions are stored by value in the expressions that use them, linear variables by reference.
+template <typename E>
+struct linear_expression_nested {
+  typedef const E type;
+};
+
 template <typename N, bool S>
-inline linear_variable<N, S> operator+(const linear_variable<N, S>& w1, const linear_variable<N, S>& w2) {
-  linear_variable<N, S> res(w1.B(), w1.c());
-  return res += w2;
-}
+struct linear_expression_nested<linear_variable<N, S> > {
+  typedef const linear_variable<N, S>& type;
+};
 
+/// \brief True if one of the linear variables of the expression is zero, i.e. has no B and c.
 template <typename N, bool S>
-linear_variable<N, S> operator-(const linear_variable<N, S>& w1, const linear_variable<N, S>& w2) {
-  linear_variable<N, S> res(w1.B(), w1.c());
-  return res -= w2;
+bool linear_has_zero(const linear_variable<N, S>& w) {
+  return w.isZero();
 }
 
-template <typename N, bool S>
-linear_variable<N, S> operator-(const linear_variable<N, S>& w1) {
-  return linear_variable<N, S> (-w1.B(), -w1.c());
+template <typename E>
+bool linear_has_zero(const E& expr) {
+  return expr.hasZero();
 }
 
+/// \brief res += k * expr, one linear variable of the expression after the other.
 template <typename N, bool S>
-linear_variable<N, S> operator*(const double k, const linear_variable<N, S>& w) {
-  linear_variable<N, S> res(w.B(), w.c());
-  return res *= k;
+void linear_accumulate(linear_variable<N, S>& res, const linear_variable<N, S>& w, const N k) {
+  res.add_scaled(w, k);
 }
 
-template <typename N, bool S>
-linear_variable<N, S> operator*(const linear_variable<N, S>& w, const double k) {
-  linear_variable<N, S> res(w.B(), w.c());
-  return res *= k;
+template <typename N, bool S, typename E>
+void linear_accumulate(linear_variable<N, S>& res, const E& expr, const N k) {
+  expr.accumulate(res, k);
 }
 
+/// \brief k * e, see linear_expression.
+template <typename E>
+struct linear_scaled : public linear_expression<linear_scaled<E> > {
+ private:
+  typename linear_expression_nested<E>::type e_;
+  typename E::matrix_x_t::Scalar k_;
+
+ public:
+  typedef typename E::matrix_x_t matrix_x_t;
+  typedef typename E::vector_x_t vector_x_t;
+  typedef typename matrix_x_t::Scalar Scalar;
+
+  linear_scaled(const Scalar k, const E& e) : e_(e), k_(k) {}
+
+  auto B() const -> decltype(k_ * e_.B()) { return k_ * e_.B(); }
+  auto c() const -> decltype(k_ * e_.c()) { return k_ * e_.c(); }
+  bool hasZero() const { return linear_has_zero(e_); }
+  template <bool S>
+  void accumulate(linear_variable<Scalar, S>& res, const Scalar k) const {
+    linear_accumulate(res, e_, k * k_);
+  }
+};
+
+/// \brief e1 + e2, see linear_expression.
+template <typename E1, typename E2>
+struct linear_sum : public linear_expression<linear_sum<E1, E2> > {
+ private:
+  typename linear_expression_nested<E1>::type e1_;
+  typename linear_expression_nested<E2>::type e2_;
+
+ public:
+  typedef typename E1::matrix_x_t matrix_x_t;
+  typedef typename E1::vector_x_t vector_x_t;
+  typedef typename matrix_x_t::Scalar Scalar;
+
+  linear_sum(const E1& e1, const E2& e2) : e1_(e1), e2_(e2) {}
+
+  auto B() const -> decltype(e1_.B() + e2_.B()) { return e1_.B() + e2_.B(); }
+  auto c() const -> decltype(e1_.c() + e2_.c()) { return e1_.c() + e2_.c(); }
+  bool hasZero() const { return linear_has_zero(e1_) || linear_has_zero(e2_); }
+  template <bool S>
+  void accumulate(linear_variable<Scalar, S>& res, const Scalar k) const {
+    linear_accumulate(res, e1_, k);
+    linear_accumulate(res, e2_, k);
+  }
+};
+
+/// \brief e1 - e2, see linear_expression.
+template <typename E1, typename E2>
+struct linear_difference : public linear_expression<linear_difference<E1, E2> > {
+ private:
+  typename linear_expression_nested<E1>::type e1_;
+  typename linear_expression_nested<E2>::type e2_;
+
+ public:
+  typedef typename E1::matrix_x_t matrix_x_t;
+  typedef typename E1::vector_x_t vector_x_t;
+  typedef typename matrix_x_t::Scalar Scalar;
+
+  linear_difference(const E1& e1, const E2& e2) : e1_(e1), e2_(e2) {}
+
+  auto B() const -> decltype(e1_.B() - e2_.B()) { return e1_.B() - e2_.B(); }
+  auto c() const -> decltype(e1_.c() - e2_.c()) { return e1_.c() - e2_.c(); }
+  bool hasZero() const { return linear_has_zero(e1_) || linear_has_zero(e2_); }
+  template <bool S>
+  void accumulate(linear_variable<Scalar, S>& res, const Scalar k) const {
+    linear_accumulate(res, e1_, k);
+    linear_accumulate(res, e2_, -k);
+  }
+};
+
+/// \brief B and c of the linear variables are counted in LINEAR_VARIABLES, whatever the category of the points.
 template <typename N, bool S>
-linear_variable<N, S> operator/(const linear_variable<N, S>& w, const double k) {
-  linear_variable<N, S> res(w.B(), w.c());
-  return res /= k;
+struct point_footprint<linear_variable<N, S> > {
+  static void add(footprint& res, const footprint::category /*c*/, const linear_variable<N, S>& w) {
+    point_footprint<typename linear_variable<N, S>::matrix_x_t>::add(res, footprint::LINEAR_VARIABLES, w.B());
+    point_footprint<typename linear_variable<N, S>::vector_x_t>::add(res, footprint::LINEAR_VARIABLES, w.c());
+  }
+};
+
+template <typename E1, typename E2>
+inline linear_sum<E1, E2> operator+(const linear_expression<E1>& w1, const linear_expression<E2>& w2) {
+  return linear_sum<E1, E2>(w1.derived(), w2.derived());
+}
+
+template <typename E1, typename E2>
+inline linear_difference<E1, E2> operator-(const linear_expression<E1>& w1, const linear_expression<E2>& w2) {
+  return linear_difference<E1, E2>(w1.derived(), w2.derived());
+}
+
+template <typename E>
+inline linear_scaled<E> operator-(const linear_expression<E>& w1) {
+  return linear_scaled<E>(-1, w1.derived());
+}
+
+template <typename E>
+inline linear_scaled<E> operator*(const typename linear_scaled<E>::Scalar k, const linear_expression<E>& w) {
+  return linear_scaled<E>(k, w.derived());
+}
+
+template <typename E>
+inline linear_scaled<E> operator*(const linear_expression<E>& w, const typename linear_scaled<E>::Scalar k) {
+  return linear_scaled<E>(k, w.derived());
+}
+
+template <typename E>
+inline linear_scaled<E> operator/(const linear_expression<E>& w, const typename linear_scaled<E>::Scalar k) {
+  return linear_scaled<E>(typename linear_scaled<E>::Scalar(1) / k, w.derived());
 }
 
 template <typename BezierFixed, typename BezierLinear, typename X>
@@ -221,6 +429,96 @@ BezierFixed evaluateLinear(const BezierLinear& bIn, const X x) {
   return BezierFixed(fixed_wps.begin(), fixed_wps.end(), bIn.T_min_, bIn.T_max_);
 }
 
+/// \brief Dimension of the control points of a bezier curve of linear variables, i.e. the size of B_i x + c_i.
+/// bIn.dim() is the size of the linear variables, i.e. the largest of the sizes of x and of the points.
+template <typename BezierLinear>
+Eigen::Index linearPointsDim(const BezierLinear& bIn) {
+  Eigen::Index dim = 0;
+  for (typename BezierLinear::cit_point_t cit = bIn.waypoints().begin(); cit != bIn.waypoints().end(); ++cit) {
+    dim = std::max(dim, Eigen::Index(cit->c().size()));
+  }
+  return dim;
+}
+
+/// \brief Stack the control points of a bezier curve of linear variables: the control point i is
+/// B.middleRows(i * dim, dim) x + c.segment(i * dim, dim).
+/// The constant control points (with a zero or an empty B) can have any number of columns.
+/// \param bIn : bezier curve of linear variables.
+/// \param num_vars : size of the variable x.
+/// \param B : resized to (dim * number of control points) x num_vars.
+/// \param c : resized to dim * number of control points.
+///
+template <typename BezierLinear, typename Matrix, typename Vector>
+void stackLinear(const BezierLinear& bIn, const Eigen::Index num_vars, Matrix& B, Vector& c) {
+  const Eigen::Index dim = linearPointsDim(bIn);
+  B.setZero(dim * Eigen::Index(bIn.size_), num_vars);
+  c.setZero(dim * Eigen::Index(bIn.size_));
+  Eigen::Index row = 0;
+  for (typename BezierLinear::cit_point_t cit = bIn.waypoints().begin(); cit != bIn.waypoints().end();
+       ++cit, row += dim) {
+    if (cit->isZero()) continue;
+    if (cit->B().cols() == num_vars) {
+      B.middleRows(row, dim) = cit->B();
+    } else if (!cit->B().isZero(0)) {
+      throw std::length_error("Cannot stack linear variables, variable value does not have the correct dimension");
+    }
+    c.segment(row, dim) = cit->c();
+  }
+}
+
+/// \brief Evaluate the control points of a bezier curve of linear variables for several values of the variable,
+/// with a single matrix product instead of one evaluateLinear per value.
+/// \param bIn : bezier curve of linear variables.
+/// \param X : values of the variable, one per column.
+/// \return a matrix with one column per value, where the control point i is the block of rows i * dim to
+/// (i + 1) * dim - 1, i.e. the column k stacks the control points of evaluateLinear(bIn, X.col(k)).
+///
+template <typename BezierLinear>
+typename BezierLinear::point_t::matrix_x_t evaluateLinearBatch(
+    const BezierLinear& bIn, const Eigen::Ref<const typename BezierLinear::point_t::matrix_x_t>& X) {
+  typename BezierLinear::point_t::matrix_x_t B, res;
+  typename BezierLinear::point_t::vector_x_t c;
+  stackLinear(bIn, X.rows(), B, c);
+  res.noalias() = B * X;
+  res.colwise() += c;
+  return res;
+}
+
+/// \brief Evaluate the derivative of a bezier curve of linear variables on a time grid for several values of the
+/// variable. The basis of the bezier curve (see basis_matrix) is first combined with the stacked control points, then
+/// all the values are evaluated with a single matrix product.
+/// \param bIn : bezier curve of linear variables.
+/// \param X : values of the variable, one per column.
+/// \param times : times when to evaluate the curve.
+/// \param order : order of the derivative, 0 for the position.
+/// \return a matrix with one column per value, where the rows j * dim to (j + 1) * dim - 1 of the column k are
+/// the derivative at times[j] of evaluateLinear(bIn, X.col(k)).
+///
+template <typename BezierLinear>
+typename BezierLinear::point_t::matrix_x_t evaluateLinearOnGrid(
+    const BezierLinear& bIn, const Eigen::Ref<const typename BezierLinear::point_t::matrix_x_t>& X,
+    const typename BezierLinear::vector_x_ref_t& times, const std::size_t order = 0) {
+  typedef typename BezierLinear::point_t::matrix_x_t matrix_x_t;
+  typedef typename BezierLinear::point_t::vector_x_t vector_x_t;
+  const Eigen::Index dim = linearPointsDim(bIn);
+  const matrix_x_t basis = bIn.basis_matrix(times, order);
+  matrix_x_t B, B_grid, res;
+  vector_x_t c;
+  stackLinear(bIn, X.rows(), B, c);
+  B_grid.setZero(dim * times.size(), X.rows());
+  vector_x_t c_grid = vector_x_t::Zero(dim * times.size());
+  for (Eigen::Index i = 0; i < basis.cols(); ++i) {
+    for (Eigen::Index j = 0; j < basis.rows(); ++j) {
+      if (basis(j, i) == 0) continue;
+      B_grid.middleRows(j * dim, dim) += basis(j, i) * B.middleRows(i * dim, dim);
+      c_grid.segment(j * dim, dim) += basis(j, i) * c.segment(i * dim, dim);
+    }
+  }
+  res.noalias() = B_grid * X;
+  res.colwise() += c_grid;
+  return res;
+}
+
 template <typename N, bool S>
 std::ostream &operator<<(std::ostream &os, const linear_variable<N, S>& l) {
     return os << "linear_variable: \n \t B:\n"<< l.B() << "\t c: \n" << l.c().transpose();
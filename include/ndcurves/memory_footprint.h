@@ -0,0 +1,143 @@
+/**
+ * \file memory_footprint.h
+ * \brief memory used by the curves and the optimization structures, by category.
+ */
+
+#ifndef _CLASS_MEMORY_FOOTPRINT
+#define _CLASS_MEMORY_FOOTPRINT
+
+#include <Eigen/Core>
+#include <boost/smart_ptr/shared_ptr.hpp>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace ndcurves {
+/// \struct footprint.
+/// \brief Bytes used by an object, by category, as returned by the memory_footprint() methods.
+/// The size of the object itself is counted in OBJECTS, so that the footprints of the objects stored on the heap
+/// (segments of a piecewise curve, curves of an SE3Curve, ...) add up. The heap bytes owned by an object x are
+/// x.memory_footprint().total() - sizeof(x). The allocator overhead and the alignment padding are not counted.
+///
+struct footprint {
+  enum category {
+    OBJECTS = 0,           // sizeof of the curves and of the other objects
+    CONTROL_POINTS = 1,    // control points, coefficients and other point vectors of the curves
+    BERNSTEIN = 2,         // Bernstein polynomials of the bezier curves
+    CONTROL_BLOCKS = 3,    // reference counts of the boost::shared_ptr, estimated with shared_control_block_size
+    LINEAR_VARIABLES = 4,  // matrices and vectors of linear_variable and quadratic_variable
+    TIMES = 5,             // time vectors of the piecewise curves and of the splines
+    OTHER = 6,             // everything else, e.g. the inequality matrices of a quadratic_problem
+    NUM_CATEGORIES = 7
+  };
+
+  /// \brief Estimated size of the control block of a boost::shared_ptr: the reference counts and the pointer.
+  static const std::size_t shared_control_block_size = 2 * sizeof(void*) + 2 * sizeof(long);
+
+  footprint() {
+    for (int i = 0; i < NUM_CATEGORIES; ++i) {
+      bytes_[i] = 0;
+    }
+  }
+
+  static const char* category_name(const category c) {
+    static const char* names[] = {"objects", "control_points", "bernstein", "control_blocks",
+                                  "linear_variables", "times", "other"};
+    if (int(c) < 0 || int(c) >= NUM_CATEGORIES) {
+      throw std::invalid_argument("footprint: unknown category");
+    }
+    return names[c];
+  }
+
+  /// \brief Get the number of bytes of category c.
+  std::size_t operator[](const category c) const { return bytes_[c]; }
+
+  /// \brief Get the number of bytes of all the categories.
+  std::size_t total() const {
+    std::size_t res = 0;
+    for (int i = 0; i < NUM_CATEGORIES; ++i) {
+      res += bytes_[i];
+    }
+    return res;
+  }
+
+  /// \brief Add bytes to category c.
+  footprint& add(const category c, const std::size_t bytes) {
+    bytes_[c] += bytes;
+    return *this;
+  }
+
+  footprint& operator+=(const footprint& other) {
+    for (int i = 0; i < NUM_CATEGORIES; ++i) {
+      bytes_[i] += other.bytes_[i];
+    }
+    return *this;
+  }
+
+  footprint operator+(const footprint& other) const {
+    footprint res(*this);
+    return res += other;
+  }
+
+  bool operator==(const footprint& other) const {
+    for (int i = 0; i < NUM_CATEGORIES; ++i) {
+      if (bytes_[i] != other.bytes_[i]) return false;
+    }
+    return true;
+  }
+
+  bool operator!=(const footprint& other) const { return !(*this == other); }
+
+ private:
+  std::size_t bytes_[NUM_CATEGORIES];
+};
+
+/// \struct point_footprint.
+/// \brief Heap bytes owned by a point, i.e. not counting sizeof(Point). The default is for the types that do not
+/// allocate, e.g. the fixed size Eigen matrices and the quaternions.
+template <typename Point>
+struct point_footprint {
+  static void add(footprint& /*res*/, const footprint::category /*c*/, const Point& /*point*/) {}
+};
+
+template <typename Scalar, int Rows, int Cols, int Options, int MaxRows, int MaxCols>
+struct point_footprint<Eigen::Matrix<Scalar, Rows, Cols, Options, MaxRows, MaxCols> > {
+  /// \brief Add the coefficients of a dynamic size matrix to category c.
+  static void add(footprint& res, const footprint::category c,
+                  const Eigen::Matrix<Scalar, Rows, Cols, Options, MaxRows, MaxCols>& point) {
+    if (Rows == Eigen::Dynamic || Cols == Eigen::Dynamic) {
+      res.add(c, std::size_t(point.size()) * sizeof(Scalar));
+    }
+  }
+};
+
+/// \brief Add the memory of a vector of points to category c: its capacity and the heap bytes of each point.
+template <typename Point, typename Allocator>
+void add_points_footprint(footprint& res, const footprint::category c, const std::vector<Point, Allocator>& points) {
+  res.add(c, points.capacity() * sizeof(Point));
+  for (typename std::vector<Point, Allocator>::const_iterator cit = points.begin(); cit != points.end(); ++cit) {
+    point_footprint<Point>::add(res, c, *cit);
+  }
+}
+
+/// \brief Add the memory of a vector of objects providing memory_footprint(): the unused capacity in OBJECTS and
+/// the footprint of each object.
+template <typename T, typename Allocator>
+void add_objects_footprint(footprint& res, const std::vector<T, Allocator>& objects) {
+  res.add(footprint::OBJECTS, (objects.capacity() - objects.size()) * sizeof(T));
+  for (typename std::vector<T, Allocator>::const_iterator cit = objects.begin(); cit != objects.end(); ++cit) {
+    res += cit->memory_footprint();
+  }
+}
+
+/// \brief Add the memory of an object owned by a shared pointer: its control block and its footprint.
+/// An object shared by several pointers is counted for each of them.
+template <typename T>
+void add_shared_footprint(footprint& res, const boost::shared_ptr<T>& ptr) {
+  if (ptr) {
+    res.add(footprint::CONTROL_BLOCKS, footprint::shared_control_block_size);
+    res += ptr->memory_footprint();
+  }
+}
+}  // namespace ndcurves
+#endif  //_CLASS_MEMORY_FOOTPRINT
@@ -0,0 +1,232 @@
+/**
+ * \file minimum_derivative_spline.h
+ * \brief Piecewise polynomial minimizing the integral of the squared jerk or snap through timed waypoints.
+ *
+ * Given a set of waypoints (x_i*) and times (t_i), the curve minimizing
+ * \f$\int ||x^{(k)}(t)||^2 dt\f$ under the constraints x(t_i) = x_i* and fixed boundary derivatives up to the order
+ * k-1 is made of polynomials of degree 2k-1 with continuous derivatives up to the order 2k-2 at each waypoint.
+ * k = 3 gives the minimum jerk curve (quintic polynomials) and k = 4 the minimum snap curve (polynomials of degree 7).
+ */
+
+#ifndef _CLASS_MINIMUM_DERIVATIVE_SPLINE
+#define _CLASS_MINIMUM_DERIVATIVE_SPLINE
+
+#include "MathDefs.h"
+#include "curve_abc.h"
+#include "curve_constraint.h"
+#include "piecewise_curve.h"
+#include "polynomial.h"
+
+#include <Eigen/LU>
+#include <stdexcept>
+#include <vector>
+
+namespace ndcurves {
+/// \class minimum_derivative_spline.
+/// \brief Build piecewise polynomials through timed waypoints minimizing the integral of the squared derivative of
+/// order k.
+/// Each segment is written in Hermite form: it is fully defined by the derivatives of order 0 to k-1 at its two
+/// waypoints. The unknowns are the derivatives of order 1 to k-1 at the interior waypoints, they are given by the
+/// continuity of the derivatives of order k to 2k-2. Each continuity condition only involves three consecutive
+/// waypoints, the system is block tridiagonal with blocks of size k-1 and is solved in O(N) with a block Thomas
+/// algorithm.
+///
+template <typename Time = double, typename Numeric = Time, bool Safe = false,
+          typename Point = Eigen::Matrix<Numeric, Eigen::Dynamic, 1>,
+          typename T_Point = std::vector<Point, Eigen::aligned_allocator<Point> > >
+struct minimum_derivative_spline {
+  typedef Point point_t;
+  typedef T_Point t_point_t;
+  typedef Time time_t;
+  typedef Numeric num_t;
+  typedef std::vector<Time> t_time_t;
+  typedef Eigen::Matrix<Numeric, Eigen::Dynamic, Eigen::Dynamic> MatrixX;
+  typedef Eigen::Matrix<Numeric, 1, Eigen::Dynamic> RowVectorX;
+  typedef curve_abc<Time, Numeric, Safe, Point> curve_abc_t;
+  typedef polynomial<Time, Numeric, Safe, Point, T_Point> polynomial_t;
+  typedef piecewise_curve<Time, Numeric, Safe, Point, Point, curve_abc_t> piecewise_curve_t;
+  typedef curve_constraints<Point> curve_constraints_t;
+
+  /// \brief Minimum jerk curve through the waypoints, starting and ending at rest.
+  /// \param points : the waypoints.
+  /// \param times  : the time of each waypoint, strictly increasing.
+  /// \return a piecewise curve made of polynomials of degree 5, continuous up to the fourth derivative.
+  ///
+  static piecewise_curve_t minimum_jerk(const t_point_t& points, const t_time_t& times) {
+    return minimum_jerk(points, times, curve_constraints_t(dimension(points)));
+  }
+
+  /// \brief Minimum jerk curve through the waypoints.
+  /// \param points      : the waypoints.
+  /// \param times       : the time of each waypoint, strictly increasing.
+  /// \param constraints : initial and final velocities and accelerations.
+  /// \return a piecewise curve made of polynomials of degree 5, continuous up to the fourth derivative.
+  ///
+  static piecewise_curve_t minimum_jerk(const t_point_t& points, const t_time_t& times,
+                                        const curve_constraints_t& constraints) {
+    return minimum_derivative(3, points, times, constraints);
+  }
+
+  /// \brief Minimum snap curve through the waypoints, starting and ending at rest.
+  /// \param points : the waypoints.
+  /// \param times  : the time of each waypoint, strictly increasing.
+  /// \return a piecewise curve made of polynomials of degree 7, continuous up to the sixth derivative.
+  ///
+  static piecewise_curve_t minimum_snap(const t_point_t& points, const t_time_t& times) {
+    return minimum_snap(points, times, curve_constraints_t(dimension(points)));
+  }
+
+  /// \brief Minimum snap curve through the waypoints.
+  /// \param points      : the waypoints.
+  /// \param times       : the time of each waypoint, strictly increasing.
+  /// \param constraints : initial and final velocities, accelerations and jerks.
+  /// \return a piecewise curve made of polynomials of degree 7, continuous up to the sixth derivative.
+  ///
+  static piecewise_curve_t minimum_snap(const t_point_t& points, const t_time_t& times,
+                                        const curve_constraints_t& constraints) {
+    return minimum_derivative(4, points, times, constraints);
+  }
+
+  /// \brief Curve through the waypoints minimizing the integral of the squared derivative of order k.
+  /// \param k           : order of the minimized derivative, between 2 (acceleration) and 4 (snap).
+  /// \param points      : the waypoints.
+  /// \param times       : the time of each waypoint, strictly increasing.
+  /// \param constraints : initial and final derivatives, up to the order k-1.
+  /// \return a piecewise curve made of polynomials of degree 2k-1, continuous up to the derivative of order 2k-2.
+  ///
+  static piecewise_curve_t minimum_derivative(const std::size_t k, const t_point_t& points, const t_time_t& times,
+                                              const curve_constraints_t& constraints) {
+    if (k < 2 || k > 4) {
+      throw std::invalid_argument("minimum_derivative_spline: the order k should be between 2 and 4.");
+    }
+    if (points.size() < 2) {
+      throw std::invalid_argument("minimum_derivative_spline: at least 2 waypoints are required.");
+    }
+    if (points.size() != times.size()) {
+      throw std::invalid_argument("minimum_derivative_spline: points and times must have the same size.");
+    }
+    const std::size_t dim = dimension(points);
+    if (constraints.dim_ != dim) {
+      throw std::invalid_argument("minimum_derivative_spline: the constraints should have the dimension of points.");
+    }
+    for (std::size_t i = 1; i < points.size(); ++i) {
+      if (std::size_t(points[i].size()) != dim) {
+        throw std::invalid_argument("minimum_derivative_spline: all the points must have the same dimension.");
+      }
+      if (!(times[i] > times[i - 1])) {
+        throw std::invalid_argument("minimum_derivative_spline: times must be strictly increasing.");
+      }
+    }
+    const std::size_t num_segments = points.size() - 1;
+    const Eigen::Index m = Eigen::Index(k - 1);  // number of unknown derivatives at each waypoint
+    // Hermite matrices of each segment: coefficients = hermite * [derivatives at start; derivatives at end]
+    std::vector<MatrixX> hermite(num_segments);
+    for (std::size_t j = 0; j < num_segments; ++j) {
+      hermite[j] = hermite_matrix(k, num_t(times[j + 1] - times[j]));
+    }
+    // derivatives of order 1 to k-1 at each waypoint, one row per order and one column per dimension.
+    std::vector<MatrixX> derivatives(points.size(), MatrixX::Zero(m, dim));
+    const point_t* init[3] = {&constraints.init_vel, &constraints.init_acc, &constraints.init_jerk};
+    const point_t* end[3] = {&constraints.end_vel, &constraints.end_acc, &constraints.end_jerk};
+    for (Eigen::Index r = 0; r < m; ++r) {
+      derivatives.front().row(r) = init[r]->transpose();
+      derivatives.back().row(r) = end[r]->transpose();
+    }
+    if (num_segments > 1) {
+      solve_interior_derivatives(k, points, times, hermite, derivatives);
+    }
+    piecewise_curve_t res;
+    MatrixX boundary(2 * k, dim);
+    for (std::size_t j = 0; j < num_segments; ++j) {
+      boundary.row(0) = points[j].transpose();
+      boundary.block(1, 0, m, dim) = derivatives[j];
+      boundary.row(k) = points[j + 1].transpose();
+      boundary.block(k + 1, 0, m, dim) = derivatives[j + 1];
+      res.add_curve(polynomial_t(typename polynomial_t::coeff_t((hermite[j] * boundary).transpose()), times[j],
+                                 times[j + 1]));
+    }
+    return res;
+  }
+
+ private:
+  static std::size_t dimension(const t_point_t& points) {
+    if (points.empty()) {
+      throw std::invalid_argument("minimum_derivative_spline: at least 2 waypoints are required.");
+    }
+    return points.front().size();
+  }
+
+  /// \brief Row vector giving the derivative of order r at s of a polynomial of degree 2k-1 written
+  /// \f$\sum c_q s^q\f$ from its coefficients.
+  static RowVectorX derivative_row(const std::size_t k, const std::size_t r, const num_t s) {
+    RowVectorX row = RowVectorX::Zero(2 * k);
+    for (std::size_t q = r; q < 2 * k; ++q) {
+      num_t factor = 1;
+      for (std::size_t i = q - r + 1; i <= q; ++i) factor *= num_t(i);
+      row[q] = factor * std::pow(s, num_t(q - r));
+    }
+    return row;
+  }
+
+  /// \brief Inverse of the matrix mapping the coefficients of a polynomial of degree 2k-1 defined on [0, T]
+  /// to its derivatives of order 0 to k-1 at 0 and at T.
+  static MatrixX hermite_matrix(const std::size_t k, const num_t T) {
+    MatrixX m(2 * k, 2 * k);
+    for (std::size_t r = 0; r < k; ++r) {
+      m.row(r) = derivative_row(k, r, 0);
+      m.row(k + r) = derivative_row(k, r, T);
+    }
+    return m.fullPivLu().inverse();
+  }
+
+  /// \brief Solve the block tridiagonal system given by the continuity of the derivatives of order k to 2k-2 at
+  /// the interior waypoints. The derivatives at the first and last waypoints are known and are not modified.
+  static void solve_interior_derivatives(const std::size_t k, const t_point_t& points, const t_time_t& times,
+                                         const std::vector<MatrixX>& hermite, std::vector<MatrixX>& derivatives) {
+    typedef Eigen::PartialPivLU<MatrixX> lu_t;
+    const std::size_t num_segments = hermite.size();
+    const Eigen::Index m = Eigen::Index(k - 1);
+    MatrixX rows_start(m, 2 * k), rows_end(m, 2 * k);
+    for (Eigen::Index r = 0; r < m; ++r) {
+      rows_start.row(r) = derivative_row(k, k + r, 0);
+    }
+    // Forward elimination. At the interior waypoint i, the continuity between the segments i-1 and i writes
+    // lower * z_{i-1} + diag * z_i + upper * z_{i+1} = rhs, where z_i are the unknown derivatives at waypoint i.
+    std::vector<lu_t> diag_lu(num_segments);
+    std::vector<MatrixX> upper(num_segments), rhs(num_segments);
+    MatrixX end_prev, start_next;  // continuity rows of the segments i-1 and i
+    for (std::size_t i = 1; i < num_segments; ++i) {
+      for (Eigen::Index r = 0; r < m; ++r) {
+        rows_end.row(r) = derivative_row(k, k + r, num_t(times[i] - times[i - 1]));
+      }
+      end_prev.noalias() = rows_end * hermite[i - 1];
+      start_next.noalias() = rows_start * hermite[i];
+      const MatrixX lower = end_prev.block(0, 1, m, m);
+      MatrixX diag = end_prev.block(0, k + 1, m, m) - start_next.block(0, 1, m, m);
+      upper[i] = -start_next.block(0, k + 1, m, m);
+      rhs[i] = -end_prev.col(0) * points[i - 1].transpose() -
+               (end_prev.col(k) - start_next.col(0)) * points[i].transpose() +
+               start_next.col(k) * points[i + 1].transpose();
+      if (i == 1) {
+        rhs[i] -= lower * derivatives.front();
+      } else {
+        diag -= lower * diag_lu[i - 1].solve(upper[i - 1]);
+        rhs[i] -= lower * diag_lu[i - 1].solve(rhs[i - 1]);
+      }
+      if (i + 1 == num_segments) {
+        rhs[i] -= upper[i] * derivatives.back();
+      }
+      diag_lu[i].compute(diag);
+    }
+    // Back substitution.
+    for (std::size_t i = num_segments - 1; i > 0; --i) {
+      if (i + 1 == num_segments) {
+        derivatives[i] = diag_lu[i].solve(rhs[i]);
+      } else {
+        derivatives[i] = diag_lu[i].solve(MatrixX(rhs[i] - upper[i] * derivatives[i + 1]));
+      }
+    }
+  }
+};
+}  // namespace ndcurves
+#endif  // _CLASS_MINIMUM_DERIVATIVE_SPLINE
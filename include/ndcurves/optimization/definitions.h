@@ -35,6 +35,15 @@ struct quadratic_problem {
   Eigen::Matrix<Numeric, Eigen::Dynamic, Eigen::Dynamic> ineqMatrix;
   Eigen::Matrix<Numeric, Eigen::Dynamic, 1> ineqVector;
   quadratic_variable<Numeric> cost;
+
+  /// \brief Get the memory used by the problem, by category. See footprint.
+  footprint memory_footprint() const {
+    footprint res = cost.memory_footprint();
+    res.add(footprint::OBJECTS, sizeof(*this) - sizeof(cost));
+    point_footprint<Eigen::Matrix<Numeric, Eigen::Dynamic, Eigen::Dynamic> >::add(res, footprint::OTHER, ineqMatrix);
+    point_footprint<Eigen::Matrix<Numeric, Eigen::Dynamic, 1> >::add(res, footprint::OTHER, ineqVector);
+    return res;
+  }
 };
 
 template <typename Point, typename Numeric>
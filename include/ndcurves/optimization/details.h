@@ -17,18 +17,24 @@
 
 namespace ndcurves {
 namespace optimization {
-template <typename Point, typename Numeric, bool Safe = true>
+/// \brief Variables of a problem_definition. The vectors of variables and of split curves are allocated with
+/// Allocator, e.g. an arena_allocator, the matrices of the linear variables are still allocated on the heap.
+template <typename Point, typename Numeric, bool Safe = true,
+          typename Allocator = std::allocator<linear_variable<Numeric> > >
 struct problem_data {
-  problem_data(const std::size_t dim) : bezier(0), dim_(dim) {}
+  problem_data(const std::size_t dim, const Allocator& alloc = Allocator())
+      : variables_(alloc), bezier(0), dim_(dim) {}
   ~problem_data() {
     if (bezier) delete bezier;
   }
 
   typedef linear_variable<Numeric> var_t;
-  typedef std::vector<var_t> T_var_t;
+  typedef std::vector<var_t, Allocator> T_var_t;
   typedef bezier_curve<Numeric, Numeric, true, linear_variable<Numeric> > bezier_t;
+  typedef std::vector<bezier_t, typename std::allocator_traits<Allocator>::template rebind_alloc<bezier_t> >
+      T_bezier_t;
 
-  std::vector<var_t> variables_;   // includes constant variables
+  T_var_t variables_;              // includes constant variables
   std::size_t numVariables;        // total number of variable (/ DIM for total size)
   std::size_t numControlPoints;    // total number of control Points (variables + waypoints) / DIM )
   std::size_t startVariableIndex;  // before that index, variables are constant
@@ -46,6 +52,15 @@ struct problem_data {
     const bezier_t& b = *other.bezier;
     bezier = new bezier_t(b.waypoints().begin(), b.waypoints().end(), b.T_min_, b.T_max_, b.mult_T_);
   }
+
+  /// \brief Get the memory used by the problem data and its bezier curve, by category. See footprint.
+  footprint memory_footprint() const {
+    footprint res;
+    res.add(footprint::OBJECTS, sizeof(*this));
+    add_points_footprint(res, footprint::LINEAR_VARIABLES, variables_);
+    if (bezier) res += bezier->memory_footprint();
+    return res;
+  }
 };
 
 inline std::size_t num_active_constraints(const constraint_flag& flag) {
@@ -69,24 +84,27 @@ LinearVar fill_with_zeros(const LinearVar& var, const std::size_t i, const std::
   return LinearVar(B, var.c());
 }
 
-template <typename Point, typename Numeric, typename Bezier, typename LinearVar>
-Bezier* compute_linear_control_points(const problem_data<Point, Numeric>& pData,
-                                      const std::vector<LinearVar>& linearVars, const Numeric totalTime) {
-  std::vector<LinearVar> res;
+template <typename Point, typename Numeric, typename Bezier, typename LinearVar, bool Safe, typename Allocator>
+Bezier* compute_linear_control_points(const problem_data<Point, Numeric, Safe, Allocator>& pData,
+                                      const std::vector<LinearVar, Allocator>& linearVars, const Numeric totalTime) {
+  std::vector<LinearVar, Allocator> res(linearVars.get_allocator());
   // now need to fill all this with zeros...
   std::size_t totalvar = linearVars.size();
+  res.reserve(totalvar);
   for (std::size_t i = 0; i < totalvar; ++i)
     res.push_back(fill_with_zeros<Numeric, LinearVar>(linearVars[i], i, pData.startVariableIndex, pData.numVariables,
                                                       pData.dim_));
   return new Bezier(res.begin(), res.end(), 0., totalTime);
 }
 
-template <typename Point, typename Numeric, bool Safe>
-problem_data<Point, Numeric, Safe> setup_control_points(const problem_definition<Point, Numeric>& pDef) {
+template <typename Point, typename Numeric, bool Safe,
+          typename Allocator = std::allocator<linear_variable<Numeric> > >
+problem_data<Point, Numeric, Safe, Allocator> setup_control_points(const problem_definition<Point, Numeric>& pDef,
+                                                                   const Allocator& alloc = Allocator()) {
   typedef Numeric num_t;
   typedef Point point_t;
   typedef linear_variable<Numeric> var_t;
-  typedef problem_data<Point, Numeric> problem_data_t;
+  typedef problem_data<Point, Numeric, Safe, Allocator> problem_data_t;
 
   const std::size_t& degree = pDef.degree;
   const constraint_flag& flag = pDef.flag;
@@ -96,8 +114,9 @@ problem_data<Point, Numeric, Safe> setup_control_points(const problem_definition
   if (numActiveConstraints >= numControlPoints)
     throw std::runtime_error("In setup_control_points; too many constraints for the considered degree");
 
-  problem_data_t problemData(pDef.dim_);
+  problem_data_t problemData(pDef.dim_, alloc);
   typename problem_data_t::T_var_t& variables_ = problemData.variables_;
+  variables_.reserve(numControlPoints);
 
   std::size_t numConstants = 0;
   std::size_t i = 0;
@@ -192,9 +211,9 @@ problem_data<Point, Numeric, Safe> setup_control_points(const problem_definition
 }
 
 // TODO assumes constant are inside constraints...
-template <typename Point, typename Numeric>
+template <typename Point, typename Numeric, bool Safe, typename Allocator>
 long compute_num_ineq_control_points(const problem_definition<Point, Numeric>& pDef,
-                                     const problem_data<Point, Numeric>& pData) {
+                                     const problem_data<Point, Numeric, Safe, Allocator>& pData) {
   typedef problem_definition<Point, Numeric> problem_definition_t;
   long rows(0);
   // rows depends on each constraint size, and the number of waypoints
@@ -204,38 +223,36 @@ long compute_num_ineq_control_points(const problem_definition<Point, Numeric>& p
   return rows;
 }
 
-template <typename Point, typename Numeric>
-std::vector<bezier_curve<Numeric, Numeric, true, linear_variable<Numeric> > > split(
-    const problem_definition<Point, Numeric>& pDef, problem_data<Point, Numeric>& pData) {
-  typedef linear_variable<Numeric> linear_variable_t;
-  typedef bezier_curve<Numeric, Numeric, true, linear_variable_t> bezier_t;
-  typedef std::vector<bezier_t> T_bezier_t;
+template <typename Point, typename Numeric, bool Safe, typename Allocator>
+typename problem_data<Point, Numeric, Safe, Allocator>::T_bezier_t split(
+    const problem_definition<Point, Numeric>& pDef, problem_data<Point, Numeric, Safe, Allocator>& pData) {
+  typedef typename problem_data<Point, Numeric, Safe, Allocator>::bezier_t bezier_t;
+  typedef typename problem_data<Point, Numeric, Safe, Allocator>::T_bezier_t T_bezier_t;
 
   const Eigen::VectorXd& times = pDef.splitTimes_;
-  T_bezier_t res;
+  T_bezier_t res(typename T_bezier_t::allocator_type(pData.variables_.get_allocator()));
+  res.reserve(times.rows() + 1);
   bezier_t& current = *pData.bezier;
-  Numeric current_time = 0.;
-  Numeric tmp;
   for (int i = 0; i < times.rows(); ++i) {
-    tmp = times[i];
-    std::pair<bezier_t, bezier_t> pairsplit = current.split(tmp - current_time);
+    // the split times are absolute, as the time interval of current:
+    std::pair<bezier_t, bezier_t> pairsplit = current.split(times[i]);
     res.push_back(pairsplit.first);
     current = pairsplit.second;
-    current_time += tmp - current_time;
   }
   res.push_back(current);
   return res;
 }
 
-template <typename Point, typename Numeric>
-void initInequalityMatrix(const problem_definition<Point, Numeric>& pDef, problem_data<Point, Numeric>& pData,
+template <typename Point, typename Numeric, bool Safe, typename Allocator>
+void initInequalityMatrix(const problem_definition<Point, Numeric>& pDef,
+                          problem_data<Point, Numeric, Safe, Allocator>& pData,
                           quadratic_problem<Point, Numeric>& prob) {
   const std::size_t& Dim = pData.dim_;
   typedef problem_definition<Point, Numeric> problem_definition_t;
   typedef typename problem_definition_t::matrix_x_t matrix_x_t;
   typedef typename problem_definition_t::vector_x_t vector_x_t;
-  typedef bezier_curve<Numeric, Numeric, true, linear_variable<Numeric> > bezier_t;
-  typedef std::vector<bezier_t> T_bezier_t;
+  typedef typename problem_data<Point, Numeric, Safe, Allocator>::bezier_t bezier_t;
+  typedef typename problem_data<Point, Numeric, Safe, Allocator>::T_bezier_t T_bezier_t;
   typedef typename T_bezier_t::const_iterator CIT_bezier_t;
   typedef typename bezier_t::t_point_t t_point;
   typedef typename bezier_t::t_point_t::const_iterator cit_point;
@@ -303,7 +320,7 @@ quadratic_variable<Numeric> bezier_product(In PointsBegin1, In PointsEnd1, In Po
       ratio = (Numeric)(bin(deg1, j) * bin(deg2, i - j)) / (Numeric)(bin(newDeg, i));
       In itj = PointsBegin1 + j;
       In iti = PointsBegin2 + (i - j);
-      res += ((*itj) * (*iti)) * ratio;
+      res += ((*itj) * ratio) * (*iti);
     }
   }
   return res / (newDeg + 1);
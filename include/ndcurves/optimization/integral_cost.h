@@ -26,8 +26,8 @@ enum integral_cost_flag {
   FIFTH = 0x005
 };
 
-template <typename Point, typename Numeric>
-quadratic_variable<Numeric> compute_integral_cost_internal(const problem_data<Point, Numeric>& pData,
+template <typename Point, typename Numeric, bool Safe, typename Allocator>
+quadratic_variable<Numeric> compute_integral_cost_internal(const problem_data<Point, Numeric, Safe, Allocator>& pData,
                                                            const std::size_t num_derivate) {
   typedef bezier_curve<Numeric, Numeric, true, linear_variable<Numeric> > bezier_t;
   typedef typename bezier_t::t_point_t t_point_t;
@@ -39,8 +39,8 @@ quadratic_variable<Numeric> compute_integral_cost_internal(const problem_data<Po
   return res;
 }
 
-template <typename Point, typename Numeric>
-quadratic_variable<Numeric> compute_integral_cost(const problem_data<Point, Numeric>& pData,
+template <typename Point, typename Numeric, bool Safe, typename Allocator>
+quadratic_variable<Numeric> compute_integral_cost(const problem_data<Point, Numeric, Safe, Allocator>& pData,
                                                   const integral_cost_flag flag) {
   std::size_t size = (std::size_t)(flag);
   return compute_integral_cost_internal<Point, Numeric>(pData, size);
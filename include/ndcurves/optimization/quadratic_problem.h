@@ -9,6 +9,7 @@
 #ifndef _CLASS_LINEAR_PROBLEM
 #define _CLASS_LINEAR_PROBLEM
 
+#include "ndcurves/instrumentation.h"
 #include "ndcurves/optimization/definitions.h"
 #include "ndcurves/optimization/details.h"
 #include "ndcurves/optimization/integral_cost.h"
@@ -18,21 +19,25 @@
 namespace ndcurves {
 namespace optimization {
 
-template <typename Point, typename Numeric, bool Safe>
+template <typename Point, typename Numeric, bool Safe,
+          typename Allocator = std::allocator<linear_variable<Numeric> > >
 quadratic_problem<Point, Numeric> generate_problem(const problem_definition<Point, Numeric>& pDef,
-                                                   const quadratic_variable<Numeric>& cost) {
+                                                   const quadratic_variable<Numeric>& cost, const Allocator& alloc = Allocator()) {
+  CURVES_INSTRUMENT_SCOPE(GENERATE_PROBLEM, "generate_problem");
   quadratic_problem<Point, Numeric> prob;
-  problem_data<Point, Numeric> pData = setup_control_points<Point, Numeric, Safe>(pDef);
+  problem_data<Point, Numeric, Safe, Allocator> pData = setup_control_points<Point, Numeric, Safe>(pDef, alloc);
   initInequalityMatrix<Point, Numeric>(pDef, pData, prob);
   prob.cost = cost;
   return prob;
 }
 
-template <typename Point, typename Numeric, bool Safe>
+template <typename Point, typename Numeric, bool Safe,
+          typename Allocator = std::allocator<linear_variable<Numeric> > >
 quadratic_problem<Point, Numeric> generate_problem(const problem_definition<Point, Numeric>& pDef,
-                                                   const integral_cost_flag costFlag) {
+                                                   const integral_cost_flag costFlag, const Allocator& alloc = Allocator()) {
+  CURVES_INSTRUMENT_SCOPE(GENERATE_PROBLEM, "generate_problem");
   quadratic_problem<Point, Numeric> prob;
-  problem_data<Point, Numeric> pData = setup_control_points<Point, Numeric, Safe>(pDef);
+  problem_data<Point, Numeric, Safe, Allocator> pData = setup_control_points<Point, Numeric, Safe>(pDef, alloc);
   initInequalityMatrix<Point, Numeric>(pDef, pData, prob);
   prob.cost = compute_integral_cost<Point, Numeric>(pData, costFlag);
   return prob;
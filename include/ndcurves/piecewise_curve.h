@@ -10,12 +10,182 @@
 
 #include "curve_abc.h"
 #include "curve_conversion.h"
+#include <boost/smart_ptr/make_shared.hpp>
 #include <boost/smart_ptr/shared_ptr.hpp>
 #include <boost/serialization/vector.hpp>
+#include <boost/type_traits/conditional.hpp>
+#include <boost/type_traits/declval.hpp>
+#include <boost/type_traits/is_abstract.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/remove_pointer.hpp>
 #include <fstream>
+#include <memory>
 #include <sstream>
 
 namespace ndcurves {
+/// \brief Storage policy of piecewise_curve where each segment is held by a shared pointer to CurveType.
+/// The segments can be of any type deriving from CurveType, and are shared with the caller of add_curve_ptr.
+struct piecewise_storage_shared {};
+
+/// \brief Storage policy of piecewise_curve where the segments are copied by value in a contiguous vector.
+/// CurveType must be a concrete curve type: all the segments are of this exact type. Evaluating the curve does not
+/// dereference any pointer, and copying the piecewise curve copies its segments.
+struct piecewise_storage_value {};
+
+/// \brief Allocator rebound to T. The default std::allocator is replaced by Eigen::aligned_allocator, as the segments
+/// stored by value may hold Eigen fixed size types.
+template <typename Allocator, typename T>
+struct piecewise_aligned_allocator {
+  typedef typename std::allocator_traits<Allocator>::template rebind_alloc<T> type;
+  static type make(const Allocator& alloc) { return type(alloc); }
+};
+
+template <typename U, typename T>
+struct piecewise_aligned_allocator<std::allocator<U>, T> {
+  typedef Eigen::aligned_allocator<T> type;
+  static type make(const std::allocator<U>& /*alloc*/) { return type(); }
+};
+
+/// \brief Container of the segments of a piecewise_curve for a given storage policy, allocated with Allocator
+/// rebound to the type of the elements.
+template <typename Storage, typename CurveType, typename Allocator>
+struct piecewise_storage;
+
+template <typename CurveType, typename Allocator>
+struct piecewise_storage<piecewise_storage_shared, CurveType, Allocator> {
+  typedef boost::shared_ptr<CurveType> curve_ptr_t;
+  typedef std::vector<curve_ptr_t, typename std::allocator_traits<Allocator>::template rebind_alloc<curve_ptr_t> >
+      container_t;
+  // the derivatives are stored as their abstract class:
+  typedef typename CurveType::curve_derivate_t curve_derivate_t;
+  typedef piecewise_storage_shared storage_derivate_t;
+
+  static container_t make_container(const Allocator& alloc) {
+    return container_t(typename container_t::allocator_type(alloc));
+  }
+  static const CurveType& at(const container_t& curves, const std::size_t idx) { return *curves[idx]; }
+  static curve_ptr_t ptr_at(const container_t& curves, const std::size_t idx) { return curves[idx]; }
+  static void push_back(container_t& curves, const curve_ptr_t& cf) { curves.push_back(cf); }
+  template <typename Curve>
+  static void push_back(container_t& curves, const Curve& curve) {
+    instrumentation::record_allocation(sizeof(Curve));
+    curves.push_back(boost::make_shared<Curve>(curve));
+  }
+  template <typename Curve, typename CurveAllocator>
+  static void push_back(container_t& curves, const Curve& curve, const CurveAllocator& alloc) {
+    curves.push_back(boost::allocate_shared<Curve>(alloc, curve));
+  }
+  /// \brief Add the memory of the pointers, of their control blocks and of the segments.
+  static void add_footprint(footprint& res, const container_t& curves) {
+    res.add(footprint::OBJECTS, curves.capacity() * sizeof(curve_ptr_t));
+    for (typename container_t::const_iterator cit = curves.begin(); cit != curves.end(); ++cit) {
+      add_shared_footprint(res, *cit);
+    }
+  }
+};
+
+template <typename CurveType, typename Allocator>
+struct piecewise_storage<piecewise_storage_value, CurveType, Allocator> {
+  BOOST_STATIC_ASSERT_MSG(!boost::is_abstract<CurveType>::value,
+                          "piecewise_storage_value requires a concrete curve type");
+  typedef boost::shared_ptr<CurveType> curve_ptr_t;
+  typedef piecewise_aligned_allocator<Allocator, CurveType> allocator_t;
+  typedef std::vector<CurveType, typename allocator_t::type> container_t;
+  // the derivatives are stored by value if CurveType::compute_derivate_ptr returns a concrete type:
+  typedef typename boost::remove_pointer<decltype(
+      boost::declval<const CurveType&>().compute_derivate_ptr(std::size_t(1)))>::type curve_derivate_t;
+  typedef typename boost::conditional<boost::is_abstract<curve_derivate_t>::value, piecewise_storage_shared,
+                                      piecewise_storage_value>::type storage_derivate_t;
+
+  static container_t make_container(const Allocator& alloc) { return container_t(allocator_t::make(alloc)); }
+  static const CurveType& at(const container_t& curves, const std::size_t idx) { return curves[idx]; }
+  /// \brief Return a copy of the segment, modifying it does not modify the piecewise curve.
+  static curve_ptr_t ptr_at(const container_t& curves, const std::size_t idx) {
+    return boost::make_shared<CurveType>(curves[idx]);
+  }
+  static void push_back(container_t& curves, const curve_ptr_t& cf) { curves.push_back(*cf); }
+  template <typename Curve>
+  static void push_back(container_t& curves, const Curve& curve) {
+    curves.push_back(curve);
+  }
+  template <typename Curve, typename CurveAllocator>
+  static void push_back(container_t& curves, const Curve& curve, const CurveAllocator& /*alloc*/) {
+    curves.push_back(curve);
+  }
+  /// \brief Add the memory of the segments and of the unused capacity.
+  static void add_footprint(footprint& res, const container_t& curves) { add_objects_footprint(res, curves); }
+};
+
+/// \brief Get the index of the segment of a piecewise curve corresponding to time t, by binary search.
+/// \param time_curves : bounds of the segments, num_curves + 1 increasing times.
+/// \param num_curves : number of segments, must not be 0.
+/// \param t : time where to look for the segment.
+/// \return Index of the segment for time t, the first or the last one if t is out of the bounds.
+///
+template <typename TimeVector, typename Time>
+std::size_t find_segment_index(const TimeVector& time_curves, const std::size_t num_curves, const Time t) noexcept {
+  // time before first control point time.
+  if (t < time_curves[0]) {
+    return 0;
+  }
+  // time is after last control point time
+  if (t > time_curves[num_curves - 1]) {
+    return num_curves - 1;
+  }
+
+  std::size_t left_id = 0;
+  std::size_t right_id = num_curves - 1;
+  while (left_id <= right_id) {
+    const std::size_t middle_id = left_id + (right_id - left_id) / 2;
+    if (time_curves[middle_id] < t) {
+      left_id = middle_id + 1;
+    } else if (time_curves[middle_id] > t) {
+      right_id = middle_id - 1;
+    } else {
+      return middle_id;
+    }
+  }
+  return left_id - 1;
+}
+
+/// \brief Check that a segment can be appended to a piecewise curve: it must start at t_max, the end of the
+/// num_curves segments already added, and have their dimension dim. dim is set by the first segment.
+/// \param name : name of the piecewise curve type, for the error messages.
+///
+template <typename Curve, typename Time>
+void check_segment_to_add(const Curve& cf, const std::size_t num_curves, const Time t_max, std::size_t& dim,
+                          const char* name) {
+  if (num_curves == 0) {  // first curve added
+    dim = cf.dim();
+  }
+  // Check time continuity : Beginning time of cf must be equal to the end of the piecewise curve.
+  if (num_curves != 0 && !(fabs(cf.min() - t_max) < MARGIN)) {
+    std::stringstream ss;
+    ss << "Can not add new curve to " << name << " : time discontinuity between T_max_ and curve.min(). Current "
+       << "T_max is " << t_max << " new curve min is " << cf.min();
+    throw std::invalid_argument(ss.str().c_str());
+  }
+  if (cf.dim() != dim) {
+    std::stringstream ss;
+    ss << "All the curves in a " << name << " should have the same dimension. Current dim is " << dim
+       << " dim of the new curve is " << cf.dim();
+    throw std::invalid_argument(ss.str().c_str());
+  }
+}
+
+/// \brief Update the bounds of a piecewise curve after the segment cf was appended.
+///
+template <typename Curve, typename TimeVector, typename Time>
+void append_segment_times(const Curve& cf, TimeVector& time_curves, Time& t_min, Time& t_max) {
+  if (time_curves.empty()) {
+    // First curve added
+    time_curves.push_back(cf.min());
+    t_min = cf.min();
+  }
+  t_max = cf.max();
+  time_curves.push_back(t_max);
+}
+
 /// \class PiecewiseCurve.
 /// \brief Represent a piecewise curve. We can add some new curve,
 ///        but the starting time of the curve to add should be equal to the ending time of the actual
@@ -24,10 +194,15 @@ namespace ndcurves {
 ///        \f$[T0_{max},T1_{max}]\f$ and cf2 between \f$[T1_{max},T2_{max}]\f$.
 ///        On the piecewise polynomial curve, cf0 is located between \f$[T0_{min},T0_{max}[\f$,
 ///        cf1 between \f$[T0_{max},T1_{max}[\f$ and cf2 between \f$[T1_{max},T2_{max}]\f$.
+///        The segments are stored according to the Storage policy: piecewise_storage_shared (default) keeps a shared
+///        pointer per segment, piecewise_storage_value keeps concrete segments of type CurveType contiguously.
+///        The containers of the segments and of the times are allocated with Allocator, rebound to their elements.
 ///
 template <typename Time = double, typename Numeric = Time, bool Safe = false,
           typename Point = Eigen::Matrix<Numeric, Eigen::Dynamic, 1>, typename Point_derivate = Point,
-          typename CurveType = curve_abc<Time, Numeric, Safe, Point, Point_derivate> >
+          typename CurveType = curve_abc<Time, Numeric, Safe, Point, Point_derivate>,
+          typename Storage /* = piecewise_storage_shared, see fwd.h */,
+          typename Allocator /* = std::allocator<Time>, see fwd.h */>
 struct piecewise_curve : public curve_abc<Time, Numeric, Safe, Point, Point_derivate> {
   typedef Point point_t;
   typedef Point_derivate point_derivate_t;
@@ -39,17 +214,36 @@ struct piecewise_curve : public curve_abc<Time, Numeric, Safe, Point, Point_deri
   typedef CurveType curve_t;                                                       // contained curves base class
   typedef boost::shared_ptr<curve_t> curve_ptr_t;
   typedef typename std::vector<curve_ptr_t> t_curve_ptr_t;
+  typedef Storage storage_policy_t;
+  typedef Allocator allocator_t;
+  typedef piecewise_storage<Storage, CurveType, Allocator> storage_t;
+  typedef typename storage_t::container_t t_curve_storage_t;
   typedef typename std::vector<Time> t_time_t;
-  typedef piecewise_curve<Time, Numeric, Safe, Point, Point_derivate, CurveType> piecewise_curve_t;
-  typedef piecewise_curve<Time, Numeric, Safe, Point_derivate, Point_derivate,
-    typename CurveType::curve_derivate_t> piecewise_curve_derivate_t;
+  typedef std::vector<Time, typename std::allocator_traits<Allocator>::template rebind_alloc<Time> > t_time_storage_t;
+  typedef piecewise_curve<Time, Numeric, Safe, Point, Point_derivate, CurveType, Storage, Allocator>
+      piecewise_curve_t;
+  typedef piecewise_curve<Time, Numeric, Safe, Point_derivate, Point_derivate, typename storage_t::curve_derivate_t,
+                          typename storage_t::storage_derivate_t, Allocator>
+      piecewise_curve_derivate_t;
   typedef boost::shared_ptr<typename piecewise_curve_derivate_t::curve_t> curve_derivate_ptr_t;
+  typedef typename base_curve_t::point_out_t point_out_t;
+  typedef typename base_curve_t::point_derivate_out_t point_derivate_out_t;
 
  public:
   /// \brief Empty constructor. Add at least one curve to call other class functions.
   ///
   piecewise_curve() : dim_(0), size_(0), T_min_(0), T_max_(0) {}
 
+  /// \brief Empty constructor allocating the containers with alloc, e.g. an arena_allocator.
+  ///
+  explicit piecewise_curve(const Allocator& alloc)
+      : dim_(0),
+        curves_(storage_t::make_container(alloc)),
+        time_curves_(typename t_time_storage_t::allocator_type(alloc)),
+        size_(0),
+        T_min_(0),
+        T_max_(0) {}
+
   /// \brief Constructor.
   /// Initialize a piecewise curve by giving the first curve.
   /// \param cf   : a curve.
@@ -73,12 +267,13 @@ struct piecewise_curve : public curve_abc<Time, Numeric, Safe, Point, Point_deri
   virtual ~piecewise_curve() {}
 
   virtual point_t operator()(const Time t) const {
+    CURVES_INSTRUMENT_SCOPE(EVALUATE, this);
     check_if_not_empty();
     if (Safe & !(T_min_ <= t && t <= T_max_)) {
       // std::cout<<"[Min,Max]=["<<T_min_<<","<<T_max_<<"]"<<" t="<<t<<std::endl;
       throw std::out_of_range("can't evaluate piecewise curve, out of range");
     }
-    return (*curves_.at(find_interval(t)))(t);
+    return storage_t::at(curves_, find_interval(t))(t);
   }
 
   /**
@@ -93,7 +288,7 @@ struct piecewise_curve : public curve_abc<Time, Numeric, Safe, Point, Point_deri
                 const Numeric prec = Eigen::NumTraits<Numeric>::dummy_precision()) const {
     if (num_curves() != other.num_curves()) return false;
     for (size_t i = 0; i < num_curves(); ++i) {
-      if (!curve_at_index(i)->isApprox(other.curve_at_index(i).get(), prec)) return false;
+      if (!curve_ref_at_index(i).isApprox(&other.curve_ref_at_index(i), prec)) return false;
     }
     return true;
   }
@@ -117,11 +312,68 @@ struct piecewise_curve : public curve_abc<Time, Numeric, Safe, Point, Point_deri
   ///  \return \f$\frac{d^Np(t)}{dt^N}\f$ point corresponding on derivative spline of order N at time t.
   ///
   virtual point_derivate_t derivate(const Time t, const std::size_t order) const {
+    CURVES_INSTRUMENT_SCOPE(DERIVATE, this);
     check_if_not_empty();
     if (Safe & !(T_min_ <= t && t <= T_max_)) {
       throw std::invalid_argument("can't evaluate piecewise curve, out of range");
     }
-    return (*curves_.at(find_interval(t))).derivate(t, order);
+    return storage_t::at(curves_, find_interval(t)).derivate(t, order);
+  }
+
+  ///  \brief Evaluation of the curve at time t, written in out.
+  ///  Does not allocate if the curve of the interval does not allocate in its own evaluate_into.
+  ///  \param t : time when to evaluate the curve.
+  ///  \param out : \f$x(t)\f$ point corresponding on curve at time t.
+  ///
+  virtual void evaluate_into(const Time t, point_out_t out) const {
+    check_if_not_empty();
+    if (Safe & !(T_min_ <= t && t <= T_max_)) {
+      throw std::out_of_range("can't evaluate piecewise curve, out of range");
+    }
+    storage_t::at(curves_, find_interval(t)).evaluate_into(t, out);
+  }
+
+  ///  \brief Evaluate the derivative of order N of curve at time t, written in out.
+  ///  Does not allocate if the curve of the interval does not allocate in its own derivate_into.
+  ///  \param t : time when to evaluate the spline.
+  ///  \param order : order of derivative.
+  ///  \param out : \f$\frac{d^Np(t)}{dt^N}\f$ point corresponding on derivative spline of order N at time t.
+  ///
+  virtual void derivate_into(const Time t, const std::size_t order, point_derivate_out_t out) const {
+    check_if_not_empty();
+    if (Safe & !(T_min_ <= t && t <= T_max_)) {
+      throw std::invalid_argument("can't evaluate piecewise curve, out of range");
+    }
+    storage_t::at(curves_, find_interval(t)).derivate_into(t, order, out);
+  }
+
+  ///  \brief Real-time safe evaluation of the curve at time t, see curve_abc::evaluate_rt.
+  ///  Real-time safe if the curve of the interval implements evaluate_rt.
+  ///  \param t : time when to evaluate the curve, clamped in [Tmin, Tmax].
+  ///  \param out : \f$x(t)\f$ point corresponding on curve at time t.
+  ///  \return EVAL_OK or EVAL_CLAMPED if out was written, the reason of the failure otherwise.
+  ///
+  virtual eval_status evaluate_rt(const Time t, point_out_t out) const noexcept {
+    if (curves_.size() == 0) return EVAL_EMPTY;
+    Time tc(t);
+    const eval_status status = clamp_time(tc, T_min_, T_max_);
+    const eval_status status_curve = storage_t::at(curves_, find_interval(tc)).evaluate_rt(tc, out);
+    return eval_succeeded(status_curve) ? status : status_curve;
+  }
+
+  ///  \brief Real-time safe evaluation of the derivative of order N at time t, see curve_abc::derivate_rt.
+  ///  Real-time safe if the curve of the interval implements derivate_rt.
+  ///  \param t : time when to evaluate the spline, clamped in [Tmin, Tmax].
+  ///  \param order : order of derivative.
+  ///  \param out : \f$\frac{d^Np(t)}{dt^N}\f$ point corresponding on derivative spline of order N at time t.
+  ///  \return EVAL_OK or EVAL_CLAMPED if out was written, the reason of the failure otherwise.
+  ///
+  virtual eval_status derivate_rt(const Time t, const std::size_t order, point_derivate_out_t out) const noexcept {
+    if (curves_.size() == 0) return EVAL_EMPTY;
+    Time tc(t);
+    const eval_status status = clamp_time(tc, T_min_, T_max_);
+    const eval_status status_curve = storage_t::at(curves_, find_interval(tc)).derivate_rt(tc, order, out);
+    return eval_succeeded(status_curve) ? status : status_curve;
   }
 
   /**
@@ -130,53 +382,52 @@ struct piecewise_curve : public curve_abc<Time, Numeric, Safe, Point, Point_deri
    * @return
    */
   piecewise_curve_derivate_t* compute_derivate_ptr(const std::size_t order) const {
-    piecewise_curve_derivate_t* res(new piecewise_curve_derivate_t());
-    for (typename t_curve_ptr_t::const_iterator itc = curves_.begin(); itc < curves_.end(); ++itc) {
-      curve_derivate_ptr_t ptr((*itc)->compute_derivate_ptr(order));
+    CURVES_INSTRUMENT_SCOPE(COMPUTE_DERIVATE, this);
+    piecewise_curve_derivate_t* res(new piecewise_curve_derivate_t(get_allocator()));
+    for (std::size_t i = 0; i < size_; ++i) {
+      curve_derivate_ptr_t ptr(storage_t::at(curves_, i).compute_derivate_ptr(order));
       res->add_curve_ptr(ptr);
     }
     return res;
   }
 
+  ///  \brief Add a copy of a curve to piecewise curve, see add_curve_ptr.
+  ///  With piecewise_storage_value, Curve must be CurveType and no shared pointer is created.
+  ///  \param curve : curve to add.
+  ///
   template <typename Curve>
   void add_curve(const Curve& curve) {
-    curve_ptr_t curve_ptr = boost::make_shared<Curve>(curve);
-    add_curve_ptr(curve_ptr);
+    check_curve_to_add(curve);
+    storage_t::push_back(curves_, curve);
+    update_time_curves(curve);
+  }
+
+  ///  \brief Add a copy of a curve to piecewise curve, see add_curve_ptr.
+  ///  With piecewise_storage_shared, the copy and the counter of its shared pointer are allocated together with
+  ///  alloc (boost::allocate_shared), e.g. an arena_allocator. The containers owned by the copy, e.g. its control
+  ///  points, use the allocator of the curve copied, see bezier_curve. With piecewise_storage_value alloc is not
+  ///  used.
+  ///  \param curve : curve to add.
+  ///  \param alloc : allocator of the curve, rebound to the type of the shared pointer storage.
+  ///
+  template <typename Curve, typename CurveAllocator>
+  void add_curve(const Curve& curve, const CurveAllocator& alloc) {
+    check_curve_to_add(curve);
+    storage_t::push_back(curves_, curve, alloc);
+    update_time_curves(curve);
   }
 
   ///  \brief Add a new curve to piecewise curve, which should be defined in \f$[T_{min},T_{max}]\f$ where
   ///  \f$T_{min}\f$
   ///         is equal to \f$T_{max}\f$ of the actual piecewise curve. The curve added should be of type Curve as
   ///         defined in the template.
+  ///         With piecewise_storage_value, the curve pointed by cf is copied.
   ///  \param cf : curve to add.
   ///
   void add_curve_ptr(const curve_ptr_t& cf) {
-    if (size_ == 0) {  // first curve added
-      dim_ = cf->dim();
-    }
-    // Check time continuity : Beginning time of cf must be equal to T_max_ of actual piecewise curve.
-    if (size_ != 0 && !(fabs(cf->min() - T_max_) < MARGIN)) {
-      std::stringstream ss;
-      ss << "Can not add new Polynom to PiecewiseCurve : time discontinuity between T_max_ and pol.min(). Current "
-            "T_max is "
-         << T_max_ << " new curve min is " << cf->min();
-      throw std::invalid_argument(ss.str().c_str());
-    }
-    if (cf->dim() != dim_) {
-      std::stringstream ss;
-      ss << "All the curves in a piecewiseCurve should have the same dimension. Current dim is " << dim_
-         << " dim of the new curve is " << cf->dim();
-      throw std::invalid_argument(ss.str().c_str());
-    }
-    curves_.push_back(cf);
-    size_ = curves_.size();
-    T_max_ = cf->max();
-    if (size_ == 1) {
-      // First curve added
-      time_curves_.push_back(cf->min());
-      T_min_ = cf->min();
-    }
-    time_curves_.push_back(T_max_);
+    check_curve_to_add(*cf);
+    storage_t::push_back(curves_, cf);
+    update_time_curves(*cf);
   }
 
   ///  \brief Check if the curve is continuous of order given.
@@ -190,10 +441,10 @@ struct piecewise_curve : public curve_abc<Time, Numeric, Safe, Point, Point_deri
     if (order == 0) {
       point_t value_end, value_start;
       while (isContinuous && i < (size_ - 1)) {
-        curve_ptr_t current = curves_.at(i);
-        curve_ptr_t next = curves_.at(i + 1);
-        value_end = (*current)(current->max());
-        value_start = (*next)(next->min());
+        const curve_t& current = curve_ref_at_index(i);
+        const curve_t& next = curve_ref_at_index(i + 1);
+        value_end = current(current.max());
+        value_start = next(next.min());
         if (!value_end.isApprox(value_start, MARGIN)) {
           isContinuous = false;
         }
@@ -202,10 +453,10 @@ struct piecewise_curve : public curve_abc<Time, Numeric, Safe, Point, Point_deri
     } else {
       point_derivate_t value_end, value_start;
       while (isContinuous && i < (size_ - 1)) {
-        curve_ptr_t current = curves_.at(i);
-        curve_ptr_t next = curves_.at(i + 1);
-        value_end = current->derivate(current->max(), order);
-        value_start = next->derivate(next->min(), order);
+        const curve_t& current = curve_ref_at_index(i);
+        const curve_t& next = curve_ref_at_index(i + 1);
+        value_end = current.derivate(current.max(), order);
+        value_start = next.derivate(next.min(), order);
         if (!value_end.isApprox(value_start, MARGIN)) {
           isContinuous = false;
         }
@@ -223,18 +474,46 @@ struct piecewise_curve : public curve_abc<Time, Numeric, Safe, Point, Point_deri
   /// Example : A piecewise curve PC made of two curves : c1 for t in [0,1] and c2 for t in ]1,2].
   ///           PC.curve_at_time(0.5) will return c1.
   /// \param t : time to select curve.
-  /// \return Curve corresponding to time t in piecewise curve.
-  curve_ptr_t curve_at_time(const time_t t) const { return curves_[find_interval(t)]; }
+  /// \return Curve corresponding to time t in piecewise curve. With piecewise_storage_value, a copy of the curve.
+  curve_ptr_t curve_at_time(const time_t t) const { return storage_t::ptr_at(curves_, find_interval(t)); }
+
+  /// \brief Get the index of the curve corresponding to time t, starting the search from the index of a previous
+  /// query. When called with increasing times, the cursor only moves forward and the lookup is amortized O(1).
+  /// \param t : time to select curve.
+  /// \param cursor : index returned by a previous call for a time lower or equal to t.
+  /// \return Index of the curve corresponding to time t in piecewise curve.
+  std::size_t find_interval_from(const time_t t, const std::size_t cursor) const {
+    check_if_not_empty();
+    if (cursor >= size_ || t < time_curves_[cursor]) {
+      return find_interval(t);
+    }
+    std::size_t id = cursor;
+    while (id + 1 < size_ && time_curves_[id + 1] <= t) {
+      ++id;
+    }
+    return id;
+  }
 
   /// \brief Get curve at specified index in piecewise curve.
   /// \param idx : Index of curve to return, from 0 to num_curves-1.
-  /// \return curve corresonding to index in piecewise curve.
+  /// \return curve corresonding to index in piecewise curve. With piecewise_storage_value, a copy of the curve.
   curve_ptr_t curve_at_index(const std::size_t idx) const {
     if (Safe && idx >= num_curves()) {
       throw std::length_error(
           "curve_at_index: requested index greater than number of curves in piecewise_curve instance");
     }
-    return curves_[idx];
+    return storage_t::ptr_at(curves_, idx);
+  }
+
+  /// \brief Get a reference to the curve at specified index in piecewise curve, without copy for any storage policy.
+  /// \param idx : Index of curve to return, from 0 to num_curves-1.
+  /// \return curve corresonding to index in piecewise curve, valid until a curve is added.
+  const curve_t& curve_ref_at_index(const std::size_t idx) const {
+    if (Safe && idx >= num_curves()) {
+      throw std::length_error(
+          "curve_ref_at_index: requested index greater than number of curves in piecewise_curve instance");
+    }
+    return storage_t::at(curves_, idx);
   }
 
   /// \brief Convert all curves in piecewise curve into bezier curves.
@@ -247,10 +526,10 @@ struct piecewise_curve : public curve_abc<Time, Numeric, Safe, Point, Point_deri
     BOOST_STATIC_ASSERT(boost::is_same<typename Bezier::point_t, point_t>::value);
     BOOST_STATIC_ASSERT(boost::is_same<typename Bezier::point_derivate_t, point_derivate_t>::value);
     // Create piecewise curve
-    piecewise_curve_t pc_res;
+    piecewise_curve_t pc_res(get_allocator());
     // Convert and add all other curves (segments)
     for (std::size_t i = 0; i < size_; i++) {
-      pc_res.add_curve(bezier_from_curve<Bezier>(*curves_.at(i)));
+      pc_res.add_curve(bezier_from_curve<Bezier>(storage_t::at(curves_, i)));
     }
     return pc_res;
   }
@@ -266,10 +545,10 @@ struct piecewise_curve : public curve_abc<Time, Numeric, Safe, Point, Point_deri
     BOOST_STATIC_ASSERT(boost::is_same<typename Hermite::point_t, point_t>::value);
     BOOST_STATIC_ASSERT(boost::is_same<typename Hermite::point_derivate_t, point_derivate_t>::value);
     // Create piecewise curve
-    piecewise_curve_t pc_res;
+    piecewise_curve_t pc_res(get_allocator());
     // Convert and add all other curves (segments)
     for (std::size_t i = 0; i < size_; i++) {
-      pc_res.add_curve(hermite_from_curve<Hermite>(*curves_.at(i)));
+      pc_res.add_curve(hermite_from_curve<Hermite>(storage_t::at(curves_, i)));
     }
     return pc_res;
   }
@@ -284,10 +563,10 @@ struct piecewise_curve : public curve_abc<Time, Numeric, Safe, Point, Point_deri
     BOOST_STATIC_ASSERT(boost::is_same<typename Polynomial::point_t, point_t>::value);
     BOOST_STATIC_ASSERT(boost::is_same<typename Polynomial::point_derivate_t, point_derivate_t>::value);
     // Create piecewise curve
-    piecewise_curve_t pc_res;
+    piecewise_curve_t pc_res(get_allocator());
     // Convert and add all other curves (segments)
     for (std::size_t i = 0; i < size_; i++) {
-      pc_res.add_curve(polynomial_from_curve<Polynomial>(*curves_.at(i)));
+      pc_res.add_curve(polynomial_from_curve<Polynomial>(storage_t::at(curves_, i)));
     }
     return pc_res;
   }
@@ -526,29 +805,18 @@ struct piecewise_curve : public curve_abc<Time, Numeric, Safe, Point, Point_deri
   /// \param t : time where to look for interval.
   /// \return Index of interval for time t.
   ///
-  std::size_t find_interval(const Numeric t) const {
-    // time before first control point time.
-    if (t < time_curves_[0]) {
-      return 0;
-    }
-    // time is after last control point time
-    if (t > time_curves_[size_ - 1]) {
-      return size_ - 1;
-    }
-
-    std::size_t left_id = 0;
-    std::size_t right_id = size_ - 1;
-    while (left_id <= right_id) {
-      const std::size_t middle_id = left_id + (right_id - left_id) / 2;
-      if (time_curves_.at(middle_id) < t) {
-        left_id = middle_id + 1;
-      } else if (time_curves_.at(middle_id) > t) {
-        right_id = middle_id - 1;
-      } else {
-        return middle_id;
-      }
-    }
-    return left_id - 1;
+  std::size_t find_interval(const Numeric t) const noexcept {
+    CURVES_INSTRUMENT_SCOPE(FIND_INTERVAL, this);
+    return find_segment_index(time_curves_, size_, t);
+  }
+
+  /// \brief Check that a curve can be appended: it must start at T_max_ and have the dimension of the curve.
+  void check_curve_to_add(const curve_t& cf) { check_segment_to_add(cf, size_, T_max_, dim_, "piecewise_curve"); }
+
+  /// \brief Update the time bounds after cf was appended to curves_.
+  void update_time_curves(const curve_t& cf) {
+    size_ = curves_.size();
+    append_segment_times(cf, time_curves_, T_min_, T_max_);
   }
 
   void check_if_not_empty() const {
@@ -573,13 +841,23 @@ struct piecewise_curve : public curve_abc<Time, Numeric, Safe, Point, Point_deri
   virtual std::size_t degree() const {
     throw std::runtime_error("degree() method is not implemented for this type of curve.");
   }
+  /// \brief Get the memory used by the curve, by category. See footprint.
+  virtual footprint memory_footprint() const {
+    footprint res;
+    res.add(footprint::OBJECTS, sizeof(*this));
+    storage_t::add_footprint(res, curves_);
+    add_points_footprint(res, footprint::TIMES, time_curves_);
+    return res;
+  }
   std::size_t getNumberCurves() { return curves_.size(); }
+  /// \brief Get the allocator of the containers.
+  allocator_t get_allocator() const { return allocator_t(time_curves_.get_allocator()); }
   /*Helpers*/
 
   /* Attributes */
   std::size_t dim_;       // Dim of curve
-  t_curve_ptr_t curves_;  // for curves 0/1/2 : [ curve0, curve1, curve2 ]
-  t_time_t time_curves_;  // for curves 0/1/2 : [ Tmin0, Tmax0,Tmax1,Tmax2 ]
+  t_curve_storage_t curves_;  // for curves 0/1/2 : [ curve0, curve1, curve2 ]
+  t_time_storage_t time_curves_;  // for curves 0/1/2 : [ Tmin0, Tmax0,Tmax1,Tmax2 ]
   std::size_t size_;      // Number of segments in piecewise curve = size of curves_
   Time T_min_, T_max_;
   /* Attributes */
@@ -604,7 +882,9 @@ struct piecewise_curve : public curve_abc<Time, Numeric, Safe, Point, Point_deri
 }  // namespace ndcurves
 
 DEFINE_CLASS_TEMPLATE_VERSION(SINGLE_ARG(typename Time, typename Numeric, bool Safe, typename Point,
-                                         typename Point_derivate, typename CurveType),
-                              SINGLE_ARG(ndcurves::piecewise_curve<Time, Numeric, Safe, Point, Point_derivate, CurveType>))
+                                         typename Point_derivate, typename CurveType, typename Storage,
+                                         typename Allocator),
+                              SINGLE_ARG(ndcurves::piecewise_curve<Time, Numeric, Safe, Point, Point_derivate, CurveType,
+                                                                   Storage, Allocator>))
 
 #endif  // _CLASS_PIECEWISE_CURVE
@@ -0,0 +1,464 @@
+/**
+ * \file piecewise_variant_curve.h
+ * \brief piecewise curve made of a closed set of curve types, stored inline without virtual dispatch.
+ */
+
+#ifndef _CLASS_PIECEWISE_VARIANT_CURVE
+#define _CLASS_PIECEWISE_VARIANT_CURVE
+
+#include "curve_abc.h"
+#include "bezier_curve.h"
+#include "constant_curve.h"
+#include "piecewise_curve.h"
+#include "polynomial.h"
+#include "sinusoidal.h"
+#include <boost/scoped_ptr.hpp>
+#include <boost/serialization/variant.hpp>
+#include <boost/serialization/vector.hpp>
+#include <boost/variant.hpp>
+#include <sstream>
+
+namespace ndcurves {
+/// \class piecewise_variant_curve.
+/// \brief Represent a piecewise curve whose segments are polynomial, bezier_curve, constant_curve or sinusoidal
+///        curves. Contrary to piecewise_curve, the segments are stored inline in a contiguous vector of
+///        boost::variant and are dispatched on the type tag of the variant: evaluating the curve does not
+///        dereference a pointer nor call a virtual method of the segment.
+///        The time intervals of the segments follow the same rules as piecewise_curve, and the curve can be
+///        converted from and to a piecewise_curve of the same point type.
+///
+template <typename Time = double, typename Numeric = Time, bool Safe = false,
+          typename Point = Eigen::Matrix<Numeric, Eigen::Dynamic, 1>,
+          typename T_Point = std::vector<Point, Eigen::aligned_allocator<Point> > >
+struct piecewise_variant_curve : public curve_abc<Time, Numeric, Safe, Point> {
+  typedef Point point_t;
+  typedef Point point_derivate_t;
+  typedef Time time_t;
+  typedef Numeric num_t;
+  typedef curve_abc<Time, Numeric, Safe, Point> curve_abc_t;  // parent class
+  typedef typename curve_abc_t::curve_ptr_t curve_ptr_t;
+  typedef typename curve_abc_t::point_out_t point_out_t;
+  typedef typename curve_abc_t::point_derivate_out_t point_derivate_out_t;
+  typedef piecewise_variant_curve<Time, Numeric, Safe, Point, T_Point> piecewise_variant_curve_t;
+  typedef piecewise_curve<Time, Numeric, Safe, Point, Point, curve_abc_t> piecewise_curve_t;
+  typedef typename std::vector<Time> t_time_t;
+  // types of the segments:
+  typedef polynomial<Time, Numeric, Safe, Point, T_Point> polynomial_t;
+  typedef bezier_curve<Time, Numeric, Safe, Point> bezier_t;
+  typedef constant_curve<Time, Numeric, Safe, Point, Point> constant_t;
+  typedef sinusoidal<Time, Numeric, Safe, Point> sinusoidal_t;
+  typedef boost::variant<polynomial_t, bezier_t, constant_t, sinusoidal_t> segment_t;
+  typedef std::vector<segment_t, Eigen::aligned_allocator<segment_t> > t_segment_t;
+
+  /// \brief Type of a segment, in the order of the types of segment_t.
+  enum segment_type { POLYNOMIAL = 0, BEZIER, CONSTANT, SINUSOIDAL };
+
+ public:
+  /// \brief Empty constructor. Add at least one curve to call other class functions.
+  ///
+  piecewise_variant_curve() : dim_(0), size_(0), T_min_(0), T_max_(0) {}
+
+  /// \brief Constructor from a piecewise_curve.
+  /// \param pc : piecewise curve whose segments are all of the types of segment_t.
+  ///
+  template <typename CurveType, typename Storage, typename Allocator>
+  explicit piecewise_variant_curve(
+      const piecewise_curve<Time, Numeric, Safe, Point, Point, CurveType, Storage, Allocator>& pc)
+      : dim_(0), size_(0), T_min_(0), T_max_(0) {
+    for (std::size_t i = 0; i < pc.num_curves(); ++i) {
+      add_curve_abc(pc.curve_ref_at_index(i));
+    }
+  }
+
+  virtual ~piecewise_variant_curve() {}
+
+  virtual point_t operator()(const Time t) const {
+    CURVES_INSTRUMENT_SCOPE(EVALUATE, this);
+    check_if_not_empty();
+    if (Safe & !(T_min_ <= t && t <= T_max_)) {
+      throw std::out_of_range("can't evaluate piecewise curve, out of range");
+    }
+    return boost::apply_visitor(evaluate_visitor(t), segments_[find_interval(t)]);
+  }
+
+  ///  \brief Evaluate the derivative of order N of curve at time t.
+  ///  \param t : time when to evaluate the spline.
+  ///  \param order : order of derivative.
+  ///  \return \f$\frac{d^Np(t)}{dt^N}\f$ point corresponding on derivative spline of order N at time t.
+  ///
+  virtual point_derivate_t derivate(const Time t, const std::size_t order) const {
+    CURVES_INSTRUMENT_SCOPE(DERIVATE, this);
+    check_if_not_empty();
+    if (Safe & !(T_min_ <= t && t <= T_max_)) {
+      throw std::invalid_argument("can't evaluate piecewise curve, out of range");
+    }
+    return boost::apply_visitor(derivate_visitor(t, order), segments_[find_interval(t)]);
+  }
+
+  ///  \brief Evaluation of the curve at time t, written in out.
+  ///  \param t : time when to evaluate the curve.
+  ///  \param out : \f$x(t)\f$ point corresponding on curve at time t.
+  ///
+  virtual void evaluate_into(const Time t, point_out_t out) const {
+    check_if_not_empty();
+    if (Safe & !(T_min_ <= t && t <= T_max_)) {
+      throw std::out_of_range("can't evaluate piecewise curve, out of range");
+    }
+    evaluate_into_visitor visitor(t, out);
+    boost::apply_visitor(visitor, segments_[find_interval(t)]);
+  }
+
+  ///  \brief Evaluate the derivative of order N of curve at time t, written in out.
+  ///  \param t : time when to evaluate the spline.
+  ///  \param order : order of derivative.
+  ///  \param out : \f$\frac{d^Np(t)}{dt^N}\f$ point corresponding on derivative spline of order N at time t.
+  ///
+  virtual void derivate_into(const Time t, const std::size_t order, point_derivate_out_t out) const {
+    check_if_not_empty();
+    if (Safe & !(T_min_ <= t && t <= T_max_)) {
+      throw std::invalid_argument("can't evaluate piecewise curve, out of range");
+    }
+    derivate_into_visitor visitor(t, order, out);
+    boost::apply_visitor(visitor, segments_[find_interval(t)]);
+  }
+
+  ///  \brief Real-time safe evaluation of the curve at time t, see curve_abc::evaluate_rt.
+  ///  \param t : time when to evaluate the curve, clamped in [Tmin, Tmax].
+  ///  \param out : \f$x(t)\f$ point corresponding on curve at time t.
+  ///  \return EVAL_OK or EVAL_CLAMPED if out was written, the reason of the failure otherwise.
+  ///
+  virtual eval_status evaluate_rt(const Time t, point_out_t out) const noexcept {
+    if (segments_.size() == 0) return EVAL_EMPTY;
+    Time tc(t);
+    const eval_status status = clamp_time(tc, T_min_, T_max_);
+    evaluate_rt_visitor visitor(tc, out);
+    const eval_status status_curve = boost::apply_visitor(visitor, segments_[find_interval(tc)]);
+    return eval_succeeded(status_curve) ? status : status_curve;
+  }
+
+  ///  \brief Real-time safe evaluation of the derivative of order N at time t, see curve_abc::derivate_rt.
+  ///  \param t : time when to evaluate the spline, clamped in [Tmin, Tmax].
+  ///  \param order : order of derivative.
+  ///  \param out : \f$\frac{d^Np(t)}{dt^N}\f$ point corresponding on derivative spline of order N at time t.
+  ///  \return EVAL_OK or EVAL_CLAMPED if out was written, the reason of the failure otherwise.
+  ///
+  virtual eval_status derivate_rt(const Time t, const std::size_t order, point_derivate_out_t out) const noexcept {
+    if (segments_.size() == 0) return EVAL_EMPTY;
+    Time tc(t);
+    const eval_status status = clamp_time(tc, T_min_, T_max_);
+    derivate_rt_visitor visitor(tc, order, out);
+    const eval_status status_curve = boost::apply_visitor(visitor, segments_[find_interval(tc)]);
+    return eval_succeeded(status_curve) ? status : status_curve;
+  }
+
+  /**
+   * @brief isApprox check if other and *this are approximately equals.
+   * The segments must be of the same types and approximately equals.
+   * @param other the other curve to check
+   * @param prec the precision treshold, default Eigen::NumTraits<Numeric>::dummy_precision()
+   * @return true is the two curves are approximately equals
+   */
+  bool isApprox(const piecewise_variant_curve_t& other,
+                const Numeric prec = Eigen::NumTraits<Numeric>::dummy_precision()) const {
+    if (num_curves() != other.num_curves()) return false;
+    for (std::size_t i = 0; i < num_curves(); ++i) {
+      if (segments_[i].which() != other.segments_[i].which()) return false;
+      if (!boost::apply_visitor(is_approx_visitor(prec), segments_[i], other.segments_[i])) return false;
+    }
+    return true;
+  }
+
+  virtual bool isApprox(const curve_abc_t* other,
+                        const Numeric prec = Eigen::NumTraits<Numeric>::dummy_precision()) const {
+    const piecewise_variant_curve_t* other_cast = dynamic_cast<const piecewise_variant_curve_t*>(other);
+    if (other_cast)
+      return isApprox(*other_cast, prec);
+    else
+      return false;
+  }
+
+  virtual bool operator==(const piecewise_variant_curve_t& other) const { return isApprox(other); }
+
+  virtual bool operator!=(const piecewise_variant_curve_t& other) const { return !(*this == other); }
+
+  /**
+   * @brief compute_derivate_ptr return a piecewise_variant_curve which is the derivative of this at given order
+   * @param order order of derivative
+   * @return
+   */
+  piecewise_variant_curve_t* compute_derivate_ptr(const std::size_t order) const {
+    CURVES_INSTRUMENT_SCOPE(COMPUTE_DERIVATE, this);
+    piecewise_variant_curve_t* res(new piecewise_variant_curve_t());
+    const derivative_visitor visitor(*res, order);
+    for (typename t_segment_t::const_iterator it = segments_.begin(); it != segments_.end(); ++it) {
+      boost::apply_visitor(visitor, *it);
+    }
+    return res;
+  }
+
+  ///  \brief Add a new curve to the piecewise curve, which should be defined in \f$[T_{min},T_{max}]\f$ where
+  ///  \f$T_{min}\f$ is equal to \f$T_{max}\f$ of the actual piecewise curve.
+  ///  \param curve : curve to add, of one of the types of segment_t. It is copied.
+  ///
+  template <typename Curve>
+  void add_curve(const Curve& curve) {
+    check_curve_to_add(curve);
+    segments_.push_back(segment_t(curve));
+    update_time_curves(curve);
+  }
+
+  ///  \brief Add a copy of a curve given by a pointer to its abstract class, see add_curve.
+  ///  \param cf : curve to add, its type must be one of the types of segment_t.
+  ///
+  void add_curve_ptr(const curve_ptr_t& cf) { add_curve_abc(*cf); }
+
+  /// \brief Convert the curve to a piecewise_curve storing a copy of each segment.
+  /// \return piecewise curve with the same segments.
+  ///
+  piecewise_curve_t to_piecewise_curve() const {
+    piecewise_curve_t res;
+    const to_piecewise_visitor visitor(res);
+    for (typename t_segment_t::const_iterator it = segments_.begin(); it != segments_.end(); ++it) {
+      boost::apply_visitor(visitor, *it);
+    }
+    return res;
+  }
+
+  /// \brief Get number of curves in piecewise curve.
+  /// \return Number of curves in piecewise curve.
+  std::size_t num_curves() const { return segments_.size(); }
+
+  /// \brief Get the segment at specified index in piecewise curve.
+  /// \param idx : Index of segment to return, from 0 to num_curves-1.
+  /// \return segment corresonding to index in piecewise curve.
+  const segment_t& segment_at_index(const std::size_t idx) const {
+    if (Safe && idx >= num_curves()) {
+      throw std::length_error(
+          "segment_at_index: requested index greater than number of curves in piecewise_variant_curve instance");
+    }
+    return segments_[idx];
+  }
+
+  /// \brief Get the type of the segment at specified index in piecewise curve.
+  /// \param idx : Index of segment, from 0 to num_curves-1.
+  /// \return type of the segment.
+  segment_type segment_type_at_index(const std::size_t idx) const {
+    return static_cast<segment_type>(segment_at_index(idx).which());
+  }
+
+ private:
+  /// \brief Add a copy of curve if its type is one of the types of segment_t, throw otherwise.
+  void add_curve_abc(const curve_abc_t& curve) {
+    if (const polynomial_t* pol = dynamic_cast<const polynomial_t*>(&curve)) {
+      add_curve(*pol);
+    } else if (const bezier_t* bezier = dynamic_cast<const bezier_t*>(&curve)) {
+      add_curve(*bezier);
+    } else if (const constant_t* constant = dynamic_cast<const constant_t*>(&curve)) {
+      add_curve(*constant);
+    } else if (const sinusoidal_t* sinus = dynamic_cast<const sinusoidal_t*>(&curve)) {
+      add_curve(*sinus);
+    } else {
+      throw std::invalid_argument(
+          "piecewise_variant_curve: segments must be polynomial, bezier_curve, constant_curve or sinusoidal");
+    }
+  }
+
+  /// \brief Check that a curve can be appended: it must start at T_max_ and have the dimension of the curve.
+  void check_curve_to_add(const curve_abc_t& cf) {
+    check_segment_to_add(cf, size_, T_max_, dim_, "piecewise_variant_curve");
+  }
+
+  /// \brief Update the time bounds after cf was appended to segments_.
+  void update_time_curves(const curve_abc_t& cf) {
+    size_ = segments_.size();
+    append_segment_times(cf, time_curves_, T_min_, T_max_);
+  }
+
+  /// \brief Get index of the interval corresponding to time t for the interpolation.
+  /// \param t : time where to look for interval.
+  /// \return Index of interval for time t.
+  ///
+  std::size_t find_interval(const Numeric t) const noexcept {
+    CURVES_INSTRUMENT_SCOPE(FIND_INTERVAL, this);
+    return find_segment_index(time_curves_, size_, t);
+  }
+
+  void check_if_not_empty() const {
+    if (segments_.size() == 0) {
+      throw std::runtime_error("Error in piecewise_variant_curve : No curve added");
+    }
+  }
+
+  // The visitors call the methods of the segments with a qualified name: the type of the segment is known from the
+  // tag of the variant, so the virtual dispatch is bypassed.
+  struct evaluate_visitor : public boost::static_visitor<point_t> {
+    explicit evaluate_visitor(const Time t) : t_(t) {}
+    template <typename Curve>
+    point_t operator()(const Curve& c) const {
+      return c.Curve::operator()(t_);
+    }
+    const Time t_;
+  };
+
+  struct derivate_visitor : public boost::static_visitor<point_derivate_t> {
+    derivate_visitor(const Time t, const std::size_t order) : t_(t), order_(order) {}
+    template <typename Curve>
+    point_derivate_t operator()(const Curve& c) const {
+      return c.Curve::derivate(t_, order_);
+    }
+    const Time t_;
+    const std::size_t order_;
+  };
+
+  struct evaluate_into_visitor : public boost::static_visitor<void> {
+    evaluate_into_visitor(const Time t, point_out_t out) : t_(t), out_(out) {}
+    template <typename Curve>
+    void operator()(const Curve& c) {
+      c.Curve::evaluate_into(t_, out_);
+    }
+    const Time t_;
+    point_out_t out_;
+  };
+
+  struct derivate_into_visitor : public boost::static_visitor<void> {
+    derivate_into_visitor(const Time t, const std::size_t order, point_derivate_out_t out)
+        : t_(t), order_(order), out_(out) {}
+    template <typename Curve>
+    void operator()(const Curve& c) {
+      c.Curve::derivate_into(t_, order_, out_);
+    }
+    const Time t_;
+    const std::size_t order_;
+    point_derivate_out_t out_;
+  };
+
+  struct evaluate_rt_visitor : public boost::static_visitor<eval_status> {
+    evaluate_rt_visitor(const Time t, point_out_t out) : t_(t), out_(out) {}
+    template <typename Curve>
+    eval_status operator()(const Curve& c) {
+      return c.Curve::evaluate_rt(t_, out_);
+    }
+    const Time t_;
+    point_out_t out_;
+  };
+
+  struct derivate_rt_visitor : public boost::static_visitor<eval_status> {
+    derivate_rt_visitor(const Time t, const std::size_t order, point_derivate_out_t out)
+        : t_(t), order_(order), out_(out) {}
+    template <typename Curve>
+    eval_status operator()(const Curve& c) {
+      return c.Curve::derivate_rt(t_, order_, out_);
+    }
+    const Time t_;
+    const std::size_t order_;
+    point_derivate_out_t out_;
+  };
+
+  struct is_approx_visitor : public boost::static_visitor<bool> {
+    explicit is_approx_visitor(const Numeric prec) : prec_(prec) {}
+    template <typename Curve>
+    bool operator()(const Curve& c, const Curve& other) const {
+      return c.Curve::isApprox(other, prec_);
+    }
+    template <typename Curve, typename Other>
+    bool operator()(const Curve&, const Other&) const {
+      return false;
+    }
+    const Numeric prec_;
+  };
+
+  struct derivative_visitor : public boost::static_visitor<void> {
+    derivative_visitor(piecewise_variant_curve_t& res, const std::size_t order) : res_(res), order_(order) {}
+    template <typename Curve>
+    void operator()(const Curve& c) const {
+      add(c.Curve::compute_derivate_ptr(order_));
+    }
+    template <typename Derivate>
+    void add(Derivate* derivate) const {
+      const boost::scoped_ptr<Derivate> ptr(derivate);
+      res_.add_curve(*ptr);
+    }
+    piecewise_variant_curve_t& res_;
+    const std::size_t order_;
+  };
+
+  struct to_piecewise_visitor : public boost::static_visitor<void> {
+    explicit to_piecewise_visitor(piecewise_curve_t& res) : res_(res) {}
+    template <typename Curve>
+    void operator()(const Curve& c) const {
+      res_.add_curve(c);
+    }
+    piecewise_curve_t& res_;
+  };
+
+  // footprint of a segment, the variant takes the place of the curve in the vector
+  struct footprint_visitor : public boost::static_visitor<footprint> {
+    template <typename Curve>
+    footprint operator()(const Curve& c) const {
+      footprint res = c.Curve::memory_footprint();
+      res.add(footprint::OBJECTS, sizeof(segment_t) - sizeof(Curve));
+      return res;
+    }
+  };
+
+  /*Helpers*/
+ public:
+  /// \brief Get dimension of curve.
+  /// \return dimension of curve.
+  std::size_t virtual dim() const { return dim_; };
+  /// \brief Get the minimum time for which the curve is defined
+  /// \return \f$t_{min}\f$, lower bound of time range.
+  Time virtual min() const { return T_min_; }
+  /// \brief Get the maximum time for which the curve is defined.
+  /// \return \f$t_{max}\f$, upper bound of time range.
+  Time virtual max() const { return T_max_; }
+  /// \brief Get the degree of the curve.
+  /// \return \f$degree\f$, the degree of the curve.
+  virtual std::size_t degree() const {
+    throw std::runtime_error("degree() method is not implemented for this type of curve.");
+  }
+  /// \brief Get the memory used by the curve, by category. See footprint.
+  virtual footprint memory_footprint() const {
+    footprint res;
+    res.add(footprint::OBJECTS, sizeof(*this));
+    res.add(footprint::OBJECTS, (segments_.capacity() - segments_.size()) * sizeof(segment_t));
+    for (typename t_segment_t::const_iterator cit = segments_.begin(); cit != segments_.end(); ++cit) {
+      res += boost::apply_visitor(footprint_visitor(), *cit);
+    }
+    add_points_footprint(res, footprint::TIMES, time_curves_);
+    return res;
+  }
+  /*Helpers*/
+
+  /* Attributes */
+  std::size_t dim_;         // Dim of curve
+  t_segment_t segments_;    // for curves 0/1/2 : [ curve0, curve1, curve2 ]
+  t_time_t time_curves_;    // for curves 0/1/2 : [ Tmin0, Tmax0,Tmax1,Tmax2 ]
+  std::size_t size_;        // Number of segments in piecewise curve = size of segments_
+  Time T_min_, T_max_;
+  /* Attributes */
+
+  // Serialization of the class
+  friend class boost::serialization::access;
+
+  template <class Archive>
+  void serialize(Archive& ar, const unsigned int version) {
+    if (version) {
+      // Do something depending on version ?
+    }
+    ar& BOOST_SERIALIZATION_BASE_OBJECT_NVP(curve_abc_t);
+    ar& boost::serialization::make_nvp("dim", dim_);
+    ar& boost::serialization::make_nvp("segments", segments_);
+    ar& boost::serialization::make_nvp("time_curves", time_curves_);
+    ar& boost::serialization::make_nvp("size", size_);
+    ar& boost::serialization::make_nvp("T_min", T_min_);
+    ar& boost::serialization::make_nvp("T_max", T_max_);
+  }
+};  // End struct piecewise_variant_curve
+}  // namespace ndcurves
+
+DEFINE_CLASS_TEMPLATE_VERSION(SINGLE_ARG(typename Time, typename Numeric, bool Safe, typename Point,
+                                         typename T_Point),
+                              SINGLE_ARG(ndcurves::piecewise_variant_curve<Time, Numeric, Safe, Point, T_Point>))
+
+#endif  // _CLASS_PIECEWISE_VARIANT_CURVE
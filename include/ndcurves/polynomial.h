@@ -16,6 +16,7 @@
 #include "MathDefs.h"
 
 #include "curve_abc.h"
+#include "cross_implementation.h"
 
 #include <iostream>
 #include <algorithm>
@@ -38,10 +39,11 @@ struct polynomial : public curve_abc<Time, Numeric, Safe, Point> {
   typedef Time time_t;
   typedef Numeric num_t;
   typedef curve_abc<Time, Numeric, Safe, Point> curve_abc_t;
-  typedef Eigen::MatrixXd coeff_t;
+  typedef Eigen::Matrix<Numeric, Point::RowsAtCompileTime, Eigen::Dynamic> coeff_t;  // one column per degree
   typedef Eigen::Ref<coeff_t> coeff_t_ref;
   typedef polynomial<Time, Numeric, Safe, Point, T_Point> polynomial_t;
   typedef typename curve_abc_t::curve_ptr_t curve_ptr_t;
+  typedef typename curve_abc_t::point_out_t point_out_t;
 
   /* Constructors - destructors */
  public:
@@ -141,11 +143,11 @@ struct polynomial : public curve_abc<Time, Numeric, Safe, Point> {
     [0  1  0   0   ]   [c2]   [d_init]
     [0  1  2T  3T^2]   [c3]   [d_end ]
     */
-    double T = max - min;
-    Eigen::Matrix<double, 4, 4> m;
+    num_t T = max - min;
+    Eigen::Matrix<num_t, 4, 4> m;
     m << 1., 0, 0, 0, 1., T, T * T, T * T * T, 0, 1., 0, 0, 0, 1., 2. * T, 3. * T * T;
-    Eigen::Matrix<double, 4, 4> m_inv = m.inverse();
-    Eigen::Matrix<double, 4, 1> bc;                    // boundary condition vector
+    Eigen::Matrix<num_t, 4, 4> m_inv = m.inverse();
+    Eigen::Matrix<num_t, 4, 1> bc;                    // boundary condition vector
     coefficients_ = coeff_t::Zero(dim_, degree_ + 1);  // init coefficient matrix with the right size
     for (size_t i = 0; i < dim_; ++i) {                // for each dimension, solve the boundary condition problem :
       bc[0] = init[i];
@@ -191,12 +193,12 @@ struct polynomial : public curve_abc<Time, Numeric, Safe, Point> {
     [0  0  2   0    0     0    ]   [c4]   [dd_init]
     [0  0  2   6T   12T^2 20T^3]   [c5]   [dd_end ]
     */
-    double T = max - min;
-    Eigen::Matrix<double, 6, 6> m;
+    num_t T = max - min;
+    Eigen::Matrix<num_t, 6, 6> m;
     m << 1., 0, 0, 0, 0, 0, 1., T, T * T, pow(T, 3), pow(T, 4), pow(T, 5), 0, 1., 0, 0, 0, 0, 0, 1., 2. * T,
         3. * T * T, 4. * pow(T, 3), 5. * pow(T, 4), 0, 0, 2, 0, 0, 0, 0, 0, 2, 6. * T, 12. * T * T, 20. * pow(T, 3);
-    Eigen::Matrix<double, 6, 6> m_inv = m.inverse();
-    Eigen::Matrix<double, 6, 1> bc;                    // boundary condition vector
+    Eigen::Matrix<num_t, 6, 6> m_inv = m.inverse();
+    Eigen::Matrix<num_t, 6, 1> bc;                    // boundary condition vector
     coefficients_ = coeff_t::Zero(dim_, degree_ + 1);  // init coefficient matrix with the right size
     for (size_t i = 0; i < dim_; ++i) {                // for each dimension, solve the boundary condition problem :
       bc[0] = init[i];
@@ -239,11 +241,11 @@ struct polynomial : public curve_abc<Time, Numeric, Safe, Point> {
     const size_t dim(p_init.size());
     if (static_cast<size_t>(p_final.size()) != dim)
       throw std::invalid_argument("Initial and final points must have the same dimension.");
-    const double T = t_max - t_min;
-    const double T2 = T * T;
-    const double T3 = T2 * T;
-    const double T4 = T3 * T;
-    const double T5 = T4 * T;
+    const num_t T = t_max - t_min;
+    const num_t T2 = T * T;
+    const num_t T3 = T2 * T;
+    const num_t T4 = T3 * T;
+    const num_t T5 = T4 * T;
 
     coeff_t coeffs = coeff_t::Zero(dim, 6);  // init coefficient matrix with the right size
     coeffs.col(0) = p_init;
@@ -273,6 +275,7 @@ struct polynomial : public curve_abc<Time, Numeric, Safe, Point> {
   ///  \param t : time when to evaluate the spline.
   ///  \return \f$x(t)\f$ point corresponding on spline at time t.
   virtual point_t operator()(const time_t t) const {
+    CURVES_INSTRUMENT_SCOPE(EVALUATE, this);
     check_if_not_empty();
     if ((t < T_min_ || t > T_max_) && Safe) {
       throw std::invalid_argument(
@@ -317,6 +320,7 @@ struct polynomial : public curve_abc<Time, Numeric, Safe, Point> {
   ///  \param order : order of derivative.
   ///  \return \f$\frac{d^Nx(t)}{dt^N}\f$ point corresponding on derivative spline at time t.
   virtual point_t derivate(const time_t t, const std::size_t order) const {
+    CURVES_INSTRUMENT_SCOPE(DERIVATE, this);
     check_if_not_empty();
     if ((t < T_min_ || t > T_max_) && Safe) {
       throw std::invalid_argument(
@@ -331,7 +335,60 @@ struct polynomial : public curve_abc<Time, Numeric, Safe, Point> {
     return currentPoint_;
   }
 
+  ///  \brief Evaluation of the polynomial at time t using horner's scheme, written in out without allocation.
+  ///  \param t : time when to evaluate the spline.
+  ///  \param out : \f$x(t)\f$ point corresponding on spline at time t.
+  virtual void evaluate_into(const time_t t, point_out_t out) const {
+    check_if_not_empty();
+    if ((t < T_min_ || t > T_max_) && Safe) {
+      throw std::invalid_argument(
+          "error in polynomial : time t to evaluate should be in range [Tmin, Tmax] of the curve");
+    }
+    evaluate_unchecked(t, out);
+  }
+
+  ///  \brief Evaluation of the derivative of order N of spline at time t, written in out without allocation.
+  ///  \param t : the time when to evaluate the spline.
+  ///  \param order : order of derivative.
+  ///  \param out : \f$\frac{d^Nx(t)}{dt^N}\f$ point corresponding on derivative spline at time t.
+  virtual void derivate_into(const time_t t, const std::size_t order, point_out_t out) const {
+    check_if_not_empty();
+    if ((t < T_min_ || t > T_max_) && Safe) {
+      throw std::invalid_argument(
+          "error in polynomial : time t to evaluate derivative should be in range [Tmin, Tmax] of the curve");
+    }
+    derivate_unchecked(t, order, out);
+  }
+
+  ///  \brief Real-time safe evaluation of the polynomial at time t, see curve_abc::evaluate_rt.
+  ///  \param t : time when to evaluate the spline, clamped in [Tmin, Tmax].
+  ///  \param out : \f$x(t)\f$ point corresponding on spline at time t.
+  ///  \return EVAL_OK or EVAL_CLAMPED if out was written, the reason of the failure otherwise.
+  virtual eval_status evaluate_rt(const time_t t, point_out_t out) const noexcept {
+    if (coefficients_.size() == 0) return EVAL_EMPTY;
+    if (!point_out<point_t>::valid_size(out, dim_)) return EVAL_INVALID_SIZE;
+    time_t tc(t);
+    const eval_status status = clamp_time(tc, T_min_, T_max_);
+    evaluate_unchecked(tc, out);
+    return status;
+  }
+
+  ///  \brief Real-time safe evaluation of the derivative of order N at time t, see curve_abc::derivate_rt.
+  ///  \param t : the time when to evaluate the spline, clamped in [Tmin, Tmax].
+  ///  \param order : order of derivative.
+  ///  \param out : \f$\frac{d^Nx(t)}{dt^N}\f$ point corresponding on derivative spline at time t.
+  ///  \return EVAL_OK or EVAL_CLAMPED if out was written, the reason of the failure otherwise.
+  virtual eval_status derivate_rt(const time_t t, const std::size_t order, point_out_t out) const noexcept {
+    if (coefficients_.size() == 0) return EVAL_EMPTY;
+    if (!point_out<point_t>::valid_size(out, dim_)) return EVAL_INVALID_SIZE;
+    time_t tc(t);
+    const eval_status status = clamp_time(tc, T_min_, T_max_);
+    derivate_unchecked(tc, order, out);
+    return status;
+  }
+
   polynomial_t compute_derivate(const std::size_t order) const {
+    CURVES_INSTRUMENT_SCOPE(COMPUTE_DERIVATE, this);
     check_if_not_empty();
     if (order == 0) {
       return *this;
@@ -348,7 +405,7 @@ struct polynomial : public curve_abc<Time, Numeric, Safe, Point> {
     return new polynomial_t(compute_derivate(order));
   }
 
-  Eigen::MatrixXd coeff() const { return coefficients_; }
+  coeff_t coeff() const { return coefficients_; }
 
   point_t coeffAtDegree(const std::size_t degree) const {
     point_t res;
@@ -359,7 +416,27 @@ struct polynomial : public curve_abc<Time, Numeric, Safe, Point> {
   }
 
  private:
-  num_t fact(const std::size_t n, const std::size_t order) const {
+  /// \brief Horner's scheme, without any check on t or on the coefficients.
+  void evaluate_unchecked(const time_t t, point_out_t out) const noexcept {
+    time_t const dt(t - T_min_);
+    out = coefficients_.col(degree_);
+    for (int i = (int)(degree_ - 1); i >= 0; i--) {
+      out *= dt;
+      out += coefficients_.col(i);
+    }
+  }
+
+  /// \brief Derivative of order N, without any check on t or on the coefficients.
+  void derivate_unchecked(const time_t t, const std::size_t order, point_out_t out) const noexcept {
+    time_t const dt(t - T_min_);
+    time_t cdt(1);
+    out.setZero();
+    for (int i = (int)(order); i < (int)(degree_ + 1); ++i, cdt *= dt) {
+      out += (cdt * fact(i, order)) * coefficients_.col(i);
+    }
+  }
+
+  num_t fact(const std::size_t n, const std::size_t order) const noexcept {
     num_t res(1);
     for (std::size_t i = 0; i < std::size_t(order); ++i) {
       res *= (num_t)(n - i);
@@ -398,6 +475,13 @@ struct polynomial : public curve_abc<Time, Numeric, Safe, Point> {
   /// \brief Get the degree of the curve.
   /// \return \f$degree\f$, the degree of the curve.
   virtual std::size_t degree() const { return degree_; }
+  /// \brief Get the memory used by the curve, by category. See footprint.
+  virtual footprint memory_footprint() const {
+    footprint res;
+    res.add(footprint::OBJECTS, sizeof(*this));
+    point_footprint<coeff_t>::add(res, footprint::CONTROL_POINTS, coefficients_);
+    return res;
+  }
   /*Helpers*/
 
   polynomial_t& operator+=(const polynomial_t& p1) {
@@ -438,12 +522,12 @@ struct polynomial : public curve_abc<Time, Numeric, Safe, Point> {
     return *this;
     }
 
-  polynomial_t& operator/=(const double d) {
+  polynomial_t& operator/=(const num_t d) {
     coefficients_ /= d;
     return *this;
   }
 
-  polynomial_t& operator*=(const double d) {
+  polynomial_t& operator*=(const num_t d) {
     coefficients_ *= d;
     return *this;
   }
@@ -459,14 +543,14 @@ struct polynomial : public curve_abc<Time, Numeric, Safe, Point> {
     if (dim()!= 3)
         throw std::invalid_argument("Can't perform cross product on polynomials with dimensions != 3 ");
     std::size_t new_degree =degree() + pOther.degree();
-    coeff_t nCoeffs = Eigen::MatrixXd::Zero(3,new_degree+1);
-    Eigen::Vector3d currentVec;
-    Eigen::Vector3d currentVecCrossed;
+    coeff_t nCoeffs = coeff_t::Zero(3,new_degree+1);
+    Eigen::Matrix<num_t, 3, 1> currentVec;
+    Eigen::Matrix<num_t, 3, 1> currentVecCrossed;
     for(long i = 0; i< coefficients_.cols(); ++i){
         currentVec = coefficients_.col(i);
         for(long j = 0; j< pOther.coeff().cols(); ++j){
             currentVecCrossed = pOther.coeff().col(j);
-            nCoeffs.col(i+j) += currentVec.cross(currentVecCrossed);
+            nCoeffs.template block<3, 1>(0, i+j) += ndcurves::cross(currentVec, currentVecCrossed);
         }
     }
     // remove last degrees is they are equal to 0
@@ -487,11 +571,11 @@ struct polynomial : public curve_abc<Time, Numeric, Safe, Point> {
     if (dim()!= 3)
         throw std::invalid_argument("Can't perform cross product on polynomials with dimensions != 3 ");
     coeff_t nCoeffs = coefficients_;
-    Eigen::Vector3d currentVec;
-    Eigen::Vector3d pointVec = point;
+    Eigen::Matrix<num_t, 3, 1> currentVec;
+    Eigen::Matrix<num_t, 3, 1> pointVec = point;
     for(long i = 0; i< coefficients_.cols(); ++i){
         currentVec = coefficients_.col(i);
-        nCoeffs.col(i) = currentVec.cross(pointVec);
+        nCoeffs.template block<3, 1>(0, i) = ndcurves::cross(currentVec, pointVec);
     }
     // remove last degrees is they are equal to 0
     long final_degree = degree();
@@ -591,19 +675,19 @@ polynomial<T,N,S,P,TP> operator-(const polynomial<T,N,S,P,TP>& p1, const polynom
 }
 
 template <typename T, typename N, bool S, typename P, typename TP >
-polynomial<T,N,S,P,TP> operator/(const polynomial<T,N,S,P,TP>& p1, const double k) {
+polynomial<T,N,S,P,TP> operator/(const polynomial<T,N,S,P,TP>& p1, const typename polynomial<T,N,S,P,TP>::num_t k) {
     polynomial<T,N,S,P,TP> res(p1);
     return res/=k;
 }
 
 template <typename T, typename N, bool S, typename P, typename TP >
-polynomial<T,N,S,P,TP> operator*(const polynomial<T,N,S,P,TP>& p1,const double k)  {
+polynomial<T,N,S,P,TP> operator*(const polynomial<T,N,S,P,TP>& p1,const typename polynomial<T,N,S,P,TP>::num_t k)  {
     polynomial<T,N,S,P,TP> res(p1);
     return res*=k;
 }
 
 template <typename T, typename N, bool S, typename P, typename TP >
-polynomial<T,N,S,P,TP> operator*(const double k, const polynomial<T,N,S,P,TP>& p1)  {
+polynomial<T,N,S,P,TP> operator*(const typename polynomial<T,N,S,P,TP>::num_t k, const polynomial<T,N,S,P,TP>& p1)  {
     polynomial<T,N,S,P,TP> res(p1);
     return res*=k;
 }
@@ -21,6 +21,10 @@
 
 namespace ndcurves {
 
+/// \brief x' A x + b' x + c, where only the symmetric part (A + A') / 2 of A matters.
+/// The upper triangle of the symmetric part is packed by columns in a vector of size n (n + 1) / 2: A(i, j) with
+/// i <= j is at index i + j (j + 1) / 2. The operations only touch these coefficients, the dense matrix is only built
+/// by A().
 template <typename Numeric = double>
 struct quadratic_variable {
   typedef Eigen::Matrix<Numeric, Eigen::Dynamic, Eigen::Dynamic> matrix_x_t;
@@ -30,38 +34,66 @@ struct quadratic_variable {
   quadratic_variable() {
     c_ = 0.;
     b_ = point_t::Zero(1);
-    A_ = matrix_x_t::Zero(1, 1);
+    A_packed_ = point_t::Zero(1);
     zero = true;
   }
 
-  quadratic_variable(const matrix_x_t& A, const point_t& b, const Numeric c = 0) : c_(c), b_(b), A_(A), zero(false) {
+  /// \brief Constructor, A is replaced by its symmetric part (A + A') / 2 which gives the same x' A x.
+  quadratic_variable(const matrix_x_t& A, const point_t& b, const Numeric c = 0) : c_(c), b_(b), zero(false) {
     if (A.cols() != b.rows() || A.cols() != A.rows()) {
       throw std::invalid_argument("The dimensions of A and b are incorrect.");
     }
+    A_packed_.resize(packed_size(A.cols()));
+    for (Eigen::Index j = 0; j < A.cols(); ++j) {
+      A_packed_.segment(packed_index(0, j), j + 1) =
+          (A.col(j).head(j + 1) + A.row(j).head(j + 1).transpose()) * Numeric(0.5);
+    }
   }
 
   quadratic_variable(const point_t& b, const Numeric c = 0)
-      : c_(c), b_(b), A_(matrix_x_t::Zero((int)(b.rows()), (int)(b.rows()))), zero(false) {}
+      : c_(c), b_(b), A_packed_(point_t::Zero(packed_size(b.rows()))), zero(false) {}
+
+  /// \brief Constructor from the packed upper triangle of a symmetric A, see A_packed().
+  static quadratic_variable_t FromPacked(const point_t& A_packed, const point_t& b, const Numeric c = 0) {
+    if (A_packed.rows() != packed_size(b.rows())) {
+      throw std::invalid_argument("The dimensions of A_packed and b are incorrect.");
+    }
+    quadratic_variable_t res(b, c);
+    res.A_packed_ = A_packed;
+    return res;
+  }
 
   static quadratic_variable_t Zero(size_t dim = 0) { return quadratic_variable_t(); }
 
+  /// \brief Number of coefficients of the packed upper triangle of a symmetric matrix of size n.
+  static Eigen::Index packed_size(const Eigen::Index n) { return n * (n + 1) / 2; }
+
+  /// \brief Index of A(i, j), i <= j, in the packed upper triangle.
+  static Eigen::Index packed_index(const Eigen::Index i, const Eigen::Index j) { return i + j * (j + 1) / 2; }
+
   // linear evaluation
   Numeric operator()(const Eigen::Ref<const point_t>& val) const {
     if (isZero()) {
       throw std::runtime_error("Not initialized! (isZero)");
     }
-    return val.transpose() * A() * val + b().transpose() * val + c();
+    // x' A x = sum_j x_j (2 sum_{i<j} A(i, j) x_i + A(j, j) x_j)
+    Numeric res = b_.dot(val) + c_;
+    for (Eigen::Index j = 0; j < val.rows(); ++j) {
+      const Eigen::Index col = packed_index(0, j);
+      res += val[j] * (2 * A_packed_.segment(col, j).dot(val.head(j)) + A_packed_[col + j] * val[j]);
+    }
+    return res;
   }
 
   quadratic_variable& operator+=(const quadratic_variable& w1) {
     if (w1.isZero()) return *this;
     if (isZero()) {
-      this->A_ = w1.A_;
+      this->A_packed_ = w1.A_packed_;
       this->b_ = w1.b_;
       this->c_ = w1.c_;
       zero = false;
     } else {
-      this->A_ += w1.A_;
+      this->A_packed_ += w1.A_packed_;
       this->b_ += w1.b_;
       this->c_ += w1.c_;
     }
@@ -70,42 +102,67 @@ struct quadratic_variable {
   quadratic_variable& operator-=(const quadratic_variable& w1) {
     if (w1.isZero()) return *this;
     if (isZero()) {
-      this->A_ = -w1.A_;
+      this->A_packed_ = -w1.A_packed_;
       this->b_ = -w1.b_;
       this->c_ = -w1.c_;
       zero = false;
     } else {
-      this->A_ -= w1.A_;
+      this->A_packed_ -= w1.A_packed_;
       this->b_ -= w1.b_;
       this->c_ -= w1.c_;
     }
     return *this;
   }
 
-  quadratic_variable& operator/=(const double d) {
+  quadratic_variable& operator/=(const Numeric d) {
     // handling zero case
     if (!isZero()) {
-      this->A_ /= d;
+      this->A_packed_ /= d;
       this->b_ /= d;
       this->c_ /= d;
     }
     return *this;
   }
-  quadratic_variable& operator*=(const double d) {
+  quadratic_variable& operator*=(const Numeric d) {
     // handling zero case
     if (!isZero()) {
-      this->A_ *= d;
+      this->A_packed_ *= d;
       this->b_ *= d;
       this->c_ *= d;
     }
     return *this;
   }
 
-  const matrix_x_t& A() const {
+  /// \brief A += diag(d).
+  quadratic_variable& add_to_diagonal(const Eigen::Ref<const point_t>& d) {
+    if (isZero() || d.rows() != b_.rows()) {
+      throw std::invalid_argument("Cannot add to the diagonal, the dimension of d is incorrect.");
+    }
+    for (Eigen::Index j = 0; j < d.rows(); ++j) {
+      A_packed_[packed_index(j, j)] += d[j];
+    }
+    return *this;
+  }
+
+  /// \brief Build the dense symmetric matrix A.
+  matrix_x_t A() const {
+    if (isZero()) {
+      throw std::runtime_error("Not initialized! (isZero)");
+    }
+    const Eigen::Index n = b_.rows();
+    matrix_x_t res(n, n);
+    for (Eigen::Index j = 0; j < n; ++j) {
+      res.col(j).head(j + 1) = A_packed_.segment(packed_index(0, j), j + 1);
+      res.row(j).head(j) = A_packed_.segment(packed_index(0, j), j).transpose();
+    }
+    return res;
+  }
+  /// \brief Packed upper triangle of A, see packed_index.
+  const point_t& A_packed() const {
     if (isZero()) {
       throw std::runtime_error("Not initialized! (isZero)");
     }
-    return A_;
+    return A_packed_;
   }
   const point_t& b() const {
     if (isZero()) {
@@ -120,12 +177,22 @@ struct quadratic_variable {
     return c_;
   }
   bool isZero() const { return zero; }
-  std::size_t size() const { return zero ? 0 : std::max(A_.cols(), (std::max(b_.cols(), c_.size()))); }
+
+  /// \brief Get the memory used by the quadratic variable, by category. See footprint.
+  footprint memory_footprint() const {
+    footprint res;
+    res.add(footprint::OBJECTS, sizeof(*this));
+    point_footprint<point_t>::add(res, footprint::LINEAR_VARIABLES, A_packed_);
+    point_footprint<point_t>::add(res, footprint::LINEAR_VARIABLES, b_);
+    return res;
+  }
+
+  std::size_t size() const { return zero ? 0 : std::size_t(b_.rows()); }
 
  private:
   Numeric c_;
   point_t b_;
-  matrix_x_t A_;
+  point_t A_packed_;
   bool zero;
 };
 
@@ -141,51 +208,51 @@ Eigen::Matrix<N, Eigen::Dynamic, Eigen::Dynamic> to_diagonal(
 }
 
 // only works with diagonal linear variables
-template <typename N>
-inline quadratic_variable<N> operator*(const linear_variable<N>& w1, const linear_variable<N>& w2) {
+// the expressions of linear variables, e.g. the scaling by a constant, are used directly without evaluating them
+template <typename E1, typename E2>
+inline quadratic_variable<typename E1::matrix_x_t::Scalar> operator*(const linear_expression<E1>& expr1,
+                                                                     const linear_expression<E2>& expr2) {
+  typedef typename E1::matrix_x_t::Scalar N;
   typedef quadratic_variable<N> quad_var_t;
-  typedef linear_variable<N> lin_var_t;
-  typedef typename quad_var_t::matrix_x_t matrix_x_t;
   typedef typename quad_var_t::point_t point_t;
-  typedef typename lin_var_t::vector_x_t point_dim_t;
-  point_dim_t ones = point_dim_t::Ones(w1.c().size());
-  point_t b1 = w1.B().transpose() * ones, b2 = w2.B().transpose() * ones;
-  matrix_x_t B1 = to_diagonal<N>(b1);
-  matrix_x_t B2 = to_diagonal<N>(b2);  // b1.array().square()
-  // omitting all transposes since A matrices are diagonals
-  matrix_x_t A = B1.transpose() * B2;
+  const E1& w1 = expr1.derived();
+  const E2& w2 = expr2.derived();
+  point_t b1 = w1.B().colwise().sum().transpose(), b2 = w2.B().colwise().sum().transpose();
   point_t b = w1.c().transpose() * w2.B() + w2.c().transpose() * w1.B();
-  N c = w1.c().transpose() * w2.c();
-  return quad_var_t(A, b, c);
+  N c = w1.c().dot(w2.c());
+  // A = diag(b1) * diag(b2)
+  quad_var_t res(b, c);
+  res.add_to_diagonal(b1.cwiseProduct(b2));
+  return res;
 }
 
 template <typename N>
 inline quadratic_variable<N> operator+(const quadratic_variable<N>& w1, const quadratic_variable<N>& w2) {
-  quadratic_variable<N> res(w1.A(), w1.b(), w1.c());
+  quadratic_variable<N> res(w1);
   return res += w2;
 }
 
 template <typename N>
 quadratic_variable<N> operator-(const quadratic_variable<N>& w1, const quadratic_variable<N>& w2) {
-  quadratic_variable<N> res(w1.A(), w1.b(), w1.c());
+  quadratic_variable<N> res(w1);
   return res -= w2;
 }
 
 template <typename N>
-quadratic_variable<N> operator*(const double k, const quadratic_variable<N>& w) {
-  quadratic_variable<N> res(w.A(), w.b(), w.c());
+quadratic_variable<N> operator*(const typename quadratic_variable<N>::point_t::Scalar k, const quadratic_variable<N>& w) {
+  quadratic_variable<N> res(w);
   return res *= k;
 }
 
 template <typename N>
-quadratic_variable<N> operator*(const quadratic_variable<N>& w, const double k) {
-  quadratic_variable<N> res(w.A(), w.b(), w.c());
+quadratic_variable<N> operator*(const quadratic_variable<N>& w, const typename quadratic_variable<N>::point_t::Scalar k) {
+  quadratic_variable<N> res(w);
   return res *= k;
 }
 
 template <typename N>
-quadratic_variable<N> operator/(const quadratic_variable<N>& w, const double k) {
-  quadratic_variable<N> res(w.A(), w.b(), w.c());
+quadratic_variable<N> operator/(const quadratic_variable<N>& w, const typename quadratic_variable<N>::point_t::Scalar k) {
+  quadratic_variable<N> res(w);
   return res /= k;
 }
 
@@ -4,15 +4,18 @@
 #include "MathDefs.h"
 #include "curve_abc.h"
 #include "so3_linear.h"
+#include "se3_derivate.h"
 #include "polynomial.h"
+#include "piecewise_curve.h"
 #include <boost/math/constants/constants.hpp>
+#include <algorithm>
 #include <Eigen/Dense>
 
 namespace ndcurves {
 
 /// \class SE3Curve.
 /// \brief Composition of a curve of any type of dimension 3 and a curve representing an rotation
-/// (in current implementation, only SO3Linear can be used for the rotation part)
+/// (SO3Linear or SO3Bezier)
 /// The output is a vector of size 7 (pos_x,pos_y,pos_z,quat_x,quat_y,quat_z,quat_w)
 /// The output of the derivative of any order is a vector of size 6
 /// (linear_x,linear_y,linear_z,angular_x,angular_y,angular_z)
@@ -22,13 +25,16 @@ template <typename Time = double, typename Numeric = Time, bool Safe = false>
 struct SE3Curve : public curve_abc<Time, Numeric, Safe, Eigen::Transform<Numeric, 3, Eigen::Affine>,
                                    Eigen::Matrix<Numeric, 6, 1> > {
   typedef Numeric Scalar;
+  typedef Eigen::Matrix<Scalar, 3, 3> matrix3_t;
+  typedef Eigen::Matrix<Scalar, 3, 1> point3_t;
+  typedef Eigen::Matrix<Scalar, Eigen::Dynamic, 1> pointX_t;
   typedef Eigen::Transform<Numeric, 3, Eigen::Affine> transform_t;
   typedef transform_t point_t;
   typedef Eigen::Matrix<Scalar, 6, 1> point_derivate_t;
   typedef Eigen::Quaternion<Scalar> Quaternion;
   typedef Time time_t;
   typedef curve_abc<Time, Numeric, Safe, point_t, point_derivate_t> curve_abc_t;  // parent class
-  typedef polynomial<Time, Numeric, Safe, point_derivate_t> curve_derivate_t;
+  typedef SE3Derivate<Time, Numeric, Safe> curve_derivate_t;
   typedef curve_abc<Time, Numeric, Safe, pointX_t> curve_X_t;                     // generic class of curve
   typedef curve_abc<Time, Numeric, Safe, matrix3_t, point3_t>
       curve_rotation_t;  // templated class used for the rotation (return dimension are fixed)
@@ -38,6 +44,10 @@ struct SE3Curve : public curve_abc<Time, Numeric, Safe, Eigen::Transform<Numeric
   typedef SO3Linear<Time, Numeric, Safe> SO3Linear_t;
   typedef polynomial<Time, Numeric, Safe, pointX_t> polynomial_t;
   typedef SE3Curve<Time, Numeric, Safe> SE3Curve_t;
+  typedef Eigen::Matrix<Time, Eigen::Dynamic, 1> time_vector_t;
+  typedef Eigen::Matrix<Scalar, 3, Eigen::Dynamic> translations_t;  // one translation per column
+  typedef Eigen::Matrix<Scalar, 4, Eigen::Dynamic> quaternions_t;   // one quaternion (x, y, z, w) per column
+  typedef Eigen::Matrix<Scalar, 3, Eigen::Dynamic> transforms_t;    // one 3x4 block [R | p] per sample
 
  public:
   /* Constructors - destructors */
@@ -140,6 +150,7 @@ struct SE3Curve : public curve_abc<Time, Numeric, Safe, Eigen::Transform<Numeric
   ///  \param t : time when to evaluate the spline.
   ///  \return \f$x(t)\f$ point corresponding on spline at time t. (pos_x,pos_y,pos_z,quat_x,quat_y,quat_z,quat_w)
   virtual point_t operator()(const time_t t) const {
+    CURVES_INSTRUMENT_SCOPE(EVALUATE, this);
     if (translation_curve_->dim() != 3) {
       throw std::invalid_argument("Translation curve should always be of dimension 3");
     }
@@ -149,6 +160,79 @@ struct SE3Curve : public curve_abc<Time, Numeric, Safe, Eigen::Transform<Numeric
     return res;
   }
 
+  ///  \brief Evaluation of the SE3Curve on a time grid.
+  ///  The rotation is interpolated in quaternion form and never converted to a rotation matrix.
+  ///  \param times : the times when to evaluate the curve.
+  ///  \param translations : 3 x N matrix, column i is filled with the translation at times[i].
+  ///  \param quaternions : 4 x N matrix, column i is filled with the coefficients (x, y, z, w) of the rotation at
+  ///  times[i].
+  void evaluate_batch(const Eigen::Ref<const time_vector_t>& times, Eigen::Ref<translations_t> translations,
+                      Eigen::Ref<quaternions_t> quaternions) const {
+    evaluate_batch(times, 0, times.size(), translations, quaternions);
+  }
+
+  ///  \brief Evaluation of the SE3Curve on a time grid, as 3x4 matrices [R | p].
+  ///  \param times : the times when to evaluate the curve.
+  ///  \param transforms : 3 x 4N matrix, the columns [4i, 4i+4[ are filled with the transform at times[i].
+  void evaluate_batch(const Eigen::Ref<const time_vector_t>& times, Eigen::Ref<transforms_t> transforms) const {
+    evaluate_batch(times, 0, times.size(), transforms);
+  }
+
+  ///  \brief Evaluation of the SE3Curve at the times [first, last[ of a time grid.
+  ///  Only the columns [first, last[ of the output buffers are written, this is used to fill the buffers
+  ///  of a piecewise curve segment by segment. The buffers still have one column per time of the grid.
+  void evaluate_batch(const Eigen::Ref<const time_vector_t>& times, const Eigen::Index first, const Eigen::Index last,
+                      Eigen::Ref<translations_t> translations, Eigen::Ref<quaternions_t> quaternions) const {
+    if (translations.cols() != times.size() || quaternions.cols() != times.size()) {
+      throw std::invalid_argument("SE3Curve::evaluate_batch: output buffers should have one column per time.");
+    }
+    check_batch_range(times, first, last);
+    check_translation_dim();
+    const SO3Linear_t* so3 = dynamic_cast<const SO3Linear_t*>(rotation_curve_.get());
+    if (so3) {
+      so3->evaluate_batch(times.segment(first, last - first), quaternions.middleCols(first, last - first));
+    }
+    matrix3_t rotation;
+    for (Eigen::Index i = first; i < last; ++i) {
+      translation_curve_->evaluate_into(times[i], translations.col(i));
+      if (!so3) {
+        rotation_curve_->evaluate_into(times[i], rotation);
+        quaternions.col(i) = Quaternion(rotation).coeffs();
+      }
+    }
+  }
+
+  ///  \brief Evaluation of the SE3Curve at the times [first, last[ of a time grid, as 3x4 matrices [R | p].
+  ///  Only the columns [4 first, 4 last[ of transforms are written. The rotations of a SO3Linear are computed in
+  ///  quaternion form by blocks of samples, in a buffer on the stack, then converted to rotation matrices.
+  void evaluate_batch(const Eigen::Ref<const time_vector_t>& times, const Eigen::Index first, const Eigen::Index last,
+                      Eigen::Ref<transforms_t> transforms) const {
+    if (transforms.cols() != 4 * times.size()) {
+      throw std::invalid_argument("SE3Curve::evaluate_batch: output buffer should have four columns per time.");
+    }
+    check_batch_range(times, first, last);
+    check_translation_dim();
+    const SO3Linear_t* so3 = dynamic_cast<const SO3Linear_t*>(rotation_curve_.get());
+    const Eigen::Index block_size = 16;
+    Eigen::Matrix<Scalar, 4, block_size> quaternions;
+    for (Eigen::Index begin = first; begin < last; begin += block_size) {
+      const Eigen::Index n = std::min(block_size, last - begin);
+      if (so3) {
+        so3->evaluate_batch(times.segment(begin, n), quaternions.leftCols(n));
+      }
+      for (Eigen::Index j = 0; j < n; ++j) {
+        const Eigen::Index i = begin + j;
+        if (so3) {
+          transforms.template block<3, 3>(0, 4 * i) =
+              Eigen::Map<const Quaternion>(quaternions.col(j).data()).toRotationMatrix();
+        } else {
+          rotation_curve_->evaluate_into(times[i], transforms.template block<3, 3>(0, 4 * i));
+        }
+        translation_curve_->evaluate_into(times[i], transforms.col(4 * i + 3));
+      }
+    }
+  }
+
   /**
    * @brief isApprox check if other and *this are approximately equals.
    * Only two curves of the same class can be approximately equals, for comparison between different type of curves see
@@ -182,17 +266,88 @@ struct SE3Curve : public curve_abc<Time, Numeric, Safe, Eigen::Transform<Numeric
   ///  \param order : order of derivative.
   ///  \return \f$\frac{d^Nx(t)}{dt^N}\f$ point corresponding on derivative spline at time t.
   virtual point_derivate_t derivate(const time_t t, const std::size_t order) const {
+    CURVES_INSTRUMENT_SCOPE(DERIVATE, this);
     if (translation_curve_->dim() != 3) {
       throw std::invalid_argument("Translation curve should always be of dimension 3");
     }
     point_derivate_t res = point_derivate_t::Zero();
-    res.segment(0, 3) = point3_t(translation_curve_->derivate(t, order));
-    res.segment(3, 3) = rotation_curve_->derivate(t, order);
+    res.template head<3>() = point3_t(translation_curve_->derivate(t, order));
+    res.template tail<3>() = rotation_curve_->derivate(t, order);
     return res;
   }
 
-  curve_derivate_t compute_derivate(const std::size_t /*order*/) const {
-    throw std::logic_error("Compute derivate for SE3 is not implemented yet.");
+  ///  \brief Evaluation of the SE3Curve at time t, written in out.
+  ///  Does not allocate if the translation and rotation curves do not allocate in their own evaluate_into.
+  ///  \param t : time when to evaluate the spline.
+  ///  \param out : \f$x(t)\f$ transform corresponding on spline at time t.
+  virtual void evaluate_into(const time_t t, point_t& out) const {
+    if (translation_curve_->dim() != 3) {
+      throw std::invalid_argument("Translation curve should always be of dimension 3");
+    }
+    translation_curve_->evaluate_into(t, out.translation());
+    rotation_curve_->evaluate_into(t, out.linear());
+    out.makeAffine();
+  }
+
+  ///  \brief Evaluation of the derivative of order N of spline at time t, written in out.
+  ///  Does not allocate if the translation and rotation curves do not allocate in their own derivate_into.
+  ///  \param t : the time when to evaluate the spline.
+  ///  \param order : order of derivative.
+  ///  \param out : \f$\frac{d^Nx(t)}{dt^N}\f$ point corresponding on derivative spline at time t.
+  virtual void derivate_into(const time_t t, const std::size_t order,
+                             typename curve_abc_t::point_derivate_out_t out) const {
+    if (translation_curve_->dim() != 3) {
+      throw std::invalid_argument("Translation curve should always be of dimension 3");
+    }
+    translation_curve_->derivate_into(t, order, out.template head<3>());
+    rotation_curve_->derivate_into(t, order, out.template tail<3>());
+  }
+
+  ///  \brief Real-time safe evaluation of the SE3Curve at time t, see curve_abc::evaluate_rt.
+  ///  Real-time safe if the translation and rotation curves implement evaluate_rt.
+  ///  \param t : time when to evaluate the spline, clamped in [Tmin, Tmax].
+  ///  \param out : \f$x(t)\f$ transform corresponding on spline at time t.
+  ///  \return EVAL_OK or EVAL_CLAMPED if out was written, the reason of the failure otherwise.
+  virtual eval_status evaluate_rt(const time_t t, point_t& out) const noexcept {
+    if (!translation_curve_ || !rotation_curve_) return EVAL_EMPTY;
+    time_t tc(t);
+    const eval_status status = clamp_time(tc, T_min_, T_max_);
+    eval_status status_curve = translation_curve_->evaluate_rt(tc, out.translation());
+    if (!eval_succeeded(status_curve)) return status_curve;
+    status_curve = rotation_curve_->evaluate_rt(tc, out.linear());
+    if (!eval_succeeded(status_curve)) return status_curve;
+    out.makeAffine();
+    return status;
+  }
+
+  ///  \brief Real-time safe evaluation of the derivative of order N at time t, see curve_abc::derivate_rt.
+  ///  Real-time safe if the translation and rotation curves implement derivate_rt.
+  ///  \param t : the time when to evaluate the spline, clamped in [Tmin, Tmax].
+  ///  \param order : order of derivative.
+  ///  \param out : \f$\frac{d^Nx(t)}{dt^N}\f$ point corresponding on derivative spline at time t.
+  ///  \return EVAL_OK or EVAL_CLAMPED if out was written, the reason of the failure otherwise.
+  virtual eval_status derivate_rt(const time_t t, const std::size_t order,
+                                  typename curve_abc_t::point_derivate_out_t out) const noexcept {
+    if (!translation_curve_ || !rotation_curve_) return EVAL_EMPTY;
+    time_t tc(t);
+    const eval_status status = clamp_time(tc, T_min_, T_max_);
+    eval_status status_curve = translation_curve_->derivate_rt(tc, order, out.template head<3>());
+    if (!eval_succeeded(status_curve)) return status_curve;
+    status_curve = rotation_curve_->derivate_rt(tc, order, out.template tail<3>());
+    return eval_succeeded(status_curve) ? status : status_curve;
+  }
+
+  ///  \brief Compute the derived curve at order N.
+  ///  The linear part is the derivative of the translation curve and the angular part is the derivative of the
+  ///  rotation curve, as returned by derivate().
+  ///  \param order : order of derivative.
+  ///  \return \f$\frac{d^Nx(t)}{dt^N}\f$ derivative order N of the curve.
+  curve_derivate_t compute_derivate(const std::size_t order) const {
+    CURVES_INSTRUMENT_SCOPE(COMPUTE_DERIVATE, this);
+    check_translation_dim();
+    typename curve_derivate_t::curve_ptr_t linear(translation_curve_->compute_derivate_ptr(order));
+    typename curve_derivate_t::curve3_ptr_t angular(rotation_curve_->compute_derivate_ptr(order));
+    return curve_derivate_t(linear, angular);
   }
 
   ///  \brief Compute the derived curve at order N.
@@ -213,6 +368,14 @@ struct SE3Curve : public curve_abc<Time, Numeric, Safe, Eigen::Transform<Numeric
   /// \brief Get the degree of the curve.
   /// \return \f$degree\f$, the degree of the curve.
   virtual std::size_t degree() const { return translation_curve_->degree(); }
+  /// \brief Get the memory used by the curve, by category. See footprint.
+  virtual footprint memory_footprint() const {
+    footprint res;
+    res.add(footprint::OBJECTS, sizeof(*this));
+    add_shared_footprint(res, translation_curve_);
+    add_shared_footprint(res, rotation_curve_);
+    return res;
+  }
   /// \brief const accessor to the translation curve
   const curve_ptr_t translation_curve() const {return translation_curve_;}
   /// \brief const accessor to the rotation curve
@@ -243,6 +406,19 @@ struct SE3Curve : public curve_abc<Time, Numeric, Safe, Eigen::Transform<Numeric
   }
 
  private:
+  void check_translation_dim() const {
+    if (translation_curve_->dim() != 3) {
+      throw std::invalid_argument("Translation curve should always be of dimension 3");
+    }
+  }
+
+  static void check_batch_range(const Eigen::Ref<const time_vector_t>& times, const Eigen::Index first,
+                                const Eigen::Index last) {
+    if (first < 0 || first > last || last > times.size()) {
+      throw std::invalid_argument("SE3Curve::evaluate_batch: [first, last[ should be a range of the time grid.");
+    }
+  }
+
   void safe_check() {
     if (Safe) {
       if (T_min_ > T_max_) {
@@ -256,6 +432,103 @@ struct SE3Curve : public curve_abc<Time, Numeric, Safe, Eigen::Transform<Numeric
 
 };  // SE3Curve
 
+/// \brief Evaluation of a piecewise SE3 curve on a time grid.
+/// The segment containing each time is found with a cursor, so the lookup is amortized O(1) for increasing times.
+/// Segments of type SE3Curve are evaluated in quaternion form, other segments are evaluated with evaluate_into.
+/// \param curve : the piecewise curve to evaluate.
+/// \param times : the times when to evaluate the curve.
+/// \param translations : 3 x N matrix, column i is filled with the translation at times[i].
+/// \param quaternions : 4 x N matrix, column i is filled with the coefficients (x, y, z, w) of the rotation at
+/// times[i].
+template <typename Time, typename Numeric, bool Safe>
+void evaluate_batch(const piecewise_curve<Time, Numeric, Safe, typename SE3Curve<Time, Numeric, Safe>::point_t,
+                                          typename SE3Curve<Time, Numeric, Safe>::point_derivate_t,
+                                          typename SE3Curve<Time, Numeric, Safe>::curve_abc_t>& curve,
+                    const Eigen::Ref<const typename SE3Curve<Time, Numeric, Safe>::time_vector_t>& times,
+                    Eigen::Ref<typename SE3Curve<Time, Numeric, Safe>::translations_t> translations,
+                    Eigen::Ref<typename SE3Curve<Time, Numeric, Safe>::quaternions_t> quaternions) {
+  typedef SE3Curve<Time, Numeric, Safe> SE3Curve_t;
+  if (translations.cols() != times.size() || quaternions.cols() != times.size()) {
+    throw std::invalid_argument("evaluate_batch: output buffers should have one column per time.");
+  }
+  if (Safe) {
+    for (Eigen::Index i = 0; i < times.size(); ++i) {
+      if (!(curve.min() <= times[i] && times[i] <= curve.max())) {
+        throw std::out_of_range("can't evaluate piecewise curve, out of range");
+      }
+    }
+  }
+  std::size_t cursor = 0;
+  Eigen::Index first = 0;
+  while (first < times.size()) {
+    // find the range of consecutive times evaluated by the same segment:
+    cursor = curve.find_interval_from(times[first], cursor);
+    Eigen::Index last = first + 1;
+    while (last < times.size() && curve.find_interval_from(times[last], cursor) == cursor) {
+      ++last;
+    }
+    const typename SE3Curve_t::curve_abc_t* segment = &curve.curve_ref_at_index(cursor);
+    const SE3Curve_t* se3 = dynamic_cast<const SE3Curve_t*>(segment);
+    if (se3) {
+      se3->evaluate_batch(times, first, last, translations, quaternions);
+    } else {
+      typename SE3Curve_t::transform_t pose;
+      for (Eigen::Index i = first; i < last; ++i) {
+        segment->evaluate_into(times[i], pose);
+        translations.col(i) = pose.translation();
+        quaternions.col(i) = typename SE3Curve_t::Quaternion(pose.rotation()).coeffs();
+      }
+    }
+    first = last;
+  }
+}
+
+/// \brief Evaluation of a piecewise SE3 curve on a time grid, as 3x4 matrices [R | p].
+/// Each segment writes its samples directly in transforms, see the function above.
+/// \param curve : the piecewise curve to evaluate.
+/// \param times : the times when to evaluate the curve.
+/// \param transforms : 3 x 4N matrix, the columns [4i, 4i+4[ are filled with the transform at times[i].
+template <typename Time, typename Numeric, bool Safe>
+void evaluate_batch(const piecewise_curve<Time, Numeric, Safe, typename SE3Curve<Time, Numeric, Safe>::point_t,
+                                          typename SE3Curve<Time, Numeric, Safe>::point_derivate_t,
+                                          typename SE3Curve<Time, Numeric, Safe>::curve_abc_t>& curve,
+                    const Eigen::Ref<const typename SE3Curve<Time, Numeric, Safe>::time_vector_t>& times,
+                    Eigen::Ref<typename SE3Curve<Time, Numeric, Safe>::transforms_t> transforms) {
+  typedef SE3Curve<Time, Numeric, Safe> SE3Curve_t;
+  if (transforms.cols() != 4 * times.size()) {
+    throw std::invalid_argument("evaluate_batch: output buffer should have four columns per time.");
+  }
+  if (Safe) {
+    for (Eigen::Index i = 0; i < times.size(); ++i) {
+      if (!(curve.min() <= times[i] && times[i] <= curve.max())) {
+        throw std::out_of_range("can't evaluate piecewise curve, out of range");
+      }
+    }
+  }
+  std::size_t cursor = 0;
+  Eigen::Index first = 0;
+  while (first < times.size()) {
+    // find the range of consecutive times evaluated by the same segment:
+    cursor = curve.find_interval_from(times[first], cursor);
+    Eigen::Index last = first + 1;
+    while (last < times.size() && curve.find_interval_from(times[last], cursor) == cursor) {
+      ++last;
+    }
+    const typename SE3Curve_t::curve_abc_t* segment = &curve.curve_ref_at_index(cursor);
+    const SE3Curve_t* se3 = dynamic_cast<const SE3Curve_t*>(segment);
+    if (se3) {
+      se3->evaluate_batch(times, first, last, transforms);
+    } else {
+      typename SE3Curve_t::transform_t pose;
+      for (Eigen::Index i = first; i < last; ++i) {
+        segment->evaluate_into(times[i], pose);
+        transforms.template block<3, 4>(0, 4 * i) = pose.matrix().template topRows<3>();
+      }
+    }
+    first = last;
+  }
+}
+
 }  // namespace ndcurves
 
 DEFINE_CLASS_TEMPLATE_VERSION(SINGLE_ARG(typename Time, typename Numeric, bool Safe),
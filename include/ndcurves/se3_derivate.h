@@ -0,0 +1,246 @@
+#ifndef _STRUCT_SE3_DERIVATE_H
+#define _STRUCT_SE3_DERIVATE_H
+
+#include "MathDefs.h"
+#include "curve_abc.h"
+#include <Eigen/Dense>
+
+namespace ndcurves {
+
+/// \class SE3Derivate.
+/// \brief Derivative of a SE3Curve: composition of the derivative of the translation curve and of the derivative of
+/// the rotation curve.
+/// The output is a vector of size 6 (linear_x,linear_y,linear_z,angular_x,angular_y,angular_z), this is the same
+/// vector as the one returned by SE3Curve::derivate.
+///
+template <typename Time = double, typename Numeric = Time, bool Safe = false>
+struct SE3Derivate : public curve_abc<Time, Numeric, Safe, Eigen::Matrix<Numeric, 6, 1> > {
+  typedef Numeric Scalar;
+  typedef Eigen::Matrix<Scalar, 3, 1> point3_t;
+  typedef Eigen::Matrix<Scalar, Eigen::Dynamic, 1> pointX_t;
+  typedef Eigen::Matrix<Scalar, 6, 1> point_t;
+  typedef point_t point_derivate_t;
+  typedef Time time_t;
+  typedef curve_abc<Time, Numeric, Safe, point_t> curve_abc_t;  // parent class
+  typedef SE3Derivate<Time, Numeric, Safe> SE3Derivate_t;
+  typedef SE3Derivate_t curve_derivate_t;
+  typedef curve_abc<Time, Numeric, Safe, pointX_t> curve_X_t;  // type of the linear part
+  typedef curve_abc<Time, Numeric, Safe, point3_t> curve_3_t;  // type of the angular part
+  typedef boost::shared_ptr<curve_X_t> curve_ptr_t;
+  typedef boost::shared_ptr<curve_3_t> curve3_ptr_t;
+
+ public:
+  /* Constructors - destructors */
+  /// \brief Empty constructor. Curve obtained this way can not perform other class functions.
+  ///
+  SE3Derivate() : curve_abc_t(), dim_(6), linear_curve_(), angular_curve_(), T_min_(0), T_max_(0) {}
+
+  /// \brief Constructor from the linear and angular parts.
+  /// \param linear_curve : derivative of the translation curve, of dimension 3.
+  /// \param angular_curve : derivative of the rotation curve, defined on the same time interval.
+  SE3Derivate(curve_ptr_t linear_curve, curve3_ptr_t angular_curve)
+      : curve_abc_t(),
+        dim_(6),
+        linear_curve_(linear_curve),
+        angular_curve_(angular_curve),
+        T_min_(linear_curve->min()),
+        T_max_(linear_curve->max()) {
+    if (linear_curve->dim() != 3) {
+      throw std::invalid_argument("The linear curve should be of dimension 3.");
+    }
+    if (angular_curve->min() != T_min_) {
+      throw std::invalid_argument("Min bounds of linear and angular curve are not the same.");
+    }
+    if (angular_curve->max() != T_max_) {
+      throw std::invalid_argument("Max bounds of linear and angular curve are not the same.");
+    }
+    safe_check();
+  }
+
+  /// \brief Destructor
+  ~SE3Derivate() {}
+
+  ///  \brief Evaluation of the SE3Derivate at time t
+  ///  \param t : time when to evaluate the curve.
+  ///  \return \f$x(t)\f$ point corresponding on curve at time t. (linear_x,linear_y,linear_z,angular_x,angular_y,
+  ///  angular_z)
+  virtual point_t operator()(const time_t t) const {
+    CURVES_INSTRUMENT_SCOPE(EVALUATE, this);
+    point_t res;
+    res.template head<3>() = point3_t((*linear_curve_)(t));
+    res.template tail<3>() = (*angular_curve_)(t);
+    return res;
+  }
+
+  /**
+   * @brief isApprox check if other and *this are approximately equals.
+   * Only two curves of the same class can be approximately equals, for comparison between different type of curves see
+   * isEquivalent
+   * @param other the other curve to check
+   * @param prec the precision treshold, default Eigen::NumTraits<Numeric>::dummy_precision()
+   * @return true is the two curves are approximately equals
+   */
+  bool isApprox(const SE3Derivate_t& other, const Numeric prec = Eigen::NumTraits<Numeric>::dummy_precision()) const {
+    return ndcurves::isApprox<Numeric>(T_min_, other.min()) && ndcurves::isApprox<Numeric>(T_max_, other.max()) &&
+           (linear_curve_ == other.linear_curve_ || linear_curve_->isApprox(other.linear_curve_.get(), prec)) &&
+           (angular_curve_ == other.angular_curve_ || angular_curve_->isApprox(other.angular_curve_.get(), prec));
+  }
+
+  virtual bool isApprox(const curve_abc_t* other,
+                        const Numeric prec = Eigen::NumTraits<Numeric>::dummy_precision()) const {
+    const SE3Derivate_t* other_cast = dynamic_cast<const SE3Derivate_t*>(other);
+    if (other_cast)
+      return isApprox(*other_cast, prec);
+    else
+      return false;
+  }
+
+  virtual bool operator==(const SE3Derivate_t& other) const { return isApprox(other); }
+
+  virtual bool operator!=(const SE3Derivate_t& other) const { return !(*this == other); }
+
+  ///  \brief Evaluation of the derivative of order N of the curve at time t.
+  ///  \param t : the time when to evaluate the curve.
+  ///  \param order : order of derivative.
+  ///  \return \f$\frac{d^Nx(t)}{dt^N}\f$ point corresponding on derivative curve at time t.
+  virtual point_derivate_t derivate(const time_t t, const std::size_t order) const {
+    CURVES_INSTRUMENT_SCOPE(DERIVATE, this);
+    point_derivate_t res;
+    res.template head<3>() = point3_t(linear_curve_->derivate(t, order));
+    res.template tail<3>() = angular_curve_->derivate(t, order);
+    return res;
+  }
+
+  ///  \brief Evaluation of the SE3Derivate at time t, written in out.
+  ///  Does not allocate if the linear and angular curves do not allocate in their own evaluate_into.
+  ///  \param t : time when to evaluate the curve.
+  ///  \param out : \f$x(t)\f$ point corresponding on curve at time t.
+  virtual void evaluate_into(const time_t t, typename curve_abc_t::point_out_t out) const {
+    linear_curve_->evaluate_into(t, out.template head<3>());
+    angular_curve_->evaluate_into(t, out.template tail<3>());
+  }
+
+  ///  \brief Evaluation of the derivative of order N of the curve at time t, written in out.
+  ///  Does not allocate if the linear and angular curves do not allocate in their own derivate_into.
+  ///  \param t : the time when to evaluate the curve.
+  ///  \param order : order of derivative.
+  ///  \param out : \f$\frac{d^Nx(t)}{dt^N}\f$ point corresponding on derivative curve at time t.
+  virtual void derivate_into(const time_t t, const std::size_t order,
+                             typename curve_abc_t::point_derivate_out_t out) const {
+    linear_curve_->derivate_into(t, order, out.template head<3>());
+    angular_curve_->derivate_into(t, order, out.template tail<3>());
+  }
+
+  ///  \brief Real-time safe evaluation of the SE3Derivate at time t, see curve_abc::evaluate_rt.
+  ///  Real-time safe if the linear and angular curves implement evaluate_rt.
+  ///  \param t : time when to evaluate the curve, clamped in [Tmin, Tmax].
+  ///  \param out : \f$x(t)\f$ point corresponding on curve at time t.
+  ///  \return EVAL_OK or EVAL_CLAMPED if out was written, the reason of the failure otherwise.
+  virtual eval_status evaluate_rt(const time_t t, typename curve_abc_t::point_out_t out) const noexcept {
+    if (!linear_curve_ || !angular_curve_) return EVAL_EMPTY;
+    time_t tc(t);
+    const eval_status status = clamp_time(tc, T_min_, T_max_);
+    eval_status status_curve = linear_curve_->evaluate_rt(tc, out.template head<3>());
+    if (!eval_succeeded(status_curve)) return status_curve;
+    status_curve = angular_curve_->evaluate_rt(tc, out.template tail<3>());
+    return eval_succeeded(status_curve) ? status : status_curve;
+  }
+
+  ///  \brief Real-time safe evaluation of the derivative of order N at time t, see curve_abc::derivate_rt.
+  ///  Real-time safe if the linear and angular curves implement derivate_rt.
+  ///  \param t : the time when to evaluate the curve, clamped in [Tmin, Tmax].
+  ///  \param order : order of derivative.
+  ///  \param out : \f$\frac{d^Nx(t)}{dt^N}\f$ point corresponding on derivative curve at time t.
+  ///  \return EVAL_OK or EVAL_CLAMPED if out was written, the reason of the failure otherwise.
+  virtual eval_status derivate_rt(const time_t t, const std::size_t order,
+                                  typename curve_abc_t::point_derivate_out_t out) const noexcept {
+    if (!linear_curve_ || !angular_curve_) return EVAL_EMPTY;
+    time_t tc(t);
+    const eval_status status = clamp_time(tc, T_min_, T_max_);
+    eval_status status_curve = linear_curve_->derivate_rt(tc, order, out.template head<3>());
+    if (!eval_succeeded(status_curve)) return status_curve;
+    status_curve = angular_curve_->derivate_rt(tc, order, out.template tail<3>());
+    return eval_succeeded(status_curve) ? status : status_curve;
+  }
+
+  curve_derivate_t compute_derivate(const std::size_t order) const {
+    CURVES_INSTRUMENT_SCOPE(COMPUTE_DERIVATE, this);
+    curve_ptr_t linear(linear_curve_->compute_derivate_ptr(order));
+    curve3_ptr_t angular(angular_curve_->compute_derivate_ptr(order));
+    return curve_derivate_t(linear, angular);
+  }
+
+  ///  \brief Compute the derived curve at order N.
+  ///  \param order : order of derivative.
+  ///  \return A pointer to \f$\frac{d^Nx(t)}{dt^N}\f$ derivative order N of the curve.
+  curve_derivate_t* compute_derivate_ptr(const std::size_t order) const {
+    return new curve_derivate_t(compute_derivate(order));
+  }
+
+  /*Helpers*/
+  /// \brief Get dimension of curve.
+  /// \return dimension of curve.
+  std::size_t virtual dim() const { return dim_; };
+  /// \brief Get the minimum time for which the curve is defined
+  /// \return \f$t_{min}\f$ lower bound of time range.
+  time_t min() const { return T_min_; }
+  /// \brief Get the maximum time for which the curve is defined.
+  /// \return \f$t_{max}\f$ upper bound of time range.
+  time_t max() const { return T_max_; }
+  /// \brief Get the degree of the curve.
+  /// \return \f$degree\f$, the degree of the curve.
+  virtual std::size_t degree() const { return std::max(linear_curve_->degree(), angular_curve_->degree()); }
+  /// \brief Get the memory used by the curve, by category. See footprint.
+  virtual footprint memory_footprint() const {
+    footprint res;
+    res.add(footprint::OBJECTS, sizeof(*this));
+    add_shared_footprint(res, linear_curve_);
+    add_shared_footprint(res, angular_curve_);
+    return res;
+  }
+  /// \brief const accessor to the linear curve
+  const curve_ptr_t linear_curve() const { return linear_curve_; }
+  /// \brief const accessor to the angular curve
+  const curve3_ptr_t angular_curve() const { return angular_curve_; }
+  /*Helpers*/
+
+  /*Attributes*/
+  std::size_t dim_;
+  curve_ptr_t linear_curve_;
+  curve3_ptr_t angular_curve_;
+  time_t T_min_, T_max_;
+  /*Attributes*/
+
+  // Serialization of the class
+  friend class boost::serialization::access;
+
+  template <class Archive>
+  void serialize(Archive& ar, const unsigned int version) {
+    if (version) {
+      // Do something depending on version ?
+    }
+    ar& BOOST_SERIALIZATION_BASE_OBJECT_NVP(curve_abc_t);
+    ar& boost::serialization::make_nvp("dim", dim_);
+    ar& boost::serialization::make_nvp("linear_curve", linear_curve_);
+    ar& boost::serialization::make_nvp("angular_curve", angular_curve_);
+    ar& boost::serialization::make_nvp("T_min", T_min_);
+    ar& boost::serialization::make_nvp("T_max", T_max_);
+  }
+
+ private:
+  void safe_check() {
+    if (Safe) {
+      if (T_min_ > T_max_) {
+        throw std::invalid_argument("Tmin should be inferior to Tmax");
+      }
+    }
+  }
+
+};  // SE3Derivate
+
+}  // namespace ndcurves
+
+DEFINE_CLASS_TEMPLATE_VERSION(SINGLE_ARG(typename Time, typename Numeric, bool Safe),
+                              SINGLE_ARG(ndcurves::SE3Derivate<Time, Numeric, Safe>))
+
+#endif  // _STRUCT_SE3_DERIVATE_H
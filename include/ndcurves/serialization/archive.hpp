@@ -13,12 +13,13 @@
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/archive/binary_oarchive.hpp>
 #include <boost/serialization/version.hpp>
+#include "../instrumentation.h"
 
 /* Define the current version number for the serialization
  * Must be increased everytime the save() method of a class is modified
  * Or when a change is made to register_types()
  * */
-const unsigned int CURVES_API_VERSION = 1;
+const unsigned int CURVES_API_VERSION = 7;
 
 #define SINGLE_ARG(...) __VA_ARGS__ // Macro used to be able to put comma in the following macro arguments
 // Macro used to define the serialization version of a templated class
@@ -51,6 +52,7 @@ struct Serializable {
   /// \brief Loads a Derived object from a text file.
   template <class Derived>
   void loadFromText(const std::string& filename) {
+    CURVES_INSTRUMENT_SCOPE(LOAD, &derived<Derived>());
     std::ifstream ifs(filename.c_str());
     if (ifs) {
       boost::archive::text_iarchive ia(ifs);
@@ -64,6 +66,7 @@ struct Serializable {
   /// \brief Saved a Derived object as a text file.
   template <class Derived>
   void saveAsText(const std::string& filename) const {
+    CURVES_INSTRUMENT_SCOPE(SAVE, &derived<Derived>());
     std::ofstream ofs(filename.c_str());
     if (ofs) {
       boost::archive::text_oarchive oa(ofs);
@@ -77,6 +80,7 @@ struct Serializable {
   /// \brief Loads a Derived object from an XML file.
   template <class Derived>
   void loadFromXML(const std::string& filename, const std::string& tag_name) {
+    CURVES_INSTRUMENT_SCOPE(LOAD, &derived<Derived>());
     if (tag_name.empty()) {
       throw std::invalid_argument("tag_name cannot be empty.");
     }
@@ -93,6 +97,7 @@ struct Serializable {
   /// \brief Saved a Derived object as an XML file.
   template <class Derived>
   void saveAsXML(const std::string& filename, const std::string& tag_name) const {
+    CURVES_INSTRUMENT_SCOPE(SAVE, &derived<Derived>());
     if (tag_name.empty()) {
       throw std::invalid_argument("tag_name cannot be empty.");
     }
@@ -109,6 +114,7 @@ struct Serializable {
   /// \brief Loads a Derived object from an binary file.
   template <class Derived>
   void loadFromBinary(const std::string& filename) {
+    CURVES_INSTRUMENT_SCOPE(LOAD, &derived<Derived>());
     std::ifstream ifs(filename.c_str());
     if (ifs) {
       boost::archive::binary_iarchive ia(ifs);
@@ -122,6 +128,7 @@ struct Serializable {
   /// \brief Saved a Derived object as an binary file.
   template <class Derived>
   void saveAsBinary(const std::string& filename) const {
+    CURVES_INSTRUMENT_SCOPE(SAVE, &derived<Derived>());
     std::ofstream ofs(filename.c_str());
     if (ofs) {
       boost::archive::binary_oarchive oa(ofs);
@@ -15,12 +15,15 @@
 #include "registeration.hpp"
 #include "ndcurves/curve_abc.h"
 #include "ndcurves/so3_linear.h"
+#include "ndcurves/so3_bezier.h"
 #include "ndcurves/se3_curve.h"
+#include "ndcurves/se3_derivate.h"
 #include "ndcurves/sinusoidal.h"
 #include "ndcurves/polynomial.h"
 #include "ndcurves/bezier_curve.h"
 #include "ndcurves/constant_curve.h"
 #include "ndcurves/piecewise_curve.h"
+#include "ndcurves/piecewise_variant_curve.h"
 #include "ndcurves/exact_cubic.h"
 #include "ndcurves/cubic_hermite_spline.h"
 
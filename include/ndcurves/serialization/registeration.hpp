@@ -50,6 +50,45 @@ void register_types(Archive& ar,  const unsigned int version) {
     ar.template register_type<sinusoidal_t>();
     ar.template register_type<constant_t>();
   }
+  if(version >= 2){
+    ar.template register_type<SO3Bezier_t>();
+  }
+  if(version >= 3){
+    ar.template register_type<SE3Derivate_t>();
+  }
+  if(version >= 4){
+    ar.template register_type<polynomialf_t>();
+    ar.template register_type<exact_cubicf_t>();
+    ar.template register_type<bezierf_t>();
+    ar.template register_type<cubic_hermite_splinef_t>();
+    ar.template register_type<piecewisef_t>();
+    ar.template register_type<constantf_t>();
+    ar.template register_type<sinusoidalf_t>();
+    ar.template register_type<polynomial3f_t>();
+    ar.template register_type<bezier3f_t>();
+    ar.template register_type<cubic_hermite_spline3f_t>();
+    ar.template register_type<constant3f_t>();
+    ar.template register_type<piecewise3f_t>();
+    ar.template register_type<SO3Linearf_t>();
+    ar.template register_type<SO3Bezierf_t>();
+    ar.template register_type<SE3Curvef_t>();
+    ar.template register_type<SE3Derivatef_t>();
+    ar.template register_type<piecewise_SE3f_t>();
+  }
+  if(version >= 5){
+    ar.template register_type<piecewise_polynomial_value_t>();
+    ar.template register_type<piecewise_bezier_value_t>();
+    ar.template register_type<piecewise_polynomial3_value_t>();
+    ar.template register_type<piecewise_bezier3_value_t>();
+  }
+  if(version >= 6){
+    ar.template register_type<piecewise_variant_t>();
+    ar.template register_type<piecewise_variant3_t>();
+  }
+  if(version >= 7){
+    ar.template register_type<SO3BezierDerivate_t>();
+    ar.template register_type<SO3BezierDerivatef_t>();
+  }
 }
 
 }  // namespace serialization
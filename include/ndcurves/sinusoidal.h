@@ -26,6 +26,7 @@ struct sinusoidal : public curve_abc<Time, Numeric, Safe, Point> {
   typedef Numeric num_t;
   typedef sinusoidal<Time, Numeric, Safe, Point> sinusoidal_t;
   typedef curve_abc<Time, Numeric, Safe, Point> curve_abc_t;  // parent class
+  typedef typename curve_abc_t::point_out_t point_out_t;
 
   /* Constructors - destructors */
  public:
@@ -98,6 +99,7 @@ struct sinusoidal : public curve_abc<Time, Numeric, Safe, Point> {
   ///  \param t : time when to evaluate the spine
   ///  \return \f$x(t)\f$, point corresponding on curve at time t.
   virtual point_t operator()(const time_t t) const {
+    CURVES_INSTRUMENT_SCOPE(EVALUATE, this);
     if (Safe && (t < T_min_ || t > T_max_)) {
       throw std::invalid_argument(
           "error in sinusoidal curve : time t to evaluate should be in range [Tmin, Tmax] of the curve");
@@ -110,6 +112,7 @@ struct sinusoidal : public curve_abc<Time, Numeric, Safe, Point> {
   /// \param order : order of derivative.
   /// \return \f$\frac{d^Nx(t)}{dt^N}\f$, point corresponding on derivative curve of order N at time t.
   virtual point_derivate_t derivate(const time_t t, const std::size_t order) const {
+    CURVES_INSTRUMENT_SCOPE(DERIVATE, this);
     if (Safe && (t < T_min_ || t > T_max_)) {
       throw std::invalid_argument(
           "error in constant curve : time t to derivate should be in range [Tmin, Tmax] of the curve");
@@ -119,11 +122,66 @@ struct sinusoidal : public curve_abc<Time, Numeric, Safe, Point> {
            sin(two_pi_f(t) + phi_ + (M_PI * static_cast<num_t>(order) / 2.));
   }
 
+  ///  \brief Evaluation of the curve at time t, written in out without allocation.
+  ///  \param t : time when to evaluate the curve.
+  ///  \param out : \f$x(t)\f$, point corresponding on curve at time t.
+  virtual void evaluate_into(const time_t t, point_out_t out) const {
+    if (Safe && (t < T_min_ || t > T_max_)) {
+      throw std::invalid_argument(
+          "error in sinusoidal curve : time t to evaluate should be in range [Tmin, Tmax] of the curve");
+    }
+    out = p0_ + amplitude_ * num_t(sin(two_pi_f(t) + phi_));
+  }
+
+  /// \brief Evaluate the derivative of order N of curve at time t, written in out without allocation.
+  /// \param t : time when to evaluate the spline.
+  /// \param order : order of derivative.
+  /// \param out : \f$\frac{d^Nx(t)}{dt^N}\f$, point corresponding on derivative curve of order N at time t.
+  virtual void derivate_into(const time_t t, const std::size_t order, point_out_t out) const {
+    if (Safe && (t < T_min_ || t > T_max_)) {
+      throw std::invalid_argument(
+          "error in constant curve : time t to derivate should be in range [Tmin, Tmax] of the curve");
+    }
+    if (order <= 0) throw std::invalid_argument("Order must be strictly positive");
+    out = amplitude_ * num_t(pow(2. * M_PI / T_, static_cast<num_t>(order)) *
+                             sin(two_pi_f(t) + phi_ + (M_PI * static_cast<num_t>(order) / 2.)));
+  }
+
+  ///  \brief Real-time safe evaluation of the curve at time t, see curve_abc::evaluate_rt.
+  ///  \param t : time when to evaluate the curve, clamped in [Tmin, Tmax].
+  ///  \param out : \f$x(t)\f$, point corresponding on curve at time t.
+  ///  \return EVAL_OK or EVAL_CLAMPED if out was written, the reason of the failure otherwise.
+  virtual eval_status evaluate_rt(const time_t t, point_out_t out) const noexcept {
+    if (dim_ == 0) return EVAL_EMPTY;
+    if (!point_out<point_t>::valid_size(out, dim_)) return EVAL_INVALID_SIZE;
+    time_t tc(t);
+    const eval_status status = clamp_time(tc, T_min_, T_max_);
+    out = p0_ + amplitude_ * num_t(sin(two_pi_f(tc) + phi_));
+    return status;
+  }
+
+  /// \brief Real-time safe evaluation of the derivative of order N at time t, see curve_abc::derivate_rt.
+  /// \param t : time when to evaluate the spline, clamped in [Tmin, Tmax].
+  /// \param order : order of derivative, strictly positive.
+  /// \param out : \f$\frac{d^Nx(t)}{dt^N}\f$, point corresponding on derivative curve of order N at time t.
+  /// \return EVAL_OK or EVAL_CLAMPED if out was written, the reason of the failure otherwise.
+  virtual eval_status derivate_rt(const time_t t, const std::size_t order, point_out_t out) const noexcept {
+    if (dim_ == 0) return EVAL_EMPTY;
+    if (order == 0) return EVAL_INVALID_ORDER;
+    if (!point_out<point_t>::valid_size(out, dim_)) return EVAL_INVALID_SIZE;
+    time_t tc(t);
+    const eval_status status = clamp_time(tc, T_min_, T_max_);
+    out = amplitude_ * num_t(pow(2. * M_PI / T_, static_cast<num_t>(order)) *
+                             sin(two_pi_f(tc) + phi_ + (M_PI * static_cast<num_t>(order) / 2.)));
+    return status;
+  }
+
   ///  \brief Compute the derived curve at order N.
   ///  Computes the derivative order N, \f$\frac{d^Nx(t)}{dt^N}\f$ of bezier curve of parametric equation x(t).
   ///  \param order : order of derivative.
   ///  \return \f$\frac{d^Nx(t)}{dt^N}\f$ derivative order N of the curve.
   sinusoidal_t compute_derivate(const std::size_t order) const {
+    CURVES_INSTRUMENT_SCOPE(COMPUTE_DERIVATE, this);
     if (order <= 0) throw std::invalid_argument("Order must be strictly positive");
     const point_t amplitude = amplitude_ * pow(2. * M_PI / T_, static_cast<num_t>(order));
     const time_t phi = phi_ + (M_PI * static_cast<num_t>(order) / 2.);
@@ -178,6 +236,14 @@ struct sinusoidal : public curve_abc<Time, Numeric, Safe, Point> {
   /// \brief Get the degree of the curve.
   /// \return \f$degree\f$, the degree of the curve.
   virtual std::size_t degree() const { return 1; }
+  /// \brief Get the memory used by the curve, by category. See footprint.
+  virtual footprint memory_footprint() const {
+    footprint res;
+    res.add(footprint::OBJECTS, sizeof(*this));
+    point_footprint<Point>::add(res, footprint::CONTROL_POINTS, p0_);
+    point_footprint<Point>::add(res, footprint::CONTROL_POINTS, amplitude_);
+    return res;
+  }
   /*Helpers*/
 
   /*Attributes*/
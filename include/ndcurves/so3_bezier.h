@@ -0,0 +1,554 @@
+/**
+ * \file so3_bezier.h
+ * \brief Smooth rotation curve defined as a cumulative Bezier curve in SO3.
+ * \date 10/2026
+ *
+ * This file contains the definition of the SO3Bezier struct.
+ * Given N+1 control rotations R_0 ... R_N, the rotation at the normalized time u is
+ * \f$ R(u) = R_0 \prod_{i=1}^{N} exp(\tilde{B}_i^N(u) \omega_i) \f$
+ * with \f$ \omega_i = log(R_{i-1}^T R_i) \f$ and \f$ \tilde{B}_i^N = \sum_{j=i}^{N} B_j^N \f$ the cumulative
+ * Bernstein polynomials. More details in the paper "A General Construction Scheme for Unit Quaternion Curves with
+ * Simple High Order Derivatives" by M.J. Kim, M.S. Kim and S.Y. Shin (SIGGRAPH 1995).
+ */
+
+#ifndef _STRUCT_SO3_BEZIER_H
+#define _STRUCT_SO3_BEZIER_H
+
+#include "MathDefs.h"
+
+#include "curve_abc.h"
+#include "bernstein.h"
+#include <Eigen/Geometry>
+#include <boost/math/constants/constants.hpp>
+
+#include <boost/serialization/shared_ptr.hpp>
+#include <boost/serialization/split_free.hpp>
+#include <boost/serialization/vector.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace ndcurves {
+
+template <typename Time, typename Numeric, bool Safe>
+struct SO3BezierDerivate;
+
+/// \class SO3Bezier.
+/// \brief Represents a smooth rotation curve of arbitrary degree, as a cumulative Bezier curve in SO3.
+/// The curve starts at the first control rotation and ends at the last one, the angular velocity is continuous and
+/// the angular velocity and acceleration are computed in closed form.
+/// As for SO3Linear, the derivatives are expressed in the local frame of the rotation.
+///
+template <typename Time = double, typename Numeric = Time, bool Safe = false>
+struct SO3Bezier : public curve_abc<Time, Numeric, Safe, Eigen::Matrix<Numeric, 3, 3>, Eigen::Matrix<Numeric, 3, 1> > {
+  typedef Numeric Scalar;
+  typedef Eigen::Matrix<Scalar, 3, 3> matrix3_t;
+  typedef Eigen::Matrix<Scalar, 3, 1> point3_t;
+  typedef std::vector<point3_t, Eigen::aligned_allocator<point3_t> > t_point3_t;
+  typedef matrix3_t point_t;
+  typedef point3_t point_derivate_t;
+  typedef Eigen::Quaternion<Scalar> quaternion_t;
+  typedef Time time_t;
+  typedef curve_abc<Time, Numeric, Safe, point_t, point_derivate_t> curve_abc_t;
+  typedef typename curve_abc_t::point_out_t point_out_t;
+  typedef typename curve_abc_t::point_derivate_out_t point_derivate_out_t;
+  typedef typename curve_abc_t::curve_derivate_t curve_derivate_t;
+  typedef std::vector<quaternion_t, Eigen::aligned_allocator<quaternion_t> > t_quaternion_t;
+  typedef std::vector<matrix3_t, Eigen::aligned_allocator<matrix3_t> > t_matrix3_t;
+  typedef Eigen::Matrix<Scalar, Eigen::Dynamic, 1> vector_x_t;
+  typedef SO3Bezier<Time, Numeric, Safe> SO3Bezier_t;
+
+ public:
+  /* Constructors - destructors */
+  /// \brief Empty constructor. Curve obtained this way can not perform other class functions.
+  ///
+  SO3Bezier() : curve_abc_t(), dim_(3), degree_(0), T_min_(0), T_max_(0) {}
+
+  /// \brief Constructor from the control rotations.
+  /// \param controlRotationsBegin : an iterator pointing to the first element of a container of rotations,
+  /// either quaternions or rotation matrices.
+  /// \param controlRotationsEnd   : an iterator pointing to the last element of the container.
+  /// \param t_min : lower bound of the time interval.
+  /// \param t_max : upper bound of the time interval.
+  template <typename In>
+  SO3Bezier(In controlRotationsBegin, In controlRotationsEnd, const time_t t_min = 0., const time_t t_max = 1.)
+      : curve_abc_t(), dim_(3), T_min_(t_min), T_max_(t_max) {
+    for (In it = controlRotationsBegin; it != controlRotationsEnd; ++it) {
+      control_rotations_.push_back(quaternion_t(*it).normalized());
+    }
+    if (control_rotations_.size() < 2) {
+      throw std::invalid_argument("SO3Bezier: at least two control rotations are required.");
+    }
+    degree_ = control_rotations_.size() - 1;
+    compute_relative_rotations();
+    safe_check();
+  }
+
+  /// \brief Destructor
+  ~SO3Bezier() {
+    // NOTHING
+  }
+
+  /*Operations*/
+  quaternion_t computeAsQuaternion(const time_t t) const {
+    check_if_not_empty();
+    if (Safe & !(T_min_ <= t && t <= T_max_)) {
+      throw std::invalid_argument("can't evaluate SO3Bezier curve, time t is out of range");
+    }
+    return rotation_unchecked(t);
+  }
+
+  ///  \brief Evaluation of the SO3Bezier at time t.
+  ///  \param t : time when to evaluate the curve.
+  ///  \return \f$x(t)\f$ rotation matrix corresponding on curve at time t.
+  virtual point_t operator()(const time_t t) const {
+    CURVES_INSTRUMENT_SCOPE(EVALUATE, this);
+    return computeAsQuaternion(t).toRotationMatrix();
+  }
+
+  /**
+   * @brief isApprox check if other and *this are approximately equals.
+   * Only two curves of the same class can be approximately equals, for comparison between different type of curves see
+   * isEquivalent
+   * @param other the other curve to check
+   * @param prec the precision treshold, default Eigen::NumTraits<Numeric>::dummy_precision()
+   * @return true is the two curves are approximately equals
+   */
+  bool isApprox(const SO3Bezier_t& other, const Numeric prec = Eigen::NumTraits<Numeric>::dummy_precision()) const {
+    bool equal = ndcurves::isApprox<Numeric>(T_min_, other.min()) && ndcurves::isApprox<Numeric>(T_max_, other.max()) &&
+                 dim_ == other.dim() && degree_ == other.degree();
+    if (!equal) return false;
+    for (std::size_t i = 0; i <= degree_; ++i) {
+      if (!control_rotations_[i].toRotationMatrix().isApprox(other.control_rotations_[i].toRotationMatrix(), prec))
+        return false;
+    }
+    return true;
+  }
+
+  virtual bool isApprox(const curve_abc_t* other,
+                        const Numeric prec = Eigen::NumTraits<Numeric>::dummy_precision()) const {
+    const SO3Bezier_t* other_cast = dynamic_cast<const SO3Bezier_t*>(other);
+    if (other_cast)
+      return isApprox(*other_cast, prec);
+    else
+      return false;
+  }
+
+  virtual bool operator==(const SO3Bezier_t& other) const { return isApprox(other); }
+
+  virtual bool operator!=(const SO3Bezier_t& other) const { return !(*this == other); }
+
+  ///  \brief Evaluation of the angular velocity (order 1) or angular acceleration (order 2) at time t.
+  ///  Both are expressed in the local frame and computed in closed form by differentiating the product of
+  ///  exponentials.
+  ///  \param t : the time when to evaluate the derivative.
+  ///  \param order : order of derivative, 1 or 2.
+  ///  \return \f$\frac{d^Nx(t)}{dt^N}\f$ derivative of order N at time t.
+  virtual point_derivate_t derivate(const time_t t, const std::size_t order) const {
+    CURVES_INSTRUMENT_SCOPE(DERIVATE, this);
+    check_if_not_empty();
+    if ((t < T_min_ || t > T_max_) && Safe) {
+      throw std::invalid_argument(
+          "error in SO3Bezier : time t to evaluate derivative should be in range [Tmin, Tmax] of the curve");
+    }
+    if (order == 0) {
+      throw std::invalid_argument("Order must be > 0 ");
+    }
+    if (order > 2) {
+      throw std::invalid_argument("SO3Bezier: derivatives are only implemented up to order 2.");
+    }
+    return derivate_unchecked(t, order);
+  }
+
+  ///  \brief Real-time safe evaluation of the SO3Bezier at time t, see curve_abc::evaluate_rt.
+  ///  \param t : time when to evaluate the curve, clamped in [Tmin, Tmax].
+  ///  \param out : \f$x(t)\f$ rotation matrix corresponding on curve at time t.
+  ///  \return EVAL_OK or EVAL_CLAMPED if out was written, the reason of the failure otherwise.
+  virtual eval_status evaluate_rt(const time_t t, point_out_t out) const noexcept {
+    if (control_rotations_.size() < 2) return EVAL_EMPTY;
+    time_t tc(t);
+    const eval_status status = clamp_time(tc, T_min_, T_max_);
+    out = rotation_unchecked(tc).toRotationMatrix();
+    return status;
+  }
+
+  ///  \brief Real-time safe evaluation of the angular velocity or acceleration at time t, see
+  ///  curve_abc::derivate_rt.
+  ///  \param t : the time when to evaluate the derivative, clamped in [Tmin, Tmax].
+  ///  \param order : order of derivative, 1 or 2.
+  ///  \param out : \f$\frac{d^Nx(t)}{dt^N}\f$ derivative of order N at time t.
+  ///  \return EVAL_OK or EVAL_CLAMPED if out was written, the reason of the failure otherwise.
+  virtual eval_status derivate_rt(const time_t t, const std::size_t order, point_derivate_out_t out) const noexcept {
+    if (control_rotations_.size() < 2) return EVAL_EMPTY;
+    if (order == 0 || order > 2) return EVAL_INVALID_ORDER;
+    time_t tc(t);
+    const eval_status status = clamp_time(tc, T_min_, T_max_);
+    out = derivate_unchecked(tc, order);
+    return status;
+  }
+
+  ///  \brief Compute the derived curve at order N.
+  ///  The angular velocity of this curve is not a polynomial, the derived curve is a SO3BezierDerivate that
+  ///  evaluates a copy of this curve.
+  ///  \param order : order of derivative, 1 or 2.
+  ///  \return \f$\frac{d^Nx(t)}{dt^N}\f$ derivative order N of the curve.
+  SO3BezierDerivate<Time, Numeric, Safe> compute_derivate(const std::size_t order) const;
+
+  ///  \brief Compute the derived curve at order N.
+  ///  \param order : order of derivative, 1 or 2.
+  ///  \return A pointer to \f$\frac{d^Nx(t)}{dt^N}\f$ derivative order N of the curve.
+  SO3BezierDerivate<Time, Numeric, Safe>* compute_derivate_ptr(const std::size_t order) const {
+    return new SO3BezierDerivate<Time, Numeric, Safe>(compute_derivate(order));
+  }
+
+  /*Helpers*/
+  /// \brief Get dimension of curve.
+  /// \return dimension of curve.
+  std::size_t virtual dim() const { return dim_; };
+  /// \brief Get the minimum time for which the curve is defined
+  /// \return \f$t_{min}\f$ lower bound of time range.
+  time_t min() const { return T_min_; }
+  /// \brief Get the maximum time for which the curve is defined.
+  /// \return \f$t_{max}\f$ upper bound of time range.
+  time_t max() const { return T_max_; }
+  /// \brief Get the degree of the curve.
+  /// \return \f$degree\f$, the degree of the curve.
+  virtual std::size_t degree() const { return degree_; }
+  /// \brief Get the memory used by the curve, by category. See footprint.
+  virtual footprint memory_footprint() const {
+    footprint res;
+    res.add(footprint::OBJECTS, sizeof(*this));
+    add_points_footprint(res, footprint::CONTROL_POINTS, control_rotations_);
+    add_points_footprint(res, footprint::CONTROL_POINTS, relative_rotations_);
+    return res;
+  }
+  /// \brief Get the control rotations of the curve, as rotation matrices.
+  t_matrix3_t getControlRotations() const {
+    t_matrix3_t res;
+    for (typename t_quaternion_t::const_iterator it = control_rotations_.begin(); it != control_rotations_.end();
+         ++it) {
+      res.push_back(it->toRotationMatrix());
+    }
+    return res;
+  }
+  matrix3_t getInitRotation() const { return control_rotations_.front().toRotationMatrix(); }
+  matrix3_t getEndRotation() const { return control_rotations_.back().toRotationMatrix(); }
+  /*Helpers*/
+
+  /*Attributes*/
+  std::size_t dim_;                  // const
+  t_quaternion_t control_rotations_;  // const
+  t_point3_t relative_rotations_;     // const, log(R_{i-1}^T R_i)
+  std::size_t degree_;               // const
+  time_t T_min_, T_max_;             // const
+  /*Attributes*/
+
+  // Serialization of the class
+  friend class boost::serialization::access;
+
+  template <class Archive>
+  void load(Archive& ar, const unsigned int version) {
+    if (version) {
+      // Do something depending on version ?
+    }
+    ar >> BOOST_SERIALIZATION_BASE_OBJECT_NVP(curve_abc_t);
+    ar >> boost::serialization::make_nvp("dim", dim_);
+    t_matrix3_t rotations;
+    ar >> boost::serialization::make_nvp("control_rotations", rotations);
+    ar >> boost::serialization::make_nvp("T_min", T_min_);
+    ar >> boost::serialization::make_nvp("T_max", T_max_);
+    control_rotations_.clear();
+    for (typename t_matrix3_t::const_iterator it = rotations.begin(); it != rotations.end(); ++it) {
+      control_rotations_.push_back(quaternion_t(*it));
+    }
+    degree_ = control_rotations_.empty() ? 0 : control_rotations_.size() - 1;
+    compute_relative_rotations();
+  }
+
+  template <class Archive>
+  void save(Archive& ar, const unsigned int version) const {
+    if (version) {
+      // Do something depending on version ?
+    }
+    ar << BOOST_SERIALIZATION_BASE_OBJECT_NVP(curve_abc_t);
+    ar << boost::serialization::make_nvp("dim", dim_);
+    t_matrix3_t rotations(getControlRotations());
+    ar << boost::serialization::make_nvp("control_rotations", rotations);
+    ar << boost::serialization::make_nvp("T_min", T_min_);
+    ar << boost::serialization::make_nvp("T_max", T_max_);
+  }
+
+  BOOST_SERIALIZATION_SPLIT_MEMBER()
+
+ private:
+  Scalar normalized_time(const time_t t) const noexcept { return (t - T_min_) / (T_max_ - T_min_); }
+
+  /// \brief Rotation at time t as a product of exponentials, without any check on t or on the control rotations.
+  quaternion_t rotation_unchecked(const time_t t) const noexcept {
+    if (t >= T_max_) return control_rotations_.back();
+    if (t <= T_min_) return control_rotations_.front();
+    const Scalar u = normalized_time(t);
+    quaternion_t res = control_rotations_.front();
+    Scalar b = Scalar(1);  // cumulative Bernstein polynomial of index i
+    for (std::size_t i = 1; i <= degree_; ++i) {
+      b -= bernstein(degree_, i - 1, u);
+      res = res * ndcurves::exp3(point3_t(b * relative_rotations_[i - 1]));
+    }
+    return res.normalized();
+  }
+
+  /// \brief Angular velocity (order 1) or acceleration (order 2) at time t, without any check on t, on the
+  /// order or on the control rotations.
+  point3_t derivate_unchecked(const time_t t, const std::size_t order) const noexcept {
+    if (T_min_ == T_max_) {
+      return point3_t::Zero();
+    }
+    const time_t T = T_max_ - T_min_;
+    const Scalar u = std::min(Scalar(1), std::max(Scalar(0), normalized_time(t)));
+    const Scalar n = Scalar(degree_);
+    // R = R_0 A_1 ... A_N with A_i = exp(b_i w_i). With w(k) and dw(k) the velocity and acceleration of the product
+    // R_0 A_1 ... A_k expressed in its local frame:
+    // w(k)  = A_k^T w(k-1) + b_k' w_k
+    // dw(k) = A_k^T dw(k-1) - b_k' w_k x w(k) + b_k'' w_k
+    // The cumulative Bernstein polynomial b_i and its derivatives are computed on the fly:
+    // b_i = b_{i-1} - B_{i-1}^N, b_i' = N B_{i-1}^{N-1}, b_i'' = N (N-1) (B_{i-2}^{N-2} - B_{i-1}^{N-2}).
+    point3_t omega = point3_t::Zero();
+    point3_t domega = point3_t::Zero();
+    Scalar b = Scalar(1);
+    for (std::size_t i = 1; i <= degree_; ++i) {
+      const point3_t& w = relative_rotations_[i - 1];
+      b -= bernstein(degree_, i - 1, u);
+      const Scalar db = n * bernstein(degree_ - 1, i - 1, u);
+      Scalar ddb = Scalar(0);
+      if (degree_ > 1) {
+        ddb = n * (n - Scalar(1)) *
+              ((i >= 2 ? bernstein(degree_ - 2, i - 2, u) : Scalar(0)) - bernstein(degree_ - 2, i - 1, u));
+      }
+      const quaternion_t A_inv = ndcurves::exp3(point3_t(b * w)).conjugate();
+      omega = A_inv * omega + db * w;
+      domega = A_inv * domega - db * w.cross(omega) + ddb * w;
+    }
+    if (order == 1) {
+      return omega / T;
+    }
+    return domega / (T * T);
+  }
+
+  /// \brief Value at u of the Bernstein polynomial \f$ B_j^N(u) = \binom{N}{j} u^j (1-u)^{N-j} \f$, zero if j > N.
+  /// Computed in closed form so that the evaluation does not allocate.
+  static Scalar bernstein(const std::size_t degree, const std::size_t j, const Scalar u) noexcept {
+    if (j > degree) return Scalar(0);
+    return Scalar(bin(unsigned(degree), unsigned(j))) * std::pow(u, Scalar(j)) *
+           std::pow(Scalar(1) - u, Scalar(degree - j));
+  }
+
+  void compute_relative_rotations() {
+    relative_rotations_.clear();
+    for (std::size_t i = 1; i < control_rotations_.size(); ++i) {
+      relative_rotations_.push_back(ndcurves::log3(control_rotations_[i - 1].conjugate() * control_rotations_[i]));
+    }
+  }
+
+  void check_if_not_empty() const {
+    if (control_rotations_.size() < 2) {
+      throw std::runtime_error("Error in SO3Bezier : there is no control rotations set / did you use empty constructor ?");
+    }
+  }
+
+  void safe_check() {
+    if (Safe) {
+      if (T_min_ > T_max_) {
+        throw std::invalid_argument("Tmin should be inferior to Tmax");
+      }
+    }
+  }
+
+};  // struct SO3Bezier
+
+/// \class SO3BezierDerivate.
+/// \brief Derivative of order N of a SO3Bezier: the angular velocity (N = 1) or acceleration (N = 2), expressed in
+/// the local frame. It holds the SO3Bezier and evaluates its derivative of order N + k, so it is only defined up
+/// to the order 2 of the SO3Bezier.
+///
+template <typename Time = double, typename Numeric = Time, bool Safe = false>
+struct SO3BezierDerivate : public curve_abc<Time, Numeric, Safe, Eigen::Matrix<Numeric, 3, 1> > {
+  typedef Numeric Scalar;
+  typedef Eigen::Matrix<Scalar, 3, 1> point_t;
+  typedef point_t point_derivate_t;
+  typedef Time time_t;
+  typedef curve_abc<Time, Numeric, Safe, point_t> curve_abc_t;  // parent class
+  typedef typename curve_abc_t::point_out_t point_out_t;
+  typedef SO3BezierDerivate<Time, Numeric, Safe> SO3BezierDerivate_t;
+  typedef SO3Bezier<Time, Numeric, Safe> SO3Bezier_t;
+  typedef boost::shared_ptr<SO3Bezier_t> SO3Bezier_ptr_t;
+
+ public:
+  /* Constructors - destructors */
+  /// \brief Empty constructor. Curve obtained this way can not perform other class functions.
+  ///
+  SO3BezierDerivate() : curve_abc_t(), curve_(), order_(0) {}
+
+  /// \brief Constructor.
+  /// \param curve : the derived SO3Bezier.
+  /// \param order : order of derivative, 1 or 2.
+  SO3BezierDerivate(const SO3Bezier_ptr_t& curve, const std::size_t order)
+      : curve_abc_t(), curve_(curve), order_(order) {
+    if (!curve_) {
+      throw std::invalid_argument("SO3BezierDerivate: the derived curve is not set.");
+    }
+    if (order_ == 0 || order_ > 2) {
+      throw std::invalid_argument("SO3BezierDerivate: the order of derivative should be 1 or 2.");
+    }
+  }
+
+  /// \brief Destructor
+  ~SO3BezierDerivate() {}
+
+  ///  \brief Evaluation of the SO3BezierDerivate at time t.
+  ///  \param t : time when to evaluate the curve.
+  ///  \return \f$x(t)\f$ derivative of order N of the SO3Bezier at time t.
+  virtual point_t operator()(const time_t t) const {
+    CURVES_INSTRUMENT_SCOPE(EVALUATE, this);
+    check_if_not_empty();
+    return curve_->derivate(t, order_);
+  }
+
+  /**
+   * @brief isApprox check if other and *this are approximately equals.
+   * Only two curves of the same class can be approximately equals, for comparison between different type of curves see
+   * isEquivalent
+   * @param other the other curve to check
+   * @param prec the precision treshold, default Eigen::NumTraits<Numeric>::dummy_precision()
+   * @return true is the two curves are approximately equals
+   */
+  bool isApprox(const SO3BezierDerivate_t& other,
+                const Numeric prec = Eigen::NumTraits<Numeric>::dummy_precision()) const {
+    if (order_ != other.order_ || !curve_ != !other.curve_) return false;
+    return curve_ == other.curve_ || curve_->isApprox(*other.curve_, prec);
+  }
+
+  virtual bool isApprox(const curve_abc_t* other,
+                        const Numeric prec = Eigen::NumTraits<Numeric>::dummy_precision()) const {
+    const SO3BezierDerivate_t* other_cast = dynamic_cast<const SO3BezierDerivate_t*>(other);
+    if (other_cast)
+      return isApprox(*other_cast, prec);
+    else
+      return false;
+  }
+
+  virtual bool operator==(const SO3BezierDerivate_t& other) const { return isApprox(other); }
+
+  virtual bool operator!=(const SO3BezierDerivate_t& other) const { return !(*this == other); }
+
+  ///  \brief Evaluation of the derivative of order k of the curve at time t.
+  ///  \param t : the time when to evaluate the curve.
+  ///  \param order : order of derivative k, N + k should not be greater than 2.
+  ///  \return \f$\frac{d^kx(t)}{dt^k}\f$ derivative of order N + k of the SO3Bezier at time t.
+  virtual point_derivate_t derivate(const time_t t, const std::size_t order) const {
+    CURVES_INSTRUMENT_SCOPE(DERIVATE, this);
+    check_if_not_empty();
+    return curve_->derivate(t, order_ + order);
+  }
+
+  ///  \brief Real-time safe evaluation of the SO3BezierDerivate at time t, see curve_abc::evaluate_rt.
+  ///  \param t : time when to evaluate the curve, clamped in [Tmin, Tmax].
+  ///  \param out : \f$x(t)\f$ derivative of order N of the SO3Bezier at time t.
+  ///  \return EVAL_OK or EVAL_CLAMPED if out was written, the reason of the failure otherwise.
+  virtual eval_status evaluate_rt(const time_t t, point_out_t out) const noexcept {
+    if (!curve_) return EVAL_EMPTY;
+    return curve_->derivate_rt(t, order_, out);
+  }
+
+  ///  \brief Real-time safe evaluation of the derivative of order k at time t, see curve_abc::derivate_rt.
+  ///  \param t : the time when to evaluate the derivative, clamped in [Tmin, Tmax].
+  ///  \param order : order of derivative k.
+  ///  \param out : \f$\frac{d^kx(t)}{dt^k}\f$ derivative of order N + k of the SO3Bezier at time t.
+  ///  \return EVAL_OK or EVAL_CLAMPED if out was written, the reason of the failure otherwise.
+  virtual eval_status derivate_rt(const time_t t, const std::size_t order, point_out_t out) const noexcept {
+    if (!curve_) return EVAL_EMPTY;
+    if (order == 0) return EVAL_INVALID_ORDER;
+    return curve_->derivate_rt(t, order_ + order, out);
+  }
+
+  SO3BezierDerivate_t compute_derivate(const std::size_t order) const {
+    CURVES_INSTRUMENT_SCOPE(COMPUTE_DERIVATE, this);
+    check_if_not_empty();
+    return SO3BezierDerivate_t(curve_, order_ + order);
+  }
+
+  ///  \brief Compute the derived curve at order k.
+  ///  \param order : order of derivative k, N + k should not be greater than 2.
+  ///  \return A pointer to \f$\frac{d^kx(t)}{dt^k}\f$ derivative order N + k of the SO3Bezier.
+  SO3BezierDerivate_t* compute_derivate_ptr(const std::size_t order) const {
+    return new SO3BezierDerivate_t(compute_derivate(order));
+  }
+
+  /*Helpers*/
+  /// \brief Get dimension of curve.
+  /// \return dimension of curve.
+  std::size_t virtual dim() const { return 3; };
+  /// \brief Get the minimum time for which the curve is defined
+  /// \return \f$t_{min}\f$ lower bound of time range.
+  time_t min() const { return curve_ ? curve_->min() : time_t(0); }
+  /// \brief Get the maximum time for which the curve is defined.
+  /// \return \f$t_{max}\f$ upper bound of time range.
+  time_t max() const { return curve_ ? curve_->max() : time_t(0); }
+  /// \brief Get the degree of the curve.
+  /// \return \f$degree\f$, the degree of the derived SO3Bezier.
+  virtual std::size_t degree() const { return curve_ ? curve_->degree() : 0; }
+  /// \brief Get the memory used by the curve, by category. See footprint.
+  virtual footprint memory_footprint() const {
+    footprint res;
+    res.add(footprint::OBJECTS, sizeof(*this));
+    add_shared_footprint(res, curve_);
+    return res;
+  }
+  /// \brief const accessor to the derived SO3Bezier
+  const SO3Bezier_ptr_t curve() const { return curve_; }
+  /// \brief Get the order of derivative N of this curve.
+  std::size_t order() const { return order_; }
+  /*Helpers*/
+
+  /*Attributes*/
+  SO3Bezier_ptr_t curve_;
+  std::size_t order_;
+  /*Attributes*/
+
+  // Serialization of the class
+  friend class boost::serialization::access;
+
+  template <class Archive>
+  void serialize(Archive& ar, const unsigned int version) {
+    if (version) {
+      // Do something depending on version ?
+    }
+    ar& BOOST_SERIALIZATION_BASE_OBJECT_NVP(curve_abc_t);
+    ar& boost::serialization::make_nvp("curve", curve_);
+    ar& boost::serialization::make_nvp("order", order_);
+  }
+
+ private:
+  void check_if_not_empty() const {
+    if (!curve_) {
+      throw std::runtime_error(
+          "Error in SO3BezierDerivate : the derived curve is not set / did you use empty constructor ?");
+    }
+  }
+
+};  // struct SO3BezierDerivate
+
+template <typename Time, typename Numeric, bool Safe>
+SO3BezierDerivate<Time, Numeric, Safe> SO3Bezier<Time, Numeric, Safe>::compute_derivate(
+    const std::size_t order) const {
+  CURVES_INSTRUMENT_SCOPE(COMPUTE_DERIVATE, this);
+  check_if_not_empty();
+  return SO3BezierDerivate<Time, Numeric, Safe>(boost::make_shared<SO3Bezier_t>(*this), order);
+}
+
+}  // namespace ndcurves
+
+DEFINE_CLASS_TEMPLATE_VERSION(SINGLE_ARG(typename Time, typename Numeric, bool Safe),
+                              SINGLE_ARG(ndcurves::SO3Bezier<Time, Numeric, Safe>))
+DEFINE_CLASS_TEMPLATE_VERSION(SINGLE_ARG(typename Time, typename Numeric, bool Safe),
+                              SINGLE_ARG(ndcurves::SO3BezierDerivate<Time, Numeric, Safe>))
+
+#endif  // _STRUCT_SO3_BEZIER_H
@@ -14,26 +14,42 @@
 namespace ndcurves {
 
 /// \class SO3Linear.
-/// \brief Represents a linear interpolation in SO3, using the slerp method provided by Eigen::Quaternion
-///
+/// \brief Represents a linear interpolation in SO3 (slerp).
+/// The angle and the axis of the relative rotation between the initial and final rotations are computed once at
+/// construction, so an evaluation only costs one sin / cos pair.
 ///
 template <typename Time = double, typename Numeric = Time, bool Safe = false>
-struct SO3Linear : public curve_abc<Time, Numeric, Safe, matrix3_t, point3_t > {
+struct SO3Linear : public curve_abc<Time, Numeric, Safe, Eigen::Matrix<Numeric, 3, 3>, Eigen::Matrix<Numeric, 3, 1> > {
   typedef Numeric Scalar;
+  typedef Eigen::Matrix<Scalar, 3, 3> matrix3_t;
+  typedef Eigen::Matrix<Scalar, 3, 1> point3_t;
   typedef matrix3_t point_t;
   typedef point3_t point_derivate_t;
   typedef Eigen::Quaternion<Scalar> quaternion_t;
   typedef Time time_t;
   typedef curve_abc<Time, Numeric, Safe, point_t, point_derivate_t> curve_abc_t;
+  typedef typename curve_abc_t::point_out_t point_out_t;
+  typedef typename curve_abc_t::point_derivate_out_t point_derivate_out_t;
   typedef constant_curve<Time, Numeric, Safe, point_derivate_t> curve_derivate_t;
   typedef SO3Linear<Time, Numeric, Safe> SO3Linear_t;
+  typedef Eigen::Matrix<Time, Eigen::Dynamic, 1> time_vector_t;
+  typedef Eigen::Matrix<Scalar, 4, Eigen::Dynamic> quaternions_t;  // one quaternion (x, y, z, w) per column
 
 
  public:
   /* Constructors - destructors */
   /// \brief Empty constructor. Curve obtained this way can not perform other class functions.
   ///
-  SO3Linear() : curve_abc_t(), dim_(3), init_rot_(), end_rot_(), angular_vel_(), T_min_(0), T_max_(0) {}
+  SO3Linear()
+      : curve_abc_t(),
+        dim_(3),
+        init_rot_(),
+        end_rot_(),
+        angular_vel_(),
+        T_min_(0),
+        T_max_(0),
+        half_angle_(0),
+        init_times_axis_() {}
 
   /// \brief constructor with initial and final rotation and time bounds
   SO3Linear(const quaternion_t& init_rot, const quaternion_t& end_rot, const time_t t_min, const time_t t_max)
@@ -44,6 +60,7 @@ struct SO3Linear : public curve_abc<Time, Numeric, Safe, matrix3_t, point3_t > {
         angular_vel_(computeAngularVelocity(init_rot.toRotationMatrix(), end_rot.toRotationMatrix(), t_min, t_max)),
         T_min_(t_min),
         T_max_(t_max) {
+    compute_slerp_constants();
     safe_check();
   }
 
@@ -56,6 +73,7 @@ struct SO3Linear : public curve_abc<Time, Numeric, Safe, matrix3_t, point3_t > {
         angular_vel_(computeAngularVelocity(init_rot, end_rot, t_min, t_max)),
         T_min_(t_min),
         T_max_(t_max) {
+    compute_slerp_constants();
     safe_check();
   }
 
@@ -68,6 +86,7 @@ struct SO3Linear : public curve_abc<Time, Numeric, Safe, matrix3_t, point3_t > {
         angular_vel_(computeAngularVelocity(init_rot.toRotationMatrix(), end_rot.toRotationMatrix(), 0., 1.)),
         T_min_(0.),
         T_max_(1.) {
+    compute_slerp_constants();
     safe_check();
   }
 
@@ -80,6 +99,7 @@ struct SO3Linear : public curve_abc<Time, Numeric, Safe, matrix3_t, point3_t > {
         angular_vel_(computeAngularVelocity(init_rot, end_rot, 0., 1.)),
         T_min_(0.),
         T_max_(1.) {
+    compute_slerp_constants();
     safe_check();
   }
 
@@ -94,9 +114,11 @@ struct SO3Linear : public curve_abc<Time, Numeric, Safe, matrix3_t, point3_t > {
         end_rot_(other.end_rot_),
         angular_vel_(other.angular_vel_),
         T_min_(other.T_min_),
-        T_max_(other.T_max_) {}
+        T_max_(other.T_max_),
+        half_angle_(other.half_angle_),
+        init_times_axis_(other.init_times_axis_) {}
 
-  point3_t computeAngularVelocity(const matrix3_t& init_rot, const matrix3_t& end_rot, const double t_min, const double t_max){
+  point3_t computeAngularVelocity(const matrix3_t& init_rot, const matrix3_t& end_rot, const time_t t_min, const time_t t_max){
     if(t_min == t_max){
       return point3_t::Zero();
     }else{
@@ -108,16 +130,48 @@ struct SO3Linear : public curve_abc<Time, Numeric, Safe, matrix3_t, point3_t > {
     if (Safe & !(T_min_ <= t && t <= T_max_)) {
       throw std::invalid_argument("can't evaluate bezier curve, time t is out of range");  // TODO
     }
-    if (t >= T_max_) return end_rot_;
-    if (t <= T_min_) return init_rot_;
-    Scalar u = (t - T_min_) / (T_max_ - T_min_);
-    return init_rot_.slerp(u, end_rot_);
+    return slerp(t);
+  }
+
+  ///  \brief Evaluation of the SO3Linear on a time grid.
+  ///  The sin and cos of all the samples are computed with Eigen array operations, which are vectorized.
+  ///  \param times : the times when to evaluate the curve.
+  ///  \param quaternions : 4 x N matrix, column i is filled with the coefficients (x, y, z, w) of the rotation at
+  ///  times[i].
+  void evaluate_batch(const Eigen::Ref<const time_vector_t>& times, Eigen::Ref<quaternions_t> quaternions) const {
+    if (quaternions.cols() != times.size()) {
+      throw std::invalid_argument("SO3Linear::evaluate_batch: output buffer should have one column per time.");
+    }
+    if (Safe) {
+      for (Eigen::Index i = 0; i < times.size(); ++i) {
+        if (!(T_min_ <= times[i] && times[i] <= T_max_)) {
+          throw std::invalid_argument("SO3Linear::evaluate_batch: time t is out of range");
+        }
+      }
+    }
+    if (T_max_ > T_min_) {
+      const Eigen::Array<Scalar, Eigen::Dynamic, 1> half_angles =
+          ((times.array() - T_min_) * (half_angle_ / (T_max_ - T_min_))).template cast<Scalar>();
+      quaternions.noalias() = init_rot_.coeffs() * half_angles.cos().matrix().transpose() +
+                              init_times_axis_.coeffs() * half_angles.sin().matrix().transpose();
+    }
+    // same values as computeAsQuaternion at the bounds:
+    for (Eigen::Index i = 0; i < times.size(); ++i) {
+      if (times[i] >= T_max_) {
+        quaternions.col(i) = end_rot_.coeffs();
+      } else if (times[i] <= T_min_) {
+        quaternions.col(i) = init_rot_.coeffs();
+      }
+    }
   }
 
   ///  \brief Evaluation of the SO3Linear at time t using Eigen slerp.
   ///  \param t : time when to evaluate the spline.
   ///  \return \f$x(t)\f$ point corresponding on spline at time t.
-  virtual point_t operator()(const time_t t) const { return computeAsQuaternion(t).toRotationMatrix(); }
+  virtual point_t operator()(const time_t t) const {
+    CURVES_INSTRUMENT_SCOPE(EVALUATE, this);
+    return computeAsQuaternion(t).toRotationMatrix();
+  }
 
   /**
    * @brief isApprox check if other and *this are approximately equals.
@@ -151,6 +205,7 @@ struct SO3Linear : public curve_abc<Time, Numeric, Safe, matrix3_t, point3_t > {
   ///  \param order : order of derivative.
   ///  \return \f$\frac{d^Nx(t)}{dt^N}\f$ point corresponding on derivative spline at time t.
   virtual point_derivate_t derivate(const time_t t, const std::size_t order) const {
+    CURVES_INSTRUMENT_SCOPE(DERIVATE, this);
     if ((t < T_min_ || t > T_max_) && Safe) {
       throw std::invalid_argument(
           "error in SO3_linear : time t to evaluate derivative should be in range [Tmin, Tmax] of the curve");
@@ -164,7 +219,36 @@ struct SO3Linear : public curve_abc<Time, Numeric, Safe, matrix3_t, point3_t > {
     }
   }
 
+  ///  \brief Real-time safe evaluation of the SO3Linear at time t, see curve_abc::evaluate_rt.
+  ///  \param t : time when to evaluate the spline, clamped in [Tmin, Tmax].
+  ///  \param out : \f$x(t)\f$ rotation matrix corresponding on spline at time t.
+  ///  \return EVAL_OK or EVAL_CLAMPED.
+  virtual eval_status evaluate_rt(const time_t t, point_out_t out) const noexcept {
+    time_t tc(t);
+    const eval_status status = clamp_time(tc, T_min_, T_max_);
+    out = slerp(tc).toRotationMatrix();
+    return status;
+  }
+
+  ///  \brief Real-time safe evaluation of the derivative of order N at time t, see curve_abc::derivate_rt.
+  ///  \param t : the time when to evaluate the spline, clamped in [Tmin, Tmax].
+  ///  \param order : order of derivative, strictly positive.
+  ///  \param out : \f$\frac{d^Nx(t)}{dt^N}\f$ point corresponding on derivative spline at time t.
+  ///  \return EVAL_OK or EVAL_CLAMPED if out was written, EVAL_INVALID_ORDER for the order 0.
+  virtual eval_status derivate_rt(const time_t t, const std::size_t order, point_derivate_out_t out) const noexcept {
+    if (order == 0) return EVAL_INVALID_ORDER;
+    time_t tc(t);
+    const eval_status status = clamp_time(tc, T_min_, T_max_);
+    if (order == 1) {
+      out = angular_vel_;
+    } else {
+      out.setZero();
+    }
+    return status;
+  }
+
   curve_derivate_t compute_derivate(const std::size_t order) const {
+    CURVES_INSTRUMENT_SCOPE(COMPUTE_DERIVATE, this);
     return curve_derivate_t(derivate(T_min_, order), T_min_, T_max_);
   }
 
@@ -186,6 +270,12 @@ struct SO3Linear : public curve_abc<Time, Numeric, Safe, matrix3_t, point3_t > {
   /// \brief Get the degree of the curve.
   /// \return \f$degree\f$, the degree of the curve.
   virtual std::size_t degree() const { return 1; }
+  /// \brief Get the memory used by the curve, by category. See footprint.
+  virtual footprint memory_footprint() const {
+    footprint res;
+    res.add(footprint::OBJECTS, sizeof(*this));
+    return res;
+  }
   matrix3_t getInitRotation() const { return init_rot_.toRotationMatrix(); }
   matrix3_t getEndRotation() const { return end_rot_.toRotationMatrix(); }
   matrix3_t getInitRotation() { return init_rot_.toRotationMatrix(); }
@@ -198,6 +288,8 @@ struct SO3Linear : public curve_abc<Time, Numeric, Safe, matrix3_t, point3_t > {
   quaternion_t init_rot_, end_rot_;
   point3_t angular_vel_;  // const
   time_t T_min_, T_max_;  // const
+  Scalar half_angle_;              // half of the angle between init_rot_ and end_rot_, not serialized
+  quaternion_t init_times_axis_;  // init_rot_ * (0, axis) with axis the axis of rotation, not serialized
   /*Attributes*/
 
   // Serialization of the class
@@ -218,6 +310,7 @@ struct SO3Linear : public curve_abc<Time, Numeric, Safe, matrix3_t, point3_t > {
     ar >> boost::serialization::make_nvp("angular_vel", angular_vel_);
     ar >> boost::serialization::make_nvp("T_min", T_min_);
     ar >> boost::serialization::make_nvp("T_max", T_max_);
+    compute_slerp_constants();
   }
 
   template <class Archive>
@@ -290,6 +383,25 @@ struct SO3Linear : public curve_abc<Time, Numeric, Safe, matrix3_t, point3_t > {
   }
 
  private:
+  /// \brief Compute the constants of the slerp: q(u) = init_rot_ * exp(u * angle * axis) is equal to
+  /// cos(u * half_angle_) * init_rot_ + sin(u * half_angle_) * init_times_axis_.
+  /// They must be updated each time init_rot_ or end_rot_ is modified.
+  void compute_slerp_constants() {
+    const point3_t rel = ndcurves::log3(quaternion_t(init_rot_.conjugate() * end_rot_));
+    const Scalar angle = rel.norm();
+    half_angle_ = angle / Scalar(2);
+    const point3_t axis = angle > Scalar(0) ? point3_t(rel / angle) : point3_t::Zero();
+    init_times_axis_ = init_rot_ * quaternion_t(Scalar(0), axis[0], axis[1], axis[2]);
+  }
+
+  /// \brief Slerp between init_rot_ and end_rot_ at time t, without any check on t.
+  quaternion_t slerp(const time_t t) const noexcept {
+    if (t >= T_max_) return end_rot_;
+    if (t <= T_min_) return init_rot_;
+    const Scalar half_angle = half_angle_ * (t - T_min_) / (T_max_ - T_min_);
+    return quaternion_t(std::cos(half_angle) * init_rot_.coeffs() + std::sin(half_angle) * init_times_axis_.coeffs());
+  }
+
   void safe_check() {
     if (Safe) {
       if (T_min_ > T_max_) {
@@ -6,6 +6,7 @@
 #include "python_variables.h"
 #include "archive_python_binding.h"
 #include "optimization_python.h"
+#include "instrumentation_python.h"
 #include <ndcurves/serialization/curves.hpp>
 
 #include <boost/python.hpp>
@@ -364,6 +365,36 @@ bezier_t* bezier_linear_variable_t_evaluate(const bezier_linear_variable_t* b, c
   return new bezier_t(evaluateLinear<bezier_t, bezier_linear_variable_t>(*b, x));
 }
 
+// the operators of linear_variable_t return lazy expressions, evaluate them
+linear_variable_t linear_variable_t_add(const linear_variable_t& w1, const linear_variable_t& w2) { return w1 + w2; }
+
+linear_variable_t linear_variable_t_sub(const linear_variable_t& w1, const linear_variable_t& w2) { return w1 - w2; }
+
+linear_variable_t linear_variable_t_neg(const linear_variable_t& w) { return -w; }
+
+linear_variable_t linear_variable_t_mul(const linear_variable_t& w, const real k) { return w * k; }
+
+linear_variable_t linear_variable_t_div(const linear_variable_t& w, const real k) { return w / k; }
+
+template <typename Bezier>
+pointX_t bezierBasisAt(const Bezier& b, const real t, const std::size_t order) {
+  return b.basis_at(t, order);
+}
+
+template <typename Bezier>
+matrix_x_t bezierBasisMatrix(const Bezier& b, const pointX_t& times, const std::size_t order) {
+  return b.basis_matrix(times, order);
+}
+
+matrix_x_t bezier_linear_variable_t_evaluate_batch(const bezier_linear_variable_t& b, const matrix_x_t& X) {
+  return evaluateLinearBatch(b, X);
+}
+
+matrix_x_t bezier_linear_variable_t_evaluate_on_grid(const bezier_linear_variable_t& b, const matrix_x_t& X,
+                                                      const pointX_t& times, const std::size_t order) {
+  return evaluateLinearOnGrid(b, X, times, order);
+}
+
 bezier_t::piecewise_curve_t (bezier_t::*splitspe)(const bezier_t::vector_x_t&) const = &bezier_t::split;
 bezier_linear_variable_t::piecewise_curve_t (bezier_linear_variable_t::*split_py)(
     const bezier_linear_variable_t::vector_x_t&) const = &bezier_linear_variable_t::split;
@@ -383,6 +414,19 @@ SO3Linear_t* wrapSO3LinearConstructorFromMatrix(const matrix3_t& init_rot, const
 
 /* End wrap SO3Linear */
 
+/* Wrap SO3Bezier */
+SO3Bezier_t* wrapSO3BezierConstructor(const pointX_list_t& quaternions, const real min, const real max) {
+  if (quaternions.rows() != 4) {
+    throw std::invalid_argument("SO3Bezier: the control rotations should be given as quaternions (x, y, z, w).");
+  }
+  std::vector<quaternion_t, Eigen::aligned_allocator<quaternion_t> > rotations;
+  for (int i = 0; i < quaternions.cols(); ++i) {
+    rotations.push_back(quaternion_t(quaternions(3, i), quaternions(0, i), quaternions(1, i), quaternions(2, i)));
+  }
+  return new SO3Bezier_t(rotations.begin(), rotations.end(), min, max);
+}
+/* End wrap SO3Bezier */
+
 /* Wrap SE3Curves */
 
 matrix4_t se3Return(const curve_SE3_t& curve, const real t) { return curve(t).matrix(); }
@@ -541,6 +585,8 @@ BOOST_PYTHON_MODULE(ndcurves) {
       .def("max", &curve_abc_t::max, "Get the HIGHER bound on interval definition of the curve.")
       .def("dim", &curve_abc_t::dim, "Get the dimension of the curve.")
       .def("degree", &curve_abc_t::degree, "Get the degree of the representation of the curve (if applicable).")
+      .def("memory_footprint", &memoryFootprint<curve_abc_t>,
+           "Get the memory used by the curve in bytes, by category, including the size of the curve itself.")
       .def("saveAsText", pure_virtual(&curve_abc_t::saveAsText<curve_abc_t>), bp::args("filename"),
            "Saves *this inside a text file.")
       .def("loadFromText", pure_virtual(&curve_abc_t::loadFromText<curve_abc_t>), bp::args("filename"),
@@ -571,6 +617,8 @@ BOOST_PYTHON_MODULE(ndcurves) {
       .def("max", &curve_3_t::max, "Get the HIGHER bound on interval definition of the curve.")
       .def("dim", &curve_3_t::dim, "Get the dimension of the curve.")
       .def("degree", &curve_3_t::degree, "Get the degree of the representation of the curve (if applicable).")
+      .def("memory_footprint", &memoryFootprint<curve_3_t>,
+           "Get the memory used by the curve in bytes, by category, including the size of the curve itself.")
       .def_pickle(curve_pickle_suite<curve_3_t>());
 
   class_<curve_rotation_t, boost::noncopyable, bases<curve_abc_t>, boost::shared_ptr<curve_rotation_callback> >("curve_rotation")
@@ -589,6 +637,8 @@ BOOST_PYTHON_MODULE(ndcurves) {
       .def("max", &curve_rotation_t::max, "Get the HIGHER bound on interval definition of the curve.")
       .def("dim", &curve_rotation_t::dim, "Get the dimension of the curve.")
       .def("degree", &curve_rotation_t::degree, "Get the degree of the representation of the curve (if applicable).")
+      .def("memory_footprint", &memoryFootprint<curve_rotation_t>,
+           "Get the memory used by the curve in bytes, by category, including the size of the curve itself.")
       .def_pickle(curve_pickle_suite<curve_rotation_t>());
 
   class_<curve_SE3_t, boost::noncopyable, bases<curve_abc_t>, boost::shared_ptr<curve_SE3_callback> >("curve_SE3")
@@ -606,6 +656,8 @@ BOOST_PYTHON_MODULE(ndcurves) {
       .def("min", &curve_SE3_t::min, "Get the LOWER bound on interval definition of the curve.")
       .def("max", &curve_SE3_t::max, "Get the HIGHER bound on interval definition of the curve.")
       .def("dim", &curve_SE3_t::dim, "Get the dimension of the curve.")
+      .def("memory_footprint", &memoryFootprint<curve_SE3_t>,
+           "Get the memory used by the curve in bytes, by category, including the size of the curve itself.")
       .def("rotation", &se3returnRotation, "Output the rotation (as a 3x3 matrix) at the given time.",
            args("self", "time"))
       .def("translation", &se3returnTranslation, "Output the rotation (as a vector 3) at the given time.",
@@ -640,6 +692,10 @@ BOOST_PYTHON_MODULE(ndcurves) {
       .def("elevateSelf",&bezier3_t::elevate_self, bp::args("order"), "Elevate the Bezier curve of order degrees higher than the current curve, but strictly equivalent.")
       .def_readonly("degree", &bezier3_t::degree_)
       .def_readonly("nbWaypoints", &bezier3_t::size_)
+      .def("basis_at", &bezierBasisAt<bezier3_t>, (bp::arg("t"), bp::arg("order") = 0),
+           "Weights w of the control points in the derivative of given order at time t, sum(w_i P_i).")
+      .def("basis_matrix", &bezierBasisMatrix<bezier3_t>, (bp::arg("times"), bp::arg("order") = 0),
+           "Matrix with one row basis_at(t, order) per time t.")
       .def("saveAsText", &bezier3_t::saveAsText<bezier3_t>, bp::args("filename"), "Saves *this inside a text file.")
       .def("loadFromText", &bezier3_t::loadFromText<bezier3_t>, bp::args("filename"), "Loads *this from a text file.")
       .def("saveAsXML", &bezier3_t::saveAsXML<bezier3_t>, bp::args("filename", "tag_name"),
@@ -685,6 +741,10 @@ BOOST_PYTHON_MODULE(ndcurves) {
       .def("elevateSelf",&bezier_t::elevate_self, bp::args("order"), "Elevate the Bezier curve of order degrees higher than the current curve, but strictly equivalent.")
       .def_readonly("degree", &bezier_t::degree_)
       .def_readonly("nbWaypoints", &bezier_t::size_)
+      .def("basis_at", &bezierBasisAt<bezier_t>, (bp::arg("t"), bp::arg("order") = 0),
+           "Weights w of the control points in the derivative of given order at time t, sum(w_i P_i).")
+      .def("basis_matrix", &bezierBasisMatrix<bezier_t>, (bp::arg("times"), bp::arg("order") = 0),
+           "Matrix with one row basis_at(t, order) per time t.")
       .def("split", splitspe)
       .def("saveAsText", &bezier_t::saveAsText<bezier_t>, bp::args("filename"), "Saves *this inside a text file.")
       .def("loadFromText", &bezier_t::loadFromText<bezier_t>, bp::args("filename"), "Loads *this from a text file.")
@@ -730,15 +790,18 @@ BOOST_PYTHON_MODULE(ndcurves) {
       .def(init<linear_variable_t::matrix_x_t, linear_variable_t::vector_x_t>())
       .def(init<linear_variable_t::matrix_x_t, linear_variable_t::vector_x_t>())
       .def("__call__", &linear_variable_t::operator())
+      .def("memory_footprint", &memoryFootprint<linear_variable_t>,
+           "Get the memory used by the linear variable in bytes, by category.")
       .def(self += linear_variable_t())
       .def(self -= linear_variable_t())
       .def(self *= double())
       .def(self /= double())
-      .def(self +  linear_variable_t())
-      .def(self -  linear_variable_t())
-      .def(-self)
-      .def(self * double())
-      .def(self / double())
+      .def("__add__", &linear_variable_t_add)
+      .def("__sub__", &linear_variable_t_sub)
+      .def("__neg__", &linear_variable_t_neg)
+      .def("__mul__", &linear_variable_t_mul)
+      .def("__div__", &linear_variable_t_div)
+      .def("__truediv__", &linear_variable_t_div)
       .def(self *  linear_variable_t())
       .def("B", &linear_variable_t::B, return_value_policy<copy_const_reference>())
       .def("c", &linear_variable_t::c, return_value_policy<copy_const_reference>())
@@ -757,6 +820,12 @@ BOOST_PYTHON_MODULE(ndcurves) {
       .def("max", &bezier_linear_variable_t::max)
       .def("__call__", &bezier_linear_variable_t::operator())
       .def("evaluate", &bezier_linear_variable_t_evaluate, bp::return_value_policy<bp::manage_new_object>())
+      .def("evaluate_batch", &bezier_linear_variable_t_evaluate_batch, bp::args("X"),
+           "Control points for each column x of X, stacked in the corresponding column of the result.")
+      .def("evaluate_on_grid", &bezier_linear_variable_t_evaluate_on_grid,
+           (bp::arg("X"), bp::arg("times"), bp::arg("order") = 0),
+           "Derivative of given order at each time for each column x of X, stacked in the corresponding column of the "
+           "result.")
       .def("derivate", &bezier_linear_variable_t::derivate)
       .def("compute_derivate", &bezier_linear_variable_t::compute_derivate_ptr,
            return_value_policy<manage_new_object>())
@@ -766,6 +835,12 @@ BOOST_PYTHON_MODULE(ndcurves) {
       .def("waypointAtIndex", &bezier_linear_variable_t::waypointAtIndex)
       .def_readonly("degree", &bezier_linear_variable_t::degree_)
       .def_readonly("nbWaypoints", &bezier_linear_variable_t::size_)
+      .def("basis_at", &bezierBasisAt<bezier_linear_variable_t>, (bp::arg("t"), bp::arg("order") = 0),
+           "Weights w of the control points in the derivative of given order at time t, sum(w_i P_i).")
+      .def("basis_matrix", &bezierBasisMatrix<bezier_linear_variable_t>, (bp::arg("times"), bp::arg("order") = 0),
+           "Matrix with one row basis_at(t, order) per time t.")
+      .def("memory_footprint", &memoryFootprint<bezier_linear_variable_t>,
+           "Get the memory used by the curve in bytes, by category, including the size of the curve itself.")
       .def("cross", cross_bez_var,  bp::args("other"), "Compute the cross product of the current Bezier by another Bezier. The cross product p1Xp2 of 2 polynomials p1 and p2 is defined such that forall t, p1Xp2(t) = p1(t) X p2(t), with X designing the cross product. This method of course only makes sense for dimension 3 polynomials.")
       .def("cross", cross_point_var, bp::args("point"), "Compute the cross product PXpt of the current Bezier P by a point pt, such that for all t, PXpt(t) = P(t) X pt")
       .def(bp::self == bp::self)
@@ -787,8 +862,11 @@ BOOST_PYTHON_MODULE(ndcurves) {
 
   class_<quadratic_variable_t>("cost", no_init)
       .add_property("A", &cost_t_quad)
+      .add_property("A_packed", &cost_t_quad_packed)
       .add_property("b", &cost_t_linear)
-      .add_property("c", &cost_t_constant);
+      .add_property("c", &cost_t_constant)
+      .def("memory_footprint", &memoryFootprint<quadratic_variable_t>,
+           "Get the memory used by the cost in bytes, by category.");
 
   /** END variable points bezier curve**/
   /** BEGIN polynomial curve function**/
@@ -977,6 +1055,8 @@ BOOST_PYTHON_MODULE(ndcurves) {
       .def("curve_at_index", &piecewise_linear_bezier_t::curve_at_index)
       .def("curve_at_time", &piecewise_linear_bezier_t::curve_at_time)
       .def("num_curves", &piecewise_linear_bezier_t::num_curves)
+      .def("memory_footprint", &memoryFootprint<piecewise_linear_bezier_t>,
+           "Get the memory used by the curve in bytes, by category, including the size of the curve itself.")
       .def("saveAsText", &piecewise_linear_bezier_t::saveAsText<piecewise_linear_bezier_t>, bp::args("filename"),
            "Saves *this inside a text file.")
       .def("loadFromText", &piecewise_linear_bezier_t::loadFromText<piecewise_linear_bezier_t>, bp::args("filename"),
@@ -1142,6 +1222,32 @@ BOOST_PYTHON_MODULE(ndcurves) {
       .def_pickle(curve_pickle_suite<SO3Linear_t>());
 
   /** END  SO3 Linear**/
+  /** BEGIN SO3 Bezier**/
+  class_<SO3Bezier_t, bases<curve_rotation_t>, boost::shared_ptr<SO3Bezier_t>  >("SO3Bezier", init<>())
+      .def("__init__",
+           make_constructor(&wrapSO3BezierConstructor, default_call_policies(),
+                            args("control_rotations", "min", "max")),
+           "Create a smooth rotation curve defined for t in [min,max], as a cumulative Bezier curve in SO3."
+           " The control rotations are the columns of a 4xN matrix of quaternions (x, y, z, w).")
+      .def("computeAsQuaternion", &SO3Bezier_t::computeAsQuaternion,
+           "Output the quaternion of the rotation at the given time.")
+      .def("saveAsText", &SO3Bezier_t::saveAsText<SO3Bezier_t>, bp::args("filename"),
+           "Saves *this inside a text file.")
+      .def("loadFromText", &SO3Bezier_t::loadFromText<SO3Bezier_t>, bp::args("filename"),
+           "Loads *this from a text file.")
+      .def("saveAsXML", &SO3Bezier_t::saveAsXML<SO3Bezier_t>, bp::args("filename", "tag_name"),
+           "Saves *this inside a XML file.")
+      .def("loadFromXML", &SO3Bezier_t::loadFromXML<SO3Bezier_t>, bp::args("filename", "tag_name"),
+           "Loads *this from a XML file.")
+      .def("saveAsBinary", &SO3Bezier_t::saveAsBinary<SO3Bezier_t>, bp::args("filename"),
+           "Saves *this inside a binary file.")
+      .def("loadFromBinary", &SO3Bezier_t::loadFromBinary<SO3Bezier_t>, bp::args("filename"),
+           "Loads *this from a binary file.")
+      .def(bp::self == bp::self)
+      .def(bp::self != bp::self)
+      .def_pickle(curve_pickle_suite<SO3Bezier_t>());
+
+  /** END  SO3 Bezier**/
   /** BEGIN SE3 Curve**/
   class_<SE3Curve_t, bases<curve_SE3_t>, boost::shared_ptr<SE3Curve_t>  >("SE3Curve", init<>())
       .def("__init__",
@@ -1298,12 +1404,18 @@ BOOST_PYTHON_MODULE(ndcurves) {
   /** END curves conversion**/
 
   optimization::python::exposeOptimization();
+  instrumentation::python::exposeInstrumentation();
 
 #ifdef CURVES_WITH_PINOCCHIO_SUPPORT
   scope().attr("CURVES_WITH_PINOCCHIO_SUPPORT") = true;
 #else
   scope().attr("CURVES_WITH_PINOCCHIO_SUPPORT") = false;
 #endif
+#ifdef CURVES_WITH_INSTRUMENTATION
+  scope().attr("CURVES_WITH_INSTRUMENTATION") = true;
+#else
+  scope().attr("CURVES_WITH_INSTRUMENTATION") = false;
+#endif
 
 }  // End BOOST_PYTHON_MODULE
 }  // namespace ndcurves
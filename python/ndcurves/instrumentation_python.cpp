@@ -0,0 +1,47 @@
+#include "instrumentation_python.h"
+#include "namespace.h"
+#include "ndcurves/instrumentation.h"
+
+#include <boost/python.hpp>
+
+namespace ndcurves {
+namespace instrumentation {
+namespace python {
+namespace bp = boost::python;
+
+/// \brief Return the counters as a list of dict, with the keys of the JSON written by save_chrome_trace.
+bp::list snapshot_t() {
+  const std::vector<counter_snapshot> counters = snapshot();
+  bp::list res;
+  for (std::vector<counter_snapshot>::const_iterator cit = counters.begin(); cit != counters.end(); ++cit) {
+    bp::dict d;
+    d["category"] = category_name(cit->category_);
+    d["type"] = cit->type_;
+    d["count"] = cit->count_;
+    d["total_time"] = cit->total_time_;
+    d["max_time"] = cit->max_time_;
+    d["bytes"] = cit->bytes_;
+    res.append(d);
+  }
+  return res;
+}
+
+void start_trace_t() { start_trace(); }
+void start_trace_max_t(const std::size_t max_events) { start_trace(max_events); }
+
+void exposeInstrumentation() {
+  // using the instrumentation scope
+  bp::scope current_scope = ndcurves::python::getOrCreatePythonNamespace("instrumentation");
+  bp::def("enabled", &enabled, "True if ndcurves was built with CURVES_WITH_INSTRUMENTATION.");
+  bp::def("snapshot", &snapshot_t, "Value of the counters, as a list of dict.");
+  bp::def("reset", &reset, "Set all the counters to zero and clear the trace.");
+  bp::def("start_trace", &start_trace_t, "Start recording each instrumented call.");
+  bp::def("start_trace", &start_trace_max_t, bp::args("max_events"),
+          "Start recording each instrumented call, up to max_events calls.");
+  bp::def("stop_trace", &stop_trace, "Stop recording the calls.");
+  bp::def("save_chrome_trace", &save_chrome_trace, bp::args("filename"),
+          "Write the trace and the counters in the Chrome trace event format.");
+}
+}  // namespace python
+}  // namespace instrumentation
+}  // namespace ndcurves
@@ -0,0 +1,19 @@
+#include "namespace.h"
+
+#include "ndcurves/instrumentation.h"
+
+#include <boost/python.hpp>
+
+#ifndef _INSTRUMENTATION_PYTHON
+#define _INSTRUMENTATION_PYTHON
+
+namespace ndcurves {
+namespace instrumentation {
+namespace python {
+
+void exposeInstrumentation();
+}  // namespace python
+}  // namespace instrumentation
+}  // namespace ndcurves
+
+#endif  //_INSTRUMENTATION_PYTHON
@@ -120,7 +120,9 @@ void exposeOptimization() {
   bp::class_<quadratic_problem_t>("quadratic_problem", bp::init<>())
       .add_property("cost", &problem_t_cost)
       .add_property("A", &problem_t_ineqMatrix)
-      .add_property("b", &problem_t_ineqVector);
+      .add_property("b", &problem_t_ineqVector)
+      .def("memory_footprint", &memoryFootprint<quadratic_problem_t>,
+           "Get the memory used by the problem in bytes, by category.");
 
   bp::def("setup_control_points", &setup_control_points_t);
   bp::def("generate_problem", &generate_problem_t);
@@ -131,7 +133,9 @@ void exposeOptimization() {
       .def_readonly("numControlPoints", &problem_data_t::numControlPoints)
       .def_readonly("numVariables", &problem_data_t::numVariables)
       .def_readonly("startVariableIndex", &problem_data_t::startVariableIndex)
-      .def_readonly("numStateConstraints", &problem_data_t::numStateConstraints);
+      .def_readonly("numStateConstraints", &problem_data_t::numStateConstraints)
+      .def("memory_footprint", &memoryFootprint<problem_data_t>,
+           "Get the memory used by the problem data and its bezier curve in bytes, by category.");
 
   bp::class_<problem_definition_t, bp::bases<curve_constraints_t> >("problem_definition", bp::init<int>())
       .def("__init__", bp::make_constructor(&wrapProblemDefinitionConstructor))
@@ -48,12 +48,23 @@ Eigen::Matrix<real, Eigen::Dynamic, Eigen::Dynamic> cost_t_quad(const quadratic_
   Eigen::Matrix<real, Eigen::Dynamic, Eigen::Dynamic> A = p.A();
   return A;
 }
+Eigen::Matrix<real, Eigen::Dynamic, 1> cost_t_quad_packed(const quadratic_variable_t& p) { return p.A_packed(); }
 Eigen::Matrix<real, Eigen::Dynamic, 1> cost_t_linear(const quadratic_variable_t& p) {
   Eigen::Matrix<real, Eigen::Dynamic, 1> b = p.b();
   return b;
 }
 real cost_t_constant(const quadratic_variable_t& p) { return p.c(); }
 
+boost::python::dict footprintToDict(const footprint& fp) {
+  boost::python::dict res;
+  for (int i = 0; i < footprint::NUM_CATEGORIES; ++i) {
+    const footprint::category c = footprint::category(i);
+    res[footprint::category_name(c)] = fp[c];
+  }
+  res["total"] = fp.total();
+  return res;
+}
+
 linear_variable_t* wayPointsToLists(const bezier_linear_variable_t& self) {
   typedef typename bezier_linear_variable_t::t_point_t t_point;
   typedef typename bezier_linear_variable_t::t_point_t::const_iterator cit_point;
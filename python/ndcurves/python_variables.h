@@ -10,6 +10,7 @@
 #include "ndcurves/cubic_hermite_spline.h"
 #include "ndcurves/piecewise_curve.h"
 #include "ndcurves/so3_linear.h"
+#include "ndcurves/so3_bezier.h"
 #include "ndcurves/se3_curve.h"
 #include "ndcurves/sinusoidal.h"
 #include "ndcurves/python/python_definitions.h"
@@ -47,11 +48,20 @@ struct matrix_pair {
 };
 
 Eigen::Matrix<real, Eigen::Dynamic, Eigen::Dynamic> cost_t_quad(const quadratic_variable_t& p);
+Eigen::Matrix<real, Eigen::Dynamic, 1> cost_t_quad_packed(const quadratic_variable_t& p);
 Eigen::Matrix<real, Eigen::Dynamic, 1> cost_t_linear(const quadratic_variable_t& p);
 real cost_t_constant(const quadratic_variable_t& p);
 
 linear_variable_t* wayPointsToLists(const bezier_linear_variable_t& self);
 
+/// \brief Convert a footprint to a dict {category name: bytes}, with the sum of the categories in "total".
+boost::python::dict footprintToDict(const footprint& fp);
+
+template <typename T>
+boost::python::dict memoryFootprint(const T& self) {
+  return footprintToDict(self.memory_footprint());
+}
+
 struct LinearBezierVector {
   std::vector<bezier_linear_variable_t> beziers_;
   std::size_t size() { return beziers_.size(); }
@@ -83,6 +93,7 @@ EIGENPY_DEFINE_STRUCT_ALLOCATOR_SPECIALIZATION(ndcurves::constant3_t)
 EIGENPY_DEFINE_STRUCT_ALLOCATOR_SPECIALIZATION(ndcurves::cubic_hermite_spline3_t)
 EIGENPY_DEFINE_STRUCT_ALLOCATOR_SPECIALIZATION(ndcurves::piecewise3_t)
 EIGENPY_DEFINE_STRUCT_ALLOCATOR_SPECIALIZATION(ndcurves::SO3Linear_t)
+EIGENPY_DEFINE_STRUCT_ALLOCATOR_SPECIALIZATION(ndcurves::SO3Bezier_t)
 EIGENPY_DEFINE_STRUCT_ALLOCATOR_SPECIALIZATION(ndcurves::SE3Curve_t)
 EIGENPY_DEFINE_STRUCT_ALLOCATOR_SPECIALIZATION(ndcurves::sinusoidal_t)
 EIGENPY_DEFINE_STRUCT_ALLOCATOR_SPECIALIZATION(ndcurves::piecewise_SE3_t)
@@ -35,5 +35,29 @@ class TestProblemDefinition(unittest.TestCase):
         self.assertTrue(norm(bezierFixed.derivate(0.0, 1) - pD.init_vel) <= 0.001)
 
 
+    def test_memory_footprint(self):
+        pD = problem_definition(3)
+        pD.init_pos = array([[0., 0., 0.]]).T
+        pD.end_pos = array([[1., 1., 1.]]).T
+        pD.flag = constraint_flag.INIT_POS | constraint_flag.END_POS
+
+        # the problem data counts its variables and its bezier curve:
+        problem = setup_control_points(pD)
+        footprint = problem.memory_footprint()
+        self.assertEqual(footprint["total"], sum(v for k, v in footprint.items() if k != "total"))
+        self.assertTrue(footprint["total"] >= footprint["objects"])
+        footprint_bezier = problem.bezier().memory_footprint()
+        self.assertTrue(footprint["total"] >= footprint_bezier["total"])
+        self.assertTrue(footprint["linear_variables"] > footprint_bezier["linear_variables"])
+
+        # the quadratic problem counts its cost in linear_variables and its inequalities in other:
+        qp = generate_integral_problem(pD, integral_cost_flag.ACCELERATION)
+        footprint = qp.memory_footprint()
+        self.assertEqual(footprint["total"], sum(v for k, v in footprint.items() if k != "total"))
+        self.assertTrue(footprint["total"] >= footprint["objects"])
+        self.assertEqual(footprint["linear_variables"], (qp.cost.A_packed.size + qp.cost.b.size) * 8)
+        self.assertEqual(footprint["linear_variables"], qp.cost.memory_footprint()["linear_variables"])
+        self.assertEqual(footprint["other"], (qp.A.size + qp.b.size) * 8)
+
 if __name__ == '__main__':
     unittest.main()
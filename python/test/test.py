@@ -1,3 +1,4 @@
+import json
 import os
 import unittest
 from math import sqrt
@@ -7,9 +8,10 @@ import numpy as np
 from numpy import array, array_equal, isclose, random, zeros
 from numpy.linalg import norm
 import pickle
-from ndcurves import (CURVES_WITH_PINOCCHIO_SUPPORT, Quaternion, SE3Curve, SO3Linear, bezier, bezier3, convert_to_bezier,
-                    convert_to_hermite, convert_to_polynomial, cubic_hermite_spline, curve_constraints, exact_cubic,
-                    piecewise, piecewise_SE3, polynomial)
+from ndcurves import (CURVES_WITH_PINOCCHIO_SUPPORT, Quaternion, SE3Curve, SO3Bezier, SO3Linear, bezier, bezier3,
+                    bezier_linear_variable, convert_to_bezier, convert_to_hermite, convert_to_polynomial,
+                    cubic_hermite_spline, curve_constraints, exact_cubic, instrumentation, piecewise, piecewise_SE3,
+                    polynomial)
 
 eigenpy.switchToNumpyArray()
 
@@ -983,6 +985,56 @@ class TestCurves(unittest.TestCase):
         so3Rot_from_pickle = pickle.loads(so3Rot_pickled)
         self.assertEqual(so3Rot_from_pickle, so3Rot)
 
+    def test_so3_bezier(self):
+        print("test SO3 Bezier")
+        s = sqrt(2.) / 2.
+        # control rotations as the columns of a 4xN matrix of quaternions (x, y, z, w):
+        quats = array([[0., s, 0., 0.5], [0., 0., 0., 0.5], [0., 0., s, 0.5], [1., s, s, 0.5]])
+        min = 0.5
+        max = 2.5
+        so3 = SO3Bezier(quats, min, max)
+        self.assertEqual(so3.min(), min)
+        self.assertEqual(so3.max(), max)
+        self.assertEqual(so3.dim(), 3)
+        self.assertTrue(isclose(so3(min), np.identity(3)).all())
+        self.assertTrue(isclose(so3(max), Quaternion(0.5, 0.5, 0.5, 0.5).matrix()).all())
+        # values computed with the C++ API for the same control rotations:
+        rot = array([[0.666666666666667, -0.588826746263444, 0.456988641478496],
+                     [0.718886960940863, 0.346020077914785, -0.602886094605819],
+                     [0.196868212123658, 0.730447238727515, 0.653979922085214]])
+        self.assertTrue(isclose(so3(1.5), rot).all())
+        vel = array([0.0748480221297017, 0.719553626237427, 0.981735037785307])
+        self.assertTrue(isclose(so3.derivate(1.5, 1), vel).all())
+        rot = array([[0.0759553001885487, -0.508626402945073, 0.857630441740744],
+                     [0.994971194221953, -0.0176601562709586, -0.0985922996436658],
+                     [0.0652925343497134, 0.860806192535603, 0.504727237080138]])
+        self.assertTrue(isclose(so3(2.2), rot).all())
+        vel = array([1.24385840412986, 0.616653703360384, -0.0711649186473247])
+        self.assertTrue(isclose(so3.derivate(2.2, 1), vel).all())
+        # computeAsQuaternion returns a Quaternion, whose coefficients are ordered (x, y, z, w):
+        quat = so3.computeAsQuaternion(1.)
+        self.assertTrue(isclose(quat.coeffs(), array([0.359600288756978, 0.0448075623193307, 0.125228747474228,
+                                                      0.923578732697399])).all())
+        self.assertTrue(isclose(quat.matrix(), so3(1.)).all())
+        t = min
+        while t < max:
+            self.assertTrue(isclose(so3.computeAsQuaternion(t).matrix(), so3(t)).all())
+            t += 0.1
+        # the columns are quaternions (x, y, z, w), w first gives another curve:
+        so3_wxyz = SO3Bezier(quats[[3, 0, 1, 2], :], min, max)
+        self.assertFalse(isclose(so3_wxyz(1.5), so3(1.5)).all())
+        with self.assertRaises(ValueError):
+            SO3Bezier(quats[:3, :], min, max)
+        # pickle round trip:
+        so3_pickled = pickle.dumps(so3)
+        so3_from_pickle = pickle.loads(so3_pickled)
+        self.assertEqual(so3_from_pickle, so3)
+        t = min
+        while t < max:
+            self.assertTrue(isclose(so3_from_pickle(t), so3(t)).all())
+            self.assertTrue(isclose(so3_from_pickle.derivate(t, 1), so3.derivate(t, 1)).all())
+            t += 0.1
+
     def test_se3_curve_linear(self):
         print("test SE3 Linear")
         init_quat = Quaternion.Identity()
@@ -1422,5 +1474,141 @@ class TestCurves(unittest.TestCase):
         self.assertTrue(se3_1 != se3_4)
 
 
+    def checkFootprint(self, footprint):
+        categories = ["objects", "control_points", "bernstein", "control_blocks", "linear_variables", "times", "other"]
+        self.assertEqual(sorted(footprint.keys()), sorted(categories + ["total"]))
+        self.assertEqual(footprint["total"], sum(footprint[c] for c in categories))
+        self.assertTrue(footprint["objects"] > 0)
+        self.assertTrue(footprint["total"] >= footprint["objects"])
+
+    def test_memory_footprint(self):
+        print("test_memory_footprint")
+        waypoints = array([[1., 2., 3.], [4., 5., 6.], [4., -5., 6.], [2., 5., 1.]]).transpose()
+        a = bezier(waypoints, 0., 2.)
+        footprint = a.memory_footprint()
+        self.checkFootprint(footprint)
+        # 4 control points of 3 doubles, and 4 Bernstein polynomials:
+        self.assertTrue(footprint["control_points"] >= 4 * 3 * 8)
+        self.assertTrue(footprint["bernstein"] >= 4 * 3 * 8)
+        self.assertEqual(footprint["linear_variables"], 0)
+        self.assertEqual(footprint["times"], 0)
+        # a curve with more control points uses more memory:
+        b = a.elevate(2)
+        self.assertTrue(b.memory_footprint()["control_points"] > footprint["control_points"])
+        self.assertTrue(b.memory_footprint()["total"] > footprint["total"])
+        # a piecewise curve counts its curves and its times:
+        pc = piecewise(a)
+        pc.append(bezier(waypoints, 2., 3.))
+        pc.append(bezier(waypoints, 3., 5.))
+        footprint_pc = pc.memory_footprint()
+        self.checkFootprint(footprint_pc)
+        self.assertTrue(footprint_pc["times"] >= 4 * 8)
+        self.assertTrue(footprint_pc["control_points"] >= 3 * footprint["control_points"])
+        footprints = [pc.curve_at_index(i).memory_footprint() for i in range(3)]
+        self.assertTrue(footprint_pc["total"] >= sum(f["total"] for f in footprints))
+        # an SE3 curve counts its translation curve:
+        translation = bezier(waypoints, 0.2, 1.5)
+        se3 = SE3Curve(translation, Quaternion.Identity().matrix(), Quaternion(0.5, 0.5, 0.5, 0.5).matrix())
+        footprint_se3 = se3.memory_footprint()
+        self.checkFootprint(footprint_se3)
+        self.assertTrue(footprint_se3["control_points"] >= footprint["control_points"])
+        self.assertTrue(footprint_se3["total"] >= translation.memory_footprint()["total"])
+        # a bezier of linear variables counts the matrices and vectors of its control points:
+        matrices = np.hstack([array([[1., 2., 3.], [4., 5., 6.], [7., 8., 9.]]), np.identity(3)])
+        vectors = array([[1., 2., 3.], [4., 5., 6.]]).transpose()
+        b_var = bezier_linear_variable(matrices, vectors, 0., 1.)
+        footprint_var = b_var.memory_footprint()
+        self.checkFootprint(footprint_var)
+        # each of the 2 control points is a 3x6 matrix and a vector of size 3:
+        self.assertTrue(footprint_var["linear_variables"] >= 2 * (3 * 6 + 3) * 8)
+
+    def test_instrumentation(self):
+        print("test_instrumentation")
+        waypoints = array([[1., 2., 3.], [4., 5., 6.], [4., -5., 6.], [2., 5., 1.]]).transpose()
+        a = bezier(waypoints, 0., 2.)
+        instrumentation.reset()
+        instrumentation.start_trace()
+        for i in range(10):
+            a(0.2 * i)
+        instrumentation.stop_trace()
+        counters = instrumentation.snapshot()
+        instrumentation.save_chrome_trace("instrumentation_trace.json")
+        with open("instrumentation_trace.json") as f:
+            trace = json.load(f)
+        os.remove("instrumentation_trace.json")
+        self.assertEqual(len(trace["otherData"]["counters"]), len(counters))
+        if not instrumentation.enabled():
+            self.assertEqual(counters, [])
+            self.assertEqual(trace["traceEvents"], [])
+            return
+        keys = ["bytes", "category", "count", "max_time", "total_time", "type"]
+        for c in counters:
+            self.assertEqual(sorted(c.keys()), keys)
+            self.assertTrue(c["max_time"] <= c["total_time"])
+        evaluate = [c for c in counters if c["category"] == "evaluate" and "bezier_curve" in c["type"]]
+        evaluate = [c for c in evaluate if c["count"] > 0]
+        self.assertEqual(len(evaluate), 1)
+        self.assertEqual(evaluate[0]["count"], 10)
+        events = [e for e in trace["traceEvents"] if e["cat"] == "evaluate" and "bezier_curve" in e["name"]]
+        self.assertEqual(len(events), 10)
+        # reset sets the counters to zero and clears the trace:
+        instrumentation.reset()
+        for c in instrumentation.snapshot():
+            self.assertEqual(c["count"], 0)
+
+    def test_bezier_basis(self):
+        print("test_bezier_basis")
+        waypoints = array([[1., 2., 3.], [4., 5., 6.], [4., -5., 6.], [2., 5., 1.]]).transpose()
+        for a in [bezier(waypoints, 0., 2.), bezier3(waypoints, 0., 2.)]:
+            # degree 3 Bernstein polynomials at 0, 1/2 and 1, and their derivatives scaled by 1 / (max - min):
+            self.assertTrue(isclose(a.basis_at(0.), array([1., 0., 0., 0.])).all())
+            self.assertTrue(isclose(a.basis_at(1.), array([1., 3., 3., 1.]) / 8.).all())
+            self.assertTrue(isclose(a.basis_at(2.), array([0., 0., 0., 1.])).all())
+            self.assertTrue(isclose(a.basis_at(0., 1), array([-1.5, 1.5, 0., 0.])).all())
+            self.assertTrue(isclose(a.basis_at(1., 2), array([0.75, -0.75, -0.75, 0.75])).all())
+            self.assertTrue(isclose(a.basis_at(1., 4), zeros(4)).all())
+            times = array([0., 0.3, 0.7, 1., 1.6, 2.])
+            for order in range(4):
+                basis = a.basis_matrix(times, order)
+                self.assertEqual(basis.shape, (6, 4))
+                values = basis @ waypoints.T
+                for j, t in enumerate(times):
+                    self.assertTrue(isclose(basis[j, :], a.basis_at(t, order)).all())
+                    if order == 0:
+                        self.assertTrue(isclose(values[j, :], a(t)).all())
+                    else:
+                        self.assertTrue(isclose(values[j, :], a.derivate(t, order)).all())
+            self.assertTrue(isclose(a.basis_matrix(times).sum(axis=1), 1.).all())
+            with self.assertRaises(ValueError):
+                a.basis_at(2.1)
+            with self.assertRaises(ValueError):
+                a.basis_matrix(array([0., 2.5]))
+
+    def test_bezier_linear_variable_batch(self):
+        print("test_bezier_linear_variable_batch")
+        # control point i is B_i x_i + c_i, where x_i are the rows 3 i to 3 i + 2 of the variable x:
+        B = [array([[1., 2., 3.], [4., 5., 6.], [7., 8., 9.]]),
+             np.identity(3),
+             array([[0., -1., 0.], [2., 0., 1.], [0., 3., -2.]])]
+        c = array([[1., 2., 3.], [0., 0., 0.], [-4., 5., 0.5]]).transpose()
+        b_var = bezier_linear_variable(np.hstack(B), c, 0., 2.)
+        X = array([[0.1 * (i + 1) * (k - 1.5) for k in range(4)] for i in range(9)])
+        batch = b_var.evaluate_batch(X)
+        self.assertEqual(batch.shape, (9, 4))
+        for k in range(4):
+            for i in range(3):
+                self.assertTrue(isclose(batch[3 * i:3 * i + 3, k], B[i].dot(X[3 * i:3 * i + 3, k]) + c[:, i]).all())
+            self.assertTrue(isclose(batch[:, k], b_var.evaluate(X[:, k]).waypoints().flatten("F")).all())
+        times = array([0., 0.5, 1.2, 2.])
+        for order in range(3):
+            grid = b_var.evaluate_on_grid(X, times, order)
+            self.assertEqual(grid.shape, (12, 4))
+            for k in range(4):
+                curve = b_var.evaluate(X[:, k])
+                for j, t in enumerate(times):
+                    value = curve(t) if order == 0 else curve.derivate(t, order)
+                    self.assertTrue(isclose(grid[3 * j:3 * j + 3, k], value).all())
+        self.assertTrue(isclose(b_var.evaluate_on_grid(X, times), b_var.evaluate_on_grid(X, times, 0)).all())
+
 if __name__ == '__main__':
     unittest.main()
@@ -1,5 +1,6 @@
 #include "ndcurves/fwd.h"
 #include "ndcurves/exact_cubic.h"
+#include "ndcurves/exact_cubic_incremental.h"
 #include "ndcurves/bezier_curve.h"
 #include "ndcurves/polynomial.h"
 #include "ndcurves/helpers/effector_spline.h"
@@ -569,6 +570,142 @@ void ExactCubicNoErrorTest(bool& error) {
   }
 }
 
+void ExactCubicSolverTest(bool& error) {
+  // Same waypoint times, different positions
+  std::vector<double> times;
+  times.push_back(0.);
+  times.push_back(0.4);
+  times.push_back(1.);
+  times.push_back(1.2);
+  times.push_back(2.5);
+  const exact_cubic_t::solver_t solver(times.begin(), times.end());
+  std::string errmsg("In ExactCubicSolverTest, Error while checking the spline computed by the solver");
+  for (double scale = 1.; scale < 4.; scale += 1.) {
+    t_pointX_t points;
+    ndcurves::T_Waypoint waypoints;
+    for (std::size_t i = 0; i < times.size(); ++i) {
+      points.push_back(point3_t(scale * std::cos(double(i)), -scale * double(i * i), scale + double(i)));
+      waypoints.push_back(std::make_pair(times[i], points.back()));
+    }
+    exact_cubic_t exactCubic = solver.compute(points.begin(), points.end());
+    if (exactCubic.getNumberSplines() != times.size() - 1 || !QuasiEqual(exactCubic.min(), times.front()) ||
+        !QuasiEqual(exactCubic.max(), times.back())) {
+      error = true;
+      std::cout << errmsg << " : wrong number of splines or time bounds" << std::endl;
+    }
+    for (std::size_t i = 0; i < times.size(); ++i) {
+      ComparePoints(points[i], exactCubic(times[i]), errmsg, error);
+    }
+    // velocity is continuous at the waypoints
+    for (std::size_t i = 1; i + 1 < times.size(); ++i) {
+      ComparePoints(exactCubic.getSplineAt(i - 1).derivate(times[i], 1), exactCubic.getSplineAt(i).derivate(times[i], 1),
+                    errmsg, error);
+    }
+    exact_cubic_t exactCubicWaypoints(waypoints.begin(), waypoints.end());
+    if (!exactCubic.isApprox(exactCubicWaypoints)) {
+      error = true;
+      std::cout << errmsg << " : not equal to the spline built from the waypoints" << std::endl;
+    }
+  }
+  try {
+    t_pointX_t points(times.size() - 1, point3_t::Zero());
+    solver.compute(points.begin(), points.end());
+    error = true;
+    std::cout << "exact_cubic_solver: calling compute with a wrong number of positions should raise an "
+                 "invalid_argument error"
+              << std::endl;
+  } catch (std::invalid_argument& /*e*/) {
+  }
+}
+
+void ExactCubicIncrementalTest(bool& error) {
+  std::string errmsg("In ExactCubicIncrementalTest, Error while checking the incremental spline");
+  ndcurves::T_Waypoint waypoints;
+  double t = 0.;
+  for (std::size_t i = 0; i < 60; ++i) {
+    const double x = double(i);
+    waypoints.push_back(std::make_pair(t, point3_t(std::cos(x), std::sin(2. * x) + 0.1 * x, std::sin(0.3 * x))));
+    t += 0.3 + 0.2 * std::sin(3. * x) * std::sin(3. * x);
+  }
+  spline_constraints_t constraints(3);
+  constraints.init_vel = point3_t(0.5, -1., 0.);
+  constraints.init_acc = point3_t(0., 2., -1.);
+  const exact_cubic_incremental_t batch(waypoints.begin(), waypoints.end(), constraints, 0.);
+  exact_cubic_t curve = batch.curve();
+  if (curve.getNumberSplines() != waypoints.size() - 1) {
+    error = true;
+    std::cout << errmsg << " : wrong number of splines" << std::endl;
+  }
+  for (std::size_t i = 0; i < waypoints.size(); ++i) {
+    ComparePoints(waypoints[i].second, curve(waypoints[i].first), errmsg, error, 1e-10);
+  }
+  for (std::size_t i = 1; i + 1 < waypoints.size(); ++i) {
+    for (std::size_t order = 1; order <= 2; ++order) {
+      ComparePoints(curve.getSplineAt(i - 1).derivate(waypoints[i].first, order),
+                    curve.getSplineAt(i).derivate(waypoints[i].first, order), errmsg, error, 1e-8);
+    }
+  }
+  ComparePoints(constraints.init_vel, curve.derivate(curve.min(), 1), errmsg, error, 1e-10);
+  ComparePoints(constraints.init_acc, curve.derivate(curve.min(), 2), errmsg, error, 1e-10);
+  ComparePoints(point3_t::Zero(), curve.derivate(curve.max(), 2), errmsg, error, 1e-8);
+
+  // appending the waypoints one by one, or by chunks, gives the same curve:
+  exact_cubic_incremental_t incremental(waypoints.begin(), waypoints.begin() + 2, constraints, 0.);
+  for (std::size_t i = 2; i < 40; ++i) {
+    incremental.append(waypoints[i].first, waypoints[i].second);
+  }
+  incremental.append(waypoints.begin() + 40, waypoints.end());
+  for (double ti = curve.min(); ti <= curve.max(); ti += 0.01) {
+    ComparePoints(curve(ti), incremental.curve()(ti), errmsg + " (one by one)", error, 1e-8);
+  }
+  // with the default tolerance only the last segments are updated:
+  exact_cubic_incremental_t local(waypoints.begin(), waypoints.end() - 1, constraints);
+  const curve_ptr_t first_segment = local.curve().curves_.front();
+  local.append(waypoints.back().first, waypoints.back().second);
+  if (local.curve().curves_.front() != first_segment) {
+    error = true;
+    std::cout << errmsg << " : the first segment should not have been updated" << std::endl;
+  }
+  for (double ti = curve.min(); ti <= curve.max(); ti += 0.01) {
+    ComparePoints(curve(ti), local.curve()(ti), errmsg + " (local update)", error, 1e-8);
+  }
+
+  // freeze the existing segments:
+  exact_cubic_incremental_t frozen(waypoints.begin(), waypoints.begin() + 20, constraints);
+  const exact_cubic_t before = frozen.curve();
+  frozen.append(waypoints.begin() + 20, waypoints.begin() + 25, true);
+  const exact_cubic_t& after = frozen.curve();
+  for (std::size_t i = 0; i < 19; ++i) {
+    if (after.curves_[i] != before.curves_[i]) {
+      error = true;
+      std::cout << errmsg << " : frozen segments should not be modified" << std::endl;
+    }
+  }
+  if (after.curves_.size() != 24) {
+    error = true;
+    std::cout << errmsg << " : wrong number of splines after a frozen append" << std::endl;
+  }
+  for (std::size_t i = 19; i < 25; ++i) {
+    ComparePoints(waypoints[i].second, after(waypoints[i].first), errmsg + " (freeze)", error, 1e-10);
+  }
+  for (std::size_t i = 19; i < 24; ++i) {
+    for (std::size_t order = 1; order <= 2; ++order) {
+      ComparePoints(after.curves_[i - 1]->derivate(waypoints[i].first, order),
+                    after.curves_[i]->derivate(waypoints[i].first, order), errmsg + " (freeze)", error, 1e-8);
+    }
+  }
+  ComparePoints(point3_t::Zero(), after.derivate(after.max(), 2), errmsg + " (freeze)", error, 1e-8);
+
+  try {
+    frozen.append(waypoints[3].first, waypoints[3].second);
+    error = true;
+    std::cout << "exact_cubic_incremental: appending a waypoint before the end of the curve should raise an "
+                 "invalid_argument error"
+              << std::endl;
+  } catch (std::invalid_argument& /*e*/) {
+  }
+}
+
 /*Exact Cubic Function tests*/
 void ExactCubicTwoPointsTest(bool& error) {
   // Create an exact cubic spline with 2 waypoints => 1 polynomial defined in [0.0,1.0]
@@ -728,6 +865,52 @@ void EffectorTrajectoryTest(bool& error) {
   delete eff_traj;
 }
 
+void EffectorTrajectoryBatchTest(bool& error) {
+  // create arbitrary trajectories
+  std::vector<ndcurves::T_Waypoint> waypoint_sets;
+  for (double offset = 0; offset < 3; offset += 0.5) {
+    ndcurves::T_Waypoint waypoints;
+    for (double i = 0; i <= 10; i = i + 2) {
+      waypoints.push_back(std::make_pair(i, point3_t(i + offset, i, i * offset)));
+    }
+    waypoint_sets.push_back(waypoints);
+  }
+  const helpers::effector_spline_parameters params(Eigen::Vector3d::UnitZ(), Eigen::Vector3d(0, 0, 2), 1, 0.02, 1,
+                                                   0.5);
+  const std::vector<helpers::exact_cubic_t> eff_trajs =
+      helpers::effector_splines(waypoint_sets.begin(), waypoint_sets.end(), params);
+  // appended to an existing vector, the second half only:
+  const std::size_t half = waypoint_sets.size() / 2;
+  std::vector<helpers::exact_cubic_t> eff_trajs_appended(half);
+  helpers::effector_splines(waypoint_sets.begin() + half, waypoint_sets.end(), eff_trajs_appended, params);
+  std::string errmsg("Error in EffectorTrajectoryBatchTest; batch and single trajectories are not identical");
+  if (eff_trajs.size() != waypoint_sets.size()) {
+    error = true;
+    std::cout << errmsg << ": wrong number of trajectories" << std::endl;
+    return;
+  }
+  if (eff_trajs_appended.size() != waypoint_sets.size() || eff_trajs_appended[0].getNumberCurves() != 0) {
+    error = true;
+    std::cout << errmsg << ": the splines should be appended after the existing ones" << std::endl;
+    return;
+  }
+  for (std::size_t i = 0; i < waypoint_sets.size(); ++i) {
+    helpers::exact_cubic_t* eff_traj =
+        helpers::effector_spline(waypoint_sets[i].begin(), waypoint_sets[i].end(), params.lift_normal,
+                                 params.land_normal, params.lift_offset, params.land_offset,
+                                 params.lift_offset_duration, params.land_offset_duration);
+    if (!eff_traj->isApprox(eff_trajs[i])) {
+      error = true;
+      std::cout << errmsg << std::endl;
+    }
+    if (i >= half && !eff_traj->isApprox(eff_trajs_appended[i])) {
+      error = true;
+      std::cout << errmsg << " (appended to an existing vector)" << std::endl;
+    }
+    delete eff_traj;
+  }
+}
+
 helpers::quat_t GetXRotQuat(const double theta) {
   Eigen::AngleAxisd m(theta, Eigen::Vector3d::UnitX());
   return helpers::quat_t(Eigen::Quaterniond(m).coeffs().data());
@@ -827,30 +1010,82 @@ void EffectorSplineRotationWayPointRotationTest(bool& error) {
   ComparePoints(q_end, eff_traj(10), errmsg, error);
 }
 
-void TestReparametrization(bool& error) {
-  helpers::rotation_spline s;
-  const helpers::exact_cubic_constraint_one_dim& sp = s.time_reparam_;
-  if (!QuasiEqual(sp.min(), 0.0)) {
-    std::cout << "in TestReparametrization; min value is not 0, got " << sp.min() << std::endl;
-    error = true;
+void EffectorSplineRotationDerivativeTest(bool& error) {
+  // create arbitrary trajectory
+  ndcurves::T_Waypoint waypoints;
+  for (double i = 0; i <= 10; i = i + 2) {
+    waypoints.push_back(std::make_pair(i, point3_t(i, i, i)));
   }
-  if (!QuasiEqual(sp.max(), 1.0)) {
-    std::cout << "in TestReparametrization; max value is not 1, got " << sp.max() << std::endl;
+  helpers::t_waypoint_quat_t quat_waypoints_;
+  quat_waypoints_.push_back(std::make_pair(4, GetXRotQuat(M_PI_2)));
+  quat_waypoints_.push_back(std::make_pair(7, helpers::quat_t(0.2, 0.3, -0.5, 0.8).normalized()));
+  helpers::effector_spline_rotation eff_traj(waypoints.begin(), waypoints.end(), quat_waypoints_.begin(),
+                                             quat_waypoints_.end());
+  std::string errmsg(
+      "Error in EffectorSplineRotationDerivativeTest; while checking derivatives with finite differences (expected / "
+      "obtained)");
+  const double dt = 1e-6;
+  for (double t = 0.1; t < 9.9; t += 0.35) {
+    const helpers::config_derivate_t vel = eff_traj.derivate(t, 1);
+    // angular velocity in the local frame:
+    const Eigen::Quaterniond q0(eff_traj(t - dt).tail<4>()), q1(eff_traj(t + dt).tail<4>());
+    const Eigen::AngleAxisd aa(q0.conjugate() * q1);
+    helpers::config_derivate_t vel_fd;
+    vel_fd.head<3>() = (eff_traj(t + dt).head<3>() - eff_traj(t - dt).head<3>()) / (2 * dt);
+    vel_fd.tail<3>() = aa.angle() * aa.axis() / (2 * dt);
+    ComparePoints(vel_fd, vel, errmsg, error, 1e-4);
+    const helpers::config_derivate_t acc_fd = (eff_traj.derivate(t + dt, 1) - eff_traj.derivate(t - dt, 1)) / (2 * dt);
+    ComparePoints(acc_fd, eff_traj.derivate(t, 2), errmsg, error, 1e-4);
+  }
+  // derivative of the quaternion coefficients of a rotation_spline:
+  helpers::rotation_spline rot_spline(GetXRotQuat(0.3), helpers::quat_t(0.2, 0.3, -0.5, 0.8).normalized(), 1., 3.);
+  for (double t = 1.1; t < 3.; t += 0.2) {
+    ComparePoints((rot_spline(t + dt) - rot_spline(t - dt)) / (2 * dt), rot_spline.derivate(t, 1), errmsg, error,
+                  1e-4);
+    ComparePoints((rot_spline.derivate(t + dt, 1) - rot_spline.derivate(t - dt, 1)) / (2 * dt),
+                  rot_spline.derivate(t, 2), errmsg, error, 1e-4);
+  }
+  ComparePoints(helpers::angular_derivate_t::Zero(), rot_spline.angular_derivate(1., 1), errmsg, error);
+  ComparePoints(helpers::angular_derivate_t::Zero(), rot_spline.angular_derivate(3., 1), errmsg, error);
+  try {
+    rot_spline.derivate(2., 0);
     error = true;
+    std::cout << "rotation_spline: calling derivate with order = 0 should raise an invalid_argument error"
+              << std::endl;
+  } catch (std::invalid_argument& /*e*/) {
   }
-  if (!QuasiEqual(sp(1)[0], 1.0)) {
-    std::cout << "in TestReparametrization; end value is not 1, got " << sp(1)[0] << std::endl;
+}
+
+void TestReparametrization(bool& error) {
+  // the closed form reparametrization is the exact cubic spline through (0, 0) and (1, 1):
+  helpers::t_waypoint_one_dim_t waypoints;
+  waypoints.push_back(std::make_pair(0, helpers::point_one_dim_t::Zero()));
+  waypoints.push_back(std::make_pair(1, helpers::point_one_dim_t::Ones()));
+  const helpers::exact_cubic_constraint_one_dim sp(waypoints.begin(), waypoints.end());
+  if (!QuasiEqual(helpers::rotation_spline::time_reparam(1), 1.0)) {
+    std::cout << "in TestReparametrization; end value is not 1, got " << helpers::rotation_spline::time_reparam(1)
+              << std::endl;
     error = true;
   }
-  if (!QuasiEqual(sp(0)[0], 0.0)) {
-    std::cout << "in TestReparametrization; init value is not 0, got " << sp(0)[0] << std::endl;
+  if (!QuasiEqual(helpers::rotation_spline::time_reparam(0), 0.0)) {
+    std::cout << "in TestReparametrization; init value is not 0, got " << helpers::rotation_spline::time_reparam(0)
+              << std::endl;
     error = true;
   }
   for (double i = 0; i < 1; i += 0.002) {
-    if (sp(i)[0] > sp(i + 0.002)[0]) {
-      std::cout << "in TestReparametrization; reparametrization not monotonous " << sp.max() << std::endl;
+    if (helpers::rotation_spline::time_reparam(i) > helpers::rotation_spline::time_reparam(i + 0.002)) {
+      std::cout << "in TestReparametrization; reparametrization not monotonous at " << i << std::endl;
       error = true;
     }
+    for (std::size_t order = 0; order <= 3; ++order) {
+      const double expected = order == 0 ? sp(i)[0] : sp.derivate(i, order)[0];
+      if (!QuasiEqual(helpers::rotation_spline::time_reparam_derivate(i, order), expected)) {
+        std::cout << "in TestReparametrization; closed form reparametrization of order " << order
+                  << " is not the exact cubic, expected " << expected << " got "
+                  << helpers::rotation_spline::time_reparam_derivate(i, order) << std::endl;
+        error = true;
+      }
+    }
   }
 }
 
@@ -1401,6 +1636,57 @@ void curveAbcDimDynamicTest(bool& error) {
   }
 }
 
+void curveFixedSize3Test(bool& error) {
+  std::string errmsg("In curveFixedSize3Test, Error while comparing the fixed size and the dynamic size curves");
+  if (polynomial3_t::coeff_t::RowsAtCompileTime != 3) {
+    error = true;
+    std::cout << errmsg << " : the coefficients of polynomial3_t should have a fixed number of rows" << std::endl;
+  }
+  // EXACT CUBIC
+  ndcurves::T_Waypoint waypoints;
+  t_pointX_t points;
+  std::vector<double> times;
+  for (double t = 0; t <= 2.; t = t + 0.4) {
+    waypoints.push_back(std::make_pair(t, point3_t(std::cos(3. * t), t * t, std::sin(t))));
+    points.push_back(waypoints.back().second);
+    times.push_back(t);
+  }
+  const exact_cubic_t ec(waypoints.begin(), waypoints.end());
+  const exact_cubic3_t ec3(waypoints.begin(), waypoints.end());
+  for (double t = 0; t <= 2.; t = t + 0.05) {
+    for (std::size_t order = 0; order <= 3; ++order) {
+      ComparePoints(ec.derivate(t, order), ec3.derivate(t, order), errmsg + " (exact cubic)", error);
+    }
+  }
+  // BEZIER: the derivatives evaluated on the fly are the ones of the derived curve
+  const bezier_t bc(points.begin(), points.end(), 0.5, 2.);
+  t_point3_t points3;
+  for (std::size_t i = 0; i < points.size(); ++i) points3.push_back(points[i]);
+  const bezier3_t bc3(points3.begin(), points3.end(), 0.5, 2.);
+  for (double t = 0.5; t <= 2.; t = t + 0.05) {
+    for (std::size_t order = 1; order <= bc.degree() + 1; ++order) {
+      ComparePoints(bc.compute_derivate(order)(t), bc.derivate(t, order), errmsg + " (bezier)", error);
+      ComparePoints(bc.derivate(t, order), bc3.derivate(t, order), errmsg + " (bezier3)", error);
+    }
+  }
+  // CUBIC HERMITE
+  cubic_hermite_spline_t::t_pair_point_tangent_t pairs;
+  cubic_hermite_spline3_t::t_pair_point_tangent_t pairs3;
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    const point3_t tangent(std::sin(double(i)), 1., -2. * double(i));
+    pairs.push_back(std::make_pair(points[i], pointX_t(tangent)));
+    pairs3.push_back(std::make_pair(points3[i], tangent));
+  }
+  const cubic_hermite_spline_t chs(pairs.begin(), pairs.end(), times);
+  const cubic_hermite_spline3_t chs3(pairs3.begin(), pairs3.end(), times);
+  for (double t = 0; t <= 2.; t = t + 0.05) {
+    for (std::size_t order = 0; order <= 4; ++order) {
+      ComparePoints(chs.compute_derivate(order)(t), chs.derivate(t, order), errmsg + " (hermite)", error);
+      ComparePoints(chs.derivate(t, order), chs3.derivate(t, order), errmsg + " (hermite3)", error);
+    }
+  }
+}
+
 void PiecewisePolynomialCurveFromDiscretePoints(bool& error) {
   std::string errMsg("PiecewisePolynomialCurveFromDiscretePoints, Error, value on curve is wrong : ");
   point3_t p0(0., 0., 0.);
@@ -2539,6 +2825,37 @@ void BezierLinearProblemsetupLoadProblem(bool& /*error*/) {
   // initInequalityMatrix<point_t,3,double>(pDef,pData,prob);
 }
 
+void BezierLinearProblemSplit(bool& error) {
+  problem_definition_t pDef(3);
+  pDef.flag = INIT_POS | END_POS;
+  pDef.init_pos = point3_t(0., 0., 0.);
+  pDef.end_pos = point3_t(1., 2., 3.);
+  pDef.degree = 5;
+  pDef.totalTime = 2.;
+  pDef.splitTimes_ = Eigen::Vector3d(0.5, 0.8, 1.5);
+  problem_data_t pData = setup_control_points<point3_t, double, true>(pDef);
+  const problem_data_t::bezier_t full(*pData.bezier);
+  const std::vector<problem_data_t::bezier_t> beziers = split(pDef, pData);
+  if (beziers.size() != 4) {
+    error = true;
+    std::cout << "BezierLinearProblemSplit: expected 4 curves, got " << beziers.size() << std::endl;
+    return;
+  }
+  // the split times are absolute times, each curve must match the original curve on its interval:
+  const double bounds[] = {0., 0.5, 0.8, 1.5, 2.};
+  for (std::size_t i = 0; i < beziers.size(); ++i) {
+    if (!QuasiEqual(beziers[i].min(), bounds[i]) || !QuasiEqual(beziers[i].max(), bounds[i + 1])) {
+      error = true;
+      std::cout << "BezierLinearProblemSplit: wrong time interval for curve " << i << std::endl;
+    }
+    const double t = (bounds[i] + bounds[i + 1]) / 2.;
+    if (!beziers[i](t).isApprox(full(t))) {
+      error = true;
+      std::cout << "BezierLinearProblemSplit: wrong value for curve " << i << std::endl;
+    }
+  }
+}
+
 void testOperatorEqual(bool& error) {
   // test with a C2 polynomial :
   pointX_t zeros = point3_t(0., 0., 0.);
@@ -2892,11 +3209,15 @@ int main(int /*argc*/, char** /*argv[]*/) {
   ExactCubicTwoPointsTest(error);
   ExactCubicOneDimTest(error);
   ExactCubicVelocityConstraintsTest(error);
+  ExactCubicSolverTest(error);
+  ExactCubicIncrementalTest(error);
   EffectorTrajectoryTest(error);
+  EffectorTrajectoryBatchTest(error);
   EffectorSplineRotationNoRotationTest(error);
   EffectorSplineRotationRotationTest(error);
   TestReparametrization(error);
   EffectorSplineRotationWayPointRotationTest(error);
+  EffectorSplineRotationDerivativeTest(error);
   BezierCurveTest(error);
   BezierDerivativeCurveTest(error);
   BezierDerivativeCurveConstraintTest(error);
@@ -2912,6 +3233,7 @@ int main(int /*argc*/, char** /*argv[]*/) {
   toPolynomialConversionTest(error);
   cubicConversionTest(error);
   curveAbcDimDynamicTest(error);
+  curveFixedSize3Test(error);
   serializationCurvesTest(error);
   polynomialFromBoundaryConditions(error);
   so3LinearTest(error);
@@ -2923,6 +3245,7 @@ int main(int /*argc*/, char** /*argv[]*/) {
   BezierLinearProblemsetup_control_pointsVarCombinatorialEnd(error);
   BezierLinearProblemsetup_control_pointsVarCombinatorialMix(error);
   BezierLinearProblemsetupLoadProblem(error);
+  BezierLinearProblemSplit(error);
   testOperatorEqual(error);
 
   if (error) {
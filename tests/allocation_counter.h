@@ -0,0 +1,76 @@
+/**
+ * \file allocation_counter.h
+ * \brief Count the heap allocations made by a test. It replaces the global operator new and eigen_assert, so it
+ * must be included once per test executable, before Eigen and the ndcurves headers.
+ */
+
+#ifndef _CLASS_TEST_ALLOCATION_COUNTER
+#define _CLASS_TEST_ALLOCATION_COUNTER
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace {
+// While counting is set, every call to the global operator new is counted. The heap allocations made by Eigen,
+// e.g. by Eigen::aligned_allocator, use malloc: they are forbidden with EIGEN_RUNTIME_NO_MALLOC and counted by the
+// eigen_assert below.
+bool counting = false;
+std::size_t num_allocations = 0;
+
+// Count the failure of the EIGEN_RUNTIME_NO_MALLOC check and abort on every other failed assertion. Unlike the
+// default eigen_assert, it is not disabled by NDEBUG: the allocations are also detected in a Release build.
+void eigen_assert_failed(const char* condition, const char* file, const int line) {
+  if (std::strstr(condition, "heap allocation is forbidden")) {
+    ++num_allocations;
+    return;
+  }
+  std::fprintf(stderr, "%s:%d: assertion failed: %s\n", file, line, condition);
+  std::abort();
+}
+}  // namespace
+
+#define EIGEN_RUNTIME_NO_MALLOC
+#define eigen_assert(x)                                    \
+  do {                                                     \
+    if (!(x)) eigen_assert_failed(#x, __FILE__, __LINE__); \
+  } while (false)
+
+#include <Eigen/Core>
+
+// The replacements are not inlined, otherwise GCC sees the free of a pointer returned by new (-Wmismatched-new-delete)
+#if defined(__GNUC__)
+#define TEST_NOINLINE __attribute__((noinline))
+#else
+#define TEST_NOINLINE
+#endif
+
+TEST_NOINLINE void* operator new(std::size_t size) {
+  if (counting) ++num_allocations;
+  void* p = std::malloc(size ? size : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+TEST_NOINLINE void* operator new[](std::size_t size) { return operator new(size); }
+TEST_NOINLINE void operator delete(void* p) throw() { std::free(p); }
+TEST_NOINLINE void operator delete[](void* p) throw() { std::free(p); }
+
+namespace {
+/// \brief Count the heap allocations made during its lifetime.
+struct allocation_counter {
+  allocation_counter() {
+    num_allocations = 0;
+    counting = true;
+    Eigen::internal::set_is_malloc_allowed(false);
+  }
+  ~allocation_counter() { stop(); }
+  std::size_t stop() {
+    counting = false;
+    Eigen::internal::set_is_malloc_allowed(true);
+    return num_allocations;
+  }
+};
+}  // namespace
+
+#endif  //_CLASS_TEST_ALLOCATION_COUNTER
@@ -0,0 +1,26 @@
+/**
+ * \file control_rotations.h
+ * \brief Control rotations of the SO3Bezier curves of the tests.
+ */
+
+#ifndef _CLASS_TEST_CONTROL_ROTATIONS
+#define _CLASS_TEST_CONTROL_ROTATIONS
+
+#include "ndcurves/fwd.h"
+#include "ndcurves/so3_bezier.h"
+
+namespace {
+/// \brief Five unit quaternions, starting at the identity and ending at a rotation of pi around z.
+ndcurves::SO3Bezier_t::t_quaternion_t control_rotations() {
+  typedef ndcurves::quaternion_t quaternion_t;
+  ndcurves::SO3Bezier_t::t_quaternion_t rotations;
+  rotations.push_back(quaternion_t(1, 0, 0, 0));
+  rotations.push_back(quaternion_t(0.7071, 0.7071, 0, 0).normalized());
+  rotations.push_back(quaternion_t(0.544, -0.002, -0.796, 0.265).normalized());
+  rotations.push_back(quaternion_t(0.2, 0.3, -0.5, 0.8).normalized());
+  rotations.push_back(quaternion_t(0., 0., 0., 1.));
+  return rotations;
+}
+}  // namespace
+
+#endif  //_CLASS_TEST_CONTROL_ROTATIONS
@@ -0,0 +1,165 @@
+#define BOOST_TEST_MODULE test_arena
+
+#include "allocation_counter.h"
+
+#include <cstdint>
+
+#include "ndcurves/fwd.h"
+#include "ndcurves/arena.h"
+#include "ndcurves/bezier_curve.h"
+#include "ndcurves/piecewise_curve.h"
+#include "ndcurves/polynomial.h"
+#include "ndcurves/optimization/details.h"
+#include <boost/test/included/unit_test.hpp>
+
+using namespace ndcurves;
+
+namespace {
+bool is_aligned(const void* p, const std::size_t alignment) {
+  return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+}
+
+typedef arena_allocator<point3_t> point3_allocator_t;
+typedef bezier_curve<double, double, true, point3_t, point3_allocator_t> bezier3_arena_t;
+typedef piecewise_curve<double, double, true, point3_t, point3_t, curve_3_t, piecewise_storage_shared,
+                        point3_allocator_t>
+    piecewise3_arena_t;
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+BOOST_AUTO_TEST_CASE(monotonic_arena_allocation) {
+  monotonic_arena arena(1024);
+  BOOST_CHECK_EQUAL(arena.capacity(), 0);
+  void* a = arena.allocate(3, 1);
+  void* b = arena.allocate(8, 16);
+  void* c = arena.allocate(100, 64);
+  BOOST_CHECK(is_aligned(b, 16));
+  BOOST_CHECK(is_aligned(c, 64));
+  BOOST_CHECK(static_cast<char*>(b) >= static_cast<char*>(a) + 3);
+  BOOST_CHECK(static_cast<char*>(c) >= static_cast<char*>(b) + 8);
+  BOOST_CHECK_EQUAL(arena.num_blocks(), 1);
+  BOOST_CHECK_GE(arena.used(), 111);
+  // a request larger than the blocks gets its own block:
+  void* large = arena.allocate(4000, 16);
+  BOOST_CHECK(is_aligned(large, 16));
+  BOOST_CHECK_EQUAL(arena.num_blocks(), 2);
+  BOOST_CHECK_GE(arena.capacity(), 4000 + 1024);
+  // the next allocation does not fit in the large block and gets a new one:
+  arena.allocate(1000, 8);
+  BOOST_CHECK_EQUAL(arena.num_blocks(), 3);
+
+  // after a reset, the same allocations reuse the blocks:
+  const std::size_t capacity = arena.capacity();
+  arena.reset();
+  BOOST_CHECK_EQUAL(arena.used(), 0);
+  BOOST_CHECK(arena.allocate(3, 1) == a);
+  arena.allocate(8, 16);
+  arena.allocate(100, 64);
+  arena.allocate(4000, 16);
+  arena.allocate(1000, 8);
+  BOOST_CHECK_EQUAL(arena.num_blocks(), 3);
+  BOOST_CHECK_EQUAL(arena.capacity(), capacity);
+}
+
+BOOST_AUTO_TEST_CASE(piecewise_allocate_shared) {
+  monotonic_arena arena;
+  t_pointX_t points;
+  points.push_back(point3_t(1, 2, 3));
+  points.push_back(point3_t(4, 5, 6));
+  points.push_back(point3_t(-1, 0, 2));
+  for (std::size_t cycle = 0; cycle < 2; ++cycle) {
+    arena.reset();
+    {
+      const arena_allocator<bezier_t> alloc(arena);
+      piecewise_t pc, pc_heap;
+      for (std::size_t i = 0; i < 10; ++i) {
+        const bezier_t bezier(points.begin(), points.end(), double(i), double(i + 1));
+        pc.add_curve(bezier, alloc);
+        pc_heap.add_curve(bezier);
+        std::reverse(points.begin(), points.end());
+      }
+      BOOST_CHECK_GE(arena.used(), 10 * sizeof(bezier_t));
+      BOOST_CHECK(pc == pc_heap);
+      BOOST_CHECK(pc(4.5).isApprox(pc_heap(4.5)));
+      // copies share the curves allocated in the arena:
+      const piecewise_t pc_copy(pc);
+      BOOST_CHECK_EQUAL(pc_copy.curve_at_index(3).get(), pc.curve_at_index(3).get());
+      BOOST_CHECK_THROW(pc.add_curve(bezier_t(points.begin(), points.end(), 0., 1.), alloc), std::invalid_argument);
+    }
+    BOOST_CHECK_EQUAL(arena.num_blocks(), 1);
+  }
+  // the allocator is ignored by the value storage:
+  piecewise_bezier_value_t pc_value;
+  pc_value.add_curve(bezier_t(points.begin(), points.end(), 0., 1.), arena_allocator<bezier_t>(arena));
+  BOOST_CHECK_EQUAL(pc_value.num_curves(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(bezier_piecewise_in_arena) {
+  monotonic_arena arena;
+  arena.allocate(1, 1);  // the first block is allocated from the heap
+  const point3_allocator_t alloc(arena);
+  t_point3_t points;
+  points.push_back(point3_t(1, 2, 3));
+  points.push_back(point3_t(4, 5, 6));
+  points.push_back(point3_t(-1, 0, 2));
+  points.push_back(point3_t(3, -2, 1));
+  const bezier3_t bezier_heap(points.begin(), points.end(), 0., 2.);
+  {
+    allocation_counter counter;
+    const bezier3_arena_t bezier(points.begin(), points.end(), 0., 2., 1., alloc);
+    const bezier3_arena_t derivate = bezier.compute_derivate(1);
+    const std::pair<bezier3_arena_t, bezier3_arena_t> halves = bezier.split(1.);
+    const bezier3_arena_t elevated = bezier.elevate(2) + bezier;
+    piecewise3_arena_t pc(alloc);
+    pc.add_curve(halves.first, alloc);
+    pc.add_curve(halves.second, alloc);
+    const piecewise3_arena_t pc_copy(pc);
+    BOOST_CHECK_EQUAL(counter.stop(), 0);
+
+    BOOST_CHECK(derivate.get_allocator() == alloc);
+    BOOST_CHECK(elevated.get_allocator() == alloc);
+    BOOST_CHECK(pc.get_allocator() == alloc);
+    for (double t = 0.; t <= 2.; t += 0.1) {
+      BOOST_CHECK(bezier(t).isApprox(bezier_heap(t)));
+      BOOST_CHECK(derivate(t).isApprox(bezier_heap.derivate(t, 1)));
+      BOOST_CHECK(elevated(t).isApprox(2. * bezier_heap(t)));
+      BOOST_CHECK(pc_copy(t).isApprox(bezier_heap(t)));
+    }
+  }
+  BOOST_CHECK_EQUAL(arena.num_blocks(), 1);
+  // the curves using the default allocator are detected by the counter:
+  {
+    allocation_counter counter;
+    const bezier3_t bezier(points.begin(), points.end(), 0., 2.);
+    piecewise3_t pc;
+    pc.add_curve(bezier);
+    BOOST_CHECK_GT(counter.stop(), 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(problem_data_in_arena) {
+  using namespace ndcurves::optimization;
+  typedef arena_allocator<linear_variable_t> variable_allocator_t;
+  monotonic_arena arena;
+  problem_definition<pointX_t, double> pDef(3);
+  pDef.init_pos = pointX_t::Zero(3);
+  pDef.end_pos = pointX_t::Ones(3);
+  pDef.degree = 5;
+  pDef.flag = INIT_POS | END_POS;
+  pDef.splitTimes_ = Eigen::VectorXd::Constant(1, 0.5);
+  const variable_allocator_t alloc(arena);
+  problem_data<pointX_t, double, true, variable_allocator_t> pData =
+      setup_control_points<pointX_t, double, true>(pDef, alloc);
+  problem_data<pointX_t, double> pData_heap = setup_control_points<pointX_t, double, true>(pDef);
+  BOOST_CHECK(pData.variables_.get_allocator() == alloc);
+  BOOST_CHECK_GE(arena.used(), pData.variables_.size() * sizeof(linear_variable_t));
+  BOOST_CHECK_EQUAL(pData.numVariables, pData_heap.numVariables);
+  const problem_data<pointX_t, double, true, variable_allocator_t>::T_bezier_t beziers =
+      split<pointX_t, double>(pDef, pData);
+  BOOST_CHECK(beziers.get_allocator() == alloc);
+  BOOST_CHECK_EQUAL(beziers.size(), 2);
+  BOOST_CHECK(beziers[1] == (split<pointX_t, double>(pDef, pData_heap)[1]));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
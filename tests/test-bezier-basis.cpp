@@ -0,0 +1,105 @@
+#define BOOST_TEST_MODULE test_bezier_basis
+
+#include "ndcurves/fwd.h"
+#include "ndcurves/bezier_curve.h"
+#include "ndcurves/linear_variable.h"
+#include <boost/test/included/unit_test.hpp>
+
+using namespace ndcurves;
+
+namespace {
+bezier_t make_bezier(const std::size_t degree, const double t_min, const double t_max) {
+  bezier_t::t_point_t points;
+  for (std::size_t i = 0; i <= degree; ++i) {
+    points.push_back(pointX_t::Random(3));
+  }
+  return bezier_t(points.begin(), points.end(), t_min, t_max);
+}
+
+pointX_t weighted_sum(const bezier_t& bc, const pointX_t& weights) {
+  pointX_t res = pointX_t::Zero(bc.dim());
+  for (std::size_t i = 0; i < bc.size_; ++i) {
+    res += weights[i] * bc.waypointAtIndex(i);
+  }
+  return res;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+BOOST_AUTO_TEST_CASE(bernstein_basis_values) {
+  pointX_t w;
+  bernstein_basis<double>(3, 0, 0.25, w);
+  BOOST_CHECK_EQUAL(w.size(), 4);
+  for (unsigned int i = 0; i <= 3; ++i) {
+    BOOST_CHECK_CLOSE(w[i], Bern<double>(3, i)(0.25), 1e-10);
+  }
+  BOOST_CHECK_CLOSE(w.sum(), 1., 1e-10);
+  // the derivatives of a partition of unity sum to zero:
+  bernstein_basis<double>(5, 2, 0.7, w);
+  BOOST_CHECK_SMALL(w.sum(), 1e-10);
+  bernstein_basis<double>(2, 3, 0.5, w);
+  BOOST_CHECK_EQUAL(w.size(), 3);
+  BOOST_CHECK(w.isZero());
+  // at the bounds, only the first order + 1 weights are not zero:
+  bernstein_basis<double>(4, 1, 0., w);
+  BOOST_CHECK_CLOSE(w[0], -4., 1e-10);
+  BOOST_CHECK_CLOSE(w[1], 4., 1e-10);
+  BOOST_CHECK(w.tail(3).isZero());
+}
+
+BOOST_AUTO_TEST_CASE(basis_at_derivatives) {
+  for (std::size_t degree = 0; degree < 8; ++degree) {
+    const bezier_t bc = make_bezier(degree, 0.5, 2.);
+    for (double t = 0.5; t <= 2.; t += 0.125) {
+      BOOST_CHECK(weighted_sum(bc, bc.basis_at(t)).isApprox(bc(t), 1e-9));
+      for (std::size_t order = 1; order <= degree + 1; ++order) {
+        const pointX_t expected = bc.derivate(t, order);
+        const pointX_t res = weighted_sum(bc, bc.basis_at(t, order));
+        BOOST_CHECK_SMALL((res - expected).norm(), 1e-8 * (1. + expected.norm()));
+      }
+    }
+  }
+  // the factor of the derived curves is taken into account:
+  const bezier_t bc = make_bezier(5, 0., 3.);
+  const bezier_t derived = bc.compute_derivate(2);
+  BOOST_CHECK(weighted_sum(derived, derived.basis_at(1.2, 1)).isApprox(bc.derivate(1.2, 3), 1e-9));
+}
+
+BOOST_AUTO_TEST_CASE(basis_matrix_rows) {
+  const bezier_t bc = make_bezier(6, -1., 1.);
+  pointX_t times(5);
+  times << -1., -0.3, 0., 0.8, 1.;
+  for (std::size_t order = 0; order < 4; ++order) {
+    const Eigen::MatrixXd m = bc.basis_matrix(times, order);
+    BOOST_CHECK_EQUAL(m.rows(), 5);
+    BOOST_CHECK_EQUAL(m.cols(), 7);
+    for (int j = 0; j < times.size(); ++j) {
+      BOOST_CHECK(m.row(j).transpose().isApprox(bc.basis_at(times[j], order)));
+    }
+  }
+  BOOST_CHECK_THROW(bc.basis_at(1.5), std::invalid_argument);
+  BOOST_CHECK_THROW(bc.basis_matrix(pointX_t::Constant(2, 3.)), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(linear_variable_bezier) {
+  // x(t) = sum_i B_i(t) (B_i x + c_i), the weights of the bezier of linear variables give the same linear map:
+  std::vector<linear_variable_t> vars;
+  for (int i = 0; i < 4; ++i) {
+    vars.push_back(linear_variable_t(Eigen::MatrixXd::Random(3, 5), Eigen::VectorXd::Random(3)));
+  }
+  const bezier_linear_variable_t bc(vars.begin(), vars.end(), 0., 2.);
+  const pointX_t x = pointX_t::Random(5);
+  for (std::size_t order = 0; order < 3; ++order) {
+    const pointX_t w = bc.basis_at(0.6, order);
+    linear_variable_t res = bc.waypointAtIndex(0) * w[0];
+    for (std::size_t i = 1; i < bc.size_; ++i) {
+      res += bc.waypointAtIndex(i) * w[i];
+    }
+    const linear_variable_t expected = bc.derivate(0.6, order);
+    BOOST_CHECK(res.B().isApprox(expected.B(), 1e-9));
+    BOOST_CHECK(res(x).isApprox(expected(x), 1e-9));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
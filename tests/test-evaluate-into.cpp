@@ -0,0 +1,261 @@
+#define BOOST_TEST_MODULE test_evaluate_into
+
+#include "allocation_counter.h"
+#include "control_rotations.h"
+
+#include <limits>
+
+#include "ndcurves/fwd.h"
+#include "ndcurves/bezier_curve.h"
+#include "ndcurves/constant_curve.h"
+#include "ndcurves/cubic_hermite_spline.h"
+#include "ndcurves/exact_cubic.h"
+#include "ndcurves/linear_variable.h"
+#include "ndcurves/piecewise_curve.h"
+#include "ndcurves/polynomial.h"
+#include "ndcurves/se3_curve.h"
+#include "ndcurves/se3_derivate.h"
+#include "ndcurves/sinusoidal.h"
+#include "ndcurves/so3_bezier.h"
+#include "ndcurves/so3_linear.h"
+#include <boost/test/included/unit_test.hpp>
+
+using namespace ndcurves;
+
+namespace {
+template <typename Curve, typename Out>
+std::size_t allocations_evaluate(const Curve& c, const double t, Out out) {
+  allocation_counter counter;
+  c.evaluate_into(t, out);
+  return counter.stop();
+}
+
+template <typename Curve, typename Out>
+std::size_t allocations_derivate(const Curve& c, const double t, const std::size_t order, Out out) {
+  allocation_counter counter;
+  c.derivate_into(t, order, out);
+  return counter.stop();
+}
+
+template <typename Curve, typename Out>
+std::size_t allocations_evaluate_rt(const Curve& c, const double t, Out out, eval_status& status) {
+  allocation_counter counter;
+  status = c.evaluate_rt(t, out);
+  return counter.stop();
+}
+
+template <typename Curve, typename Out>
+std::size_t allocations_derivate_rt(const Curve& c, const double t, const std::size_t order, Out out,
+                                    eval_status& status) {
+  allocation_counter counter;
+  status = c.derivate_rt(t, order, out);
+  return counter.stop();
+}
+
+template <typename Derived, typename OtherDerived>
+bool is_close(const Eigen::MatrixBase<Derived>& a, const Eigen::MatrixBase<OtherDerived>& b) {
+  return (a - b).norm() <= 1e-10 * std::max(1., b.norm());
+}
+
+bool is_close(const transform_t& a, const transform_t& b) { return is_close(a.matrix(), b.matrix()); }
+
+// check that evaluate_into, derivate_into, evaluate_rt and derivate_rt, up to max_order, do not allocate and give
+// the same results as operator() and derivate(). out and dout must already have the dimension of the curve and of
+// its derivative.
+template <typename Curve>
+void check_evaluate_into(const Curve& c, typename Curve::point_t out, typename Curve::point_derivate_t dout,
+                         const std::size_t max_order) {
+  typedef typename Curve::point_t& out_t;
+  typedef typename Curve::point_derivate_t& derivate_out_t;
+  eval_status status;
+  for (std::size_t i = 0; i <= 10; ++i) {
+    const double t = c.min() + (c.max() - c.min()) * double(i) / 10.;
+    BOOST_CHECK_EQUAL((allocations_evaluate<Curve, out_t>(c, t, out)), 0);
+    BOOST_CHECK(is_close(out, c(t)));
+    BOOST_CHECK_EQUAL((allocations_evaluate_rt<Curve, out_t>(c, t, out, status)), 0);
+    BOOST_CHECK_EQUAL(status, EVAL_OK);
+    BOOST_CHECK(is_close(out, c(t)));
+    for (std::size_t order = 1; order <= max_order; ++order) {
+      BOOST_CHECK_EQUAL((allocations_derivate<Curve, derivate_out_t>(c, t, order, dout)), 0);
+      BOOST_CHECK_MESSAGE(is_close(dout, c.derivate(t, order)), "derivative of order " << order << " at " << t);
+      BOOST_CHECK_EQUAL((allocations_derivate_rt<Curve, derivate_out_t>(c, t, order, dout, status)), 0);
+      BOOST_CHECK_EQUAL(status, EVAL_OK);
+      BOOST_CHECK_MESSAGE(is_close(dout, c.derivate(t, order)), "derivative of order " << order << " at " << t);
+    }
+  }
+  // out of range, the time is clamped:
+  BOOST_CHECK_EQUAL((allocations_evaluate_rt<Curve, out_t>(c, c.min() - 1., out, status)), 0);
+  BOOST_CHECK_EQUAL(status, EVAL_CLAMPED);
+  BOOST_CHECK(is_close(out, c(c.min())));
+  BOOST_CHECK_EQUAL((allocations_evaluate_rt<Curve, out_t>(c, c.max() + 1., out, status)), 0);
+  BOOST_CHECK_EQUAL(status, EVAL_CLAMPED);
+  BOOST_CHECK(is_close(out, c(c.max())));
+  if (max_order > 0) {
+    BOOST_CHECK_EQUAL((allocations_derivate_rt<Curve, derivate_out_t>(c, c.max() + 1., 1, dout, status)), 0);
+    BOOST_CHECK_EQUAL(status, EVAL_CLAMPED);
+    BOOST_CHECK(is_close(dout, c.derivate(c.max(), 1)));
+  }
+}
+
+// same check through the base class, the call is dispatched to the overriding method.
+template <typename Curve>
+void check_evaluate_into_virtual(const Curve& c, typename Curve::point_t out, typename Curve::point_derivate_t dout,
+                                 const std::size_t max_order) {
+  typedef curve_abc<double, double, true, typename Curve::point_t, typename Curve::point_derivate_t> base_t;
+  check_evaluate_into<base_t>(c, out, dout, max_order);
+}
+
+t_pointX_t control_points() {
+  t_pointX_t points;
+  points.push_back(point3_t(1, 2, 3));
+  points.push_back(point3_t(4, -1, 6));
+  points.push_back(point3_t(-2, 8, 9));
+  points.push_back(point3_t(0.5, 3, -1));
+  return points;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+BOOST_AUTO_TEST_CASE(polynomial_bezier_hermite) {
+  const t_pointX_t points = control_points();
+  const pointX_t x3 = pointX_t::Zero(3);
+  const polynomial_t pol(points.begin(), points.end(), 0.5, 2.);
+  check_evaluate_into(pol, x3, x3, 4);
+  check_evaluate_into_virtual(pol, x3, x3, 4);
+  {
+    // check that the allocations are counted:
+    allocation_counter counter;
+    const std::vector<double> res(3);
+    BOOST_CHECK_GT(counter.stop(), 0);
+  }
+  {
+    // and the allocations made by Eigen:
+    allocation_counter counter;
+    const pointX_t res(points.size());
+    BOOST_CHECK_EQUAL(counter.stop(), 1);
+  }
+  const bezier_t bc(points.begin(), points.end(), 0.5, 2., 1.5);
+  check_evaluate_into(bc, x3, x3, 4);
+  check_evaluate_into_virtual(bc, x3, x3, 4);
+  const bezier_t bc_single(points.begin(), points.begin() + 1, 0.5, 2.);
+  check_evaluate_into(bc_single, x3, x3, 1);
+
+  std::vector<std::pair<pointX_t, pointX_t>, Eigen::aligned_allocator<std::pair<pointX_t, pointX_t> > > pairs;
+  std::vector<double> times;
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    pairs.push_back(std::make_pair(points[i], points[(i + 1) % points.size()]));
+    times.push_back(0.5 + 0.5 * double(i));
+  }
+  const cubic_hermite_spline_t hermite(pairs.begin(), pairs.end(), times);
+  check_evaluate_into(hermite, x3, x3, 4);
+  check_evaluate_into_virtual(hermite, x3, x3, 4);
+
+  const point3_t p3 = point3_t::Zero();
+  t_point3_t points3;
+  for (std::size_t i = 0; i < points.size(); ++i) points3.push_back(points[i]);
+  check_evaluate_into(polynomial3_t(points3.begin(), points3.end(), 0.5, 2.), p3, p3, 4);
+  check_evaluate_into(bezier3_t(points3.begin(), points3.end(), 0.5, 2.), p3, p3, 4);
+
+  // out of range:
+  pointX_t out = pointX_t::Zero(3);
+  BOOST_CHECK_THROW(pol.evaluate_into(2.5, out), std::invalid_argument);
+  BOOST_CHECK_THROW(bc.derivate_into(0., 1, out), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(constant_sinusoidal) {
+  const t_pointX_t points = control_points();
+  const pointX_t x3 = pointX_t::Zero(3);
+  const constant_t c(points[0], 0.5, 2.);
+  check_evaluate_into(c, x3, x3, 3);
+  check_evaluate_into_virtual(c, x3, x3, 3);
+  const sinusoidal_t s(points[0], points[1], 1.5, 0.2, 0.5, 2.);
+  check_evaluate_into(s, x3, x3, 3);
+  check_evaluate_into_virtual(s, x3, x3, 3);
+}
+
+BOOST_AUTO_TEST_CASE(piecewise_exact_cubic) {
+  const t_pointX_t points = control_points();
+  const pointX_t x3 = pointX_t::Zero(3);
+  std::vector<double> times;
+  for (std::size_t i = 0; i < points.size(); ++i) times.push_back(0.5 * double(i));
+  piecewise_t pc = piecewise_t::convert_discrete_points_to_polynomial<polynomial_t>(points, points, times);
+  check_evaluate_into(pc, x3, x3, 3);
+  check_evaluate_into_virtual(pc, x3, x3, 3);
+  check_evaluate_into(pc.convert_piecewise_curve_to_bezier<bezier_t>(), x3, x3, 3);
+
+  std::vector<std::pair<double, pointX_t> > waypoints;
+  for (std::size_t i = 0; i < points.size(); ++i) waypoints.push_back(std::make_pair(times[i], points[i]));
+  const exact_cubic_t ec(waypoints.begin(), waypoints.end());
+  check_evaluate_into(ec, x3, x3, 3);
+
+  // the output can be a block of a bigger matrix:
+  Eigen::MatrixXd buffer = Eigen::MatrixXd::Zero(3, 4);
+  BOOST_CHECK_EQUAL(allocations_evaluate(pc, 0.7, buffer.col(1)), 0);
+  BOOST_CHECK_EQUAL(allocations_derivate(ec, 0.7, 2, buffer.col(3)), 0);
+  BOOST_CHECK(buffer.col(1).isApprox(pc(0.7)));
+  BOOST_CHECK(buffer.col(3).isApprox(ec.derivate(0.7, 2)));
+  BOOST_CHECK(buffer.col(0).isZero());
+}
+
+BOOST_AUTO_TEST_CASE(rotations_se3) {
+  const point3_t p3 = point3_t::Zero();
+  const quaternion_t q0(1., 0., 0., 0.);
+  const quaternion_t q1 = quaternion_t(0.544, -0.002, -0.796, 0.265).normalized();
+  const SO3Linear_t so3(q0, q1, 0.5, 2.);
+  check_evaluate_into(so3, matrix3_t::Zero(), p3, 2);
+  const SO3Bezier_t::t_quaternion_t rotations = control_rotations();
+  const SO3Bezier_t so3b(rotations.begin(), rotations.end(), 0.5, 2.);
+  check_evaluate_into(so3b, matrix3_t::Zero(), p3, 2);
+
+  const t_pointX_t points = control_points();
+  const SE3Curve_t se3(points[0], points[1], q0, q1, 0.5, 2.);
+  check_evaluate_into(se3, transform_t::Identity(), point6_t::Zero(), 2);
+  transform_t pose;
+  BOOST_CHECK(noexcept(se3.evaluate_rt(1., pose)));
+  check_evaluate_into_virtual(se3, transform_t::Identity(), point6_t::Zero(), 2);
+  check_evaluate_into(se3.compute_derivate(1), point6_t::Zero(), point6_t::Zero(), 1);
+
+  curve_ptr_t translation(new bezier_t(points.begin(), points.end(), 0.5, 2.));
+  curve_rotation_ptr_t rotation(new SO3Bezier_t(so3b));
+  piecewise_SE3_t pc_se3(boost::make_shared<SE3Curve_t>(translation, rotation));
+  pc_se3.add_curve(SE3Curve_t(points[3], points[0], rotations.back(), q0, 2., 3.));
+  check_evaluate_into(pc_se3, transform_t::Identity(), point6_t::Zero(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(real_time_errors) {
+  const t_pointX_t points = control_points();
+  pointX_t out = pointX_t::Zero(3);
+  pointX_t wrong_size = pointX_t::Zero(2);
+  const polynomial_t pol(points.begin(), points.end(), 0.5, 2.);
+  BOOST_CHECK_EQUAL(pol.evaluate_rt(1., wrong_size), EVAL_INVALID_SIZE);
+  BOOST_CHECK_EQUAL(polynomial_t().evaluate_rt(1., out), EVAL_EMPTY);
+  BOOST_CHECK_EQUAL(bezier_t().derivate_rt(1., 1, out), EVAL_EMPTY);
+  BOOST_CHECK_EQUAL(piecewise_t().evaluate_rt(1., out), EVAL_EMPTY);
+  BOOST_CHECK_EQUAL(sinusoidal_t(points[0], points[1], 1.5, 0.2, 0.5, 2.).derivate_rt(1., 0, out),
+                    EVAL_INVALID_ORDER);
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  BOOST_CHECK_EQUAL(pol.evaluate_rt(nan, out), EVAL_CLAMPED);
+  BOOST_CHECK(out.isApprox(pol(0.5)));
+
+  // a piecewise curve reports the error of its curves:
+  piecewise_t pc(boost::make_shared<polynomial_t>(pol));
+  BOOST_CHECK_EQUAL(pc.evaluate_rt(1., wrong_size), EVAL_INVALID_SIZE);
+
+  point3_t angular;
+  const SO3Bezier_t::t_quaternion_t rotations = control_rotations();
+  const SO3Bezier_t so3b(rotations.begin(), rotations.end(), 0.5, 2.);
+  BOOST_CHECK_EQUAL(so3b.derivate_rt(1., 3, angular), EVAL_INVALID_ORDER);
+  BOOST_CHECK_EQUAL(SO3Bezier_t().derivate_rt(1., 1, angular), EVAL_EMPTY);
+  BOOST_CHECK_EQUAL(SO3Linear_t().derivate_rt(1., 0, angular), EVAL_INVALID_ORDER);
+
+  // the points of bezier_linear_variable allocate, there is no real-time evaluation:
+  std::vector<linear_variable_t> variables;
+  variables.push_back(linear_variable_t::X(3));
+  variables.push_back(linear_variable_t::X(3));
+  const bezier_linear_variable_t blv(variables.begin(), variables.end(), 0., 1.);
+  linear_variable_t res = linear_variable_t::X(3);
+  BOOST_CHECK_EQUAL(blv.evaluate_rt(0.5, res), EVAL_NOT_REAL_TIME);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,221 @@
+#define BOOST_TEST_MODULE test_float
+
+#include "ndcurves/fwd.h"
+#include "ndcurves/bezier_curve.h"
+#include "ndcurves/constant_curve.h"
+#include "ndcurves/cubic_hermite_spline.h"
+#include "ndcurves/exact_cubic.h"
+#include "ndcurves/linear_variable.h"
+#include "ndcurves/piecewise_curve.h"
+#include "ndcurves/polynomial.h"
+#include "ndcurves/se3_curve.h"
+#include "ndcurves/sinusoidal.h"
+#include "ndcurves/so3_bezier.h"
+#include "ndcurves/so3_linear.h"
+#include "ndcurves/serialization/curves.hpp"
+#include <boost/test/included/unit_test.hpp>
+
+using namespace ndcurves;
+
+namespace {
+const float prec = 1e-4f;
+
+// compare a single precision curve with the same curve in double precision
+template <typename CurveF, typename CurveD>
+void check_same(const CurveF& cf, const CurveD& cd, const std::size_t max_order = 2) {
+  BOOST_CHECK_CLOSE(cf.min(), float(cd.min()), 1e-4);
+  BOOST_CHECK_CLOSE(cf.max(), float(cd.max()), 1e-4);
+  BOOST_CHECK_EQUAL(cf.dim(), cd.dim());
+  for (double t = cd.min(); t <= cd.max(); t += (cd.max() - cd.min()) / 17.) {
+    const typename CurveF::point_t pf = cf(float(t));
+    BOOST_CHECK(pf.template cast<double>().isApprox(cd(t), prec));
+    for (std::size_t order = 1; order <= max_order; ++order) {
+      const typename CurveF::point_derivate_t df = cf.derivate(float(t), order);
+      const typename CurveD::point_derivate_t dd = cd.derivate(t, order);
+      BOOST_CHECK(df.template cast<double>().isApprox(dd, prec) || (df.norm() < prec && dd.norm() < prec));
+    }
+  }
+}
+
+template <typename Curve>
+void check_serialization(const Curve& c) {
+  const std::string fileName("fileTest_float");
+  c.template saveAsText<Curve>(fileName + ".txt");
+  c.template saveAsXML<Curve>(fileName + ".xml", "curve");
+  c.template saveAsBinary<Curve>(fileName);
+  Curve c_txt, c_xml, c_binary;
+  c_txt.template loadFromText<Curve>(fileName + ".txt");
+  c_xml.template loadFromXML<Curve>(fileName + ".xml", "curve");
+  c_binary.template loadFromBinary<Curve>(fileName);
+  BOOST_CHECK(c.isApprox(c_txt, prec));
+  BOOST_CHECK(c.isApprox(c_xml, prec));
+  BOOST_CHECK(c == c_binary);
+}
+
+template <typename PointList>
+PointList control_points() {
+  typedef typename PointList::value_type point_t;
+  const typename point_t::Scalar coords[4][3] = {{1, 2, 3}, {4, -5, 6}, {-7, 8, 1}, {3, 0, -2}};
+  PointList res;
+  for (std::size_t i = 0; i < 4; ++i) {
+    point_t p(3);
+    p << coords[i][0], coords[i][1], coords[i][2];
+    res.push_back(p);
+  }
+  return res;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+BOOST_AUTO_TEST_CASE(polynomial) {
+  const t_pointXf_t pts_f = control_points<t_pointXf_t>();
+  const t_pointX_t pts_d = control_points<t_pointX_t>();
+  const polynomialf_t pf(pts_f.begin(), pts_f.end(), 0.5f, 2.f);
+  const polynomial_t pd(pts_d.begin(), pts_d.end(), 0.5, 2.);
+  check_same(pf, pd, 3);
+  check_same(polynomialf_t(pts_f[0], pts_f[1], pts_f[2], pts_f[3], 0.5f, 2.f),
+             polynomial_t(pts_d[0], pts_d[1], pts_d[2], pts_d[3], 0.5, 2.));
+  check_same(polynomialf_t(pts_f[0], pts_f[1], pts_f[2], pts_f[3], pts_f[1], pts_f[0], 0.5f, 2.f),
+             polynomial_t(pts_d[0], pts_d[1], pts_d[2], pts_d[3], pts_d[1], pts_d[0], 0.5, 2.));
+  check_same(polynomialf_t::MinimumJerk(pts_f[0], pts_f[1], 0.5f, 2.f),
+             polynomial_t::MinimumJerk(pts_d[0], pts_d[1], 0.5, 2.));
+  check_same(pf.compute_derivate(1), pd.compute_derivate(1));
+  check_same(pf * 2.f, pd * 2.);
+  check_same(pf / 2.f, pd / 2.);
+  check_same(pf.cross(pts_f[1]), pd.cross(pts_d[1]));
+  check_same(pf.cross(pf), pd.cross(pd));
+  const t_point3f_t pts_3f = control_points<t_point3f_t>();
+  const polynomial3f_t p3f(pts_3f.begin(), pts_3f.end(), 0.5f, 2.f);
+  check_same(p3f, pd);
+  check_serialization(pf);
+}
+
+BOOST_AUTO_TEST_CASE(bezier) {
+  const t_pointXf_t pts_f = control_points<t_pointXf_t>();
+  const t_pointX_t pts_d = control_points<t_pointX_t>();
+  bezierf_t bf(pts_f.begin(), pts_f.end(), 0.5f, 2.f);
+  bezier_t bd(pts_d.begin(), pts_d.end(), 0.5, 2.);
+  check_same(bf, bd, 3);
+  check_same(bf.compute_derivate(1), bd.compute_derivate(1));
+  check_same(bf.compute_primitive(1), bd.compute_primitive(1));
+  check_same(bf.elevate(2), bd.elevate(2));
+  check_same(bf.extract(0.7f, 1.5f), bd.extract(0.7, 1.5));
+  check_same(bf * 2.f, bd * 2.);
+  check_same(bf.cross(pts_f[1]), bd.cross(pts_d[1]));
+  check_same(polynomial_from_curve<polynomialf_t>(bf), polynomial_from_curve<polynomial_t>(bd));
+  check_same(hermite_from_curve<cubic_hermite_splinef_t>(bf), hermite_from_curve<cubic_hermite_spline_t>(bd));
+  check_same(bezier_from_curve<bezierf_t>(polynomial_from_curve<polynomialf_t>(bf)), bd);
+  const t_point3f_t pts_3f = control_points<t_point3f_t>();
+  const bezier3f_t b3f(pts_3f.begin(), pts_3f.end(), 0.5f, 2.f);
+  check_same(b3f, bd);
+  check_serialization(bf);
+
+  // linear variable
+  pointXf_t b(3);
+  b << 1.f, 2.f, 3.f;
+  linear_variablef_t lv(matrix3f_t::Identity() * 2.f, b);
+  lv *= 2.f;
+  lv /= 4.f;
+  BOOST_CHECK(lv(point3f_t(1.f, 1.f, 1.f)).isApprox(point3f_t(1.5f, 2.f, 2.5f)));
+}
+
+BOOST_AUTO_TEST_CASE(hermite_exact_cubic) {
+  const t_pointXf_t pts_f = control_points<t_pointXf_t>();
+  const t_pointX_t pts_d = control_points<t_pointX_t>();
+  std::vector<std::pair<pointXf_t, pointXf_t>, Eigen::aligned_allocator<std::pair<pointXf_t, pointXf_t> > > ptf;
+  std::vector<std::pair<pointX_t, pointX_t>, Eigen::aligned_allocator<std::pair<pointX_t, pointX_t> > > ptd;
+  std::vector<float> times_f;
+  std::vector<double> times_d;
+  for (std::size_t i = 0; i < pts_f.size(); ++i) {
+    ptf.push_back(std::make_pair(pts_f[i], pts_f[(i + 1) % 4]));
+    ptd.push_back(std::make_pair(pts_d[i], pts_d[(i + 1) % 4]));
+    times_f.push_back(0.5f * float(i));
+    times_d.push_back(0.5 * double(i));
+  }
+  const cubic_hermite_splinef_t hf(ptf.begin(), ptf.end(), times_f);
+  const cubic_hermite_spline_t hd(ptd.begin(), ptd.end(), times_d);
+  check_same(hf, hd);
+  check_serialization(hf);
+
+  std::vector<std::pair<float, pointXf_t> > wf;
+  std::vector<std::pair<double, pointX_t> > wd;
+  for (std::size_t i = 0; i < pts_f.size(); ++i) {
+    wf.push_back(std::make_pair(times_f[i], pts_f[i]));
+    wd.push_back(std::make_pair(times_d[i], pts_d[i]));
+  }
+  const exact_cubicf_t ef(wf.begin(), wf.end());
+  const exact_cubic_t ed(wd.begin(), wd.end());
+  check_same(ef, ed);
+  exact_cubicf_t::spline_constraints cf(3);
+  exact_cubic_t::spline_constraints cd(3);
+  cf.init_vel = pts_f[1];
+  cd.init_vel = pts_d[1];
+  check_same(exact_cubicf_t(wf.begin(), wf.end(), cf), exact_cubic_t(wd.begin(), wd.end(), cd));
+  check_serialization(ef);
+}
+
+BOOST_AUTO_TEST_CASE(piecewise_constant_sinusoidal) {
+  const t_pointXf_t pts_f = control_points<t_pointXf_t>();
+  const t_pointX_t pts_d = control_points<t_pointX_t>();
+  std::vector<float> times_f;
+  std::vector<double> times_d;
+  for (std::size_t i = 0; i < pts_f.size(); ++i) {
+    times_f.push_back(0.5f * float(i));
+    times_d.push_back(0.5 * double(i));
+  }
+  piecewisef_t pcf = piecewisef_t::convert_discrete_points_to_polynomial<polynomialf_t>(pts_f, pts_f, times_f);
+  piecewise_t pcd = piecewise_t::convert_discrete_points_to_polynomial<polynomial_t>(pts_d, pts_d, times_d);
+  check_same(pcf, pcd);
+  BOOST_CHECK(pcf.is_continuous(0));
+  check_same(pcf.convert_piecewise_curve_to_bezier<bezierf_t>(), pcd);
+  check_serialization(pcf);
+
+  const constantf_t cf(pts_f[0], 0.5f, 2.f);
+  const constant_t cd(pts_d[0], 0.5, 2.);
+  check_same(cf, cd);
+  check_serialization(cf);
+
+  const sinusoidalf_t sf(pts_f[0], pts_f[1], 1.5f, 0.2f, 0.5f, 2.f);
+  const sinusoidal_t sd(pts_d[0], pts_d[1], 1.5, 0.2, 0.5, 2.);
+  check_same(sf, sd);
+  check_serialization(sf);
+}
+
+BOOST_AUTO_TEST_CASE(rotations) {
+  const quaternionf_t q0f(1.f, 0.f, 0.f, 0.f);
+  const quaternionf_t q1f = quaternionf_t(0.544f, -0.002f, -0.796f, 0.265f).normalized();
+  const quaternion_t q0d(q0f.cast<double>());
+  const quaternion_t q1d(q1f.cast<double>());
+  const SO3Linearf_t so3f(q0f, q1f, 0.5f, 2.f);
+  const SO3Linear_t so3d(q0d, q1d, 0.5, 2.);
+  check_same(so3f, so3d, 1);
+  check_serialization(so3f);
+
+  SO3Bezierf_t::t_quaternion_t rotations_f;
+  SO3Bezier_t::t_quaternion_t rotations_d;
+  rotations_f.push_back(q0f);
+  rotations_f.push_back(quaternionf_t(0.7071f, 0.7071f, 0.f, 0.f).normalized());
+  rotations_f.push_back(q1f);
+  for (std::size_t i = 0; i < rotations_f.size(); ++i) rotations_d.push_back(rotations_f[i].cast<double>());
+  const SO3Bezierf_t so3bf(rotations_f.begin(), rotations_f.end(), 0.5f, 2.f);
+  const SO3Bezier_t so3bd(rotations_d.begin(), rotations_d.end(), 0.5, 2.);
+  check_same(so3bf, so3bd, 2);
+  check_serialization(so3bf);
+
+  const t_pointXf_t pts_f = control_points<t_pointXf_t>();
+  const t_pointX_t pts_d = control_points<t_pointX_t>();
+  const SE3Curvef_t se3f(pts_f[0], pts_f[1], q0f, q1f, 0.5f, 2.f);
+  const SE3Curve_t se3d(pts_d[0], pts_d[1], q0d, q1d, 0.5, 2.);
+  for (double t = 0.5; t <= 2.; t += 0.1) {
+    BOOST_CHECK(se3f(float(t)).matrix().cast<double>().isApprox(se3d(t).matrix(), prec));
+  }
+  check_same(se3f.compute_derivate(1), se3d.compute_derivate(1), 1);
+  check_serialization(se3f);
+  piecewise_SE3f_t pc_se3f(boost::make_shared<SE3Curvef_t>(se3f));
+  pc_se3f.add_curve(SE3Curvef_t(pts_f[1], pts_f[2], q1f, q0f, 2.f, 3.f));
+  BOOST_CHECK(pc_se3f(2.5f).isApprox(SE3Curvef_t(pts_f[1], pts_f[2], q1f, q0f, 2.f, 3.f)(2.5f)));
+  check_serialization(pc_se3f);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
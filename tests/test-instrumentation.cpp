@@ -0,0 +1,197 @@
+#define BOOST_TEST_MODULE test_instrumentation
+
+// The instrumentation is off by default, enable it for this test only:
+#ifndef CURVES_WITH_INSTRUMENTATION
+#define CURVES_WITH_INSTRUMENTATION
+#endif
+
+#include "ndcurves/fwd.h"
+#include "ndcurves/arena.h"
+#include "ndcurves/bezier_curve.h"
+#include "ndcurves/instrumentation.h"
+#include "ndcurves/piecewise_curve.h"
+#include "ndcurves/polynomial.h"
+#include "ndcurves/optimization/quadratic_problem.h"
+#include "ndcurves/serialization/curves.hpp"
+#include <boost/test/included/unit_test.hpp>
+#include <cstdio>
+#include <sstream>
+
+using namespace ndcurves;
+namespace inst = ndcurves::instrumentation;
+
+namespace {
+// Return the counter of (c, type), or a counter with a count of 0 if it does not exist
+inst::counter_snapshot find(const inst::category c, const std::string& type) {
+  const std::vector<inst::counter_snapshot> counters = inst::snapshot();
+  for (std::size_t i = 0; i < counters.size(); ++i) {
+    if (counters[i].category_ == c && counters[i].type_ == type) {
+      return counters[i];
+    }
+  }
+  inst::counter_snapshot res;
+  res.category_ = c;
+  res.type_ = type;
+  res.count_ = 0;
+  res.total_time_ = 0;
+  res.max_time_ = 0;
+  res.bytes_ = 0;
+  return res;
+}
+
+template <typename T>
+std::string name_of(const T*) {
+  return boost::core::demangle(typeid(T).name());
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+BOOST_AUTO_TEST_CASE(enabled) {
+  BOOST_CHECK(inst::enabled());
+  BOOST_CHECK_EQUAL(std::string(inst::category_name(inst::FIND_INTERVAL)), "find_interval");
+  BOOST_CHECK_THROW(inst::category_name(inst::NUM_CATEGORIES), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(counters) {
+  inst::reset();
+  bezier_t::t_point_t points;
+  points.push_back(pointX_t::Zero(3));
+  points.push_back(pointX_t::Ones(3));
+  points.push_back(pointX_t::Constant(3, 2.));
+  const bezier_t bc(points.begin(), points.end(), 0., 1.);
+  const std::string bezier_name = name_of(&bc);
+  for (int i = 0; i < 10; ++i) {
+    bc(0.1 * i);
+  }
+  bc.derivate(0.5, 1);
+  bc.derivate(0.5, 2);
+  bc.compute_derivate(1);
+  BOOST_CHECK_EQUAL(find(inst::EVALUATE, bezier_name).count_, 10);
+  BOOST_CHECK_EQUAL(find(inst::DERIVATE, bezier_name).count_, 2);
+  // compute_derivate is recursive, each order is counted:
+  BOOST_CHECK_EQUAL(find(inst::COMPUTE_DERIVATE, bezier_name).count_, 2);
+  const inst::counter_snapshot evaluate = find(inst::EVALUATE, bezier_name);
+  BOOST_CHECK_GE(evaluate.total_time_, evaluate.max_time_);
+  BOOST_CHECK_GE(evaluate.max_time_, 0.);
+
+  // the counters are per static type:
+  const pointX_t init = pointX_t::Zero(3), end = pointX_t::Ones(3);
+  const polynomial_t pol(init, end, 0., 1.);
+  pol(0.5);
+  BOOST_CHECK_EQUAL(find(inst::EVALUATE, name_of(&pol)).count_, 1);
+  BOOST_CHECK_EQUAL(find(inst::EVALUATE, bezier_name).count_, 10);
+
+  inst::reset();
+  BOOST_CHECK_EQUAL(find(inst::EVALUATE, bezier_name).count_, 0);
+  BOOST_CHECK_EQUAL(find(inst::EVALUATE, bezier_name).total_time_, 0.);
+  bc(0.5);
+  BOOST_CHECK_EQUAL(find(inst::EVALUATE, bezier_name).count_, 1);
+}
+
+BOOST_AUTO_TEST_CASE(piecewise) {
+  bezier_t::t_point_t points;
+  points.push_back(pointX_t::Zero(3));
+  points.push_back(pointX_t::Ones(3));
+  const bezier_t bc0(points.begin(), points.end(), 0., 1.), bc1(points.begin(), points.end(), 1., 2.);
+  inst::reset();
+  piecewise_t pc;
+  pc.add_curve(bc0);
+  pc.add_curve(bc1);
+  BOOST_CHECK_EQUAL(find(inst::ALLOCATION, "heap").count_, 2);
+  BOOST_CHECK_EQUAL(find(inst::ALLOCATION, "heap").bytes_, 2 * sizeof(bezier_t));
+  pc(0.5);
+  pc(1.5);
+  pc.derivate(1.5, 1);
+  const std::string piecewise_name = name_of(&pc);
+  BOOST_CHECK_EQUAL(find(inst::EVALUATE, piecewise_name).count_, 2);
+  BOOST_CHECK_EQUAL(find(inst::DERIVATE, piecewise_name).count_, 1);
+  BOOST_CHECK_EQUAL(find(inst::FIND_INTERVAL, piecewise_name).count_, 3);
+  // the segments are called through curve_abc, with the counters of bezier_t:
+  BOOST_CHECK_EQUAL(find(inst::EVALUATE, name_of(static_cast<const bezier_t*>(0))).count_, 2);
+
+  // the blocks of the arenas are counted, the curves copied in an arena are not:
+  inst::reset();
+  monotonic_arena arena(4096);
+  piecewise_t pc_arena;
+  pc_arena.add_curve(bc0, arena_allocator<bezier_t>(arena));
+  pc_arena.add_curve(bc1, arena_allocator<bezier_t>(arena));
+  BOOST_CHECK_EQUAL(find(inst::ALLOCATION, "heap").count_, arena.num_blocks());
+  BOOST_CHECK_EQUAL(find(inst::ALLOCATION, "heap").bytes_, arena.capacity());
+}
+
+BOOST_AUTO_TEST_CASE(serialization) {
+  bezier_t::t_point_t points;
+  points.push_back(pointX_t::Zero(3));
+  points.push_back(pointX_t::Ones(3));
+  const bezier_t bc(points.begin(), points.end(), 0., 1.);
+  inst::reset();
+  const std::string fileName("serialization_instrumentation");
+  bc.saveAsText<bezier_t>(fileName);
+  bezier_t bc_loaded;
+  bc_loaded.loadFromText<bezier_t>(fileName);
+  bc_loaded.loadFromText<bezier_t>(fileName);
+  std::remove(fileName.c_str());
+  BOOST_CHECK_EQUAL(find(inst::SAVE, name_of(&bc)).count_, 1);
+  BOOST_CHECK_EQUAL(find(inst::LOAD, name_of(&bc)).count_, 2);
+}
+
+BOOST_AUTO_TEST_CASE(optimization) {
+  using namespace ndcurves::optimization;
+  inst::reset();
+  problem_definition<pointX_t, double> pDef(3);
+  pDef.init_pos = pointX_t::Zero(3);
+  pDef.end_pos = pointX_t::Ones(3);
+  pDef.degree = 5;
+  pDef.flag = INIT_POS | END_POS;
+  ndcurves::optimization::generate_problem<pointX_t, double, true>(pDef, ACCELERATION);
+  BOOST_CHECK_EQUAL(find(inst::GENERATE_PROBLEM, "generate_problem").count_, 1);
+}
+
+BOOST_AUTO_TEST_CASE(chrome_trace) {
+  bezier_t::t_point_t points;
+  points.push_back(pointX_t::Zero(3));
+  points.push_back(pointX_t::Ones(3));
+  const bezier_t bc(points.begin(), points.end(), 0., 1.);
+  inst::reset();
+  // not recorded before start_trace:
+  bc(0.5);
+  BOOST_CHECK_EQUAL(inst::registry::instance().num_trace_events(), 0);
+  inst::start_trace(3);
+  bc(0.5);
+  bc.derivate(0.5, 1);
+  BOOST_CHECK_EQUAL(inst::registry::instance().num_trace_events(), 2);
+  // the trace is full after max_events calls:
+  bc(0.5);
+  bc(0.5);
+  BOOST_CHECK_EQUAL(inst::registry::instance().num_trace_events(), 3);
+  inst::stop_trace();
+  BOOST_CHECK_EQUAL(inst::registry::instance().num_trace_events(), 3);
+  // the counters are updated even if the trace is full:
+  BOOST_CHECK_EQUAL(find(inst::EVALUATE, name_of(&bc)).count_, 4);
+
+  std::ostringstream os;
+  inst::registry::instance().write_chrome_trace(os);
+  const std::string trace = os.str();
+  BOOST_CHECK(trace.find("\"traceEvents\":[") != std::string::npos);
+  BOOST_CHECK(trace.find("\"cat\":\"evaluate\",\"ph\":\"X\"") != std::string::npos);
+  BOOST_CHECK(trace.find("\"cat\":\"derivate\",\"ph\":\"X\"") != std::string::npos);
+  BOOST_CHECK(trace.find("\"otherData\":{\"counters\":[") != std::string::npos);
+  BOOST_CHECK(trace.find("\"category\":\"evaluate\",\"type\":\"" + name_of(&bc) + "\",\"count\":4") !=
+              std::string::npos);
+
+  const std::string fileName("instrumentation_trace.json");
+  inst::save_chrome_trace(fileName);
+  std::ifstream ifs(fileName.c_str());
+  std::stringstream saved;
+  saved << ifs.rdbuf();
+  ifs.close();
+  std::remove(fileName.c_str());
+  BOOST_CHECK_EQUAL(saved.str(), trace);
+  BOOST_CHECK_THROW(inst::save_chrome_trace("/not_a_directory/trace.json"), std::invalid_argument);
+
+  inst::reset();
+  BOOST_CHECK_EQUAL(inst::registry::instance().num_trace_events(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,98 @@
+#define BOOST_TEST_MODULE test_linear_batch
+
+#include "ndcurves/fwd.h"
+#include "ndcurves/bezier_curve.h"
+#include "ndcurves/linear_variable.h"
+#include "ndcurves/optimization/details.h"
+#include <boost/test/included/unit_test.hpp>
+
+using namespace ndcurves;
+
+namespace {
+const std::size_t dim = 3;
+
+// constant first and last control points, variable control points in between
+bezier_linear_variable_t make_linear_bezier(const std::size_t num_vars) {
+  const Eigen::MatrixXd zero = Eigen::MatrixXd::Zero(dim, num_vars);
+  std::vector<linear_variable_t> vars;
+  vars.push_back(linear_variable_t(zero, pointX_t::Random(dim)));
+  for (int i = 0; i < 4; ++i) {
+    vars.push_back(linear_variable_t(Eigen::MatrixXd::Random(dim, num_vars), Eigen::VectorXd::Random(dim)));
+  }
+  vars.push_back(linear_variable_t(zero, pointX_t::Random(dim)));
+  return bezier_linear_variable_t(vars.begin(), vars.end(), 0.5, 2.);
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+BOOST_AUTO_TEST_CASE(stack) {
+  const bezier_linear_variable_t bc = make_linear_bezier(5);
+  Eigen::MatrixXd B;
+  pointX_t c;
+  stackLinear(bc, 5, B, c);
+  BOOST_CHECK_EQUAL(B.rows(), 18);
+  BOOST_CHECK_EQUAL(B.cols(), 5);
+  BOOST_CHECK_EQUAL(c.size(), 18);
+  const pointX_t x = pointX_t::Random(5);
+  for (std::size_t i = 0; i < bc.size_; ++i) {
+    const pointX_t expected = bc.waypointAtIndex(i)(x);
+    BOOST_CHECK((B.middleRows(Eigen::Index(i * dim), dim) * x + c.segment(Eigen::Index(i * dim), dim))
+                    .isApprox(expected));
+  }
+  // the variable control points must have the size of x:
+  BOOST_CHECK_THROW(stackLinear(bc, 4, B, c), std::length_error);
+}
+
+BOOST_AUTO_TEST_CASE(batch) {
+  const bezier_linear_variable_t bc = make_linear_bezier(5);
+  const Eigen::MatrixXd X = Eigen::MatrixXd::Random(5, 20);
+  const Eigen::MatrixXd res = evaluateLinearBatch(bc, X);
+  BOOST_CHECK_EQUAL(res.rows(), 18);
+  BOOST_CHECK_EQUAL(res.cols(), 20);
+  for (Eigen::Index k = 0; k < X.cols(); ++k) {
+    const bezier_t expected = evaluateLinear<bezier_t, bezier_linear_variable_t>(bc, X.col(k));
+    for (std::size_t i = 0; i < bc.size_; ++i) {
+      BOOST_CHECK(res.col(k).segment(Eigen::Index(i * dim), dim).isApprox(expected.waypointAtIndex(i)));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(grid) {
+  const bezier_linear_variable_t bc = make_linear_bezier(5);
+  const Eigen::MatrixXd X = Eigen::MatrixXd::Random(5, 7);
+  pointX_t times(6);
+  times << 0.5, 0.7, 1., 1.3, 1.9, 2.;
+  for (std::size_t order = 0; order < 3; ++order) {
+    const Eigen::MatrixXd res = evaluateLinearOnGrid(bc, X, times, order);
+    BOOST_CHECK_EQUAL(res.rows(), 18);
+    BOOST_CHECK_EQUAL(res.cols(), 7);
+    for (Eigen::Index k = 0; k < X.cols(); ++k) {
+      const bezier_t expected = evaluateLinear<bezier_t, bezier_linear_variable_t>(bc, X.col(k));
+      for (Eigen::Index j = 0; j < times.size(); ++j) {
+        BOOST_CHECK(res.col(k).segment(j * dim, dim).isApprox(expected.derivate(times[j], order), 1e-9));
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(problem_data_bezier) {
+  // the curve of an optimization problem, with constant control points of B = Zero(dim, dim):
+  using namespace ndcurves::optimization;
+  problem_definition<pointX_t, double> pDef(3);
+  pDef.init_pos = pointX_t::Zero(3);
+  pDef.end_pos = pointX_t::Ones(3);
+  pDef.degree = 6;
+  pDef.flag = INIT_POS | END_POS;
+  const problem_data<pointX_t, double> pData = setup_control_points<pointX_t, double, true>(pDef);
+  const bezier_linear_variable_t& bc = *pData.bezier;
+  const Eigen::MatrixXd X = Eigen::MatrixXd::Random(Eigen::Index(pData.numVariables * 3), 4);
+  const Eigen::MatrixXd res = evaluateLinearOnGrid(bc, X, pointX_t::LinSpaced(5, bc.min(), bc.max()));
+  for (Eigen::Index k = 0; k < X.cols(); ++k) {
+    const bezier_t expected = evaluateLinear<bezier_t, bezier_linear_variable_t>(bc, X.col(k));
+    BOOST_CHECK(res.col(k).head(3).isApprox(expected(bc.min())));
+    BOOST_CHECK(res.col(k).tail(3).isApprox(expected(bc.max())));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
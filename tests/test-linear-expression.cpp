@@ -0,0 +1,117 @@
+#define BOOST_TEST_MODULE test_linear_expression
+
+#include "ndcurves/fwd.h"
+#include "ndcurves/bezier_curve.h"
+#include "ndcurves/linear_variable.h"
+#include "ndcurves/quadratic_variable.h"
+#include <boost/test/included/unit_test.hpp>
+
+using namespace ndcurves;
+
+namespace {
+linear_variable_t random_variable() {
+  return linear_variable_t(Eigen::MatrixXd::Random(3, 5), Eigen::VectorXd::Random(3));
+}
+
+void check_equal(const linear_variable_t& res, const Eigen::MatrixXd& B, const Eigen::VectorXd& c) {
+  BOOST_CHECK(!res.isZero());
+  BOOST_CHECK(res.B().isApprox(B));
+  BOOST_CHECK(res.c().isApprox(c));
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+BOOST_AUTO_TEST_CASE(operators) {
+  const linear_variable_t a = random_variable(), b = random_variable();
+  const double u = 0.3;
+  check_equal((1 - u) * a + u * b, (1 - u) * a.B() + u * b.B(), (1 - u) * a.c() + u * b.c());
+  check_equal(a - b, a.B() - b.B(), a.c() - b.c());
+  check_equal(-a, -a.B(), -a.c());
+  check_equal(a * 2., 2. * a.B(), 2. * a.c());
+  check_equal(a / 4., a.B() / 4., a.c() / 4.);
+  check_equal(3. * (a - b * 2.) / 2., 1.5 * (a.B() - 2. * b.B()), 1.5 * (a.c() - 2. * b.c()));
+  // expressions can be used wherever a linear variable is expected:
+  const Eigen::VectorXd x = Eigen::VectorXd::Random(5);
+  BOOST_CHECK(linear_variable_t(a + b)(x).isApprox(a(x) + b(x)));
+  BOOST_CHECK(linear_variable_t(a + b).isApprox(b + a));
+}
+
+BOOST_AUTO_TEST_CASE(assignment) {
+  const linear_variable_t a = random_variable(), b = random_variable();
+  linear_variable_t res = a;
+  // res appears in the expression:
+  res = 0.5 * res + 0.5 * b;
+  check_equal(res, 0.5 * (a.B() + b.B()), 0.5 * (a.c() + b.c()));
+  res = a;
+  res += 2. * b;
+  check_equal(res, a.B() + 2. * b.B(), a.c() + 2. * b.c());
+  res -= b - a;
+  check_equal(res, 2. * a.B() + b.B(), 2. * a.c() + b.c());
+  res.add_scaled(a, -2.);
+  check_equal(res, b.B(), b.c());
+}
+
+BOOST_AUTO_TEST_CASE(zero_variables) {
+  // the zero variables have no B and c, the expressions using them are evaluated term by term
+  const linear_variable_t a = random_variable(), zero;
+  check_equal(zero + 2. * a, 2. * a.B(), 2. * a.c());
+  check_equal(a - zero, a.B(), a.c());
+  check_equal(zero - a, -a.B(), -a.c());
+  const linear_variable_t zero_sum = zero + zero * 2.;
+  BOOST_CHECK(zero_sum.isZero());
+  linear_variable_t res;
+  res += a * 3.;
+  check_equal(res, 3. * a.B(), 3. * a.c());
+  res = zero + res;
+  check_equal(res, 3. * a.B(), 3. * a.c());
+}
+
+BOOST_AUTO_TEST_CASE(bezier_linear_variable) {
+  // de Casteljau, derivation and degree elevation use the expressions:
+  std::vector<linear_variable_t> vars;
+  for (int i = 0; i < 5; ++i) {
+    vars.push_back(random_variable());
+  }
+  const bezier_linear_variable_t bc(vars.begin(), vars.end(), 0., 2.);
+  const Eigen::VectorXd x = Eigen::VectorXd::Random(5);
+  const bezier_t fixed = evaluateLinear<bezier_t, bezier_linear_variable_t>(bc, x);
+  BOOST_CHECK(bc.evalDeCasteljau(0.7)(x).isApprox(fixed(0.7)));
+  BOOST_CHECK(bc.derivate(0.7, 2)(x).isApprox(fixed.derivate(0.7, 2)));
+  BOOST_CHECK(bc.elevate(2)(1.3)(x).isApprox(fixed(1.3)));
+  const bezier_linear_variable_t::piecewise_curve_t split = bc.split(pointX_t::Constant(1, 0.5));
+  BOOST_CHECK(split(1.5)(x).isApprox(fixed(1.5)));
+}
+
+BOOST_AUTO_TEST_CASE(quadratic_product) {
+  // diagonal linear variables:
+  const linear_variable_t a(Eigen::VectorXd::Random(3).asDiagonal() * Eigen::MatrixXd::Identity(3, 3),
+                            Eigen::VectorXd::Random(3));
+  const linear_variable_t b(Eigen::VectorXd::Random(3).asDiagonal() * Eigen::MatrixXd::Identity(3, 3),
+                            Eigen::VectorXd::Random(3));
+  const quadratic_variable<double> q = a * b;
+  const quadratic_variable<double> q_scaled = (a * 0.5) * b;
+  BOOST_CHECK(q_scaled.A().isApprox(0.5 * q.A()));
+  BOOST_CHECK(q_scaled.b().isApprox(0.5 * q.b()));
+  BOOST_CHECK_CLOSE(q_scaled.c(), 0.5 * q.c(), 1e-10);
+  const Eigen::VectorXd x = Eigen::VectorXd::Random(3);
+  BOOST_CHECK_CLOSE(q(x), a(x).dot(b(x)), 1e-8);
+}
+
+BOOST_AUTO_TEST_CASE(float_variables) {
+  const linear_variablef_t a(Eigen::MatrixXf::Random(3, 5), Eigen::VectorXf::Random(3));
+  const linear_variablef_t res = 0.5 * a + a / 2.;
+  BOOST_CHECK(res.B().isApprox(a.B()));
+  BOOST_CHECK(res.c().isApprox(a.c()));
+  // the scaling factors are taken in the scalar type of the variables
+  const float k = 3.f;
+  const linear_variablef_t res_f = k * a - a * k + a / k;
+  BOOST_CHECK(res_f.B().isApprox(a.B() / k));
+  BOOST_CHECK(res_f.c().isApprox(a.c() / k));
+  const quadratic_variable<float> q(Eigen::MatrixXf::Identity(3, 3), Eigen::VectorXf::Ones(3), 2.f);
+  const quadratic_variable<float> q_scaled = k * (q * k) / k;
+  BOOST_CHECK(q_scaled.A().isApprox(k * q.A()));
+  BOOST_CHECK_CLOSE(q_scaled.c(), k * q.c(), 1e-4);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,174 @@
+#define BOOST_TEST_MODULE test_memory_footprint
+
+#include "ndcurves/fwd.h"
+#include "ndcurves/bezier_curve.h"
+#include "ndcurves/constant_curve.h"
+#include "ndcurves/exact_cubic.h"
+#include "ndcurves/memory_footprint.h"
+#include "ndcurves/piecewise_curve.h"
+#include "ndcurves/piecewise_variant_curve.h"
+#include "ndcurves/polynomial.h"
+#include "ndcurves/se3_curve.h"
+#include "ndcurves/so3_linear.h"
+#include "ndcurves/optimization/details.h"
+#include <boost/test/included/unit_test.hpp>
+
+using namespace ndcurves;
+
+namespace {
+const std::size_t control_block = footprint::shared_control_block_size;
+
+template <typename Curve>
+std::size_t heap_bytes(const Curve& c) {
+  return c.memory_footprint().total() - sizeof(c);
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+BOOST_AUTO_TEST_CASE(footprint_arithmetic) {
+  footprint a;
+  BOOST_CHECK_EQUAL(a.total(), 0);
+  a.add(footprint::CONTROL_POINTS, 10).add(footprint::TIMES, 5);
+  footprint b;
+  b.add(footprint::CONTROL_POINTS, 1).add(footprint::OTHER, 2);
+  const footprint c = a + b;
+  BOOST_CHECK_EQUAL(c[footprint::CONTROL_POINTS], 11);
+  BOOST_CHECK_EQUAL(c[footprint::TIMES], 5);
+  BOOST_CHECK_EQUAL(c[footprint::OTHER], 2);
+  BOOST_CHECK_EQUAL(c.total(), 18);
+  a += b;
+  BOOST_CHECK(a == c);
+  BOOST_CHECK(a != b);
+  BOOST_CHECK_EQUAL(std::string(footprint::category_name(footprint::BERNSTEIN)), "bernstein");
+  BOOST_CHECK_THROW(footprint::category_name(footprint::NUM_CATEGORIES), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(curves) {
+  bezier_t::t_point_t points;
+  points.push_back(pointX_t::Zero(3));
+  points.push_back(pointX_t::Ones(3));
+  points.push_back(pointX_t::Constant(3, 2.));
+  const bezier_t bc(points.begin(), points.end(), 0., 1.);
+  const footprint fp_bc = bc.memory_footprint();
+  BOOST_CHECK_EQUAL(fp_bc[footprint::OBJECTS], sizeof(bezier_t));
+  BOOST_CHECK_EQUAL(fp_bc[footprint::CONTROL_POINTS],
+                    bc.control_points_.capacity() * sizeof(pointX_t) + 3 * 3 * sizeof(double));
+  BOOST_CHECK_EQUAL(fp_bc[footprint::BERNSTEIN], bc.bernstein_.capacity() * sizeof(Bern<double>));
+  BOOST_CHECK_GE(fp_bc[footprint::BERNSTEIN], 3 * sizeof(Bern<double>));
+
+  // fixed size points do not allocate:
+  const constant3_t c3(point3_t(1., 2., 3.), 0., 1.);
+  BOOST_CHECK_EQUAL(c3.memory_footprint().total(), sizeof(constant3_t));
+  const constant_t c(pointX_t::Ones(4), 0., 1.);
+  BOOST_CHECK_EQUAL(c.memory_footprint()[footprint::CONTROL_POINTS], 4 * sizeof(double));
+
+  const pointX_t init = pointX_t::Zero(3), end = pointX_t::Ones(3);
+  const polynomial_t pol(init, end, 0., 1.);
+  BOOST_CHECK_EQUAL(pol.memory_footprint()[footprint::CONTROL_POINTS], 3 * 2 * sizeof(double));
+  BOOST_CHECK_EQUAL(heap_bytes(pol), 3 * 2 * sizeof(double));
+
+  const SO3Linear_t so3(quaternion_t::Identity(), quaternion_t(0., 1., 0., 0.), 0., 1.);
+  BOOST_CHECK_EQUAL(so3.memory_footprint().total(), sizeof(SO3Linear_t));
+
+  // through the abstract class:
+  const curve_abc_t& abc = bc;
+  BOOST_CHECK(abc.memory_footprint() == fp_bc);
+}
+
+BOOST_AUTO_TEST_CASE(piecewise) {
+  bezier_t::t_point_t points;
+  points.push_back(pointX_t::Zero(3));
+  points.push_back(pointX_t::Ones(3));
+  points.push_back(pointX_t::Constant(3, 2.));
+  const bezier_t bc0(points.begin(), points.end(), 0., 1.), bc1(points.begin(), points.end(), 1., 2.);
+  piecewise_t pc;
+  pc.add_curve(bc0);
+  pc.add_curve(bc1);
+  const footprint fp = pc.memory_footprint();
+  // the segments are copies of bc0 and bc1, with possibly less capacity:
+  footprint expected = pc.curve_at_index(0)->memory_footprint() + pc.curve_at_index(1)->memory_footprint();
+  expected.add(footprint::OBJECTS, sizeof(piecewise_t) + pc.curves_.capacity() * sizeof(piecewise_t::curve_ptr_t));
+  expected.add(footprint::CONTROL_BLOCKS, 2 * control_block);
+  expected.add(footprint::TIMES, pc.time_curves_.capacity() * sizeof(double));
+  BOOST_CHECK(fp == expected);
+
+  // by value, the segments are in the vector and there is no control block:
+  piecewise_bezier_value_t pc_value;
+  pc_value.add_curve(bc0);
+  pc_value.add_curve(bc1);
+  const footprint fp_value = pc_value.memory_footprint();
+  BOOST_CHECK_EQUAL(fp_value[footprint::CONTROL_BLOCKS], 0);
+  BOOST_CHECK_EQUAL(fp_value[footprint::CONTROL_POINTS], fp[footprint::CONTROL_POINTS]);
+  BOOST_CHECK_EQUAL(fp_value[footprint::OBJECTS],
+                    sizeof(piecewise_bezier_value_t) + pc_value.curves_.capacity() * sizeof(bezier_t));
+
+  piecewise_variant_t pc_variant;
+  pc_variant.add_curve(bc0);
+  pc_variant.add_curve(bc1);
+  const footprint fp_variant = pc_variant.memory_footprint();
+  BOOST_CHECK_EQUAL(fp_variant[footprint::CONTROL_BLOCKS], 0);
+  BOOST_CHECK_EQUAL(fp_variant[footprint::CONTROL_POINTS], fp[footprint::CONTROL_POINTS]);
+  const std::size_t segments_bytes = pc_variant.segments_.capacity() * sizeof(piecewise_variant_t::segment_t);
+  BOOST_CHECK_EQUAL(fp_variant[footprint::OBJECTS], sizeof(piecewise_variant_t) + segments_bytes);
+
+  // recursively through the piecewise curves of piecewise curves:
+  piecewise_t::curve_ptr_t pc_ptr(new piecewise_t(pc));
+  piecewise_t pc_of_pc(pc_ptr);
+  BOOST_CHECK_EQUAL(pc_of_pc.memory_footprint()[footprint::CONTROL_POINTS], fp[footprint::CONTROL_POINTS]);
+  BOOST_CHECK_EQUAL(pc_of_pc.memory_footprint()[footprint::CONTROL_BLOCKS], 3 * control_block);
+}
+
+BOOST_AUTO_TEST_CASE(exact_cubic) {
+  typedef std::pair<double, pointX_t> waypoint_t;
+  std::vector<waypoint_t> waypoints;
+  for (int i = 0; i < 4; ++i) {
+    waypoints.push_back(waypoint_t(double(i), pointX_t::Constant(3, double(i * i))));
+  }
+  const exact_cubic_t ec(waypoints.begin(), waypoints.end());
+  const footprint fp = ec.memory_footprint();
+  BOOST_CHECK_EQUAL(fp[footprint::CONTROL_BLOCKS], 3 * control_block);
+  // 3 cubic splines, with 4 coefficients per dimension:
+  BOOST_CHECK_EQUAL(fp[footprint::CONTROL_POINTS], 3 * 3 * 4 * sizeof(double));
+  const piecewise_t& pc = ec;
+  BOOST_CHECK_EQUAL(fp.total(),
+                    pc.piecewise_t::memory_footprint().total() + sizeof(exact_cubic_t) - sizeof(piecewise_t));
+}
+
+BOOST_AUTO_TEST_CASE(se3) {
+  const pointX_t init_pos = pointX_t::Zero(3), end_pos = pointX_t::Ones(3);
+  const SE3Curve_t se3(init_pos, end_pos, quaternion_t::Identity(), quaternion_t(0., 1., 0., 0.), 0., 1.);
+  const footprint fp = se3.memory_footprint();
+  BOOST_CHECK_EQUAL(fp[footprint::CONTROL_BLOCKS], 2 * control_block);
+  const footprint fp_translation = se3.translation_curve()->memory_footprint();
+  BOOST_CHECK_EQUAL(fp[footprint::OBJECTS],
+                    sizeof(SE3Curve_t) + fp_translation[footprint::OBJECTS] + sizeof(SO3Linear_t));
+  BOOST_CHECK_EQUAL(fp[footprint::CONTROL_POINTS], fp_translation[footprint::CONTROL_POINTS]);
+}
+
+BOOST_AUTO_TEST_CASE(linear_variables) {
+  const linear_variable_t var(Eigen::MatrixXd::Identity(3, 6), Eigen::VectorXd::Ones(3));
+  BOOST_CHECK_EQUAL(var.memory_footprint()[footprint::LINEAR_VARIABLES], (18 + 3) * sizeof(double));
+  BOOST_CHECK_EQUAL(var.memory_footprint()[footprint::OBJECTS], sizeof(linear_variable_t));
+
+  std::vector<linear_variable_t> vars(3, var);
+  const bezier_linear_variable_t bc(vars.begin(), vars.end(), 0., 1.);
+  const footprint fp = bc.memory_footprint();
+  // B and c are counted with the linear variables, the rest of the control points with the control points:
+  BOOST_CHECK_EQUAL(fp[footprint::LINEAR_VARIABLES], 3 * (18 + 3) * sizeof(double));
+  BOOST_CHECK_EQUAL(fp[footprint::CONTROL_POINTS], bc.control_points_.capacity() * sizeof(linear_variable_t));
+
+  using namespace ndcurves::optimization;
+  problem_definition<pointX_t, double> pDef(3);
+  pDef.init_pos = pointX_t::Zero(3);
+  pDef.end_pos = pointX_t::Ones(3);
+  pDef.degree = 5;
+  pDef.flag = INIT_POS | END_POS;
+  const problem_data<pointX_t, double> pData = setup_control_points<pointX_t, double, true>(pDef);
+  const footprint fp_data = pData.memory_footprint();
+  BOOST_CHECK_GE(fp_data[footprint::LINEAR_VARIABLES], pData.bezier->memory_footprint()[footprint::LINEAR_VARIABLES]);
+  BOOST_CHECK_GE(fp_data[footprint::BERNSTEIN], 6 * sizeof(Bern<double>));
+  BOOST_CHECK_EQUAL(fp_data[footprint::OBJECTS], sizeof(pData) + sizeof(*pData.bezier));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
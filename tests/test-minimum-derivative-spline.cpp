@@ -0,0 +1,163 @@
+#define BOOST_TEST_MODULE test_minimum_derivative_spline
+
+#include "ndcurves/fwd.h"
+#include "ndcurves/minimum_derivative_spline.h"
+#include <boost/test/included/unit_test.hpp>
+
+using namespace ndcurves;
+
+namespace {
+typedef minimum_derivative_spline_t::curve_constraints_t curve_constraints_t;
+
+void waypoints(t_pointX_t& points, std::vector<double>& times, const std::size_t size) {
+  points.clear();
+  times.clear();
+  double t = 0.5;
+  for (std::size_t i = 0; i < size; ++i) {
+    const double x = double(i);
+    points.push_back(point3_t(std::cos(x), std::sin(2. * x) + 0.1 * x, std::sin(0.3 * x)));
+    times.push_back(t);
+    t += 0.4 + 0.3 * std::sin(3. * x) * std::sin(3. * x);
+  }
+}
+
+// check that the curve crosses the waypoints and that its derivatives up to max_order are continuous.
+void check_spline(piecewise_t& pc, const t_pointX_t& points, const std::vector<double>& times,
+                  const std::size_t degree, const std::size_t max_order) {
+  BOOST_CHECK_EQUAL(pc.getNumberCurves(), points.size() - 1);
+  BOOST_CHECK_EQUAL(pc.min(), times.front());
+  BOOST_CHECK_EQUAL(pc.max(), times.back());
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    BOOST_CHECK(pc(times[i]).isApprox(points[i], 1e-8));
+  }
+  for (std::size_t i = 0; i + 1 < points.size(); ++i) {
+    BOOST_CHECK_EQUAL(pc.curve_at_index(i)->degree(), degree);
+  }
+  for (std::size_t i = 1; i + 1 < points.size(); ++i) {
+    const curve_ptr_t before = pc.curve_at_index(i - 1);
+    const curve_ptr_t after = pc.curve_at_index(i);
+    for (std::size_t order = 1; order <= max_order; ++order) {
+      const pointX_t end = before->derivate(times[i], order);
+      const pointX_t start = after->derivate(times[i], order);
+      BOOST_CHECK_MESSAGE((end - start).norm() <= 1e-6 * std::max(1., end.norm()),
+                          "discontinuity of order " << order << " at waypoint " << i);
+    }
+  }
+}
+
+// integral of the squared derivative of the given order, with the Simpson rule on each segment
+double cost(piecewise_t& pc, const std::size_t order) {
+  double res = 0.;
+  const std::size_t steps = 200;
+  for (std::size_t i = 0; i < pc.getNumberCurves(); ++i) {
+    const curve_ptr_t c = pc.curve_at_index(i);
+    const double h = (c->max() - c->min()) / double(steps);
+    for (std::size_t j = 0; j <= steps; ++j) {
+      const double w = (j == 0 || j == steps) ? 1. : (j % 2 ? 4. : 2.);
+      res += w * h / 3. * c->derivate(c->min() + double(j) * h, order).squaredNorm();
+    }
+  }
+  return res;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+BOOST_AUTO_TEST_CASE(two_waypoints) {
+  const point3_t a(1.5, -2, 3.7);
+  const point3_t b(2, 3, -4.);
+  t_pointX_t points;
+  points.push_back(a);
+  points.push_back(b);
+  std::vector<double> times;
+  times.push_back(1.);
+  times.push_back(2.5);
+  piecewise_t pc = minimum_derivative_spline_t::minimum_jerk(points, times);
+  const polynomial_t minjerk = polynomial_t::MinimumJerk(a, b, 1., 2.5);
+  BOOST_CHECK_EQUAL(pc.getNumberCurves(), 1);
+  BOOST_CHECK(pc.curve_at_index(0)->isApprox(&minjerk));
+}
+
+BOOST_AUTO_TEST_CASE(minimum_jerk) {
+  t_pointX_t points;
+  std::vector<double> times;
+  waypoints(points, times, 7);
+  piecewise_t pc = minimum_derivative_spline_t::minimum_jerk(points, times);
+  check_spline(pc, points, times, 5, 4);
+  BOOST_CHECK(pc.derivate(pc.min(), 1).isZero(1e-10));
+  BOOST_CHECK(pc.derivate(pc.min(), 2).isZero(1e-10));
+  BOOST_CHECK(pc.derivate(pc.max(), 1).isZero(1e-10));
+  BOOST_CHECK(pc.derivate(pc.max(), 2).isZero(1e-10));
+
+  // any other C2 quintic spline through the same waypoints has a higher jerk cost:
+  const double jerk_cost = cost(pc, 3);
+  t_pointX_t vel, acc;
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    vel.push_back(pc.derivate(times[i], 1));
+    acc.push_back(pc.derivate(times[i], 2));
+  }
+  for (std::size_t i = 1; i + 1 < points.size(); ++i) {
+    t_pointX_t vel_perturbed(vel), acc_perturbed(acc);
+    vel_perturbed[i] += point3_t(0.05, -0.05, 0.05);
+    acc_perturbed[i + 1 == points.size() - 1 ? i : i + 1] += point3_t(-0.2, 0., 0.1);
+    piecewise_t perturbed = piecewise_t::convert_discrete_points_to_polynomial<polynomial_t>(
+        points, vel_perturbed, acc_perturbed, times);
+    BOOST_CHECK_GT(cost(perturbed, 3), jerk_cost);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(minimum_snap) {
+  t_pointX_t points;
+  std::vector<double> times;
+  waypoints(points, times, 6);
+  curve_constraints_t constraints(3);
+  constraints.init_vel = point3_t(0.5, -1., 0.);
+  constraints.init_acc = point3_t(0., 2., -1.);
+  constraints.init_jerk = point3_t(1., 0., 0.);
+  constraints.end_vel = point3_t(-0.5, 0., 1.);
+  constraints.end_acc = point3_t(0., 0., 0.5);
+  constraints.end_jerk = point3_t(0., -3., 0.);
+  piecewise_t pc = minimum_derivative_spline_t::minimum_snap(points, times, constraints);
+  check_spline(pc, points, times, 7, 6);
+  BOOST_CHECK(pc.derivate(pc.min(), 1).isApprox(constraints.init_vel, 1e-8));
+  BOOST_CHECK(pc.derivate(pc.min(), 2).isApprox(constraints.init_acc, 1e-8));
+  BOOST_CHECK(pc.derivate(pc.min(), 3).isApprox(constraints.init_jerk, 1e-8));
+  BOOST_CHECK(pc.derivate(pc.max(), 1).isApprox(constraints.end_vel, 1e-8));
+  BOOST_CHECK(pc.derivate(pc.max(), 2).isApprox(constraints.end_acc, 1e-8));
+  BOOST_CHECK(pc.derivate(pc.max(), 3).isApprox(constraints.end_jerk, 1e-8));
+
+  // minimum jerk with the same constraints, the jerk is ignored:
+  piecewise_t pc_jerk = minimum_derivative_spline_t::minimum_jerk(points, times, constraints);
+  check_spline(pc_jerk, points, times, 5, 4);
+  BOOST_CHECK(pc_jerk.derivate(pc_jerk.min(), 1).isApprox(constraints.init_vel, 1e-8));
+  BOOST_CHECK(pc_jerk.derivate(pc_jerk.max(), 2).isApprox(constraints.end_acc, 1e-8));
+  BOOST_CHECK_LT(cost(pc_jerk, 3), cost(pc, 3));
+}
+
+BOOST_AUTO_TEST_CASE(many_waypoints) {
+  t_pointX_t points;
+  std::vector<double> times;
+  waypoints(points, times, 2000);
+  piecewise_t pc = minimum_derivative_spline_t::minimum_snap(points, times);
+  check_spline(pc, points, times, 7, 6);
+}
+
+BOOST_AUTO_TEST_CASE(errors) {
+  t_pointX_t points;
+  std::vector<double> times;
+  waypoints(points, times, 4);
+  std::vector<double> wrong_times(times.begin(), times.end() - 1);
+  BOOST_CHECK_THROW(minimum_derivative_spline_t::minimum_jerk(points, wrong_times), std::invalid_argument);
+  wrong_times = times;
+  wrong_times[2] = wrong_times[1];
+  BOOST_CHECK_THROW(minimum_derivative_spline_t::minimum_jerk(points, wrong_times), std::invalid_argument);
+  BOOST_CHECK_THROW(minimum_derivative_spline_t::minimum_snap(points, times, curve_constraints_t(2)),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(minimum_derivative_spline_t::minimum_derivative(5, points, times, curve_constraints_t(3)),
+                    std::invalid_argument);
+  t_pointX_t single(points.begin(), points.begin() + 1);
+  std::vector<double> single_time(times.begin(), times.begin() + 1);
+  BOOST_CHECK_THROW(minimum_derivative_spline_t::minimum_jerk(single, single_time), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
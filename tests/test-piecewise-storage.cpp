@@ -0,0 +1,164 @@
+#define BOOST_TEST_MODULE test_piecewise_storage
+
+#include "ndcurves/fwd.h"
+#include "ndcurves/bezier_curve.h"
+#include "ndcurves/piecewise_curve.h"
+#include "ndcurves/polynomial.h"
+#include "ndcurves/serialization/curves.hpp"
+#include <boost/test/included/unit_test.hpp>
+
+using namespace ndcurves;
+
+namespace {
+// three bezier curves of degree 3 joined with C0 continuity on [0.5, 3.5]
+std::vector<bezier_t> bezier_segments() {
+  std::vector<bezier_t> res;
+  t_pointX_t points;
+  points.push_back(point3_t(1, 2, 3));
+  points.push_back(point3_t(4, -5, 6));
+  points.push_back(point3_t(-7, 8, 1));
+  points.push_back(point3_t(3, 0, -2));
+  for (std::size_t i = 0; i < 3; ++i) {
+    res.push_back(bezier_t(points.begin(), points.end(), 0.5 + double(i), 1.5 + double(i)));
+    // the next segment starts at the end of this one:
+    points.front() = points.back();
+    for (std::size_t j = 1; j < points.size(); ++j) {
+      points[j] = points[j] * -0.5 + point3_t(1., 0.5, double(j));
+    }
+  }
+  return res;
+}
+
+// compare two piecewise curves storing the same segments with a different policy
+template <typename PiecewiseA, typename PiecewiseB>
+void check_same(const PiecewiseA& a, const PiecewiseB& b) {
+  BOOST_CHECK_EQUAL(a.num_curves(), b.num_curves());
+  BOOST_CHECK_EQUAL(a.min(), b.min());
+  BOOST_CHECK_EQUAL(a.max(), b.max());
+  BOOST_CHECK_EQUAL(a.dim(), b.dim());
+  pointX_t out(a.dim());
+  for (double t = a.min(); t <= a.max(); t += 0.1) {
+    BOOST_CHECK(a(t).isApprox(b(t)));
+    for (std::size_t order = 1; order < 4; ++order) {
+      BOOST_CHECK(a.derivate(t, order).isApprox(b.derivate(t, order)) || a.derivate(t, order).isZero());
+    }
+    b.evaluate_into(t, out);
+    BOOST_CHECK(out.isApprox(a(t)));
+    BOOST_CHECK(eval_succeeded(b.evaluate_rt(t, out)));
+    BOOST_CHECK(out.isApprox(a(t)));
+  }
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+BOOST_AUTO_TEST_CASE(bezier_value_storage) {
+  const std::vector<bezier_t> segments = bezier_segments();
+  piecewise_t pc_shared;
+  piecewise_bezier_value_t pc_value;
+  for (std::size_t i = 0; i < segments.size(); ++i) {
+    pc_shared.add_curve(segments[i]);
+    pc_value.add_curve(segments[i]);
+  }
+  BOOST_CHECK((boost::is_same<piecewise_bezier_value_t::t_curve_storage_t,
+                              std::vector<bezier_t, Eigen::aligned_allocator<bezier_t> > >::value));
+  check_same(pc_shared, pc_value);
+  BOOST_CHECK(pc_value.is_continuous(0));
+  BOOST_CHECK_EQUAL(pc_value.is_continuous(1), pc_shared.is_continuous(1));
+  for (std::size_t i = 0; i < segments.size(); ++i) {
+    BOOST_CHECK(pc_value.curve_ref_at_index(i) == segments[i]);
+    BOOST_CHECK(*pc_value.curve_at_index(i) == segments[i]);
+  }
+  // the derivative of a bezier curve is a bezier curve, also stored by value:
+  BOOST_CHECK((boost::is_same<piecewise_bezier_value_t::piecewise_curve_derivate_t, piecewise_bezier_value_t>::value));
+  boost::shared_ptr<piecewise_bezier_value_t::piecewise_curve_derivate_t> derivate(pc_value.compute_derivate_ptr(2));
+  for (double t = pc_value.min(); t <= pc_value.max(); t += 0.1) {
+    BOOST_CHECK(derivate->operator()(t).isApprox(pc_value.derivate(t, 2)));
+  }
+  // the same curves added by pointer are copied:
+  piecewise_bezier_value_t pc_from_ptr;
+  for (std::size_t i = 0; i < segments.size(); ++i) {
+    pc_from_ptr.add_curve_ptr(boost::make_shared<bezier_t>(segments[i]));
+  }
+  BOOST_CHECK(pc_from_ptr == pc_value);
+  BOOST_CHECK(pc_value.isApprox(&pc_from_ptr));
+}
+
+BOOST_AUTO_TEST_CASE(polynomial_value_storage) {
+  t_pointX_t points, velocities;
+  std::vector<double> times;
+  for (std::size_t i = 0; i < 6; ++i) {
+    const double x = double(i);
+    points.push_back(point3_t(std::cos(x), std::sin(x), x));
+    velocities.push_back(point3_t(-std::sin(x), std::cos(x), 1.));
+    times.push_back(0.3 * x);
+  }
+  const piecewise_t pc_shared =
+      piecewise_t::convert_discrete_points_to_polynomial<polynomial_t>(points, velocities, times);
+  const piecewise_polynomial_value_t pc_value =
+      piecewise_polynomial_value_t::convert_discrete_points_to_polynomial<polynomial_t>(points, velocities, times);
+  check_same(pc_shared, pc_value);
+  // the derivative of a polynomial is a polynomial, also stored by value:
+  BOOST_CHECK((boost::is_same<piecewise_polynomial_value_t::piecewise_curve_derivate_t,
+                              piecewise_polynomial_value_t>::value));
+  // while the shared storage keeps the abstract class:
+  BOOST_CHECK((boost::is_same<piecewise_t::piecewise_curve_derivate_t, piecewise_t>::value));
+  boost::shared_ptr<piecewise_polynomial_value_t::piecewise_curve_derivate_t> derivate(pc_value.compute_derivate_ptr(1));
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    BOOST_CHECK(derivate->operator()(times[i]).isApprox(velocities[i]));
+  }
+  const piecewise_polynomial_value_t pc_copy(pc_value);
+  BOOST_CHECK(pc_copy == pc_value);
+}
+
+BOOST_AUTO_TEST_CASE(value_semantics) {
+  const std::vector<bezier_t> segments = bezier_segments();
+  piecewise_bezier_value_t pc;
+  pc.add_curve(segments[0]);
+  pc.add_curve(segments[1]);
+  piecewise_bezier_value_t pc_copy(pc);
+  pc_copy.add_curve(segments[2]);
+  BOOST_CHECK_EQUAL(pc.num_curves(), 2);
+  BOOST_CHECK_EQUAL(pc_copy.num_curves(), 3);
+  // curve_at_index returns a copy, modifying it does not modify the piecewise curve:
+  piecewise_bezier_value_t::curve_ptr_t first = pc.curve_at_index(0);
+  *first *= 2.;
+  BOOST_CHECK(pc.curve_ref_at_index(0) == segments[0]);
+  BOOST_CHECK(!(*first == segments[0]));
+  // error handling is the same as the shared storage:
+  BOOST_CHECK_THROW(pc.add_curve(segments[0]), std::invalid_argument);
+  BOOST_CHECK_THROW(pc.curve_ref_at_index(2), std::length_error);
+  BOOST_CHECK_THROW(piecewise_bezier_value_t()(0.), std::runtime_error);
+  BOOST_CHECK_EQUAL(pc.num_curves(), 2);
+  BOOST_CHECK_EQUAL(pc.max(), segments[1].max());
+}
+
+BOOST_AUTO_TEST_CASE(serialization) {
+  const std::vector<bezier_t> segments = bezier_segments();
+  piecewise_bezier_value_t pc;
+  for (std::size_t i = 0; i < segments.size(); ++i) {
+    pc.add_curve(segments[i]);
+  }
+  const std::string fileName("fileTest_piecewise_storage");
+  pc.saveAsText<piecewise_bezier_value_t>(fileName + ".txt");
+  pc.saveAsXML<piecewise_bezier_value_t>(fileName + ".xml", "curve");
+  pc.saveAsBinary<piecewise_bezier_value_t>(fileName);
+  piecewise_bezier_value_t pc_txt, pc_xml, pc_binary;
+  pc_txt.loadFromText<piecewise_bezier_value_t>(fileName + ".txt");
+  pc_xml.loadFromXML<piecewise_bezier_value_t>(fileName + ".xml", "curve");
+  pc_binary.loadFromBinary<piecewise_bezier_value_t>(fileName);
+  BOOST_CHECK(pc.isApprox(pc_txt));
+  BOOST_CHECK(pc.isApprox(pc_xml));
+  BOOST_CHECK(pc == pc_binary);
+
+  // serialization through a pointer to the abstract class:
+  piecewise_t pc_ptr;
+  pc_ptr.add_curve_ptr(curve_ptr_t(new piecewise_bezier_value_t(pc)));
+  pc_ptr.saveAsBinary<piecewise_t>(fileName + "_ptr");
+  piecewise_t pc_ptr_binary;
+  pc_ptr_binary.loadFromBinary<piecewise_t>(fileName + "_ptr");
+  BOOST_CHECK(pc_ptr == pc_ptr_binary);
+  BOOST_CHECK(pc_ptr_binary(1.2).isApprox(pc(1.2)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
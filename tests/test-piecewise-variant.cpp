@@ -0,0 +1,163 @@
+#define BOOST_TEST_MODULE test_piecewise_variant
+
+#include "ndcurves/fwd.h"
+#include "ndcurves/piecewise_variant_curve.h"
+#include "ndcurves/cubic_hermite_spline.h"
+#include "ndcurves/serialization/curves.hpp"
+#include <boost/test/included/unit_test.hpp>
+
+using namespace ndcurves;
+
+namespace {
+// a piecewise curve on [0, 4] made of one segment of each supported type
+piecewise_t mixed_curve() {
+  piecewise_t pc;
+  const polynomial_t pol = polynomial_t::MinimumJerk(point3_t(0, 0, 0), point3_t(1, 2, 3), 0., 1.);
+  pc.add_curve(pol);
+  t_pointX_t points;
+  points.push_back(pol(1.));
+  points.push_back(point3_t(2, 3, 1));
+  points.push_back(point3_t(-1, 0, 2));
+  points.push_back(point3_t(1, 1, 1));
+  const bezier_t bezier(points.begin(), points.end(), 1., 2.);
+  pc.add_curve(bezier);
+  pc.add_curve(constant_t(bezier(2.), 2., 3.));
+  pc.add_curve(sinusoidal_t(point3_t(1, 1, 1), point3_t(0.5, -0.2, 1.), 0.8, 0., 3., 4.));
+  return pc;
+}
+
+void check_same(const piecewise_t& pc, const piecewise_variant_t& pv) {
+  BOOST_CHECK_EQUAL(pc.num_curves(), pv.num_curves());
+  BOOST_CHECK_EQUAL(pc.min(), pv.min());
+  BOOST_CHECK_EQUAL(pc.max(), pv.max());
+  BOOST_CHECK_EQUAL(pc.dim(), pv.dim());
+  pointX_t out(pv.dim());
+  for (double t = pc.min(); t <= pc.max(); t += 0.05) {
+    BOOST_CHECK(pc(t).isApprox(pv(t)));
+    pv.evaluate_into(t, out);
+    BOOST_CHECK(out.isApprox(pc(t)));
+    BOOST_CHECK(eval_succeeded(pv.evaluate_rt(t, out)));
+    BOOST_CHECK(out.isApprox(pc(t)));
+    for (std::size_t order = 1; order < 4; ++order) {
+      const pointX_t d = pc.derivate(t, order);
+      BOOST_CHECK(pv.derivate(t, order).isApprox(d) || d.isZero());
+      pv.derivate_into(t, order, out);
+      BOOST_CHECK(out.isApprox(d) || d.isZero());
+      BOOST_CHECK(eval_succeeded(pv.derivate_rt(t, order, out)));
+      BOOST_CHECK(out.isApprox(d) || d.isZero());
+    }
+  }
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+BOOST_AUTO_TEST_CASE(evaluation) {
+  const piecewise_t pc = mixed_curve();
+  const piecewise_variant_t pv(pc);
+  check_same(pc, pv);
+  BOOST_CHECK_EQUAL(pv.segment_type_at_index(0), piecewise_variant_t::POLYNOMIAL);
+  BOOST_CHECK_EQUAL(pv.segment_type_at_index(1), piecewise_variant_t::BEZIER);
+  BOOST_CHECK_EQUAL(pv.segment_type_at_index(2), piecewise_variant_t::CONSTANT);
+  BOOST_CHECK_EQUAL(pv.segment_type_at_index(3), piecewise_variant_t::SINUSOIDAL);
+  BOOST_CHECK(boost::get<bezier_t>(pv.segment_at_index(1)) ==
+              *boost::dynamic_pointer_cast<bezier_t>(pc.curve_at_index(1)));
+  // out of the time interval:
+  pointX_t out(3);
+  BOOST_CHECK_EQUAL(pv.evaluate_rt(5., out), EVAL_CLAMPED);
+  BOOST_CHECK(out.isApprox(pv(4.)));
+  BOOST_CHECK_THROW(pv(5.), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(conversions) {
+  const piecewise_t pc = mixed_curve();
+  piecewise_variant_t pv;
+  for (std::size_t i = 0; i < pc.num_curves(); ++i) {
+    pv.add_curve_ptr(pc.curve_at_index(i));
+  }
+  BOOST_CHECK(pv == piecewise_variant_t(pc));
+  const piecewise_t pc_back = pv.to_piecewise_curve();
+  BOOST_CHECK(pc_back == pc);
+  BOOST_CHECK(pv.isApprox(&pv));
+  BOOST_CHECK(!pv.isApprox(&pc));
+
+  // from a piecewise curve with a concrete segment type:
+  t_pointX_t points;
+  points.push_back(point3_t(1, 2, 3));
+  points.push_back(point3_t(4, 5, 6));
+  std::vector<double> times;
+  times.push_back(0.);
+  times.push_back(1.);
+  const piecewise_polynomial_value_t pc_value =
+      piecewise_polynomial_value_t::convert_discrete_points_to_polynomial<polynomial_t>(points, times);
+  const piecewise_variant_t pv_value(pc_value);
+  BOOST_CHECK(pv_value(0.5).isApprox(pc_value(0.5)));
+
+  // curve types that are not part of the variant:
+  cubic_hermite_spline_t::t_pair_point_tangent_t control_points;
+  control_points.push_back(cubic_hermite_spline_t::pair_point_tangent_t(points[0], points[1]));
+  control_points.push_back(cubic_hermite_spline_t::pair_point_tangent_t(points[1], points[0]));
+  piecewise_t pc_hermite;
+  pc_hermite.add_curve(cubic_hermite_spline_t(control_points.begin(), control_points.end(), times));
+  BOOST_CHECK_THROW(piecewise_variant_t pv_hermite(pc_hermite), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(comparison_and_derivative) {
+  const piecewise_t pc = mixed_curve();
+  const piecewise_variant_t pv(pc);
+  piecewise_variant_t pv_other;
+  pv_other.add_curve(boost::get<polynomial_t>(pv.segment_at_index(0)));
+  BOOST_CHECK(!(pv_other == pv));
+  // same time interval and values, but a bezier segment instead of a polynomial one:
+  const polynomial_t pol(point3_t(1, 2, 3), point3_t(0, 1, 0), point3_t(4, 5, 6), point3_t(1, 0, 0), 0., 1.);
+  piecewise_variant_t pv_pol, pv_bezier;
+  pv_pol.add_curve(pol);
+  pv_bezier.add_curve(bezier_from_curve<bezier_t>(pol));
+  BOOST_CHECK(pv_pol(0.3).isApprox(pv_bezier(0.3)));
+  BOOST_CHECK(pv_pol != pv_bezier);
+  BOOST_CHECK(pv_pol == pv_pol);
+
+  boost::shared_ptr<piecewise_variant_t> derivate(pv.compute_derivate_ptr(2));
+  BOOST_CHECK_EQUAL(derivate->num_curves(), pv.num_curves());
+  for (double t = pv.min(); t <= pv.max(); t += 0.1) {
+    BOOST_CHECK(derivate->operator()(t).isApprox(pv.derivate(t, 2)) || pv.derivate(t, 2).isZero());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(errors) {
+  piecewise_variant_t pv;
+  BOOST_CHECK_THROW(pv(0.), std::runtime_error);
+  pointX_t out(3);
+  BOOST_CHECK_EQUAL(pv.evaluate_rt(0., out), EVAL_EMPTY);
+  pv.add_curve(constant_t(point3_t(1, 2, 3), 0., 1.));
+  BOOST_CHECK_THROW(pv.add_curve(constant_t(point3_t(1, 2, 3), 2., 3.)), std::invalid_argument);
+  BOOST_CHECK_THROW(pv.add_curve(constant_t(pointX_t::Zero(2), 1., 3.)), std::invalid_argument);
+  BOOST_CHECK_EQUAL(pv.num_curves(), 1);
+  BOOST_CHECK_THROW(pv.segment_at_index(1), std::length_error);
+}
+
+BOOST_AUTO_TEST_CASE(serialization) {
+  const piecewise_variant_t pv(mixed_curve());
+  const std::string fileName("fileTest_piecewise_variant");
+  pv.saveAsText<piecewise_variant_t>(fileName + ".txt");
+  pv.saveAsXML<piecewise_variant_t>(fileName + ".xml", "curve");
+  pv.saveAsBinary<piecewise_variant_t>(fileName);
+  piecewise_variant_t pv_txt, pv_xml, pv_binary;
+  pv_txt.loadFromText<piecewise_variant_t>(fileName + ".txt");
+  pv_xml.loadFromXML<piecewise_variant_t>(fileName + ".xml", "curve");
+  pv_binary.loadFromBinary<piecewise_variant_t>(fileName);
+  BOOST_CHECK(pv.isApprox(pv_txt));
+  BOOST_CHECK(pv.isApprox(pv_xml));
+  BOOST_CHECK(pv == pv_binary);
+
+  // serialization through a pointer to the abstract class:
+  piecewise_t pc;
+  pc.add_curve(pv);
+  pc.saveAsBinary<piecewise_t>(fileName + "_ptr");
+  piecewise_t pc_binary;
+  pc_binary.loadFromBinary<piecewise_t>(fileName + "_ptr");
+  BOOST_CHECK(pc == pc_binary);
+  BOOST_CHECK(pc_binary(2.5).isApprox(pv(2.5)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,82 @@
+#define BOOST_TEST_MODULE test_quadratic_variable
+
+#include "ndcurves/fwd.h"
+#include "ndcurves/quadratic_variable.h"
+#include "ndcurves/optimization/integral_cost.h"
+#include <boost/test/included/unit_test.hpp>
+
+using namespace ndcurves;
+
+namespace {
+typedef quadratic_variable<double> quadratic_variable_t;
+
+double quadratic_form(const Eigen::MatrixXd& A, const Eigen::VectorXd& b, const double c, const Eigen::VectorXd& x) {
+  return x.dot(A * x) + b.dot(x) + c;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+BOOST_AUTO_TEST_CASE(packed_storage) {
+  const Eigen::MatrixXd A = Eigen::MatrixXd::Random(4, 4);
+  const Eigen::VectorXd b = Eigen::VectorXd::Random(4);
+  const quadratic_variable_t q(A, b, 2.);
+  BOOST_CHECK_EQUAL(q.size(), 4);
+  BOOST_CHECK_EQUAL(q.A_packed().size(), 10);
+  // only the symmetric part of A is kept:
+  const Eigen::MatrixXd sym = 0.5 * (A + A.transpose());
+  BOOST_CHECK(q.A().isApprox(sym));
+  BOOST_CHECK_EQUAL(q.A_packed()[quadratic_variable_t::packed_index(1, 3)], sym(1, 3));
+  BOOST_CHECK_EQUAL(q.A_packed()[quadratic_variable_t::packed_index(2, 2)], A(2, 2));
+  for (int i = 0; i < 10; ++i) {
+    const Eigen::VectorXd x = Eigen::VectorXd::Random(4);
+    BOOST_CHECK_CLOSE(q(x), quadratic_form(A, b, 2., x), 1e-8);
+  }
+  const quadratic_variable_t q_packed = quadratic_variable_t::FromPacked(q.A_packed(), b, 2.);
+  BOOST_CHECK(q_packed.A().isApprox(sym));
+  BOOST_CHECK_THROW(quadratic_variable_t::FromPacked(Eigen::VectorXd::Zero(9), b), std::invalid_argument);
+  BOOST_CHECK_THROW(quadratic_variable_t(Eigen::MatrixXd::Zero(3, 4), b), std::invalid_argument);
+  // a linear cost has a zero A:
+  BOOST_CHECK(quadratic_variable_t(b).A().isZero());
+}
+
+BOOST_AUTO_TEST_CASE(arithmetic) {
+  const Eigen::MatrixXd A1 = Eigen::MatrixXd::Random(5, 5), A2 = Eigen::MatrixXd::Random(5, 5);
+  const Eigen::VectorXd b1 = Eigen::VectorXd::Random(5), b2 = Eigen::VectorXd::Random(5);
+  const quadratic_variable_t q1(A1, b1, 1.), q2(A2, b2, -3.);
+  const Eigen::VectorXd x = Eigen::VectorXd::Random(5);
+  BOOST_CHECK_CLOSE((q1 + q2)(x), quadratic_form(A1 + A2, b1 + b2, -2., x), 1e-8);
+  BOOST_CHECK_CLOSE((q1 - q2)(x), quadratic_form(A1 - A2, b1 - b2, 4., x), 1e-8);
+  BOOST_CHECK_CLOSE((q1 * 3.)(x), 3. * q1(x), 1e-8);
+  BOOST_CHECK_CLOSE((2. * q1)(x), 2. * q1(x), 1e-8);
+  BOOST_CHECK_CLOSE((q1 / 4.)(x), q1(x) / 4., 1e-8);
+  quadratic_variable_t res;
+  res += q1;
+  res -= q2;
+  BOOST_CHECK(res.A_packed().isApprox(q1.A_packed() - q2.A_packed()));
+  const Eigen::VectorXd d = Eigen::VectorXd::Random(5);
+  res.add_to_diagonal(d);
+  BOOST_CHECK(res.A().isApprox(q1.A() - q2.A() + Eigen::MatrixXd(d.asDiagonal())));
+  BOOST_CHECK_THROW(res.add_to_diagonal(Eigen::VectorXd::Zero(4)), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(integral_cost) {
+  using namespace ndcurves::optimization;
+  problem_definition<pointX_t, double> pDef(3);
+  pDef.init_pos = pointX_t::Zero(3);
+  pDef.end_pos = pointX_t::Ones(3);
+  pDef.degree = 20;
+  pDef.flag = INIT_POS | END_POS;
+  const problem_data<pointX_t, double> pData = setup_control_points<pointX_t, double, true>(pDef);
+  const quadratic_variable_t cost = compute_integral_cost<pointX_t, double>(pData, ACCELERATION);
+  const std::size_t n = cost.size();
+  BOOST_CHECK_EQUAL(n, pData.numVariables * 3);
+  const Eigen::MatrixXd A = cost.A();
+  BOOST_CHECK(A.isApprox(A.transpose()));
+  const Eigen::VectorXd x = Eigen::VectorXd::Random(Eigen::Index(n));
+  BOOST_CHECK_CLOSE(cost(x), quadratic_form(A, cost.b(), cost.c(), x), 1e-8);
+  // the packed A uses about half of the memory of the dense one:
+  BOOST_CHECK_EQUAL(cost.memory_footprint()[footprint::LINEAR_VARIABLES], (n * (n + 1) / 2 + n) * sizeof(double));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
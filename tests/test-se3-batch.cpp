@@ -0,0 +1,175 @@
+#define BOOST_TEST_MODULE test_se3_batch
+
+#include "ndcurves/fwd.h"
+#include "ndcurves/bezier_curve.h"
+#include "ndcurves/se3_curve.h"
+#include "ndcurves/so3_bezier.h"
+#include "ndcurves/serialization/curves.hpp"
+#include <boost/test/included/unit_test.hpp>
+
+#include "control_rotations.h"
+
+using namespace ndcurves;
+
+namespace {
+SE3Curve_t::time_vector_t time_grid(const double t_min, const double t_max, const Eigen::Index size) {
+  return SE3Curve_t::time_vector_t::LinSpaced(size, t_min, t_max);
+}
+
+void check_batch(const curve_SE3_t& curve, const SE3Curve_t::time_vector_t& times,
+                 const SE3Curve_t::translations_t& translations, const SE3Curve_t::quaternions_t& quaternions,
+                 const SE3Curve_t::transforms_t& transforms) {
+  for (Eigen::Index i = 0; i < times.size(); ++i) {
+    const transform_t pose = curve(times[i]);
+    BOOST_CHECK(translations.col(i).isApprox(pose.translation()));
+    const quaternion_t q(quaternions.col(i));
+    BOOST_CHECK(q.toRotationMatrix().isApprox(pose.rotation()));
+    BOOST_CHECK((transforms.block<3, 3>(0, 4 * i).isApprox(pose.rotation())));
+    BOOST_CHECK(transforms.col(4 * i + 3).isApprox(pose.translation()));
+  }
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+BOOST_AUTO_TEST_CASE(se3_curve) {
+  quaternion_t q0(1, 0, 0, 0);
+  quaternion_t q1(0.544, -0.002, -0.796, 0.265);
+  q1.normalize();
+  pointX_t p0 = point3_t(1., 1.5, -2.);
+  pointX_t p1 = point3_t(3., 0, 1.);
+  SE3Curve_t c(p0, p1, q0, q1, 0.5, 2.);
+
+  const SE3Curve_t::time_vector_t times = time_grid(0.5, 2., 31);
+  SE3Curve_t::translations_t translations(3, times.size());
+  SE3Curve_t::quaternions_t quaternions(4, times.size());
+  SE3Curve_t::transforms_t transforms(3, 4 * times.size());
+  c.evaluate_batch(times, translations, quaternions);
+  c.evaluate_batch(times, transforms);
+  check_batch(c, times, translations, quaternions, transforms);
+
+  // wrong buffer sizes:
+  SE3Curve_t::translations_t too_small(3, times.size() - 1);
+  BOOST_CHECK_THROW(c.evaluate_batch(times, too_small, quaternions), std::invalid_argument);
+  BOOST_CHECK_THROW(c.evaluate_batch(times, translations), std::invalid_argument);
+
+  // only the range [first, last[ of the time grid is written:
+  translations.setZero();
+  transforms.setZero();
+  c.evaluate_batch(times, 5, 20, translations, quaternions);
+  c.evaluate_batch(times, 5, 20, transforms);
+  for (Eigen::Index i = 0; i < times.size(); ++i) {
+    const transform_t pose = c(times[i]);
+    if (i < 5 || i >= 20) {
+      BOOST_CHECK(translations.col(i).isZero());
+      BOOST_CHECK(transforms.middleCols(4 * i, 4).isZero());
+    } else {
+      BOOST_CHECK(translations.col(i).isApprox(pose.translation()));
+      BOOST_CHECK((transforms.block<3, 3>(0, 4 * i).isApprox(pose.rotation())));
+      BOOST_CHECK(transforms.col(4 * i + 3).isApprox(pose.translation()));
+    }
+  }
+  c.evaluate_batch(times, 7, 7, transforms);
+  BOOST_CHECK_THROW(c.evaluate_batch(times, 20, 5, translations, quaternions), std::invalid_argument);
+  BOOST_CHECK_THROW(c.evaluate_batch(times, -1, 5, translations, quaternions), std::invalid_argument);
+  BOOST_CHECK_THROW(c.evaluate_batch(times, 0, times.size() + 1, transforms), std::invalid_argument);
+  BOOST_CHECK_THROW(c.evaluate_batch(times, 0, 5, too_small, quaternions), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(se3_curve_generic_rotation) {
+  // rotation curve which is not a SO3Linear: evaluated through operator()
+  point3_t a(1, 2, 3), b(2, 3, 4), d(3, 6, 7);
+  std::vector<pointX_t> params;
+  params.push_back(a);
+  params.push_back(b);
+  params.push_back(d);
+  curve_ptr_t translation(new bezier_t(params.begin(), params.end(), 0., 1.));
+  quaternion_t q1(0.7071, 0.7071, 0, 0);
+  q1.normalize();
+  boost::shared_ptr<SE3Curve_t> inner(new SE3Curve_t(translation, matrix3_t::Identity(), q1.toRotationMatrix()));
+  piecewise_SE3_t pc(inner);
+
+  const SE3Curve_t::time_vector_t times = time_grid(0., 1., 11);
+  SE3Curve_t::translations_t translations(3, times.size());
+  SE3Curve_t::quaternions_t quaternions(4, times.size());
+  SE3Curve_t::transforms_t transforms(3, 4 * times.size());
+  evaluate_batch(pc, times, translations, quaternions);
+  evaluate_batch(pc, times, transforms);
+  check_batch(pc, times, translations, quaternions, transforms);
+}
+
+BOOST_AUTO_TEST_CASE(se3_curve_so3_bezier) {
+  // rotation curve which is not a SO3Linear: written with its evaluate_into
+  std::vector<pointX_t> params;
+  params.push_back(point3_t(1, 2, 3));
+  params.push_back(point3_t(2, 3, 4));
+  params.push_back(point3_t(3, 6, 7));
+  curve_ptr_t translation(new bezier_t(params.begin(), params.end(), 0.5, 2.));
+  const SO3Bezier_t::t_quaternion_t rotations = control_rotations();
+  curve_rotation_ptr_t rotation(new SO3Bezier_t(rotations.begin(), rotations.end(), 0.5, 2.));
+  const SE3Curve_t c(translation, rotation);
+
+  const SE3Curve_t::time_vector_t times = time_grid(0.5, 2., 31);
+  SE3Curve_t::translations_t translations(3, times.size());
+  SE3Curve_t::quaternions_t quaternions(4, times.size());
+  SE3Curve_t::transforms_t transforms(3, 4 * times.size());
+  c.evaluate_batch(times, translations, quaternions);
+  c.evaluate_batch(times, transforms);
+  check_batch(c, times, translations, quaternions, transforms);
+}
+
+BOOST_AUTO_TEST_CASE(piecewise_se3) {
+  quaternion_t q0(1, 0, 0, 0);
+  quaternion_t q1(0.7071, 0.7071, 0, 0);
+  quaternion_t q2(0.544, -0.002, -0.796, 0.265);
+  q1.normalize();
+  q2.normalize();
+  pointX_t p0 = point3_t(0., 0., 0.);
+  pointX_t p1 = point3_t(1., 2., 0.5);
+  pointX_t p2 = point3_t(-1., 0.5, 2.);
+  piecewise_SE3_t pc;
+  pc.add_curve(SE3Curve_t(p0, p1, q0, q1, 0., 1.));
+  pc.add_curve(SE3Curve_t(p1, p2, q1, q2, 1., 1.5));
+  pc.add_curve(SE3Curve_t(p2, p0, q2, q0, 1.5, 3.));
+
+  const SE3Curve_t::time_vector_t times = time_grid(0., 3., 61);
+  SE3Curve_t::translations_t translations(3, times.size());
+  SE3Curve_t::quaternions_t quaternions(4, times.size());
+  SE3Curve_t::transforms_t transforms(3, 4 * times.size());
+  evaluate_batch(pc, times, translations, quaternions);
+  evaluate_batch(pc, times, transforms);
+  check_batch(pc, times, translations, quaternions, transforms);
+
+  // times do not need to be sorted, the cursor falls back to a binary search:
+  SE3Curve_t::time_vector_t unsorted(5);
+  unsorted << 2.5, 0.2, 1.2, 1., 3.;
+  SE3Curve_t::translations_t translations_unsorted(3, unsorted.size());
+  SE3Curve_t::quaternions_t quaternions_unsorted(4, unsorted.size());
+  SE3Curve_t::transforms_t transforms_unsorted(3, 4 * unsorted.size());
+  evaluate_batch(pc, unsorted, translations_unsorted, quaternions_unsorted);
+  evaluate_batch(pc, unsorted, transforms_unsorted);
+  check_batch(pc, unsorted, translations_unsorted, quaternions_unsorted, transforms_unsorted);
+
+  // out of range:
+  SE3Curve_t::time_vector_t out_of_range(2);
+  out_of_range << 0.5, 3.5;
+  SE3Curve_t::translations_t translations_out(3, 2);
+  SE3Curve_t::quaternions_t quaternions_out(4, 2);
+  BOOST_CHECK_THROW(evaluate_batch(pc, out_of_range, translations_out, quaternions_out), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(find_interval_from) {
+  piecewise_SE3_t pc;
+  pc.add_curve(SE3Curve_t(transform_t::Identity(), transform_t::Identity(), 0., 1.));
+  pc.add_curve(SE3Curve_t(transform_t::Identity(), transform_t::Identity(), 1., 2.));
+  pc.add_curve(SE3Curve_t(transform_t::Identity(), transform_t::Identity(), 2., 4.));
+  BOOST_CHECK_EQUAL(pc.find_interval_from(0., 0), 0);
+  BOOST_CHECK_EQUAL(pc.find_interval_from(0.5, 0), 0);
+  BOOST_CHECK_EQUAL(pc.find_interval_from(1., 0), 1);
+  BOOST_CHECK_EQUAL(pc.find_interval_from(3., 1), 2);
+  BOOST_CHECK_EQUAL(pc.find_interval_from(4., 0), 2);
+  BOOST_CHECK_EQUAL(pc.find_interval_from(0.5, 2), 0);
+  BOOST_CHECK_EQUAL(pc.find_interval_from(1.5, 10), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
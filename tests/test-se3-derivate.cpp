@@ -0,0 +1,119 @@
+#define BOOST_TEST_MODULE test_se3_derivate
+
+#include "ndcurves/fwd.h"
+#include "ndcurves/bezier_curve.h"
+#include "ndcurves/se3_curve.h"
+#include "ndcurves/so3_bezier.h"
+#include "ndcurves/serialization/curves.hpp"
+#include <boost/test/included/unit_test.hpp>
+
+using namespace ndcurves;
+
+namespace {
+typedef curve_SE3_t::curve_derivate_t curve_SE3_derivate_t;
+typedef piecewise_SE3_t::piecewise_curve_derivate_t piecewise_SE3_derivate_t;
+
+SE3Curve_t bezier_se3(const double t_min, const double t_max) {
+  t_pointX_t params;
+  params.push_back(point3_t(1, 2, 3));
+  params.push_back(point3_t(2, 3, 4));
+  params.push_back(point3_t(3, 6, 7));
+  params.push_back(point3_t(-1, 0, 2));
+  curve_ptr_t translation(new bezier_t(params.begin(), params.end(), t_min, t_max));
+  quaternion_t q0(1, 0, 0, 0);
+  quaternion_t q1(0.544, -0.002, -0.796, 0.265);
+  q1.normalize();
+  return SE3Curve_t(translation, q0, q1);
+}
+
+void check_derivate(const curve_SE3_t& curve, const curve_SE3_derivate_t& derivate, const std::size_t order) {
+  BOOST_CHECK_EQUAL(derivate.dim(), 6);
+  BOOST_CHECK_EQUAL(derivate.min(), curve.min());
+  BOOST_CHECK_EQUAL(derivate.max(), curve.max());
+  for (double t = curve.min(); t <= curve.max(); t += 0.1) {
+    BOOST_CHECK(derivate(t).isApprox(curve.derivate(t, order)) ||
+                (derivate(t).isZero() && curve.derivate(t, order).isZero()));
+    BOOST_CHECK(derivate.derivate(t, 1).isApprox(curve.derivate(t, order + 1)) ||
+                (derivate.derivate(t, 1).isZero() && curve.derivate(t, order + 1).isZero()));
+  }
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+BOOST_AUTO_TEST_CASE(se3_curve) {
+  const SE3Curve_t c = bezier_se3(0.5, 2.);
+  for (std::size_t order = 1; order <= 3; ++order) {
+    const SE3Derivate_t derivate = c.compute_derivate(order);
+    check_derivate(c, derivate, order);
+    boost::shared_ptr<curve_SE3_derivate_t> derivate_ptr(c.compute_derivate_ptr(order));
+    check_derivate(c, *derivate_ptr, order);
+    BOOST_CHECK(derivate.isApprox(derivate_ptr.get()));
+  }
+  // derivative of the derivative:
+  const SE3Derivate_t acc = c.compute_derivate(1).compute_derivate(1);
+  BOOST_CHECK(acc.isApprox(c.compute_derivate(2)));
+
+  // rotation curve with a SO3BezierDerivate as derivative curve, defined up to the order 2:
+  SO3Bezier_t::t_quaternion_t rotations;
+  rotations.push_back(quaternion_t(1, 0, 0, 0));
+  rotations.push_back(quaternion_t(0.7071, 0.7071, 0, 0).normalized());
+  rotations.push_back(quaternion_t(0.2, 0.3, -0.5, 0.8).normalized());
+  curve_rotation_ptr_t rotation(new SO3Bezier_t(rotations.begin(), rotations.end(), 0.5, 2.));
+  SE3Curve_t c_bezier(c.translation_curve(), rotation);
+  const SE3Derivate_t twist = c_bezier.compute_derivate(1);
+  check_derivate(c_bezier, twist, 1);
+  BOOST_CHECK(dynamic_cast<const SO3BezierDerivate_t*>(twist.angular_curve().get()) != NULL);
+  BOOST_CHECK_THROW(c_bezier.compute_derivate(3), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(piecewise_se3) {
+  piecewise_SE3_t pc;
+  pc.add_curve(bezier_se3(0., 1.));
+  pc.add_curve(bezier_se3(1., 2.5));
+  pc.add_curve(SE3Curve_t(pointX_t(point3_t(0, 0, 0)), pointX_t(point3_t(1, -1, 2)), quaternion_t(1, 0, 0, 0),
+                          quaternion_t(0.7071, 0.7071, 0, 0).normalized(), 2.5, 3.));
+  boost::shared_ptr<piecewise_SE3_derivate_t> derivate(pc.compute_derivate_ptr(1));
+  BOOST_CHECK_EQUAL(derivate->getNumberCurves(), 3);
+  check_derivate(pc, *derivate, 1);
+
+  // with a SO3Bezier segment:
+  SO3Bezier_t::t_quaternion_t rotations;
+  rotations.push_back(quaternion_t(0.7071, 0.7071, 0, 0).normalized());
+  rotations.push_back(quaternion_t(0.544, -0.002, -0.796, 0.265).normalized());
+  rotations.push_back(quaternion_t(0.2, 0.3, -0.5, 0.8).normalized());
+  curve_rotation_ptr_t rotation(new SO3Bezier_t(rotations.begin(), rotations.end(), 3., 4.));
+  curve_ptr_t translation(new polynomial_t(pointX_t(point3_t(1, -1, 2)), pointX_t(point3_t(0, 1, 1)), 3., 4.));
+  pc.add_curve(SE3Curve_t(translation, rotation));
+  derivate.reset(pc.compute_derivate_ptr(1));
+  BOOST_CHECK_EQUAL(derivate->getNumberCurves(), 4);
+  check_derivate(pc, *derivate, 1);
+}
+
+BOOST_AUTO_TEST_CASE(serialization) {
+  std::string fileName("fileTest_se3_derivate");
+  const SE3Curve_t c = bezier_se3(0.5, 2.);
+  const SE3Derivate_t derivate = c.compute_derivate(1);
+  derivate.saveAsText<SE3Derivate_t>(fileName + ".txt");
+  derivate.saveAsXML<SE3Derivate_t>(fileName + ".xml", "se3_derivate");
+  derivate.saveAsBinary<SE3Derivate_t>(fileName);
+  SE3Derivate_t derivate_txt, derivate_xml, derivate_binary;
+  derivate_txt.loadFromText<SE3Derivate_t>(fileName + ".txt");
+  derivate_xml.loadFromXML<SE3Derivate_t>(fileName + ".xml", "se3_derivate");
+  derivate_binary.loadFromBinary<SE3Derivate_t>(fileName);
+  BOOST_CHECK(derivate == derivate_txt);
+  BOOST_CHECK(derivate == derivate_xml);
+  BOOST_CHECK(derivate == derivate_binary);
+
+  // serialization of a piecewise twist trajectory:
+  piecewise_SE3_t pc;
+  pc.add_curve(bezier_se3(0., 1.));
+  pc.add_curve(bezier_se3(1., 2.5));
+  boost::shared_ptr<piecewise_SE3_derivate_t> pc_derivate(pc.compute_derivate_ptr(1));
+  pc_derivate->saveAsText<piecewise_SE3_derivate_t>(fileName + "_piecewise.txt");
+  piecewise_SE3_derivate_t pc_derivate_txt;
+  pc_derivate_txt.loadFromText<piecewise_SE3_derivate_t>(fileName + "_piecewise.txt");
+  BOOST_CHECK(pc_derivate->isApprox(pc_derivate_txt));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
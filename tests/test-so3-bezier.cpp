@@ -0,0 +1,164 @@
+#define BOOST_TEST_MODULE test_so3_bezier
+
+#include "ndcurves/fwd.h"
+#include "ndcurves/so3_bezier.h"
+#include "ndcurves/so3_linear.h"
+#include "ndcurves/se3_curve.h"
+#include "ndcurves/serialization/curves.hpp"
+#include <boost/test/included/unit_test.hpp>
+
+#include "control_rotations.h"
+
+using namespace ndcurves;
+
+namespace {
+typedef SO3Bezier_t::t_quaternion_t t_quaternion_t;
+
+// angular velocity in the local frame, computed by finite differences
+point3_t finite_difference_velocity(const SO3Bezier_t& c, const double t, const double dt) {
+  const Eigen::AngleAxisd aa(c(t - dt).transpose() * c(t + dt));
+  return aa.angle() * aa.axis() / (2. * dt);
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+BOOST_AUTO_TEST_CASE(constructors) {
+  const t_quaternion_t rotations = control_rotations();
+  SO3Bezier_t c(rotations.begin(), rotations.end(), 0.5, 2.);
+  BOOST_CHECK_EQUAL(c.min(), 0.5);
+  BOOST_CHECK_EQUAL(c.max(), 2.);
+  BOOST_CHECK_EQUAL(c.dim(), 3);
+  BOOST_CHECK_EQUAL(c.degree(), 4);
+  BOOST_CHECK(c(0.5).isApprox(rotations.front().toRotationMatrix()));
+  BOOST_CHECK(c(2.).isApprox(rotations.back().toRotationMatrix()));
+
+  // from rotation matrices:
+  SO3Bezier_t::t_matrix3_t matrices = c.getControlRotations();
+  SO3Bezier_t cMatrix(matrices.begin(), matrices.end(), 0.5, 2.);
+  BOOST_CHECK(c == cMatrix);
+  BOOST_CHECK(c(1.2).isApprox(cMatrix(1.2)));
+
+  // copy constructor
+  SO3Bezier_t cCopy(c);
+  BOOST_CHECK(c == cCopy);
+
+  BOOST_CHECK_THROW(SO3Bezier_t(rotations.begin(), rotations.begin() + 1, 0., 1.), std::invalid_argument);
+  BOOST_CHECK_THROW(SO3Bezier_t(rotations.begin(), rotations.end(), 2., 1.), std::invalid_argument);
+  BOOST_CHECK_THROW(c(0.4), std::invalid_argument);
+  BOOST_CHECK_THROW(c(2.1), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(degree_one_is_slerp) {
+  const t_quaternion_t rotations = control_rotations();
+  SO3Bezier_t c(rotations.begin() + 1, rotations.begin() + 3, 0., 2.);
+  SO3Linear_t so3(rotations[1], rotations[2], 0., 2.);
+  for (double t = 0.; t <= 2.; t += 0.1) {
+    BOOST_CHECK(c(t).isApprox(so3(t), 1e-8));
+    BOOST_CHECK(c.derivate(t, 1).isApprox(so3.derivate(t, 1), 1e-8));
+    BOOST_CHECK(c.derivate(t, 2).isZero(1e-8));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(derivatives) {
+  const t_quaternion_t rotations = control_rotations();
+  SO3Bezier_t c(rotations.begin(), rotations.end(), 0.5, 2.);
+  const double dt = 1e-5;
+  for (double t = 0.6; t < 1.95; t += 0.05) {
+    BOOST_CHECK(c.derivate(t, 1).isApprox(finite_difference_velocity(c, t, dt), 1e-5));
+    const point3_t fd_acc = (c.derivate(t + dt, 1) - c.derivate(t - dt, 1)) / (2. * dt);
+    BOOST_CHECK(c.derivate(t, 2).isApprox(fd_acc, 1e-5));
+  }
+  // boundary velocities only depend on the first and last control rotations:
+  const Eigen::AngleAxisd first(rotations[0].conjugate() * rotations[1]);
+  BOOST_CHECK(c.derivate(0.5, 1).isApprox(first.angle() * first.axis() * 4. / 1.5));
+  const Eigen::AngleAxisd last(rotations[3].conjugate() * rotations[4]);
+  BOOST_CHECK(c.derivate(2., 1).isApprox(last.angle() * last.axis() * 4. / 1.5));
+
+  BOOST_CHECK_THROW(c.derivate(1., 0), std::invalid_argument);
+  BOOST_CHECK_THROW(c.derivate(1., 3), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(derivative_curve) {
+  const t_quaternion_t rotations = control_rotations();
+  SO3Bezier_t c(rotations.begin(), rotations.end(), 0.5, 2.);
+  const SO3BezierDerivate_t velocity = c.compute_derivate(1);
+  boost::shared_ptr<curve_3_t> acceleration(c.compute_derivate_ptr(2));
+  BOOST_CHECK_EQUAL(velocity.dim(), 3);
+  BOOST_CHECK_EQUAL(velocity.min(), 0.5);
+  BOOST_CHECK_EQUAL(velocity.max(), 2.);
+  for (double t = 0.5; t <= 2.; t += 0.1) {
+    BOOST_CHECK(velocity(t).isApprox(c.derivate(t, 1)));
+    BOOST_CHECK(velocity.derivate(t, 1).isApprox(c.derivate(t, 2)));
+    BOOST_CHECK((*acceleration)(t).isApprox(c.derivate(t, 2)));
+  }
+  BOOST_CHECK(velocity.compute_derivate(1).isApprox(acceleration.get()));
+  // the derivative curve holds a copy of the curve:
+  c = SO3Bezier_t(rotations.begin(), rotations.begin() + 2, 0.5, 2.);
+  BOOST_CHECK(!velocity(1.).isApprox(c.derivate(1., 1)));
+  BOOST_CHECK_THROW(c.compute_derivate(0), std::invalid_argument);
+  BOOST_CHECK_THROW(c.compute_derivate(3), std::invalid_argument);
+  BOOST_CHECK_THROW(velocity.compute_derivate(2), std::invalid_argument);
+  BOOST_CHECK_THROW(SO3BezierDerivate_t()(1.), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(se3_curve) {
+  const t_quaternion_t rotations = control_rotations();
+  pointX_t p0 = point3_t(1., 1.5, -2.);
+  pointX_t p1 = point3_t(3., 0, 1.);
+  curve_ptr_t translation(new polynomial_t(p0, p1, 0., 3.));
+  curve_rotation_ptr_t rotation(new SO3Bezier_t(rotations.begin(), rotations.end(), 0., 3.));
+  SE3Curve_t c(translation, rotation);
+  BOOST_CHECK(c(1.3).rotation().isApprox((*rotation)(1.3)));
+  BOOST_CHECK(c.derivate(1.3, 1).tail<3>().isApprox(rotation->derivate(1.3, 1)));
+  BOOST_CHECK(c.derivate(1.3, 2).tail<3>().isApprox(rotation->derivate(1.3, 2)));
+}
+
+BOOST_AUTO_TEST_CASE(serialization) {
+  std::string fileName("fileTest_so3_bezier");
+  const t_quaternion_t rotations = control_rotations();
+  SO3Bezier_t c(rotations.begin(), rotations.end(), 0.5, 2.);
+  c.saveAsText<SO3Bezier_t>(fileName + ".txt");
+  c.saveAsXML<SO3Bezier_t>(fileName + ".xml", "so3_bezier");
+  c.saveAsBinary<SO3Bezier_t>(fileName);
+  SO3Bezier_t c_txt, c_xml, c_binary;
+  c_txt.loadFromText<SO3Bezier_t>(fileName + ".txt");
+  c_xml.loadFromXML<SO3Bezier_t>(fileName + ".xml", "so3_bezier");
+  c_binary.loadFromBinary<SO3Bezier_t>(fileName);
+  BOOST_CHECK(c == c_txt);
+  BOOST_CHECK(c == c_xml);
+  BOOST_CHECK(c == c_binary);
+  BOOST_CHECK(c.derivate(1., 1).isApprox(c_binary.derivate(1., 1)));
+
+  // serialization through a pointer to the abstract rotation curve:
+  curve_ptr_t translation(new polynomial_t(pointX_t(point3_t::Zero()), pointX_t(point3_t::Ones()), 0.5, 2.));
+  curve_rotation_ptr_t rotation(new SO3Bezier_t(c));
+  SE3Curve_t se3(translation, rotation);
+  se3.saveAsText<SE3Curve_t>(fileName + "_se3.txt");
+  SE3Curve_t se3_txt;
+  se3_txt.loadFromText<SE3Curve_t>(fileName + "_se3.txt");
+  BOOST_CHECK(se3.isApprox(se3_txt));
+  BOOST_CHECK(dynamic_cast<const SO3Bezier_t*>(se3_txt.rotation_curve().get()) != NULL);
+
+  // derivative curve, alone and in the derivative of a SE3Curve:
+  const SO3BezierDerivate_t velocity = c.compute_derivate(1);
+  velocity.saveAsText<SO3BezierDerivate_t>(fileName + "_derivate.txt");
+  velocity.saveAsXML<SO3BezierDerivate_t>(fileName + "_derivate.xml", "so3_bezier_derivate");
+  velocity.saveAsBinary<SO3BezierDerivate_t>(fileName + "_derivate");
+  SO3BezierDerivate_t velocity_txt, velocity_xml, velocity_binary;
+  velocity_txt.loadFromText<SO3BezierDerivate_t>(fileName + "_derivate.txt");
+  velocity_xml.loadFromXML<SO3BezierDerivate_t>(fileName + "_derivate.xml", "so3_bezier_derivate");
+  velocity_binary.loadFromBinary<SO3BezierDerivate_t>(fileName + "_derivate");
+  BOOST_CHECK(velocity == velocity_txt);
+  BOOST_CHECK(velocity == velocity_xml);
+  BOOST_CHECK(velocity == velocity_binary);
+  BOOST_CHECK_EQUAL(velocity_binary.order(), 1);
+  const SE3Derivate_t twist = se3.compute_derivate(1);
+  twist.saveAsText<SE3Derivate_t>(fileName + "_se3_derivate.txt");
+  SE3Derivate_t twist_txt;
+  twist_txt.loadFromText<SE3Derivate_t>(fileName + "_se3_derivate.txt");
+  BOOST_CHECK(twist.isApprox(twist_txt));
+  BOOST_CHECK(twist_txt(1.2).isApprox(se3.derivate(1.2, 1)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
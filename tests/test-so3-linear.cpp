@@ -0,0 +1,91 @@
+#define BOOST_TEST_MODULE test_so3_linear
+
+#include "ndcurves/fwd.h"
+#include "ndcurves/so3_linear.h"
+#include "ndcurves/serialization/curves.hpp"
+#include <boost/test/included/unit_test.hpp>
+
+using namespace ndcurves;
+
+namespace {
+// rotations pairs: generic, opposite quaternion signs (dot < 0), almost identical, identical
+std::vector<std::pair<quaternion_t, quaternion_t> > rotation_pairs() {
+  std::vector<std::pair<quaternion_t, quaternion_t> > res;
+  res.push_back(std::make_pair(quaternion_t(1, 0, 0, 0), quaternion_t(0.544, -0.002, -0.796, 0.265).normalized()));
+  res.push_back(std::make_pair(quaternion_t(0.2, 0.3, -0.5, 0.8).normalized(),
+                               quaternion_t(-0.7071, -0.7071, 0, 0).normalized()));
+  res.push_back(std::make_pair(quaternion_t(0.2, 0.3, -0.5, 0.8).normalized(),
+                               quaternion_t(0.2, 0.3, -0.5, 0.8 + 1e-9).normalized()));
+  res.push_back(std::make_pair(quaternion_t(0.2, 0.3, -0.5, 0.8).normalized(),
+                               quaternion_t(0.2, 0.3, -0.5, 0.8).normalized()));
+  return res;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+BOOST_AUTO_TEST_CASE(exp3_log3) {
+  const point3_t vectors[] = {point3_t(0.3, -1.2, 0.7), point3_t(1e-6, 2e-6, -1e-6), point3_t::Zero(),
+                              point3_t(0., 0., 3.1)};
+  for (std::size_t i = 0; i < 4; ++i) {
+    const point3_t& v = vectors[i];
+    const quaternion_t q = exp3(v);
+    BOOST_CHECK_CLOSE(q.norm(), 1., 1e-10);
+    const Eigen::AngleAxisd aa(q);
+    BOOST_CHECK((aa.angle() * aa.axis()).isApprox(v, 1e-10) || v.isZero());
+    BOOST_CHECK(log3(q).isApprox(v, 1e-10) || log3(q).isZero(1e-12));
+    // q and -q are the same rotation:
+    BOOST_CHECK(log3(quaternion_t(-q.coeffs())).isApprox(log3(q), 1e-10) || v.isZero());
+  }
+  const quaternion_t q(0.2, 0.3, -0.5, 0.8);
+  BOOST_CHECK(exp3(log3(q.normalized())).isApprox(q.normalized(), 1e-12));
+  SO3Linear_t so3;
+  BOOST_CHECK(log3(q.normalized()).isApprox(so3.log3(q.normalized().toRotationMatrix()), 1e-10));
+}
+
+BOOST_AUTO_TEST_CASE(slerp) {
+  const std::vector<std::pair<quaternion_t, quaternion_t> > pairs = rotation_pairs();
+  for (std::size_t i = 0; i < pairs.size(); ++i) {
+    const quaternion_t& q0 = pairs[i].first;
+    const quaternion_t& q1 = pairs[i].second;
+    SO3Linear_t so3(q0, q1, 0.5, 2.);
+    for (double t = 0.5; t <= 2.; t += 0.05) {
+      const quaternion_t expected = q0.slerp((t - 0.5) / 1.5, q1);
+      BOOST_CHECK(so3(t).isApprox(expected.toRotationMatrix(), 1e-10));
+    }
+    // the constants are recomputed after deserialization:
+    so3.saveAsText<SO3Linear_t>("fileTest_so3_linear.txt");
+    SO3Linear_t so3_txt;
+    so3_txt.loadFromText<SO3Linear_t>("fileTest_so3_linear.txt");
+    BOOST_CHECK(so3_txt(1.2).isApprox(so3(1.2)));
+    SO3Linear_t so3_copy(so3);
+    BOOST_CHECK(so3_copy(1.2).isApprox(so3(1.2)));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(batch) {
+  const std::vector<std::pair<quaternion_t, quaternion_t> > pairs = rotation_pairs();
+  const SO3Linear_t::time_vector_t times = SO3Linear_t::time_vector_t::LinSpaced(37, 0.5, 2.);
+  for (std::size_t i = 0; i < pairs.size(); ++i) {
+    SO3Linear_t so3(pairs[i].first, pairs[i].second, 0.5, 2.);
+    SO3Linear_t::quaternions_t quaternions(4, times.size());
+    so3.evaluate_batch(times, quaternions);
+    for (Eigen::Index j = 0; j < times.size(); ++j) {
+      BOOST_CHECK(quaternions.col(j).isApprox(so3.computeAsQuaternion(times[j]).coeffs(), 1e-12));
+    }
+    BOOST_CHECK(quaternions.col(0) == pairs[i].first.coeffs());
+    BOOST_CHECK(quaternions.col(times.size() - 1) == pairs[i].second.coeffs());
+  }
+  // degenerated time interval:
+  SO3Linear_t so3(pairs[0].first, pairs[0].second, 1., 1.);
+  SO3Linear_t::quaternions_t quaternions(4, 1);
+  so3.evaluate_batch(SO3Linear_t::time_vector_t::Constant(1, 1.), quaternions);
+  BOOST_CHECK(quaternions.col(0) == pairs[0].second.coeffs());
+
+  SO3Linear_t::quaternions_t too_small(4, times.size() - 1);
+  BOOST_CHECK_THROW(so3.evaluate_batch(times, too_small), std::invalid_argument);
+  SO3Linear_t::quaternions_t out_of_range(4, times.size());
+  BOOST_CHECK_THROW(so3.evaluate_batch(times, out_of_range), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()